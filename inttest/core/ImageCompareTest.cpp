@@ -0,0 +1,93 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2008 INPE and TerraLAB/UFOP.
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this library and its documentation.
+*************************************************************************************/
+
+#include "ImageCompareTest.h"
+
+#include "core/imageCompare.cpp"
+
+void ImageCompareTest::SetUp()
+{
+}
+
+void ImageCompareTest::TearDown()
+{
+}
+
+TEST_F(ImageCompareTest, Equal)
+{
+	QImage image1(20, 10, QImage::Format_RGB32);
+	image1.fill(Qt::red);
+	QImage image2 = image1.convertToFormat(QImage::Format_ARGB32);
+
+	ImageDifference diff;
+
+	ASSERT_TRUE(compareImages(image1, image2, diff));
+	ASSERT_EQ(diff.pixels, 0);
+	ASSERT_EQ(diff.maxDelta, 0);
+	ASSERT_TRUE(diff.bounds.isNull());
+}
+
+TEST_F(ImageCompareTest, Different)
+{
+	QImage image1(20, 10, QImage::Format_RGB32);
+	image1.fill(Qt::white);
+	QImage image2 = image1.copy();
+
+	image2.setPixel(3, 2, qRgb(250, 255, 255));
+	image2.setPixel(15, 7, qRgb(255, 200, 255));
+	image2.setPixel(16, 7, qRgb(255, 255, 240));
+
+	ImageDifference diff;
+
+	ASSERT_TRUE(compareImages(image1, image2, diff));
+	ASSERT_EQ(diff.pixels, 3);
+	ASSERT_EQ(diff.maxDelta, 55);
+	ASSERT_EQ(diff.bounds, QRect(QPoint(3, 2), QPoint(16, 7)));
+}
+
+TEST_F(ImageCompareTest, DifferentSizes)
+{
+	QImage image1(20, 10, QImage::Format_RGB32);
+	QImage image2(10, 20, QImage::Format_RGB32);
+	ImageDifference diff;
+
+	ASSERT_FALSE(compareImages(image1, image2, diff));
+	ASSERT_FALSE(compareImages(image1, QImage(), diff));
+}
+
+TEST_F(ImageCompareTest, ManyLines)
+{
+	QImage image1(100, 1000, QImage::Format_RGB32);
+	image1.fill(Qt::black);
+	QImage image2 = image1.copy();
+
+	for (int i = 0; i < image2.height(); i += 10)
+		image2.setPixel(i % image2.width(), i, qRgb(0, 0, 100));
+
+	ImageDifference diff;
+
+	ASSERT_TRUE(compareImages(image1, image2, diff));
+	ASSERT_EQ(diff.pixels, 100);
+	ASSERT_EQ(diff.maxDelta, 100);
+	ASSERT_EQ(diff.bounds, QRect(QPoint(0, 0), QPoint(90, 990)));
+}
@@ -31,12 +31,14 @@ class LuaApiMock : public terrame::lua::LuaApi
 		LuaApiMock() {}
 		MOCK_METHOD2(pushString, void(lua_State* L, const std::string& str));
 		MOCK_METHOD2(pushNumber, void(lua_State* L, double number));
+		MOCK_METHOD2(pushInteger, void(lua_State* L, long long number));
 		MOCK_METHOD1(pushNil, void(lua_State* L));
 		MOCK_METHOD2(pushLightUserdata, void(lua_State* L, void* pointer));
 		MOCK_METHOD2(pushBoolean, void(lua_State* L, bool b));
 
 		MOCK_METHOD2(pushGlobalByName, int(lua_State* L, const std::string& name));
 		MOCK_METHOD2(pushTableAt, int(lua_State* L, int index));
+		MOCK_METHOD3(setIndexAt, void(lua_State* L, int index, long long n));
 
 		MOCK_METHOD2(pop, void(lua_State* L, int numberOfElements));
 		MOCK_METHOD1(popOneElement, void(lua_State* L));
@@ -57,6 +59,7 @@ class LuaApiMock : public terrame::lua::LuaApi
 
 		MOCK_METHOD2(isStringAt, bool(lua_State* L, int index));
 		MOCK_METHOD2(isNumberAt, bool(lua_State* L, int index));
+		MOCK_METHOD2(isIntegerAt, bool(lua_State* L, int index));
 		MOCK_METHOD2(isBooleanAt, bool(lua_State* L, int index));
 		MOCK_METHOD2(isTableAt, bool(lua_State* L, int index));
 		MOCK_METHOD3(isUserdataAt, bool(lua_State* L, int index, const std::string& type));
@@ -23,11 +23,14 @@ of this software and its documentation.
 
 #include "LuaCellTest.h"
 
+#include <cmath>
+
 // all application
 #include "core/terrameGlobals.h"
 #include "observer/observerInterf.cpp"
 #include "observer/observerImpl.cpp"
 #include "observer/protocol/decoder/decoder.cpp"
+#include "observer/protocol/decoder/stateFrame.cpp"
 #include "observer/protocol/blackBoard/blackBoard.cpp"
 #include "observer/components/legend/legendAttributes.cpp"
 #include "observer/components/legend/legendColorUtils.cpp"
@@ -39,7 +42,9 @@ of this software and its documentation.
 #include "observer/cellSubjectInterf.cpp"
 #include "observer/cellSpaceSubjectInterf.cpp"
 #include "core/luaCellularSpace.cpp"
+#include "core/luaCellTraversal.cpp"
 #include "core/luaNeighborhood.cpp"
+#include "core/neighborhoodFile.cpp"
 
 #include "LuaApiMock.h"
 #include "LuaBindingMock.h"
@@ -58,6 +63,94 @@ void LuaCellTest::TearDown()
 {
 }
 
+void LuaCellTest::popColumn(LuaApiMock* luaApiMock, const std::vector<int>& types,
+	TerraMEObserver::StateFrame& frame)
+{
+	LuaBindingMock<luaCell>* bindMock = new LuaBindingMock<luaCell>();
+	terrame::lua::LuaBindingDelegate<luaCell>::getInstance().setBinding(bindMock);
+
+	luaCellularSpace* cs = new luaCellularSpace(L);
+
+	std::vector<luaCell*> cells;
+	for(unsigned int i = 0; i < types.size(); i++)
+		cells.push_back(new luaCell(L));
+
+	unsigned int next = 0;
+	EXPECT_CALL(*bindMock, check(testing::_, -1))
+		.Times(types.size())
+		.WillRepeatedly(testing::Invoke([&](lua_State*, int) { return cells[next++]; }));
+
+	// each cell has its own coordinates
+	double coordinate = 0;
+	EXPECT_CALL(*luaApiMock, getNumberAt(testing::_, -2))
+		.Times(testing::AnyNumber())
+		.WillRepeatedly(testing::InvokeWithoutArgs([&]() { return coordinate++; }));
+
+	EXPECT_CALL(*luaApiMock, getNumberAt(testing::_, -3))
+		.Times(testing::AnyNumber())
+		.WillRepeatedly(testing::Return(0));
+
+	for(unsigned int i = 0; i < types.size(); i++)
+		cs->addCell(L);
+
+	unsigned int cell = 0;
+	EXPECT_CALL(*luaApiMock, getTypeAt(testing::_, -1))
+		.Times(testing::AnyNumber())
+		.WillRepeatedly(testing::InvokeWithoutArgs([&]() { return types[cell++]; }));
+
+	EXPECT_CALL(*luaApiMock, isNumber(testing::_))
+		.Times(testing::AnyNumber())
+		.WillRepeatedly(testing::Invoke([](int type) { return type == LUA_TNUMBER; }));
+
+	EXPECT_CALL(*luaApiMock, isBoolean(testing::_))
+		.Times(testing::AnyNumber())
+		.WillRepeatedly(testing::Invoke([](int type) { return type == LUA_TBOOLEAN; }));
+
+	EXPECT_CALL(*luaApiMock, isString(testing::_))
+		.Times(testing::AnyNumber())
+		.WillRepeatedly(testing::Invoke([](int type) { return type == LUA_TSTRING; }));
+
+	EXPECT_CALL(*luaApiMock, isTable(testing::_))
+		.Times(testing::AnyNumber())
+		.WillRepeatedly(testing::Invoke([](int type) { return type == LUA_TTABLE; }));
+
+	EXPECT_CALL(*luaApiMock, isUserdata(testing::_))
+		.Times(testing::AnyNumber())
+		.WillRepeatedly(testing::Return(false));
+
+	EXPECT_CALL(*luaApiMock, isFunction(testing::_))
+		.Times(testing::AnyNumber())
+		.WillRepeatedly(testing::Return(false));
+
+	EXPECT_CALL(*luaApiMock, getNumberAt(testing::_, -1))
+		.Times(testing::AnyNumber())
+		.WillRepeatedly(testing::Return(5));
+
+	EXPECT_CALL(*luaApiMock, toBooleanAt(testing::_, -1))
+		.Times(testing::AnyNumber())
+		.WillRepeatedly(testing::Return(true));
+
+	EXPECT_CALL(*luaApiMock, getStringAtTop(testing::_))
+		.Times(testing::AnyNumber())
+		.WillRepeatedly(testing::Return(std::string("farmer")));
+
+	EXPECT_CALL(*luaApiMock, getReference(testing::_, testing::_, testing::_))
+		.Times(testing::AnyNumber());
+
+	EXPECT_CALL(*luaApiMock, pushString(testing::_, testing::_))
+		.Times(testing::AnyNumber());
+
+	EXPECT_CALL(*luaApiMock, pushTableAt(testing::_, testing::_))
+		.Times(testing::AnyNumber());
+
+	EXPECT_CALL(*luaApiMock, pop(testing::_, 2))
+		.Times(testing::AnyNumber());
+
+	cs->popColumn(L, "value", frame);
+
+	delete bindMock;
+}
+
 TEST_F(LuaCellTest, Constructor)
 {
 	LuaApiMock* luaApiMock = new LuaApiMock();
@@ -172,3 +265,90 @@ TEST_F(LuaCellTest, CreateObserverAndKill)
 	delete luaApiMock;
 	delete bindMock;
 }
+
+TEST_F(LuaCellTest, PopColumnNumber)
+{
+	LuaApiMock* luaApiMock = new LuaApiMock();
+	terrame::lua::LuaSystem::getInstance().setLuaApi(luaApiMock);
+
+	// the type of the column is the type of the first value that is not nil
+	TerraMEObserver::StateFrame frame;
+	popColumn(luaApiMock, {LUA_TNIL, LUA_TNUMBER, LUA_TSTRING, LUA_TBOOLEAN}, frame);
+
+	ASSERT_EQ(frame.columns.size(), 1);
+	const TerraMEObserver::StateFrame::Column& column = frame.columns.at(0);
+	ASSERT_EQ(column.key, QString("value"));
+	ASSERT_EQ(column.type, TerraMEObserver::TObsNumber);
+	ASSERT_EQ(column.numbers.size(), 4);
+	ASSERT_TRUE(std::isnan(column.numbers.at(0)));
+	ASSERT_EQ(column.numbers.at(1), 5);
+	ASSERT_TRUE(std::isnan(column.numbers.at(2)));
+	ASSERT_TRUE(std::isnan(column.numbers.at(3)));
+
+	delete luaApiMock;
+}
+
+TEST_F(LuaCellTest, PopColumnBoolean)
+{
+	LuaApiMock* luaApiMock = new LuaApiMock();
+	terrame::lua::LuaSystem::getInstance().setLuaApi(luaApiMock);
+
+	TerraMEObserver::StateFrame frame;
+	popColumn(luaApiMock, {LUA_TNIL, LUA_TNIL, LUA_TBOOLEAN, LUA_TNUMBER}, frame);
+
+	ASSERT_EQ(frame.columns.size(), 1);
+	const TerraMEObserver::StateFrame::Column& column = frame.columns.at(0);
+	ASSERT_EQ(column.type, TerraMEObserver::TObsBool);
+	ASSERT_EQ(column.numbers.size(), 4);
+	ASSERT_TRUE(std::isnan(column.numbers.at(0)));
+	ASSERT_TRUE(std::isnan(column.numbers.at(1)));
+	ASSERT_EQ(column.numbers.at(2), 1);
+	ASSERT_TRUE(std::isnan(column.numbers.at(3)));
+
+	delete luaApiMock;
+}
+
+TEST_F(LuaCellTest, PopColumnText)
+{
+	LuaApiMock* luaApiMock = new LuaApiMock();
+	terrame::lua::LuaSystem::getInstance().setLuaApi(luaApiMock);
+
+	TerraMEObserver::StateFrame frame;
+	popColumn(luaApiMock, {LUA_TNIL, LUA_TSTRING, LUA_TNUMBER}, frame);
+
+	ASSERT_EQ(frame.columns.size(), 1);
+	const TerraMEObserver::StateFrame::Column& column = frame.columns.at(0);
+	ASSERT_EQ(column.type, TerraMEObserver::TObsText);
+	ASSERT_EQ(column.texts.size(), 3);
+	ASSERT_EQ(column.texts.at(0), TerraMEObserver::VALUE_NOT_INFORMED);
+	ASSERT_EQ(column.texts.at(1), QString("farmer"));
+	ASSERT_EQ(column.texts.at(2), TerraMEObserver::VALUE_NOT_INFORMED);
+
+	delete luaApiMock;
+}
+
+TEST_F(LuaCellTest, PopColumnIgnored)
+{
+	LuaApiMock* luaApiMock = new LuaApiMock();
+	terrame::lua::LuaSystem::getInstance().setLuaApi(luaApiMock);
+
+	// attributes that cannot be encoded do not have a column
+	TerraMEObserver::StateFrame frame;
+	popColumn(luaApiMock, {LUA_TNIL, LUA_TTABLE, LUA_TNUMBER}, frame);
+	ASSERT_TRUE(frame.columns.isEmpty());
+
+	delete luaApiMock;
+
+	luaApiMock = new LuaApiMock();
+	terrame::lua::LuaSystem::getInstance().setLuaApi(luaApiMock);
+
+	// an attribute that is nil in all the cells is a column of missing values
+	TerraMEObserver::StateFrame missing;
+	popColumn(luaApiMock, {LUA_TNIL, LUA_TNIL}, missing);
+	ASSERT_EQ(missing.columns.size(), 1);
+	ASSERT_EQ(missing.columns.at(0).type, TerraMEObserver::TObsNumber);
+	ASSERT_EQ(missing.columns.at(0).numbers.size(), 2);
+	ASSERT_TRUE(std::isnan(missing.columns.at(0).numbers.at(1)));
+
+	delete luaApiMock;
+}
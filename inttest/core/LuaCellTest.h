@@ -23,9 +23,23 @@ of this software and its documentation.
 
 #include <gtest/gtest.h>
 
+#include <QString>
+#include <vector>
+
+class luaCellularSpace;
+class LuaApiMock;
+
+namespace TerraMEObserver {
+	class StateFrame;
+}
+
 class LuaCellTest : public ::testing::Test
 {
 protected:
 	void SetUp();
 	void TearDown();
+
+	/// Encodes an attribute of the cells whose Lua types are given, in this order
+	static void popColumn(LuaApiMock* luaApiMock, const std::vector<int>& types,
+		TerraMEObserver::StateFrame& frame);
 };
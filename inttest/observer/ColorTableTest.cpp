@@ -0,0 +1,119 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+#include "ColorTableTest.h"
+
+#include <limits>
+
+#include "observer/components/legend/legendAttributes.h"
+#include "observer/components/painter/colorTable.h"
+
+using namespace TerraMEObserver;
+
+static ObsLegend makeLegend(const QString &from, const QString &to, const QColor &color)
+{
+	ObsLegend leg;
+	leg.setFrom(from);
+	leg.setTo(to);
+	leg.setColor(color);
+	return leg;
+}
+
+void ColorTableTest::SetUp()
+{
+}
+
+void ColorTableTest::TearDown()
+{
+}
+
+TEST_F(ColorTableTest, Ramp)
+{
+	Attributes attrib("cover", 0, 0, 0);
+	ColorTable table(&attrib);
+	QRgb color;
+
+	ASSERT_TRUE(table.find(0, color));
+	ASSERT_EQ(color, qRgb(0, 0, 0));
+	ASSERT_TRUE(table.find(50, color));
+	ASSERT_EQ(color, qRgb(127, 127, 127));
+	ASSERT_FALSE(table.find(101, color));
+	ASSERT_FALSE(table.find(std::numeric_limits<double>::quiet_NaN(), color));
+	ASSERT_TRUE(table.isOpaque());
+}
+
+TEST_F(ColorTableTest, EqualSteps)
+{
+	Attributes attrib("cover", 0, 0, 0);
+	attrib.setGroupMode(TObsEqualSteps);
+	attrib.addLegend(makeLegend("0", "0.1", Qt::red));
+	attrib.addLegend(makeLegend("0.1", "0.2", Qt::green));
+	attrib.addLegend(makeLegend("0.2", "0.3", Qt::blue));
+
+	ColorTable table(&attrib);
+	QRgb color;
+
+	ASSERT_TRUE(table.find(0, color));
+	ASSERT_EQ(color, QColor(Qt::red).rgba());
+	ASSERT_TRUE(table.find(0.1, color));
+	ASSERT_EQ(color, QColor(Qt::green).rgba());
+	ASSERT_TRUE(table.find(0.29, color));
+	ASSERT_EQ(color, QColor(Qt::blue).rgba());
+	ASSERT_FALSE(table.find(0.3, color));
+	ASSERT_FALSE(table.find(-0.1, color));
+}
+
+TEST_F(ColorTableTest, OverlappingRanges)
+{
+	Attributes attrib("cover", 0, 0, 0);
+	attrib.setGroupMode(TObsQuantil);
+	attrib.addLegend(makeLegend("5", "10", Qt::red));
+	attrib.addLegend(makeLegend("0", "20", Qt::green));
+
+	ColorTable table(&attrib);
+	QRgb color;
+
+	ASSERT_TRUE(table.find(7, color));
+	ASSERT_EQ(color, QColor(Qt::red).rgba());
+	ASSERT_TRUE(table.find(12, color));
+	ASSERT_EQ(color, QColor(Qt::green).rgba());
+}
+
+TEST_F(ColorTableTest, UniqueValues)
+{
+	Attributes attrib("use", 0, 0, 0);
+	attrib.setGroupMode(TObsUniqueValue);
+	attrib.addLegend(makeLegend("forest", "1", Qt::green));
+	attrib.addLegend(makeLegend("pasture", "2", QColor(255, 255, 0, 128)));
+
+	ColorTable table(&attrib);
+	QRgb color;
+
+	ASSERT_TRUE(table.find(2, color));
+	ASSERT_EQ(qAlpha(color), 128);
+	ASSERT_FALSE(table.find(3, color));
+	ASSERT_TRUE(table.find(QString("forest"), color));
+	ASSERT_EQ(color, QColor(Qt::green).rgba());
+	ASSERT_FALSE(table.find(QString("water"), color));
+	ASSERT_FALSE(table.isOpaque());
+}
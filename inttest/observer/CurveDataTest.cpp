@@ -0,0 +1,128 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+#include "CurveDataTest.h"
+
+#include "observer/types/chartPlot/curveData.h"
+
+using namespace TerraMEObserver;
+
+static QwtScaleMap makeMap(double p1, double p2, double s1, double s2)
+{
+	QwtScaleMap map;
+	map.setPaintInterval(p1, p2);
+	map.setScaleInterval(s1, s2);
+	return map;
+}
+
+void CurveDataTest::SetUp()
+{
+}
+
+void CurveDataTest::TearDown()
+{
+}
+
+TEST_F(CurveDataTest, BoundingRect)
+{
+	QVector<double> xs, ys;
+	CurveData data(&xs, &ys);
+
+	ASSERT_EQ(data.size(), (size_t) 0);
+	ASSERT_FALSE(data.boundingRect().isValid());
+
+	xs << 0 << 1 << 2;
+	ys << 5 << -1 << 3;
+
+	ASSERT_EQ(data.size(), (size_t) 3);
+	ASSERT_EQ(data.sample(1), QPointF(1, -1));
+	ASSERT_EQ(data.boundingRect(), QRectF(0, -1, 2, 6));
+
+	xs << 3;
+	ASSERT_EQ(data.size(), (size_t) 3);
+
+	ys << 10;
+	ASSERT_EQ(data.boundingRect(), QRectF(0, -1, 3, 11));
+	ASSERT_TRUE(data.isSorted());
+
+	xs << 1;
+	ys << 0;
+	ASSERT_EQ(data.boundingRect(), QRectF(0, -1, 3, 11));
+	ASSERT_FALSE(data.isSorted());
+}
+
+TEST_F(CurveDataTest, BoundingRectCleared)
+{
+	QVector<double> xs, ys;
+	CurveData data(&xs, &ys);
+
+	xs << 0 << 1 << 2;
+	ys << 5 << -1 << 3;
+	ASSERT_EQ(data.boundingRect(), QRectF(0, -1, 2, 6));
+
+	xs.clear();
+	ys.clear();
+	ASSERT_FALSE(data.boundingRect().isValid());
+
+	xs << 4 << 6;
+	ys << 2 << 1;
+	ASSERT_EQ(data.boundingRect(), QRectF(4, 1, 2, 1));
+	ASSERT_TRUE(data.isSorted());
+}
+
+TEST_F(CurveDataTest, Decimate)
+{
+	QVector<double> xs, ys;
+	CurveData data(&xs, &ys);
+
+	// 128 samples for each of the 8 pixel columns
+	for (int i = 0; i < 1024; i++)
+	{
+		xs << i;
+		ys << 0;
+	}
+
+	ys[20] = 8;
+	ys[40] = -5;
+
+	QwtScaleMap xMap = makeMap(0, 8, 0, 1024);
+	QwtScaleMap yMap = makeMap(0, 10, 0, 10);
+
+	QPolygonF points = data.decimate(xMap, yMap, 0, 1023);
+
+	// the first, maximum, minimum, and last samples of the first column,
+	// and only the first and last ones of the other columns
+	ASSERT_EQ(points.size(), 4 + 7 * 2);
+	ASSERT_EQ(points.at(0), QPointF(0, 0));
+	ASSERT_EQ(points.at(1), QPointF(20 / 128.0, 8));
+	ASSERT_EQ(points.at(2), QPointF(40 / 128.0, -5));
+	ASSERT_EQ(points.at(3), QPointF(127 / 128.0, 0));
+	ASSERT_EQ(points.at(4), QPointF(1, 0));
+	ASSERT_EQ(points.at(5), QPointF(255 / 128.0, 0));
+	ASSERT_EQ(points.last(), QPointF(1023 / 128.0, 0));
+
+	points = data.decimate(xMap, yMap, 128, 300);
+	ASSERT_EQ(points.size(), 4);
+	ASSERT_EQ(points.at(0), QPointF(1, 0));
+	ASSERT_EQ(points.at(3), QPointF(300 / 128.0, 0));
+}
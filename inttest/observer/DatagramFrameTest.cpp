@@ -0,0 +1,150 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+#include "DatagramFrameTest.h"
+
+#include <QThread>
+
+#include "observer/protocol/decoder/datagramFrame.cpp"
+
+using namespace TerraMEObserver;
+
+static QByteArray makeMessage(int size, char c)
+{
+	QByteArray message(size, c);
+	for (int i = 0; i < size; i += 7)
+		message[i] = (char) (i % 251);
+	return message;
+}
+
+// Bytes that do not compress
+static QByteArray makeNoise(int size)
+{
+	QByteArray noise(size, '\0');
+	quint32 seed = 12345;
+	for (int i = 0; i < size; i++)
+	{
+		seed = seed * 1103515245 + 12345;
+		noise[i] = (char) (seed >> 16);
+	}
+	return noise;
+}
+
+void DatagramFrameTest::SetUp()
+{
+}
+
+void DatagramFrameTest::TearDown()
+{
+}
+
+TEST_F(DatagramFrameTest, Split)
+{
+	QByteArray message = makeMessage(2500, 'a');
+	QList<QByteArray> datagrams = DatagramFrame::split(7, message, 1000, 0);
+
+	ASSERT_EQ(datagrams.size(), 3);
+	ASSERT_EQ(datagrams.at(0).size(), DatagramFrame::HEADER_SIZE + 1000);
+	ASSERT_EQ(datagrams.at(2).size(), DatagramFrame::HEADER_SIZE + 500);
+
+	datagrams = DatagramFrame::split(8, QByteArray(), 1000, DatagramFrame::EndOfSimulation);
+	ASSERT_EQ(datagrams.size(), 1);
+	ASSERT_EQ(datagrams.at(0).size(), DatagramFrame::HEADER_SIZE);
+}
+
+TEST_F(DatagramFrameTest, InterleavedAndOutOfOrder)
+{
+	QByteArray first = makeMessage(3000, 'a');
+	QByteArray second = qCompress(makeNoise(5000));
+
+	QList<QByteArray> a = DatagramFrame::split(10, first, 1000, 0);
+	QList<QByteArray> b = DatagramFrame::split(11, second, 1000, DatagramFrame::Compressed);
+
+	DatagramAssembler assembler;
+	QByteArray message;
+	quint8 flags;
+
+	ASSERT_FALSE(assembler.add(a.at(2), message, flags));
+	ASSERT_FALSE(assembler.add(b.at(0), message, flags));
+	ASSERT_FALSE(assembler.add(a.at(0), message, flags));
+	ASSERT_FALSE(assembler.add(a.at(0), message, flags)); // duplicated
+	ASSERT_TRUE(assembler.add(a.at(1), message, flags));
+	ASSERT_EQ(message, first);
+	ASSERT_EQ(flags, 0);
+
+	for (int i = b.size() - 1; i > 0; i--)
+		ASSERT_EQ(assembler.add(b.at(i), message, flags), i == 1);
+
+	ASSERT_EQ(message, makeNoise(5000));
+	ASSERT_EQ(flags, DatagramFrame::Compressed);
+	ASSERT_EQ(assembler.getDiscarded(), 0);
+}
+
+TEST_F(DatagramFrameTest, LostDatagrams)
+{
+	QList<QByteArray> a = DatagramFrame::split(20, makeMessage(3000, 'a'), 1000, 0);
+	QList<QByteArray> b = DatagramFrame::split(21, makeMessage(2000, 'b'), 1000, 0);
+	QList<QByteArray> c = DatagramFrame::split(22, makeMessage(2000, 'c'), 1000, 0);
+
+	DatagramAssembler assembler(50);
+	QByteArray message;
+	quint8 flags;
+
+	// the second datagram of a is lost, therefore a is discarded
+	// as soon as the newer message b is complete
+	ASSERT_FALSE(assembler.add(a.at(0), message, flags));
+	ASSERT_FALSE(assembler.add(b.at(0), message, flags));
+	ASSERT_TRUE(assembler.add(b.at(1), message, flags));
+	ASSERT_EQ(assembler.getDiscarded(), 1);
+
+	// late datagrams of older messages are ignored
+	ASSERT_FALSE(assembler.add(a.at(1), message, flags));
+	ASSERT_FALSE(assembler.add(a.at(2), message, flags));
+
+	// the last datagram of c is lost, therefore c expires
+	ASSERT_FALSE(assembler.add(c.at(0), message, flags));
+	ASSERT_EQ(assembler.discardExpired(), 0);
+	QThread::msleep(100);
+	ASSERT_EQ(assembler.discardExpired(), 1);
+	ASSERT_EQ(assembler.getDiscarded(), 2);
+}
+
+TEST_F(DatagramFrameTest, NewSimulation)
+{
+	DatagramAssembler assembler;
+	QByteArray message;
+	quint8 flags;
+
+	QList<QByteArray> end = DatagramFrame::split(100, QByteArray("end"), 1000,
+		DatagramFrame::EndOfSimulation);
+
+	ASSERT_TRUE(assembler.add(end.at(0), message, flags));
+	ASSERT_EQ(flags, DatagramFrame::EndOfSimulation);
+
+	// a new simulation can use ids smaller than the previous ones
+	QList<QByteArray> state = DatagramFrame::split(50, QByteArray("state"), 1000, 0);
+	ASSERT_TRUE(assembler.add(state.at(0), message, flags));
+	ASSERT_EQ(message, QByteArray("state"));
+
+	ASSERT_FALSE(assembler.add(QByteArray("invalid datagram"), message, flags));
+}
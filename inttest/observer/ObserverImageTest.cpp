@@ -0,0 +1,134 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+#include "ObserverImageTest.h"
+
+#include "observer/components/legend/legendAttributes.h"
+#include "observer/components/painter/colorTable.h"
+#include "observer/types/observerImage.h"
+
+using namespace TerraMEObserver;
+
+static ObsLegend makeLegend(const QString &from, const QString &to, const QColor &color)
+{
+	ObsLegend leg;
+	leg.setFrom(from);
+	leg.setTo(to);
+	leg.setColor(color);
+	return leg;
+}
+
+static ObserverImage::Layer makeLayer(Attributes *attrib)
+{
+	ObserverImage::Layer layer;
+	layer.table = QSharedPointer<ColorTable>(new ColorTable(attrib));
+	layer.numeric = true;
+	layer.xs << 0 << 1 << 5;
+	layer.ys << 0 << 0 << 0;
+	return layer;
+}
+
+static ObserverImage::Frame makeFrame(int cellSize, bool grid)
+{
+	ObserverImage::Frame frame;
+	frame.number = 1;
+	frame.size = QSize(2 * cellSize, cellSize);
+	frame.cellSize = cellSize;
+	frame.grid = grid;
+	return frame;
+}
+
+void ObserverImageTest::SetUp()
+{
+}
+
+void ObserverImageTest::TearDown()
+{
+}
+
+TEST_F(ObserverImageTest, Render)
+{
+	Attributes attrib("cover", 0, 0, 0);
+	attrib.setGroupMode(TObsEqualSteps);
+	attrib.addLegend(makeLegend("0", "0.1", Qt::red));
+	attrib.addLegend(makeLegend("0.1", "0.2", Qt::green));
+
+	ObserverImage::Layer layer = makeLayer(&attrib);
+	layer.numbers << 0 << 0.15 << 0;
+
+	ObserverImage::Frame frame = makeFrame(2, false);
+	frame.layers << layer;
+
+	QImage image = ObserverImage::render(frame);
+
+	ASSERT_EQ(image.size(), QSize(4, 2));
+	ASSERT_EQ(image.pixel(0, 0), QColor(Qt::red).rgb());
+	ASSERT_EQ(image.pixel(1, 1), QColor(Qt::red).rgb());
+	ASSERT_EQ(image.pixel(2, 0), QColor(Qt::green).rgb());
+	ASSERT_EQ(image.pixel(3, 1), QColor(Qt::green).rgb());
+}
+
+TEST_F(ObserverImageTest, RenderLayers)
+{
+	Attributes cover("cover", 0, 0, 0);
+	cover.setGroupMode(TObsEqualSteps);
+	cover.addLegend(makeLegend("0", "0.1", Qt::red));
+	cover.addLegend(makeLegend("0.1", "0.2", Qt::green));
+
+	Attributes use("use", 0, 0, 0);
+	use.setGroupMode(TObsUniqueValue);
+	use.addLegend(makeLegend("forest", "forest", QColor(128, 128, 128)));
+
+	ObserverImage::Layer bottom = makeLayer(&cover);
+	bottom.numbers << 0 << 0.15 << 0;
+
+	ObserverImage::Layer top = makeLayer(&use);
+	top.numeric = false;
+	top.texts << "forest" << "water" << "forest";
+
+	ObserverImage::Frame frame = makeFrame(2, false);
+	frame.layers << bottom << top;
+
+	QImage image = ObserverImage::render(frame);
+
+	ASSERT_EQ(image.pixel(0, 0), qRgb(128, 0, 0));
+	ASSERT_EQ(image.pixel(2, 0), QColor(Qt::green).rgb());
+}
+
+TEST_F(ObserverImageTest, RenderGrid)
+{
+	Attributes attrib("cover", 0, 0, 0);
+
+	ObserverImage::Layer layer = makeLayer(&attrib);
+	layer.numbers << 0 << 100 << 0;
+
+	ObserverImage::Frame frame = makeFrame(4, true);
+	frame.layers << layer;
+
+	QImage image = ObserverImage::render(frame);
+
+	ASSERT_EQ(image.pixel(0, 0), qRgb(128, 128, 128));
+	ASSERT_EQ(image.pixel(4, 2), qRgb(128, 128, 128));
+	ASSERT_EQ(image.pixel(1, 1), qRgb(0, 0, 0));
+	ASSERT_EQ(image.pixel(5, 1), qRgb(255, 255, 255));
+}
@@ -0,0 +1,160 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+#include "ObserverMapTest.h"
+
+#include "observer/components/legend/legendAttributes.h"
+#include "observer/protocol/decoder/decoder.h"
+#include "observer/protocol/decoder/stateFrame.h"
+#include "observer/types/observerMap.h"
+
+using namespace TerraMEObserver;
+
+static StateFrame makeFrame(int size)
+{
+	StateFrame frame;
+	frame.id = 3;
+	frame.subjectType = TObsCellularSpace;
+	frame.sequence = 1;
+	frame.elementType = TObsCell;
+
+	StateFrame::Column &x = frame.addColumn("x", TObsNumber);
+	StateFrame::Column &y = frame.addColumn("y", TObsNumber);
+	StateFrame::Column &cover = frame.addColumn("cover", TObsNumber);
+	StateFrame::Column &owner = frame.addColumn("owner", TObsText);
+
+	for (int i = 0; i < size; i++)
+	{
+		frame.elementIds.append(i + 1);
+		x.numbers.append(i % 2);
+		y.numbers.append(i / 2);
+		cover.numbers.append(i * 0.5);
+		owner.texts.append(i % 2 ? "farmer" : "nobody");
+	}
+	return frame;
+}
+
+static void checkLayers(Attributes &cover, Attributes &owner, int size)
+{
+	ASSERT_EQ(cover.getNumericValues()->size(), size);
+	ASSERT_EQ(owner.getTextValues()->size(), size);
+	ASSERT_EQ(cover.getXsValue()->size(), size);
+	ASSERT_EQ(cover.getYsValue()->size(), size);
+
+	ASSERT_EQ(cover.getNumericValues()->at(3), 1.5);
+	ASSERT_EQ(owner.getTextValues()->at(3), QString("farmer"));
+	ASSERT_EQ(cover.getXsValue()->at(3), 1);
+	ASSERT_EQ(cover.getYsValue()->at(3), 1);
+
+	ASSERT_TRUE(*owner.getXsValue() == *cover.getXsValue());
+	ASSERT_TRUE(*owner.getYsValue() == *cover.getYsValue());
+}
+
+void ObserverMapTest::SetUp()
+{
+}
+
+void ObserverMapTest::TearDown()
+{
+}
+
+TEST_F(ObserverMapTest, DecodeLayers)
+{
+	Attributes cover("cover", 0, 0, 0);
+	Attributes owner("owner", 0, 0, 0);
+	QHash<QString, Attributes *> attribs;
+	attribs.insert("cover", &cover);
+	attribs.insert("owner", &owner);
+	Decoder decoder(&attribs);
+
+	QList<Attributes *> layers;
+	layers << &cover << &owner;
+
+	ASSERT_TRUE(ObserverMap::decodeLayers(decoder, makeFrame(6), layers));
+	checkLayers(cover, owner, 6);
+}
+
+TEST_F(ObserverMapTest, DecodeLayersText)
+{
+	Attributes cover("cover", 0, 0, 0);
+	Attributes owner("owner", 0, 0, 0);
+	QHash<QString, Attributes *> attribs;
+	attribs.insert("cover", &cover);
+	attribs.insert("owner", &owner);
+	Decoder decoder(&attribs);
+
+	QList<Attributes *> layers;
+	layers << &cover << &owner;
+
+	ASSERT_TRUE(ObserverMap::decodeLayers(decoder, makeFrame(6).toText(), layers));
+	checkLayers(cover, owner, 6);
+}
+
+TEST_F(ObserverMapTest, DecodeLayersDelta)
+{
+	Attributes cover("cover", 0, 0, 0);
+	Attributes owner("owner", 0, 0, 0);
+	QHash<QString, Attributes *> attribs;
+	attribs.insert("cover", &cover);
+	attribs.insert("owner", &owner);
+	Decoder decoder(&attribs);
+
+	QList<Attributes *> layers;
+	layers << &cover << &owner;
+
+	StateFrame previous = makeFrame(6);
+	StateFrame current = makeFrame(6);
+	StateFrame delta;
+	current.sequence = 2;
+	current.columns[2].numbers[4] = 7;
+
+	ASSERT_TRUE(current.diff(previous, delta, 6));
+	ASSERT_TRUE(ObserverMap::decodeLayers(decoder, previous, layers));
+	ASSERT_TRUE(ObserverMap::decodeLayers(decoder, delta, layers));
+
+	checkLayers(cover, owner, 6);
+	ASSERT_EQ(cover.getNumericValues()->at(4), 7);
+}
+
+TEST_F(ObserverMapTest, DecodeLayersDeltaWithoutKeyframe)
+{
+	Attributes cover("cover", 0, 0, 0);
+	Attributes owner("owner", 0, 0, 0);
+	QHash<QString, Attributes *> attribs;
+	attribs.insert("cover", &cover);
+	attribs.insert("owner", &owner);
+	Decoder decoder(&attribs);
+
+	QList<Attributes *> layers;
+	layers << &cover << &owner;
+
+	StateFrame previous = makeFrame(6);
+	StateFrame current = makeFrame(6);
+	StateFrame delta;
+	current.sequence = 2;
+	current.columns[2].numbers[4] = 7;
+
+	ASSERT_TRUE(current.diff(previous, delta, 6));
+	ASSERT_FALSE(ObserverMap::decodeLayers(decoder, delta, layers));
+	ASSERT_TRUE(owner.getXsValue()->isEmpty());
+}
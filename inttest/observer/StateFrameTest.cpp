@@ -0,0 +1,223 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+#include "StateFrameTest.h"
+
+#include <QBuffer>
+#include <limits>
+
+#include "observer/protocol/decoder/stateFrame.h"
+
+using namespace TerraMEObserver;
+
+static StateFrame makeFrame(quint32 sequence, int size)
+{
+	StateFrame frame;
+	frame.id = 3;
+	frame.subjectType = TObsCellularSpace;
+	frame.sequence = sequence;
+	frame.elementType = TObsCell;
+	frame.addAttribute("cells", TObsText, "Lua-Address(TB): 0x1");
+
+	StateFrame::Column &cover = frame.addColumn("cover", TObsNumber);
+	StateFrame::Column &owner = frame.addColumn("owner", TObsText);
+
+	for (int i = 0; i < size; i++)
+	{
+		frame.elementIds.append(i + 1);
+		cover.numbers.append(i * 0.5);
+		owner.texts.append("nobody");
+	}
+	return frame;
+}
+
+static StateFrame writeAndRead(const StateFrame &frame)
+{
+	QByteArray data;
+	QBuffer buffer(&data);
+	buffer.open(QIODevice::WriteOnly);
+	QDataStream out(&buffer);
+	frame.write(out);
+	buffer.close();
+
+	buffer.open(QIODevice::ReadOnly);
+	QDataStream in(&buffer);
+	StateFrame result;
+	EXPECT_TRUE(StateFrame::isFrame(in));
+	EXPECT_TRUE(result.read(in));
+	return result;
+}
+
+void StateFrameTest::SetUp()
+{
+}
+
+void StateFrameTest::TearDown()
+{
+}
+
+TEST_F(StateFrameTest, Diff)
+{
+	StateFrame previous = makeFrame(1, 100);
+	StateFrame current = makeFrame(2, 100);
+	StateFrame delta;
+
+	current.columns[0].numbers[10] = 7;
+	current.columns[1].texts[90] = "farmer";
+
+	ASSERT_TRUE(current.diff(previous, delta, 50));
+	ASSERT_TRUE(delta.delta);
+	ASSERT_EQ(delta.sequence, (quint32) 2);
+	ASSERT_EQ(delta.base, (quint32) 1);
+	ASSERT_EQ(delta.rows.size(), 2);
+	ASSERT_EQ(delta.rows.at(0), 10);
+	ASSERT_EQ(delta.rows.at(1), 90);
+	ASSERT_EQ(delta.columns.at(0).numbers.at(0), 7);
+	ASSERT_EQ(delta.columns.at(0).numbers.at(1), 45);
+	ASSERT_EQ(delta.columns.at(1).texts.at(1), QString("farmer"));
+	ASSERT_TRUE(delta.toText().isEmpty());
+
+	ASSERT_FALSE(current.diff(previous, delta, 1));
+}
+
+TEST_F(StateFrameTest, DiffMissingValues)
+{
+	StateFrame previous = makeFrame(1, 10);
+	StateFrame current = makeFrame(2, 10);
+	StateFrame delta;
+
+	previous.columns[0].numbers[5] = std::numeric_limits<double>::quiet_NaN();
+	current.columns[0].numbers[5] = std::numeric_limits<double>::quiet_NaN();
+
+	ASSERT_TRUE(current.diff(previous, delta, 10));
+	ASSERT_TRUE(delta.rows.isEmpty());
+}
+
+TEST_F(StateFrameTest, DiffNeedsKeyframe)
+{
+	StateFrame previous = makeFrame(1, 10);
+	StateFrame delta;
+
+	ASSERT_FALSE(makeFrame(2, 11).diff(previous, delta, 10));
+
+	StateFrame current = makeFrame(2, 10);
+	current.columns[1].key = "use";
+	ASSERT_FALSE(current.diff(previous, delta, 10));
+}
+
+TEST_F(StateFrameTest, WriteAndReadDelta)
+{
+	StateFrame previous = makeFrame(4, 20);
+	StateFrame current = makeFrame(5, 20);
+	StateFrame delta;
+
+	current.columns[0].numbers[3] = -1;
+	ASSERT_TRUE(current.diff(previous, delta, 10));
+
+	StateFrame result = writeAndRead(delta);
+	ASSERT_TRUE(result.delta);
+	ASSERT_EQ(result.base, (quint32) 4);
+	ASSERT_EQ(result.sequence, (quint32) 5);
+	ASSERT_TRUE(result.elementIds.isEmpty());
+	ASSERT_EQ(result.rows, delta.rows);
+	ASSERT_EQ(result.columns.size(), 2);
+	ASSERT_EQ(result.columns.at(0).numbers, delta.columns.at(0).numbers);
+	ASSERT_EQ(result.columns.at(1).texts, delta.columns.at(1).texts);
+
+	result = writeAndRead(current);
+	ASSERT_FALSE(result.delta);
+	ASSERT_EQ(result.sequence, (quint32) 5);
+	ASSERT_EQ(result.elementIds, current.elementIds);
+	ASSERT_EQ(result.columns.at(0).numbers, current.columns.at(0).numbers);
+}
+
+TEST_F(StateFrameTest, WriteAndReadKeyframe)
+{
+	StateFrame frame = makeFrame(1, 5);
+	frame.addAttribute("x", TObsNumber, "3");
+
+	StateFrame::Column &alive = frame.addColumn("alive", TObsBool);
+	alive.numbers << 1 << 0 << std::numeric_limits<double>::quiet_NaN() << 1 << 0;
+	frame.columns[1].texts[2] = "";
+
+	StateFrame result = writeAndRead(frame);
+	ASSERT_EQ(result.id, 3);
+	ASSERT_EQ(result.subjectType, TObsCellularSpace);
+	ASSERT_EQ(result.elementType, TObsCell);
+	ASSERT_EQ(result.keys, frame.keys);
+	ASSERT_EQ(result.types, frame.types);
+	ASSERT_EQ(result.values, frame.values);
+	ASSERT_EQ(result.elementIds, frame.elementIds);
+
+	ASSERT_EQ(result.columns.size(), 3);
+	ASSERT_EQ(result.columns.at(0).type, TObsNumber);
+	ASSERT_EQ(result.columns.at(0).numbers, frame.columns.at(0).numbers);
+	ASSERT_EQ(result.columns.at(1).type, TObsText);
+	ASSERT_EQ(result.columns.at(1).texts, frame.columns.at(1).texts);
+	ASSERT_EQ(result.columns.at(2).key, QString("alive"));
+	ASSERT_EQ(result.columns.at(2).type, TObsBool);
+	ASSERT_EQ(result.columns.at(2).numbers.at(0), 1);
+	ASSERT_EQ(result.columns.at(2).numbers.at(1), 0);
+	ASSERT_TRUE(result.columns.at(2).numbers.at(2) != result.columns.at(2).numbers.at(2));
+}
+
+TEST_F(StateFrameTest, ReadTruncated)
+{
+	QByteArray data;
+	QBuffer buffer(&data);
+	buffer.open(QIODevice::WriteOnly);
+	QDataStream out(&buffer);
+	makeFrame(1, 100).write(out);
+	buffer.close();
+
+	// any frame that ends before its last value is rejected
+	for (int size = data.size() - 1; size > 0; size -= 97)
+	{
+		QByteArray part = data.left(size);
+		QDataStream in(part);
+		StateFrame result;
+		ASSERT_FALSE(result.read(in));
+	}
+}
+
+TEST_F(StateFrameTest, ReadInvalidSizes)
+{
+	// a frame without values that claims to have a million elements
+	QByteArray header;
+	QDataStream prefix(&header, QIODevice::WriteOnly);
+	prefix << StateFrame::MAGIC << (qint32) 3 << (qint32) TObsCellularSpace << (quint32) 1 << (quint8) 0
+	       << (qint32) 0 << (qint32) 1000000 << (qint32) TObsCell;
+
+	QDataStream in(header);
+	StateFrame result;
+	ASSERT_FALSE(result.read(in));
+
+	// the same with a negative number of columns
+	header.clear();
+	QDataStream negative(&header, QIODevice::WriteOnly);
+	negative << StateFrame::MAGIC << (qint32) 3 << (qint32) TObsCellularSpace << (quint32) 1 << (quint8) 0
+	         << (qint32) 0 << (qint32) 0 << (qint32) TObsCell << (qint32) -1;
+
+	QDataStream in2(header);
+	ASSERT_FALSE(result.read(in2));
+}
@@ -0,0 +1,163 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+#include "TcpSocketTaskTest.h"
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+
+#include "observer/types/tcpSocketTask.h"
+
+using namespace TerraMEObserver;
+
+static QByteArray serialize(const QString& msg)
+{
+	QByteArray state;
+	QDataStream out(&state, QIODevice::WriteOnly);
+	out << msg;
+	return state;
+}
+
+// Reads one frame sent by TcpSocketTask, waiting for it at most timeout ms
+static bool readFrame(QTcpSocket* socket, QString& msg, int timeout)
+{
+	const int headerSize = sizeof(quint32) + sizeof(quint8);
+
+	while (socket->bytesAvailable() < headerSize)
+	{
+		if (!socket->waitForReadyRead(timeout))
+			return false;
+	}
+
+	QDataStream in(socket);
+	quint32 size;
+	quint8 compressed;
+	in >> size >> compressed;
+
+	QByteArray data;
+	while (data.size() < (int) size)
+	{
+		if ((socket->bytesAvailable() == 0) && !socket->waitForReadyRead(timeout))
+			return false;
+
+		data.append(socket->read(size - data.size()));
+	}
+
+	msg = QString::fromLatin1(compressed ? qUncompress(data) : data);
+	return true;
+}
+
+void TcpSocketTaskTest::SetUp()
+{
+}
+
+void TcpSocketTaskTest::TearDown()
+{
+}
+
+TEST_F(TcpSocketTaskTest, Loopback)
+{
+	QTcpServer server;
+	ASSERT_TRUE(server.listen(QHostAddress::LocalHost));
+
+	QThread thread;
+	TcpSocketTask task(4);
+	task.setHost("127.0.0.1", server.serverPort());
+	task.setCompress(true);
+	task.moveToThread(&thread);
+	thread.start();
+	QMetaObject::invokeMethod(&task, "connectToHost", Qt::QueuedConnection);
+
+	ASSERT_TRUE(server.waitForNewConnection(5000));
+	QTcpSocket* receiver = server.nextPendingConnection();
+
+	const int states = 10000;
+	QElapsedTimer timer;
+	timer.start();
+
+	for (int i = 0; i < states; i++)
+		task.addState(serialize(QString("state$%1").arg(i)));
+
+	qint64 produced = timer.elapsed();
+
+	QString msg, last = QString("state$%1").arg(states - 1);
+	int received = 0, previous = -1;
+
+	while ((msg != last) && readFrame(receiver, msg, 5000))
+	{
+		int current = msg.split("$").at(1).toInt();
+		ASSERT_GT(current, previous);
+		previous = current;
+		received++;
+	}
+
+	qint64 consumed = timer.elapsed();
+
+	ASSERT_EQ(msg, last);
+	ASSERT_EQ(received, task.getStatesSent());
+	ASSERT_EQ(states, task.getStatesSent() + task.getStatesDropped());
+
+	RecordProperty("ProducerMilliseconds", (int) produced);
+	RecordProperty("ReceivedStatesPerSecond", (int) (received * 1000 / qMax(consumed, (qint64) 1)));
+
+	QMetaObject::invokeMethod(&task, "abort", Qt::BlockingQueuedConnection);
+	thread.quit();
+	thread.wait();
+}
+
+TEST_F(TcpSocketTaskTest, SlowReceiverDoesNotBlock)
+{
+	QTcpServer server;
+	ASSERT_TRUE(server.listen(QHostAddress::LocalHost));
+
+	QThread thread;
+	TcpSocketTask task(2);
+	task.setHost("127.0.0.1", server.serverPort());
+	task.setCompress(false);
+	task.moveToThread(&thread);
+	thread.start();
+	QMetaObject::invokeMethod(&task, "connectToHost", Qt::QueuedConnection);
+
+	ASSERT_TRUE(server.waitForNewConnection(5000));
+	QTcpSocket* receiver = server.nextPendingConnection();
+
+	// the receiver never reads, therefore the buffers fill up and
+	// the oldest states have to be discarded
+	QString big(1 << 18, 'x');
+	bool dropped = false;
+
+	for (int i = 0; i < 200; i++)
+		dropped = !task.addState(serialize(big)) || dropped;
+
+	ASSERT_TRUE(dropped);
+	ASSERT_GT(task.getStatesDropped(), 0);
+
+	QMetaObject::invokeMethod(&task, "abort", Qt::BlockingQueuedConnection);
+	thread.quit();
+	thread.wait();
+	receiver->abort();
+}
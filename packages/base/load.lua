@@ -10,6 +10,7 @@ files = {
 	"UnitTest.lua",
 	"Mandatory.lua",
 	"Model.lua",
+	"Batch.lua",
 	"SocialNetwork.lua",
 	"Society.lua",
 	"Group.lua",
@@ -33,6 +34,7 @@ files = {
 	"VisualTable.lua",
 	"TextScreen.lua",
 	"Log.lua",
+	"Checkpoint.lua",
 	"Profiler.lua"
 }
 
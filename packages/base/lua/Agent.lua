@@ -324,6 +324,10 @@ Agent_ = {
 		local s = self.socialnetworks[name]
 		if type(s) == "function" then
 			s = s(self)
+		elseif type(s) == "SharedSocialNetwork" then
+			-- the Agent gets its own SocialNetwork as it might be updated
+			s = s:get(self)
+			self.socialnetworks[name] = s
 		end
 
 		return s
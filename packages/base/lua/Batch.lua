@@ -0,0 +1,319 @@
+-------------------------------------------------------------------------------------------
+-- TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+-- Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+-- This code is part of the TerraME framework.
+-- This framework is free software; you can redistribute it and/or
+-- modify it under the terms of the GNU Lesser General Public
+-- License as published by the Free Software Foundation; either
+-- version 2.1 of the License, or (at your option) any later version.
+
+-- You should have received a copy of the GNU Lesser General Public
+-- License along with this library.
+
+-- The authors reassure the license terms regarding the warranties.
+-- They specifically disclaim any warranties, including, but not limited to,
+-- the implied warranties of merchantability and fitness for a particular purpose.
+-- The framework provided hereunder is on an "as is" basis, and the authors have no
+-- obligation to provide maintenance, support, updates, enhancements, or modifications.
+-- In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+-- indirect, special, incidental, or consequential damages arising out of the use
+-- of this software and its documentation.
+--
+-------------------------------------------------------------------------------------------
+
+local function expandChoice(name, choice)
+	if choice.values then
+		if #choice.values > 0 then
+			return choice.values
+		end
+
+		local values = {}
+		forEachOrderedElement(choice.values, function(idx)
+			table.insert(values, idx)
+		end)
+
+		return values
+	elseif choice.step and choice.max then
+		local values = {}
+		local quantity = math.floor((choice.max - choice.min) / choice.step + 0.5)
+
+		for i = 0, quantity do
+			table.insert(values, choice.min + i * choice.step)
+		end
+
+		return values
+	end
+
+	customError("Choice '"..name.."' should have a vector of values or arguments 'max' and 'step' to be used in a Batch.")
+end
+
+local function expandParameters(parameters)
+	if #parameters > 0 then
+		forEachElement(parameters, function(idx, value, mtype)
+			if mtype ~= "table" then
+				customError("Position "..idx.." of argument 'parameters' should be a table, got "..mtype..".")
+			end
+		end)
+
+		return parameters
+	end
+
+	local names = {}
+	local values = {}
+
+	forEachOrderedElement(parameters, function(name, value, mtype)
+		table.insert(names, name)
+
+		if mtype == "Choice" then
+			table.insert(values, expandChoice(name, value))
+		elseif mtype == "table" and #value > 0 then
+			table.insert(values, value)
+		else
+			table.insert(values, {value})
+		end
+	end)
+
+	local result = {{}}
+
+	for i = #names, 1, -1 do
+		local combined = {}
+
+		forEachElement(values[i], function(_, value)
+			forEachElement(result, function(_, set)
+				local newset = clone(set)
+				newset[names[i]] = value
+				table.insert(combined, newset)
+			end)
+		end)
+
+		result = combined
+	end
+
+	return result
+end
+
+local function serializeNumber(value)
+	if value ~= value then
+		return "0/0"
+	elseif value == math.huge then
+		return "1/0"
+	elseif value == -math.huge then
+		return "-1/0"
+	elseif math.type(value) == "integer" then
+		return tostring(value)
+	end
+
+	return string.format("%a", value)
+end
+
+local function serialize(values)
+	local items = {}
+
+	forEachOrderedElement(values, function(idx, value, mtype)
+		local str
+
+		if mtype == "number" then
+			str = serializeNumber(value)
+		elseif mtype == "string" then
+			str = string.format("%q", value)
+		elseif mtype == "boolean" then
+			str = tostring(value)
+		else
+			customError("Output '"..idx.."' should be number, string, or boolean, got "..mtype..".")
+		end
+
+		table.insert(items, "["..string.format("%q", idx).."] = "..str)
+	end)
+
+	return "{"..table.concat(items, ", ").."}"
+end
+
+local function collectOutput(self, instance)
+	local values = {}
+
+	if type(self.output) == "function" then
+		values = self.output(instance)
+
+		if type(values) ~= "table" then
+			customError("Function 'output' should return a table, got "..type(values)..".")
+		end
+	elseif self.output then
+		forEachElement(self.output, function(_, name)
+			values[name] = instance[name]
+		end)
+	else
+		forEachOrderedElement(instance, function(idx, value, mtype)
+			if belong(mtype, {"number", "string", "boolean"}) and string.sub(idx, -1, -1) ~= "_" then
+				values[idx] = value
+			end
+		end)
+	end
+
+	return values
+end
+
+local function flatten(parameters)
+	local result = {}
+
+	forEachElement(parameters, function(name, value, mtype)
+		if mtype == "table" then
+			forEachElement(value, function(iname, ivalue)
+				result[name.."."..iname] = ivalue
+			end)
+		else
+			result[name] = value
+		end
+	end)
+
+	return result
+end
+
+Batch_ = {
+	type_ = "Batch"
+}
+
+metaTableBatch_ = {__index = Batch_, __tostring = _Gtme.tostring}
+
+--- Type that executes a Model several times, each one with a different set of parameters,
+-- and gathers the results of the simulations in a DataFrame. Each run is executed in a
+-- separate process that shares the packages already loaded, with several runs
+-- executed simultaneously. Graphics are disabled within the runs. The DataFrame
+-- has one row for each run, with the values of the parameters, the repetition, the seed
+-- of the random numbers, the output values, the time in seconds spent by the run,
+-- and an error message, which is empty if the run finished successfully.
+-- In Windows, the runs are executed sequentially in the current process.
+-- A Batch cannot be executed while there are observers, because their threads do not exist
+-- in the processes of the runs. The observers created within a run are closed when it finishes.
+-- @arg data.model A Model.
+-- @arg data.parameters A named table with the values of the parameters or a vector of
+-- named tables. In the first case, each parameter can be a single value, a vector of values,
+-- or a Choice, and the Batch executes all the combinations of them. A Choice must have a
+-- vector of values or a step. In the second case, each table has the arguments of a run.
+-- The default value is an empty table, executing the Model with its default values.
+-- @arg data.repetition The number of times each set of parameters will be executed.
+-- Each repetition uses a different seed. The default value is one.
+-- @arg data.workers The number of runs executed simultaneously. The value zero
+-- means one run per processor. The default value is zero.
+-- @arg data.output A vector with the names of the attributes of the instances
+-- to be saved after each run, or a function that gets a Model instance after the simulation
+-- and returns a named table with the values to be saved. Values must be numbers, strings,
+-- or booleans. The default value saves all the number, string, and boolean attributes of the
+-- instance.
+-- @arg data.progress A boolean value indicating whether a message should be shown when each
+-- run finishes. The default value is false.
+-- @output output A DataFrame with the results.
+-- @output failures The number of runs that stopped with an error.
+-- @usage import("base")
+-- Sum = Model{
+--     a = Choice{1, 2, 3},
+--     finalTime = 2,
+--     init = function(model)
+--         model.value = 0
+--         model.timer = Timer{Event{action = function()
+--             model.value = model.value + model.a
+--         end}}
+--     end
+-- }
+--
+-- batch = Batch{
+--     model = Sum,
+--     parameters = {a = Choice{1, 2, 3}},
+--     repetition = 2,
+--     output = {"value"}
+-- }
+--
+-- print(#batch.output)
+function Batch(data)
+	verifyNamedTable(data)
+	verifyUnnecessaryArguments(data, {"model", "parameters", "repetition", "workers", "output", "progress"})
+
+	mandatoryTableArgument(data, "model", "Model")
+	defaultTableValue(data, "parameters", {})
+	defaultTableValue(data, "repetition", 1)
+	defaultTableValue(data, "workers", 0)
+	defaultTableValue(data, "progress", false)
+
+	integerTableArgument(data, "repetition")
+	positiveTableArgument(data, "repetition")
+	integerTableArgument(data, "workers")
+	positiveTableArgument(data, "workers", true)
+
+	if type(data.output) == "string" then data.output = {data.output} end
+
+	if data.output ~= nil and not belong(type(data.output), {"table", "function"}) then
+		incompatibleTypeError("output", "table or function", data.output)
+	end
+
+	if #_Gtme.createdObservers > 0 then
+		customError("Batch cannot be executed while there are observers, as their threads are not copied to the processes of the runs. Use clean() before the Batch.")
+	end
+
+	local sets = expandParameters(data.parameters)
+	local runs = #sets * data.repetition
+	local base = Random():integer(1, 1000000000)
+	local rows = {}
+
+	data.failures = 0
+
+	local function execute(run)
+		local set = sets[math.floor((run - 1) / data.repetition) + 1]
+		local graphics = sessionInfo().graphics
+
+		sessionInfo().graphics = false
+		Random{seed = base + run}
+
+		local ok, result = pcall(function()
+			local clock = os.clock()
+			local instance = data.model(clone(set))
+			instance:run()
+
+			local values = collectOutput(data, instance)
+			values.time = os.clock() - clock
+			return serialize(values)
+		end)
+
+		-- the process of the run finishes without closing the observers it created
+		clean()
+		sessionInfo().graphics = graphics
+
+		if not ok then error(result, 0) end
+
+		return result
+	end
+
+	local function finish(run, ok, result)
+		local row = flatten(sets[math.floor((run - 1) / data.repetition) + 1])
+		row.repetition = (run - 1) % data.repetition + 1
+		row.seed = base + run
+		row.error = ""
+
+		if ok then
+			forEachElement(load("return "..result, "=Batch", "t", {})(), function(idx, value)
+				row[idx] = value
+			end)
+
+			if data.progress then
+				print("Run "..run.." of "..runs.." finished in "..string.format("%.2f", row.time).." seconds.")
+			end
+		else
+			if result == "" then result = "Run "..run.." stopped without an error message." end
+
+			row.error = result
+			data.failures = data.failures + 1
+
+			if data.progress then
+				print("Run "..run.." of "..runs.." failed: "..result)
+			end
+		end
+
+		rows[run] = row
+	end
+
+	cpp_forkruns(runs, data.workers, execute, finish)
+
+	data.output = DataFrame(rows)
+
+	setmetatable(data, metaTableBatch_)
+	return data
+end
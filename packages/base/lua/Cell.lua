@@ -145,6 +145,10 @@ Cell_ = {
 			local s = self.neighborhoods[name]
 			if type(s) == "function" then
 				return s(self)
+			elseif type(s) == "SharedNeighborhood" then
+				-- the Cell gets its own Neighborhood as it might be updated
+				s = s:get(self)
+				self.neighborhoods[name] = s
 			end
 
 			return s
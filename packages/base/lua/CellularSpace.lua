@@ -43,6 +43,48 @@ local function separatorCheck(data)
 	header3:close()
 end
 
+local function createSharedNeighborhood(self, index, neighbors)
+	local shared = {
+		cObj_ = self.cObj_,
+		index_ = index,
+		neighbors_ = neighbors,
+		depth_ = 0,
+		buffers_ = {}
+	}
+
+	setmetatable(shared, metaTableSharedNeighborhood_)
+	return shared
+end
+
+local function addSharedNeighborhood(self, shared, name)
+	forEachCell(self, function(cell)
+		cell.neighborhoods[name] = shared
+	end)
+end
+
+-- Build a graph created by addGraph() and add it to all Cells.
+local function addGraph(self, graph, name)
+	local origin, neighbor = self.cObj_:buildGraph(graph)
+
+	if origin then
+		customError("Cell '"..neighbor:getId().."' already belongs to the Neighborhood.")
+	end
+
+	addSharedNeighborhood(self, createSharedNeighborhood(self, graph, self.cObj_.getGraphNeighbors), name)
+end
+
+-- Load a neighborhood file in C++ and add it to all Cells.
+local function loadGraph(self, data, format, weighted)
+	local graph, layer = self.cObj_:loadGraph(tostring(data.file), format, weighted == true)
+
+	if not graph then
+		customError(layer)
+	end
+
+	addGraph(self, graph, data.name)
+	return layer
+end
+
 local function loadNeighborhoodGAL(self, data)
 	local file = data.file
 	local lineTest = file:readLine(" ")
@@ -62,39 +104,8 @@ local function loadNeighborhoodGAL(self, data)
 		end
 	end
 
-	forEachCell(self, function(cell)
-		cell:addNeighborhood(Neighborhood{}, data.name)
-	end)
-
-	local line = file:readLine(" ")
-	local counterLine = 2
-
-	while #line > 0 do
-		local cell = self:get(line[1])
-
-		if cell == nil then
-			customError("Could not find id '"..tostring(line[1]).."' in line "..counterLine..". It seems that it is corrupted.")
-		else
-			local neig = cell:getNeighborhood(data.name)
-			local lineID = file:readLine(" ")
-
-			counterLine = counterLine + 1
-			for i = 1, tonumber(line[2]) do
-				if lineID[i] == nil then
-					customError("Could not find id '"..tostring(lineID[i]).."' in line "..counterLine..". It seems that it is corrupted.")
-				else
-					local n = self:get(lineID[i])
-
-					neig:add(n)
-				end
-			end
-		end
-
-		line = file:readLine(" ")
-		counterLine = counterLine + 1
-	end
-
 	file:close()
+	loadGraph(self, data, "gal")
 end
 
 local function loadNeighborhoodGPM(self, data)
@@ -128,45 +139,8 @@ local function loadNeighborhoodGPM(self, data)
 		values = 1
 	end
 
-	forEachCell(self, function(cell)
-		cell:addNeighborhood(Neighborhood{}, data.name)
-	end)
-
-	local line = file:readLine(" ")
-	local counterLine = 2
-
-	while #line > 0 do
-		local cell = self:get(line[1])
-
-		if cell == nil then
-			customError("Could not find id '"..tostring(line[i]).."' in line "..counterLine..". It seems that it is corrupted.")
-		end
-
-		local neig = cell:getNeighborhood(data.name)
-		local lineID = file:readLine(" ")
-		local valfor = (tonumber(line[2]) * 2)
-
-		counterLine = counterLine + 1
-
-		for i = 1, valfor, values do
-			if lineID[i] == nil and tonumber(line[2]) * values >= i then
-				customError("Could not find id '"..tostring(lineID[i]).."' in line "..counterLine..". It seems that it is corrupted.")
-			elseif lineID[i] ~= nil then
-				local n = self:get(lineID[i])
-
-				if values == 2 and n ~= nilthen  then
-					neig:add(n, tonumber(lineID[i + 1]))
-				elseif values == 1 and n ~= nil then
-					neig:add(n, 1)
-				end
-			end
-		end
-
-		line = file:readLine(" ")
-		counterLine = counterLine + 1
-	end
-
 	file:close()
+	loadGraph(self, data, "gpm", values == 2)
 end
 
 local function loadNeighborhoodGWT(self, data)
@@ -188,34 +162,34 @@ local function loadNeighborhoodGWT(self, data)
 		end
 	end
 
-	forEachCell(self, function(cell)
-		cell:addNeighborhood(Neighborhood{}, data.name)
-	end)
+	file:close()
+	loadGraph(self, data, "gwt")
+end
 
-	local line = file:readLine(" ")
-	local counterLine = 2
+-- Name of the layer stored in GPMB files.
+local function getLayerName(self)
+	if type(self.layer) == "string" then
+		return self.layer
+	elseif self.layer ~= nil then
+		return self.layer.name
+	end
 
-	while #line > 0 do
-		local cell = self:get(line[1])
+	return ""
+end
 
-		if cell == nil then
-			customError("Could not find id '"..tostring(line[1]).."' in line "..counterLine..". It seems that it is corrupted.")
-		elseif line[2] == nil then
-			customError("Could not find id '"..tostring(line[2]).."' in line "..counterLine..". It seems that it is corrupted.")
-		elseif line[3] == nil then
-			customError("Could not find id '"..tostring(line[3]).."' in line "..counterLine..". It seems that it is corrupted.")
-		else
-			local neig = cell:getNeighborhood(data.name)
-			local n = self:get(line[2])
+local function loadNeighborhoodGPMB(self, data)
+	local graph, vallayer = self.cObj_:loadGraph(tostring(data.file), "gpmb", false)
+	local layer = getLayerName(self)
 
-			neig:add(n, tonumber(line[3]))
-		end
+	if not graph then
+		customError(vallayer)
+	end
 
-		line = file:readLine(" ")
-		counterLine = counterLine + 1
+	if data.check and vallayer ~= layer and vallayer ~= self.file then
+		customError("Neighborhood file '"..data.file.."' was not built for this CellularSpace. CellularSpace layer: '"..layer.."', GPMB file layer: '"..vallayer.."'.")
 	end
 
-	file:close()
+	addGraph(self, graph, data.name)
 end
 
 local function getCoordCoupling(_, data)
@@ -351,6 +325,55 @@ local function getMxNNeighborhood(_, data)
 	end
 end
 
+-- Return the offsets of the neighbors of a Cell for the strategies that depend only
+-- on the relative position of the neighbors, or nil if the strategy cannot be
+-- represented in this way.
+local function getOffsets(cs, data)
+	local offsets = {}
+	local m, n = 1, 1
+	local include
+
+	if data.strategy == "diagonal" then
+		include = function(lin, col)
+			return (lin ~= 0 and col ~= 0) or (data.self and lin == 0 and col == 0)
+		end
+	elseif data.strategy == "moore" then
+		include = function(lin, col)
+			return data.self or lin ~= col or col ~= 0
+		end
+	elseif data.strategy == "vonneumann" then
+		include = function(lin, col)
+			return ((lin == 0 or col == 0) and lin ~= col) or (data.self and lin == 0 and col == 0)
+		end
+	elseif data.strategy == "mxn" and data.native_ and data.target == cs then
+		m = math.floor(data.m / 2)
+		n = math.floor(data.n / 2)
+		include = function() return true end
+	else
+		return
+	end
+
+	for lin = -n, n do
+		for col = -m, m do
+			if include(lin, col) then
+				table.insert(offsets, col)
+				table.insert(offsets, lin)
+			end
+		end
+	end
+
+	return offsets
+end
+
+-- Return whether the Cells of a CellularSpace fill most of the rectangle defined by
+-- their coordinates, which allows storing Neighborhoods as offsets.
+local function isRegular(cs)
+	local quantity = #cs.cells
+
+	return quantity > 0 and quantity == cs.cObj_:size() and
+		(cs.xMax - cs.xMin + 1) * (cs.yMax - cs.yMin + 1) <= 4 * quantity
+end
+
 local function getVonNeumannNeighborhood(cs, data)
 	return function(cell)
 		local neigh = Neighborhood()
@@ -485,7 +508,6 @@ local function loadCsv(self)
 
 		local cell = Cell(attributes)
 		self:add(cell)
-		self.cObj_:addCell(cell.x, cell.y, cell.cObj_)
 	end
 end
 
@@ -526,7 +548,6 @@ local function loadPGM(self)
 			forEachElement(res, function(_, value)
 				local p = Cell {x = j, y = i, [self.attrname] = tonumber(value)}
 				self:add(p)
-				self.cObj_:addCell(p.x, p.y, p.cObj_)
 				j = j + 1
 			end)
 
@@ -766,6 +787,175 @@ local function loadVirtual(self)
 	end
 end
 
+local function isScalar(value)
+	local mtype = type(value)
+	return mtype == "number" or mtype == "string" or mtype == "boolean"
+end
+
+local function createPast(self, cell)
+	local columns = self.columns_
+	local past = {}
+
+	local oldPast = rawget(cell, "past")
+	if type(oldPast) == "table" then
+		for k, v in next, oldPast do
+			if not columns.index[k] then
+				past[k] = v
+			end
+		end
+	end
+
+	columns.owners[past] = rawget(cell, "cObj_")
+	setmetatable(past, columns.pastMetatable)
+	rawset(cell, "past", past)
+	return past
+end
+
+local function attachColumns(self, cell)
+	local columns = self.columns_
+
+	forEachElement(columns.names, function(_, attr)
+		local value = rawget(cell, attr)
+		if value ~= nil then
+			rawset(cell, attr, nil)
+			cell.cObj_:setAttribute(columns.index[attr], value)
+		end
+	end)
+
+	setmetatable(cell, columns.metatable)
+	createPast(self, cell)
+end
+
+local function createColumns(self)
+	local first = self.cells[1]
+	if not first then return end
+
+	local types = {}
+
+	for attr, value in pairs(first) do
+		if type(attr) == "string" and attr ~= "id" and not _Gtme.internalCellVariables[attr] and not string.endswith(attr, "_") then
+			if math.type(value) == "integer" then
+				types[attr] = "integer"
+			elseif math.type(value) == "float" then
+				types[attr] = "number"
+			elseif type(value) == "boolean" then
+				types[attr] = "boolean"
+			end
+		end
+	end
+
+	forEachCell(self, function(cell)
+		for attr, mtype in pairs(types) do
+			local value = rawget(cell, attr)
+
+			if mtype == "boolean" then
+				if type(value) ~= "boolean" then
+					types[attr] = nil
+				end
+			elseif math.type(value) == "float" then
+				types[attr] = "number"
+			elseif math.type(value) ~= "integer" then
+				types[attr] = nil
+			end
+		end
+	end)
+
+	local columns = {names = {}, index = {}}
+
+	forEachOrderedElement(types, function(attr, mtype)
+		table.insert(columns.names, attr)
+		columns.index[attr] = self.cObj_:addAttribute(attr, mtype)
+	end)
+
+	local index = columns.index
+	local names = columns.names
+	local owners = setmetatable({}, {__mode = "k"})
+	local base = getmetatable(first)
+	local baseIndex = base.__index
+
+	columns.metatable = {
+		__index = function(cell, attr)
+			local col = index[attr]
+			if col then
+				return rawget(cell, "cObj_"):getAttribute(col)
+			end
+
+			return baseIndex[attr]
+		end,
+		__newindex = function(cell, attr, value)
+			local col = index[attr]
+			if not col then
+				rawset(cell, attr, value)
+			elseif value == nil then
+				customError("Attribute '"..attr.."' cannot be removed from a columnar CellularSpace.")
+			else
+				rawget(cell, "cObj_"):setAttribute(col, value)
+			end
+		end,
+		__pairs = function(cell)
+			local position = 0
+			local raw = true
+
+			return function(_, key)
+				if raw then
+					local k, v = next(cell, key)
+					if k ~= nil then return k, v end
+
+					raw = false
+				end
+
+				position = position + 1
+				local attr = names[position]
+				if attr then
+					return attr, rawget(cell, "cObj_"):getAttribute(index[attr])
+				end
+			end, cell, nil
+		end,
+		__len = base.__len,
+		__tostring = base.__tostring
+	}
+
+	columns.owners = owners
+	columns.pastMetatable = {
+		__index = function(past, attr)
+			local col = index[attr]
+			if col then
+				return owners[past]:getPastAttribute(col)
+			end
+		end,
+		__pairs = function(past)
+			local position = 0
+			local raw = true
+
+			return function(_, key)
+				if raw then
+					local k, v = next(past, key)
+					if k ~= nil then return k, v end
+
+					raw = false
+				end
+
+				repeat
+					position = position + 1
+					local attr = names[position]
+					if not attr then return end
+
+					local value = owners[past]:getPastAttribute(index[attr])
+					if value ~= nil then
+						return attr, value
+					end
+				until false
+			end, past, nil
+		end
+	}
+
+	self.columns_ = columns
+
+	forEachCell(self, function(cell)
+		attachColumns(self, cell)
+	end)
+end
+
 local CellularSpaceDrivers = {}
 
 local function registerCellularSpaceDriver(data)
@@ -872,17 +1062,24 @@ CellularSpace_ = {
 		cell.parent = self
 		self.cObj_:addCell(cell.x, cell.y, cell.cObj_)
 		table.insert(self.cells, cell)
+
+		if self.columns_ then
+			attachColumns(self, cell)
+		end
+
 		self.yMin = math.min(self.yMin, cell.y)
 		self.xMin = math.min(self.xMin, cell.x)
 		self.xMax = math.max(self.xMax, cell.x)
 		self.yMax = math.max(self.yMax, cell.y)
-		self.index_id_ = nil
-		self.index_xy_ = nil
 	end,
 	--- Create a Neighborhood for each Cell of the CellularSpace.
 	-- Most of the available strategies require that each Cell has
 	-- attributes with (x, y) locations. It is possible to set the attributes
 	-- that represent (x, y) locations while creating the CellularSpace.
+	-- In regular CellularSpaces, strategies "moore", "vonneumann", "diagonal", and "mxn"
+	-- without filter, weight, and target are stored only once for all Cells, as a list of
+	-- relative positions. The Neighborhood of a Cell is built only when Cell:getNeighborhood()
+	-- is called, while Utils:forEachNeighbor() does not need to build it.
 	-- @arg data.inmemory If true (default), a Neighborhood will be built and stored for
 	-- each Cell of the CellularSpace. The Neighborhoods will change only if the
 	-- modeler add or remove neighbors explicitly. If false, a Neighborhood will be
@@ -983,7 +1180,7 @@ CellularSpace_ = {
 		defaultTableValue(data, "name", "1")
 
 		if self.cells[1] and #self.cells[1] > 0 then
-			if self.cells[1]:getNeighborhood(data.name) ~= nil then
+			if self.cells[1].neighborhoods[data.name] ~= nil then
 				customError("Neighborhood '"..data.name.."' already exists.")
 			end
 		end
@@ -1019,6 +1216,7 @@ CellularSpace_ = {
 			mxn = function()
 				verifyUnnecessaryArguments(data, {"filter", "weight", "wrap", "name", "strategy", "m", "n", "target", "inmemory"})
 
+				data.native_ = data.filter == nil and data.weight == nil
 				defaultTableValue(data, "filter", function() return true end)
 				defaultTableValue(data, "weight", function() return 1 end)
 				defaultTableValue(data, "target", self)
@@ -1058,6 +1256,25 @@ CellularSpace_ = {
 			end
 		}
 
+		local offsets = isRegular(self) and getOffsets(self, data)
+
+		if offsets then
+			local index = self.cObj_:addStencil(offsets, data.wrap, data.strategy ~= "mxn")
+			local stencil = createSharedNeighborhood(self, index, self.cObj_.getStencilNeighbors)
+
+			if data.inmemory then
+				addSharedNeighborhood(self, stencil, data.name)
+			else
+				local func = function(cell) return stencil:get(cell) end
+
+				forEachCell(self, function(cell)
+					cell:addNeighborhood(func, data.name)
+				end)
+			end
+
+			return
+		end
+
 		local func = data.func(self, data)
 
 		if data.inmemory then
@@ -1147,17 +1364,7 @@ CellularSpace_ = {
 				customWarning("As #1 is string, #2 should be nil, but got "..type(yIndex)..".")
 			end
 
-			if not self.index_id_ then
-				local index_id = {}
-
-				forEachCell(self, function(cell)
-					index_id[cell:getId()] = cell
-				end)
-
-				self.index_id_ = index_id
-			end
-
-			return self.index_id_[xIndex]
+			return self.cObj_:getCellByID(xIndex)
 		end
 
 		mandatoryArgument(1, "number", xIndex)
@@ -1166,23 +1373,7 @@ CellularSpace_ = {
 		mandatoryArgument(2, "number", yIndex)
 		integerArgument(2, yIndex)
 
-		if not self.index_xy_ then
-			local index_xy = {}
-
-			forEachCell(self, function(cell)
-				if not index_xy[cell.x] then
-					index_xy[cell.x] = {}
-				end
-
-				index_xy[cell.x][cell.y] = cell
-			end)
-
-			self.index_xy_ = index_xy
-		end
-
-		if self.index_xy_[xIndex] then
-			return self.index_xy_[xIndex][yIndex]
-		end
+		return self.cObj_:getCellByIndex(xIndex, yIndex)
 	end,
 	--- Load the CellularSpace from the database. TerraME automatically executes this function when
 	-- the CellularSpace is created, but one can execute this to load the attributes again, erasing
@@ -1193,7 +1384,8 @@ CellularSpace_ = {
 		customError("Load function was not implemented.")
 	end,
 	--- Load a Neighborhood stored in an external source. Each Cell receives its own set of
-	-- neighbors.
+	-- neighbors. The connections of all Cells are stored together as a compressed graph, and
+	-- the Neighborhood of a Cell is built only when Cell:getNeighborhood() is called.
 	-- @arg data.file A File or a string with the location of the Neighborhood
 	-- file to be loaded.
 	-- @arg data.check A boolean value indicating whether this function should match the
@@ -1205,6 +1397,7 @@ CellularSpace_ = {
 	-- "gal" & Load a Neighborhood from contiguity relationships described as a GAL file.\
 	-- "gwt" & Load a Neighborhood from a GWT (generalized weights) file.\
 	-- "gpm" & Load a Neighborhood from a GPM (generalized proximity matrix) file. \
+	-- "gpmb" & Load a Neighborhood from a binary file created by CellularSpace:saveNeighborhood(). \
 	-- @usage -- DONTRUN
 	-- cs = CellularSpace{
 	--     file = filePath("cabecadeboi800.shp", "base")
@@ -1225,7 +1418,7 @@ CellularSpace_ = {
 
 		if ext == "" then
 			customError("Argument 'file' does not have an extension.")
-		elseif belong(ext, {"gal", "gwt", "gpm"}) then
+		elseif belong(ext, {"gal", "gwt", "gpm", "gpmb"}) then
 			if not data.file:exists() then
 				resourceNotFoundError("file", data.file)
 			end
@@ -1233,7 +1426,9 @@ CellularSpace_ = {
 			invalidFileExtensionError("file", ext)
 		end
 
-		separatorCheck(data)
+		if ext ~= "gpmb" then
+			separatorCheck(data)
+		end
 
 		defaultTableValue(data, "name", "1")
 		defaultTableValue(data, "check", true)
@@ -1244,6 +1439,8 @@ CellularSpace_ = {
 			loadNeighborhoodGWT(self, data)
 		elseif ext == "gpm" then
 			loadNeighborhoodGPM(self, data)
+		elseif ext == "gpmb" then
+			loadNeighborhoodGPMB(self, data)
 		end
 	end,
 	--- Notify every Observer connected to the CellularSpace.
@@ -1293,6 +1490,112 @@ CellularSpace_ = {
 
 		self.cObj_:notify(modelTime)
 	end,
+	--- Restore the state of the CellularSpace saved by CellularSpace:snapshot(). It restores
+	-- the number, string, and boolean attributes of the Cells, their past values, their
+	-- Neighborhoods, and the Agents placed in each Cell. Attributes created after the
+	-- snapshot are removed, except in the columns of a columnar CellularSpace, which keep
+	-- their values. Columns are restored by copying the whole arrays at once. The same
+	-- snapshot can be restored several times.
+	-- @arg snapshot A snapshot created by CellularSpace:snapshot().
+	-- @usage cs = CellularSpace{
+	--     xdim = 10,
+	--     value = 0
+	-- }
+	--
+	-- snapshot = cs:snapshot()
+	--
+	-- forEachCell(cs, function(cell)
+	--     cell.value = cell.value + 1
+	-- end)
+	--
+	-- cs:restore(snapshot)
+	-- print(cs:sample().value)
+	restore = function(self, snapshot)
+		mandatoryArgument(1, "table", snapshot)
+
+		if snapshot.space_ ~= self then
+			customError("The snapshot does not belong to the CellularSpace.")
+		elseif #snapshot.cells ~= #self.cells then
+			customError("The CellularSpace has "..#self.cells.." Cells, but the snapshot has "..#snapshot.cells..".")
+		end
+
+		if snapshot.index_ and not self.cObj_:loadSnapshot(snapshot.index_) then
+			customError("The columns of the CellularSpace do not match the snapshot.")
+		end
+
+		local placements = snapshot.placements
+
+		forEachCell(self, function(cell, idx)
+			forEachElement(placements[idx], function(name, saved)
+				local agents = saved.group.agents
+
+				for i = #agents, 1, -1 do
+					local cells = agents[i][name].cells
+					for j = #cells, 1, -1 do cells[j] = nil end
+
+					if agents[i].cell == cell then
+						agents[i].cell = nil
+					end
+
+					agents[i] = nil
+				end
+			end)
+		end)
+
+		forEachCell(self, function(cell, idx)
+			local values = snapshot.cells[idx]
+
+			for k, v in next, cell do
+				if values[k] == nil and isScalar(v) and not _Gtme.internalCellVariables[k] then
+					rawset(cell, k, nil)
+				end
+			end
+
+			for k, v in next, values do
+				rawset(cell, k, v)
+			end
+
+			local past = rawget(cell, "past")
+			if type(past) == "table" then
+				for k, v in next, past do
+					if isScalar(v) then
+						past[k] = nil
+					end
+				end
+
+				for k, v in next, snapshot.pasts[idx] do
+					past[k] = v
+				end
+			end
+
+			local neighborhoods = {}
+			forEachElement(snapshot.neighborhoods[idx], function(name, saved)
+				if saved.connections then
+					saved.neighborhood.connections = clone(saved.connections)
+					saved.neighborhood.weights = clone(saved.weights)
+				end
+
+				neighborhoods[name] = saved.neighborhood
+			end)
+
+			rawset(cell, "neighborhoods", neighborhoods)
+
+			forEachElement(placements[idx], function(name, saved)
+				local agents = saved.group.agents
+				rawset(cell, name, saved.group)
+
+				forEachElement(saved.agents, function(_, agent)
+					table.insert(agents, agent)
+					agent[name].cells[1] = cell
+					agent.cell = cell
+				end)
+
+				if name == "placement" then
+					rawset(cell, "agents", agents)
+				end
+			end)
+		end)
+	end,
 	--- Return a random Cell from the CellularSpace.
 	-- @usage cs = CellularSpace{
 	--     xdim = 10
@@ -1394,6 +1697,179 @@ CellularSpace_ = {
 			customError("CellularSpace should be created from a project or directory to allow saving it.")
 		end
 	end,
+	--- Save a Neighborhood of the Cells as a GPMB file. It is a binary file that
+	-- can be loaded much faster than GAL, GPM, and GWT files by CellularSpace:loadNeighborhood().
+	-- Only the neighbors that belong to the CellularSpace are saved.
+	-- @arg data.file A File or a string with the name of the file to be saved. It must have
+	-- extension "gpmb".
+	-- @arg data.name A string with the name of the Neighborhood to be saved. The default value is "1".
+	-- @usage cs = CellularSpace{xdim = 10}
+	-- cs:createNeighborhood()
+	--
+	-- file = File("moore.gpmb")
+	-- cs:saveNeighborhood{file = file}
+	-- file:delete()
+	saveNeighborhood = function(self, data)
+		verifyNamedTable(data)
+		verifyUnnecessaryArguments(data, {"file", "name"})
+
+		if type(data.file) == "string" then
+			data.file = File(data.file)
+		end
+
+		mandatoryTableArgument(data, "file", "File")
+
+		local ext = data.file:extension()
+
+		if ext ~= "gpmb" then
+			invalidFileExtensionError("file", ext)
+		end
+
+		defaultTableValue(data, "name", "1")
+
+		local shared = self.cells[1].neighborhoods[data.name]
+
+		if shared == nil then
+			customError("Neighborhood '"..data.name.."' does not exist.")
+		end
+
+		local graph
+		local reuse = type(shared) == "SharedNeighborhood" and shared.neighbors_ == self.cObj_.getGraphNeighbors
+
+		if reuse then
+			graph = shared.index_
+
+			forEachCell(self, function(cell)
+				if cell.neighborhoods[data.name] ~= shared then
+					reuse = false
+					return false
+				end
+			end)
+		end
+
+		if not reuse then
+			local neighbors = {}
+			local weights = {}
+
+			graph = self.cObj_:addGraph()
+
+			forEachCell(self, function(cell)
+				local quantity = 0
+
+				if cell.neighborhoods[data.name] then
+					forEachNeighbor(cell, data.name, function(neighbor, weight)
+						quantity = quantity + 1
+						neighbors[quantity] = neighbor.cObj_
+						weights[quantity] = weight
+					end)
+				end
+
+				neighbors[quantity + 1] = nil
+				self.cObj_:addGraphConnections(graph, cell.cObj_, neighbors, weights)
+			end)
+
+			self.cObj_:buildGraph(graph)
+		end
+
+		local err = self.cObj_:saveGraph(graph, tostring(data.file), getLayerName(self))
+
+		if err then
+			customError(err)
+		end
+	end,
+	--- Save the state of the CellularSpace to be restored later by CellularSpace:restore().
+	-- It stores the number, string, and boolean attributes of the Cells, their past values,
+	-- their Neighborhoods, and the Agents placed in each Cell, but not the attributes of the
+	-- Agents. The columns of a columnar CellularSpace are copied as whole arrays.
+	-- This way, the replicates of a stochastic model can start from the same state without
+	-- loading the data again. Another alternative is to execute the replicates with a Batch,
+	-- whose runs share the memory of a CellularSpace loaded before it starts until they
+	-- change it.
+	-- @usage cs = CellularSpace{
+	--     xdim = 10,
+	--     value = 0
+	-- }
+	--
+	-- snapshot = cs:snapshot()
+	snapshot = function(self)
+		local snapshot = {
+			space_ = self,
+			cells = {},
+			pasts = {},
+			neighborhoods = {},
+			placements = {}
+		}
+
+		if self.columns_ then
+			local cObj = self.cObj_
+			local index = cObj:saveSnapshot()
+
+			snapshot.index_ = index
+			setmetatable(snapshot, {__gc = function()
+				cObj:removeSnapshot(index)
+			end})
+		end
+
+		-- attributes stored in columns are not raw fields of the cells, therefore
+		-- cells without other attributes share the same empty (read-only) table
+		local empty = {}
+
+		forEachCell(self, function(cell, idx)
+			local values = empty
+			local placements = empty
+
+			for k, v in next, cell do
+				if isScalar(v) then
+					if not _Gtme.internalCellVariables[k] then
+						if values == empty then values = {} end
+
+						values[k] = v
+					end
+				elseif type(v) == "Group" and type(v.agents) == "table" then
+					if placements == empty then placements = {} end
+
+					placements[k] = {group = v, agents = clone(v.agents)}
+				end
+			end
+
+			local past = empty
+			local oldPast = rawget(cell, "past")
+			if type(oldPast) == "table" then
+				for k, v in next, oldPast do
+					if isScalar(v) then
+						if past == empty then past = {} end
+
+						past[k] = v
+					end
+				end
+			end
+
+			local neighborhoods = empty
+			local oldNeighborhoods = rawget(cell, "neighborhoods")
+			if type(oldNeighborhoods) == "table" and next(oldNeighborhoods) ~= nil then
+				neighborhoods = {}
+
+				forEachElement(oldNeighborhoods, function(name, neigh)
+					if type(neigh) == "Neighborhood" then
+						neighborhoods[name] = {
+							neighborhood = neigh,
+							connections = clone(neigh.connections),
+							weights = clone(neigh.weights)
+						}
+					else
+						neighborhoods[name] = {neighborhood = neigh}
+					end
+				end)
+			end
+
+			snapshot.cells[idx] = values
+			snapshot.pasts[idx] = past
+			snapshot.neighborhoods[idx] = neighborhoods
+			snapshot.placements[idx] = placements
+		end)
+
+		return snapshot
+	end,
 	--- Split the CellularSpace into a table of Trajectories according to a classification
 	-- strategy. The Trajectories will have empty intersection and union equal to the
 	-- whole CellularSpace (unless function below returns nil for some Cell). It works according
@@ -1495,7 +1971,9 @@ CellularSpace_ = {
 	-- @arg values A string or a vector of strings with the attributes to be synchronized. If
 	-- empty, TerraME synchronizes every attribute of the Cells but the (x, y) coordinates.
 	-- If the CellularSpace has an instance and it implements Cell:on_synchronize() then it
-	-- will be called for each Cell.
+	-- will be called for each Cell. When the CellularSpace is columnar, the past values of
+	-- columnar attributes are copied into native buffers and each Cell keeps the same
+	-- past table along the simulation.
 	-- @usage cell = Cell{
 	--     forest = Random{min = 0, max = 1}
 	-- }
@@ -1526,6 +2004,43 @@ CellularSpace_ = {
 			incompatibleTypeError(1, "string, table or nil", values)
 		end
 
+		if self.columns_ then
+			-- columnar attributes are copied to their past buffers in C++,
+			-- while the other values are updated within the same past tables
+			local columns = self.columns_
+			local cols = {}
+			local s = "return function(metatable, createPast, cs) return function(cell)\n"
+			s = s.."local past = rawget(cell, 'past')\n"
+			s = s.."if getmetatable(past) ~= metatable then past = createPast(cs, cell) end\n"
+
+			local current = {}
+			for _, v in pairs(values) do
+				if type(v) ~= "string" then
+					customError("Argument 'values' should contain only strings.")
+				elseif columns.index[v] then
+					table.insert(cols, columns.index[v])
+				else
+					current[v] = true
+					s = s.."past."..v.." = cell."..v.."\n"
+				end
+			end
+
+			forEachElement(columns.past or {}, function(v)
+				if not current[v] then
+					s = s.."past."..v.." = nil\n"
+				end
+			end)
+
+			columns.past = current
+
+			s = s.."if type(cell.on_synchronize) == 'function' then cell:on_synchronize() end\n"
+			s = s.."end end"
+
+			self.cObj_:synchronize(cols)
+			forEachCell(self, load(s)()(columns.pastMetatable, createPast, self))
+			return
+		end
+
 		local s = "return function(cell)\n"
 		s = s.."cell.past = {"
 
@@ -1580,6 +2095,10 @@ metaTableCellularSpace_ = {
 -- the name of the file being read.
 -- @arg data.as A table with string indexes and values. It renames the loaded attributes
 -- of the CellularSpace from the values to its indexes.
+-- @arg data.columnar A boolean value indicating whether the number and boolean attributes
+-- shared by all Cells should be stored in contiguous arrays outside the Cells. It reduces the
+-- memory used by large CellularSpaces and speeds up observers. Cells still
+-- access these attributes as usual. The default value is false.
 -- @arg data.zero A string value describing where the zero in the y axis starts. The
 -- default value is "bottom". When one uses argument xy, the
 -- default value is "top", which is the most common representation in different data
@@ -1665,6 +2184,7 @@ function CellularSpace(data)
 
 	optionalTableArgument(data, "as", "table")
 	optionalTableArgument(data, "missing", "number")
+	optionalTableArgument(data, "columnar", "boolean")
 
 	if data.as then
 		forEachElement(data.as, function(idx, value)
@@ -1928,6 +2448,10 @@ function CellularSpace(data)
 		end)
 	end
 
+	if data.columnar then
+		createColumns(data)
+	end
+
 	return data
 end
 
@@ -0,0 +1,514 @@
+-------------------------------------------------------------------------------------------
+-- TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+-- Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+-- This code is part of the TerraME framework.
+-- This framework is free software; you can redistribute it and/or
+-- modify it under the terms of the GNU Lesser General Public
+-- License as published by the Free Software Foundation; either
+-- version 2.1 of the License, or (at your option) any later version.
+
+-- You should have received a copy of the GNU Lesser General Public
+-- License along with this library.
+
+-- The authors reassure the license terms regarding the warranties.
+-- They specifically disclaim any warranties, including, but not limited to,
+-- the implied warranties of merchantability and fitness for a particular purpose.
+-- The framework provided hereunder is on an "as is" basis, and the authors have no
+-- obligation to provide maintenance, support, updates, enhancements, or modifications.
+-- In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+-- indirect, special, incidental, or consequential damages arising out of the use
+-- of this software and its documentation.
+--
+-------------------------------------------------------------------------------------------
+
+local kinds = {"CellularSpace", "Society", "Agent", "Timer", "Cell", "Environment"}
+
+local cellVariables = clone(_Gtme.internalCellVariables)
+cellVariables.id = true
+
+local function getScalars(object, internal)
+	local values = {}
+
+	for k, v in next, object do
+		local mtype = type(v)
+
+		if (mtype == "number" or mtype == "string" or mtype == "boolean") and not internal[k]
+		and not (type(k) == "string" and string.endswith(k, "_")) then
+			values[k] = v
+		end
+	end
+
+	return values
+end
+
+local function setScalars(object, internal, values)
+	for k, v in next, object do
+		local mtype = type(v)
+
+		if (mtype == "number" or mtype == "string" or mtype == "boolean") and not internal[k]
+		and not (type(k) == "string" and string.endswith(k, "_")) and values[k] == nil then
+			rawset(object, k, nil)
+		end
+	end
+
+	for k, v in next, values do
+		rawset(object, k, v)
+	end
+end
+
+local function collectComponents(object, path, components, visited)
+	if visited[object] then return end
+
+	visited[object] = true
+	components[path] = object
+
+	if type(object) ~= "Environment" and not isModel(object) then return end
+
+	forEachOrderedElement(object, function(name, value, mtype)
+		if name == "parent" or not isTable(value) then return end
+
+		if belong(mtype, kinds) or (mtype ~= "Model" and isModel(value)) then
+			collectComponents(value, path.."."..tostring(name), components, visited)
+		end
+	end)
+end
+
+local function getKind(object)
+	local mtype = type(object)
+
+	if belong(mtype, kinds) then
+		return mtype
+	end
+
+	return "Model"
+end
+
+-- placements are the Trajectories of the Agent, created by Environment or Society
+local function forEachPlacement(agent, f)
+	forEachElement(agent, function(name, trajectory, mtype)
+		if mtype == "Trajectory" and type(name) == "string" then
+			f(name, trajectory)
+		end
+	end)
+end
+
+local function saveCell(cell)
+	local past = rawget(cell, "past")
+
+	return {
+		values = getScalars(cell, cellVariables),
+		past = type(past) == "table" and getScalars(past, {}) or nil
+	}
+end
+
+local function loadCell(cell, state)
+	setScalars(cell, cellVariables, state.values or {})
+
+	local past = rawget(cell, "past")
+	if type(past) == "table" then
+		setScalars(past, {}, state.past or {})
+	end
+end
+
+local function saveAgent(agent)
+	local cells = {}
+
+	forEachPlacement(agent, function(name, trajectory)
+		if trajectory.cells[1] then
+			cells[name] = trajectory.cells[1].id
+		end
+	end)
+
+	return {
+		id = agent.id,
+		values = getScalars(agent, _Gtme.internalAgentVariables),
+		cells = cells
+	}
+end
+
+local function leavePlacements(agent)
+	forEachPlacement(agent, function(name, trajectory)
+		local cell = trajectory.cells[1]
+
+		if cell then
+			local agents = cell[name].agents
+
+			for i = #agents, 1, -1 do
+				if agents[i] == agent then
+					table.remove(agents, i)
+				end
+			end
+
+			trajectory.cells[1] = nil
+			agent.cell = nil
+		end
+	end)
+end
+
+local function enterPlacements(agent, state)
+	forEachOrderedElement(state.cells, function(name, id)
+		local trajectory = agent[name]
+		local cell = type(trajectory) == "Trajectory" and trajectory.parent:get(id)
+
+		if not cell then
+			customError("Could not find Cell '"..id.."' of placement '"..name.."' of Agent '"..tostring(agent.id).."'.")
+		end
+
+		trajectory.cells[1] = cell
+		agent.cell = cell
+		cell[name]:add(agent)
+	end)
+end
+
+local function getNextTime(event)
+	local time = event.time + event.period
+	local floor = math.floor(time)
+	local ceil = math.ceil(time)
+
+	if math.abs(time - floor) < sessionInfo().round then
+		time = floor
+	elseif math.abs(time - ceil) < sessionInfo().round then
+		time = ceil
+	end
+
+	return time
+end
+
+local save = {
+	CellularSpace = function(cs)
+		local state = {size = #cs.cells, cells = {}, columns = {}}
+
+		forEachCell(cs, function(cell, idx)
+			local cellState = saveCell(cell)
+
+			if next(cellState.values) or (cellState.past and next(cellState.past)) then
+				state.cells[idx] = cellState
+			end
+		end)
+
+		if cs.columns_ then
+			forEachElement(cs.columns_.names, function(_, name)
+				local col = cs.columns_.index[name]
+				local mtype, values = cs.cObj_:getColumn(col, false)
+				local _, past = cs.cObj_:getColumn(col, true)
+
+				state.columns[name] = {type = mtype, values = values, past = past}
+			end)
+		end
+
+		return state
+	end,
+	Cell = saveCell,
+	Society = function(soc)
+		local state = {values = getScalars(soc, {observerId = true}), agents = {}}
+
+		forEachAgent(soc, function(agent)
+			table.insert(state.agents, saveAgent(agent))
+		end)
+
+		return state
+	end,
+	Agent = saveAgent,
+	Timer = function(timer, events)
+		local state = {time = timer.time, events = {}}
+		local queued = {}
+
+		forEachElement(timer:getEvents(), function(_, event)
+			local position = events.index[event]
+
+			if not position then
+				customError("The Timer has an Event added after the Checkpoint was created.")
+			end
+
+			table.insert(state.events, {position, event.time, event.priority, event.period})
+			queued[event] = true
+		end)
+
+		-- the Event whose action is executing is not in the queue, but it will be added again
+		forEachElement(events.list, function(position, event)
+			if event.parent == timer and not queued[event] and event.period > 0 then
+				table.insert(state.events, {position, getNextTime(event), event.priority, event.period})
+			end
+		end)
+
+		return state
+	end,
+	Environment = function()
+		return {}
+	end,
+	Model = function(instance)
+		return {values = getScalars(instance, {})}
+	end
+}
+
+local function loadCellularSpace(cs, state, path)
+	if #cs.cells ~= state.size then
+		customError("CellularSpace '"..path.."' has "..#cs.cells.." Cells, but the checkpoint has "..state.size..".")
+	end
+
+	local empty = {}
+
+	forEachCell(cs, function(cell, idx)
+		loadCell(cell, state.cells[idx] or empty)
+	end)
+
+	forEachElement(state.columns, function(name, column)
+		local col = cs.columns_ and cs.columns_.index[name]
+
+		if not col then
+			customError("Attribute '"..name.."' is not a column of CellularSpace '"..path.."'.")
+		elseif not cs.cObj_:setColumn(col, column.type, column.values, column.past) then
+			customError("Could not load attribute '"..name.."' of CellularSpace '"..path.."'.")
+		end
+	end)
+end
+
+local function loadSociety(soc, state)
+	local agents = {}
+	local ids = {}
+
+	forEachAgent(soc, function(agent)
+		ids[agent.id] = agent
+	end)
+
+	forEachElement(state.agents, function(idx, agentState)
+		local agent = ids[agentState.id]
+
+		if agent then
+			ids[agentState.id] = nil
+		else
+			agent = soc:add()
+			leavePlacements(agent)
+		end
+
+		rawset(agent, "id", agentState.id)
+		setScalars(agent, _Gtme.internalAgentVariables, agentState.values)
+		agents[idx] = agent
+	end)
+
+	for i = #soc.agents, 1, -1 do
+		soc.agents[i] = nil
+	end
+
+	for i = 1, #agents do
+		soc.agents[i] = agents[i]
+	end
+
+	soc.idindex = nil
+	setScalars(soc, {observerId = true}, state.values)
+end
+
+local function loadTimer(timer, state, events, path)
+	timer:clear()
+	rawset(timer, "time", state.time)
+
+	forEachElement(state.events, function(_, saved)
+		local event = events.list[saved[1]]
+
+		if not event then
+			customError("Timer '"..path.."' does not have the Events of the checkpoint.")
+		end
+
+		event.time = saved[2]
+		event.priority = saved[3]
+		event.period = saved[4]
+		timer:add(event)
+	end)
+end
+
+Checkpoint_ = {
+	type_ = "Checkpoint",
+	--- Restore the state saved by Checkpoint:save() into the target. The target must have
+	-- the same structure of the one that was saved, which means that it needs to be
+	-- created in the same way (for example, as an instance of the same Model with the same
+	-- parameters), and the Checkpoint must be created just after it, before running the
+	-- simulation. After loading, the simulation continues exactly from where it was saved.
+	-- @usage -- DONTRUN
+	-- import("base")
+	--
+	-- instance = Tube{}
+	-- checkpoint = Checkpoint{target = instance, file = "tube.tmc"}
+	-- checkpoint:load()
+	-- instance:run()
+	load = function(self)
+		if not self.file:exists() then
+			resourceNotFoundError("file", self.file)
+		end
+
+		local state, err = cpp_loadcheckpoint(self.file.filename)
+
+		if not state then
+			customError(err)
+		end
+
+		local components = self.components_
+
+		forEachOrderedElement(state.components, function(path, componentState)
+			local component = components[path]
+
+			if not component then
+				customError("Could not find '"..path.."' in the target.")
+			elseif getKind(component) ~= componentState.type then
+				customError("'"..path.."' should be a "..componentState.type..", got "..getKind(component)..".")
+			end
+		end)
+
+		local agents = {}
+		local states = {}
+
+		forEachOrderedElement(state.components, function(path, componentState)
+			local component = components[path]
+
+			if componentState.type == "Society" then
+				forEachAgent(component, function(agent)
+					leavePlacements(agent)
+				end)
+			elseif componentState.type == "Agent" then
+				leavePlacements(component)
+			end
+		end)
+
+		forEachOrderedElement(state.components, function(path, componentState)
+			local component = components[path]
+
+			if componentState.type == "CellularSpace" then
+				loadCellularSpace(component, componentState, path)
+			elseif componentState.type == "Cell" then
+				loadCell(component, componentState)
+			end
+		end)
+
+		forEachOrderedElement(state.components, function(path, componentState)
+			local component = components[path]
+
+			if componentState.type == "Society" then
+				loadSociety(component, componentState)
+
+				forEachAgent(component, function(agent, idx)
+					table.insert(agents, agent)
+					table.insert(states, componentState.agents[idx])
+				end)
+			elseif componentState.type == "Agent" then
+				rawset(component, "id", componentState.id)
+				setScalars(component, _Gtme.internalAgentVariables, componentState.values)
+				table.insert(agents, component)
+				table.insert(states, componentState)
+			end
+		end)
+
+		for i = 1, #agents do
+			enterPlacements(agents[i], states[i])
+		end
+
+		forEachOrderedElement(state.components, function(path, componentState)
+			local component = components[path]
+
+			if componentState.type == "Timer" then
+				loadTimer(component, componentState, self.events_[path], path)
+			elseif componentState.type == "Model" then
+				setScalars(component, {}, componentState.values)
+			end
+		end)
+
+		Random():setState(state.random)
+	end,
+	--- Save the state of the target into the file. It stores the number, string, and boolean
+	-- attributes of the target and of its CellularSpaces, Cells, Societies, and Agents, the
+	-- Agents placed in each Cell, the times of the Events in the Timers, and the state of
+	-- the random numbers. The columns of columnar CellularSpaces are saved as whole arrays.
+	-- The file is replaced only after the checkpoint is completely written, therefore if the
+	-- simulation is interrupted while saving, the file keeps the previous checkpoint.
+	-- Social networks, messages, observers, and attributes stored in tables or functions
+	-- are not saved. If this function is called within the action of an Event, it considers
+	-- that the action will not return false. Simulations that draw values from Random
+	-- objects with distributions cannot be saved, as the state of their generator cannot
+	-- be restored.
+	-- @usage -- DONTRUN
+	-- import("base")
+	--
+	-- instance = Tube{}
+	-- local checkpoint
+	-- instance.timer:add(Event{period = 100, action = function()
+	--     checkpoint:save()
+	-- end})
+	--
+	-- checkpoint = Checkpoint{target = instance, file = "tube.tmc"}
+	-- instance:run()
+	save = function(self)
+		local state = {components = {}, random = Random():getState()}
+
+		if state.random.samples > 0 then
+			customError("Checkpoint cannot be saved because "..state.random.samples.." values were drawn from Random objects with distributions.")
+		end
+
+		forEachElement(self.components_, function(path, component)
+			local kind = getKind(component)
+			local componentState = save[kind](component, self.events_[path])
+
+			componentState.type = kind
+			state.components[path] = componentState
+		end)
+
+		local err = cpp_savecheckpoint(self.file.filename, state)
+
+		if err then
+			customError(err)
+		end
+	end
+}
+
+metaTableCheckpoint_ = {__index = Checkpoint_, __tostring = _Gtme.tostring}
+
+--- Type to save the state of a simulation into a binary file and restore it afterwards,
+-- allowing long simulations to continue after being interrupted. The Checkpoint must be
+-- created just after the target, before running the simulation, in order to identify the
+-- Events of its Timers. The Events added to a Timer afterwards cannot be saved.
+-- @arg data.target A Model instance, Environment, CellularSpace, Society, Agent, Cell,
+-- or Timer. When it is a Model instance or an Environment, the Checkpoint also
+-- stores the objects of the types above within it.
+-- @arg data.file A File or a string with the name of the file.
+-- @usage -- DONTRUN
+-- import("base")
+--
+-- instance = Tube{}
+-- checkpoint = Checkpoint{target = instance, file = "tube.tmc"}
+--
+-- instance:run()
+-- checkpoint:save()
+function Checkpoint(data)
+	verifyNamedTable(data)
+	verifyUnnecessaryArguments(data, {"target", "file"})
+
+	mandatoryTableArgument(data, "target")
+
+	if not belong(type(data.target), kinds) and not (isModel(data.target) and type(data.target) ~= "Model") then
+		incompatibleTypeError("target", "Model instance, Environment, CellularSpace, Society, Agent, Cell, or Timer", data.target)
+	end
+
+	if type(data.file) == "string" then
+		data.file = File(data.file)
+	end
+
+	mandatoryTableArgument(data, "file", "File")
+
+	data.components_ = {}
+	data.events_ = {}
+
+	collectComponents(data.target, "target", data.components_, {})
+
+	forEachElement(data.components_, function(path, component)
+		if type(component) == "Timer" then
+			local events = {list = component:getEvents(), index = {}}
+
+			forEachElement(events.list, function(position, event)
+				events.index[event] = position
+			end)
+
+			data.events_[path] = events
+		end
+	end)
+
+	setmetatable(data, metaTableCheckpoint_)
+	return data
+end
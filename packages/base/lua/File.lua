@@ -22,6 +22,45 @@
 --
 -------------------------------------------------------------------------------------------
 
+-- Read the rows of a CSV file starting at a given position, converting them into a DataFrame.
+-- It returns the DataFrame, the position of the next row (nil at the end of the file), and
+-- the number of the last line read.
+local function readChunk(file, sep, position, line, size)
+	local columns, header, warnings, nextPosition, lastLine = cpp_readcsv(tostring(file), sep, position, line, size)
+
+	if not columns then
+		customError(header)
+	end
+
+	forEachElement(warnings, function(_, warning)
+		customWarning("Line "..warning.line.." ('"..warning.text.."') should contain "..#header.." attributes but has "..warning.values..".")
+	end)
+
+	-- columns with the names of the arguments of DataFrame need to be given as rows
+	local reserved = {file = true, first = true, step = true, last = true, instance = true}
+	local useRows = false
+
+	forEachElement(columns, function(name)
+		if reserved[name] then useRows = true end
+	end)
+
+	if not useRows then
+		return DataFrame(columns), nextPosition, lastLine
+	end
+
+	local rows = {}
+
+	forEachElement(columns, function(name, column)
+		for i = 1, #column do
+			if not rows[i] then rows[i] = {} end
+
+			rows[i][name] = column[i]
+		end
+	end)
+
+	return DataFrame(rows), nextPosition, lastLine
+end
+
 -- This function was taken from http://lua-users.org/wiki/LuaCsv.
 local function parseLine(line, sep, cline)
 	mandatoryArgument(1, "string", line)
@@ -377,34 +416,48 @@ File_ = {
 			customError("Cannot read a file opened for writing.")
 		end
 
-		local data = DataFrame{}
-		local fields = parseLine(self.file:read(), sep, self.line)
-
-		forEachElement(fields, function(_, value)
-			data[value] = {}
-		end)
+		self:close()
 
-		local line = self.file:read()
-		while line do
-			self.line = self.line + 1
-			local element = {}
-			local tuple = parseLine(line, sep, self.line)
-			if #tuple == #fields then
-				for i = 1, #fields do
-					element[fields[i]] = tonumber(tuple[i]) or tuple[i]
-				end
+		return readChunk(self, sep, 0, 1, 0)
+	end,
+	--- Return an iterator that reads a CSV file in chunks of rows, returning a DataFrame
+	-- for each chunk. It is useful to process files that do not fit in memory. The first
+	-- line of the file list the attribute names. Lines with a different number of
+	-- attributes are skipped with a warning, as in File:read().
+	-- @arg sep A string with the separator. The default value is ','.
+	-- @arg size The maximum number of rows of each chunk. The default value is 100000.
+	-- @usage file = filePath("agents.csv", "base")
+	-- for csv in file:chunks(",", 2) do
+	--     print(#csv) -- 2
+	-- end
+	chunks = function(self, sep, size)
+		optionalArgument(1, "string", sep)
+		optionalArgument(2, "number", size)
+		sep = sep or ','
+		size = size or 100000
 
-				data:add(element)
-			else
-				customWarning("Line "..self.line.." ('"..line.."') should contain "..#fields.." attributes but has "..#tuple..".")
-			end
+		positiveArgument(2, size)
+		integerArgument(2, size)
 
-			line = self.file:read()
+		if self.mode == "w" then
+			customError("Cannot read a file opened for writing.")
+		elseif not self:exists() then
+			customError("File '"..self.."' does not exist.")
 		end
 
-		self:close()
+		local position = 0
+		local line = 1
 
-		return data
+		return function()
+			if not position then return end
+
+			local data
+			data, position, line = readChunk(self, sep, position, line, size)
+
+			if #data == 0 and not position then return end
+
+			return data
+		end
 	end,
 	--- Split the path, name, and extension of the file into three returning values.
 	-- @usage file = filePath("agents.csv", "base")
@@ -40,6 +40,10 @@ metaTableInternetSender_ = {__index = InternetSender_}
 -- a window to display the transferred data. The default value is true.
 -- @arg data.protocol A string with the protocol to be used. It can be "tcp" (default)
 -- or "udp".
+-- @arg data.bandwidth A number with the maximum number of bytes per second to be sent
+-- when using the protocol "udp". The datagrams of large states are then spread over time
+-- instead of being sent at once, which avoids losing datagrams when the receiver is slow.
+-- The default value is zero, which means no limit.
 -- @arg data.compress Compress the data to be transfered? It might be interesting not to
 -- compress when the connection is on the localhost, or when there is a very fast connection,
 -- to make the simulation faster. The default value is true.
@@ -62,7 +66,7 @@ metaTableInternetSender_ = {__index = InternetSender_}
 -- }
 function InternetSender(data)
 	verifyNamedTable(data)
-	verifyUnnecessaryArguments(data, {"target", "protocol", "select", "port", "host", "visible", "compress"})
+	verifyUnnecessaryArguments(data, {"target", "protocol", "select", "port", "host", "visible", "compress", "bandwidth"})
 
 	mandatoryTableArgument(data, "target")
 	defaultTableValue(data, "host", "localhost")
@@ -70,6 +74,8 @@ function InternetSender(data)
 	defaultTableValue(data, "visible", true)
 	defaultTableValue(data, "protocol", "udp")
 	defaultTableValue(data, "compress", true)
+	defaultTableValue(data, "bandwidth", 0)
+	positiveTableArgument(data, "bandwidth", true)
 
 	if type(data.select) == "string" then data.select = {data.select} end
 
@@ -207,6 +213,10 @@ function InternetSender(data)
 
 	isender:setObserver(obs)
 
+	if observerType == 7 then
+		isender:setBandwidth(data.bandwidth)
+	end
+
 	data.cObj_ = logfile -- SKIP
 	data.id = id -- SKIP
 
@@ -52,6 +52,16 @@ metaTableLog_ = {__index = Log_}
 -- @arg data.target An Agent, Cell, CellularSpace, Society.
 -- @arg data.file A string with the file name to be saved. The default value is "result.csv".
 -- @arg data.separator A string with the separator. The default value is ",".
+-- @arg data.format A string with the format of the file. It can be "csv" (default), "raw",
+-- or "columnar". Binary files start with the string "TMELOG", the version, the format
+-- (1 for "raw" and 2 for "columnar"), the number of attributes, and the name and type
+-- of each attribute. The types are taken from the first notification. A "raw" file then
+-- stores each value as a little-endian double, in the order of the selected attributes.
+-- A "columnar" file stores blocks of notifications, each one with its number of rows
+-- followed by the values of each attribute together. Values that do not match the type of
+-- their attribute are stored as NaN or as text.
+-- The values of binary files are buffered, and the file is complete only after the Log
+-- is removed by clean() or the simulation ends.
 -- @arg data.overwrite A boolean value indicating whether the file should be overwritten.
 -- The default value is true.
 -- @arg data.select A vector of strings with the name of the attributes to be observed.
@@ -70,12 +80,19 @@ metaTableLog_ = {__index = Log_}
 -- }
 function Log(data)
 	verifyNamedTable(data)
-	verifyUnnecessaryArguments(data, {"target", "select", "file", "separator", "overwrite"})
+	verifyUnnecessaryArguments(data, {"target", "select", "file", "separator", "overwrite", "format"})
 
 	mandatoryTableArgument(data, "target")
 	defaultTableValue(data, "separator", ",")
 	defaultTableValue(data, "file", "result.csv")
 	defaultTableValue(data, "overwrite", true)
+	defaultTableValue(data, "format", "csv")
+
+	local formats = {csv = true, raw = true, columnar = true}
+
+	if not formats[data.format] then
+		switchInvalidArgument("format", data.format, formats)
+	end
 
 	if type(data.select) == "string" then data.select = {data.select} end
 
@@ -190,6 +207,7 @@ function Log(data)
 
 	local logfile = TeLogFile()
 	logfile:setObserver(obs)
+	logfile:setFormat(data.format)
 
 	data.cObj_ = logfile
 	data.id = id
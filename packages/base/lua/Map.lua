@@ -1527,6 +1527,11 @@ metaTableMap_ = {__index = Map_}
 -- @arg data.background A Map that can be used as background to plot a Society.
 -- It can also be a string with a color to be used as background.
 -- @arg data.grid Draw a grid around the Cells? The default value is false.
+-- @arg data.file A string with the name of an image file. When used, the Map is not shown
+-- on the screen. Each notify() saves a new image whose name has the number of the notification
+-- after the name of the file (for example, "map.png" is saved as "map-1.png", "map-2.png", and so on).
+-- If it is "-", the images are written to the standard output as raw RGB frames, which can be used
+-- to create videos with tools such as ffmpeg. It can only be used with a CellularSpace.
 -- @arg data.font A string with a font name to draw Agents.
 -- @arg data.title A title for the Map to be shown on the top of the screen. Whenever
 -- the argument select is used, it is the default value for title.
@@ -1681,7 +1686,7 @@ function Map(data)
 		end
 	end
 
-	local validArgs = {"background", "color", "font", "grid", "grouping", "invert", "label", "max", "min",
+	local validArgs = {"background", "color", "file", "font", "grid", "grouping", "invert", "label", "max", "min",
 	"precision", "select", "size", "slices", "stdColor", "stdDeviation", "symbol", "target", "value", "title"}
 
 	verifyUnnecessaryArguments(data, validArgs)
@@ -1695,6 +1700,15 @@ function Map(data)
 
 	optionalTableArgument(data, "value", "table")
 	optionalTableArgument(data, "select", "string")
+	optionalTableArgument(data, "file", "string")
+
+	if data.file and type(data.target) ~= "CellularSpace" then
+		customError("Argument 'file' can only be used with a CellularSpace.")
+	end
+
+	-- the file does not change the arguments of each grouping
+	local file = data.file
+	data.file = nil
 
 	if data.select then
 		local interface = sessionInfo().interface
@@ -2161,6 +2175,10 @@ function Map(data)
 
 	local observerType = 6
 
+	if file then
+		observerType = 9
+	end
+
 	local observerParams = {}
 	local colorBar = {}
 
@@ -2222,8 +2240,17 @@ function Map(data)
 		idObs, obs = data.target.cObj_:createObserver(observerType, tbDimensions, {data.select}, observerParams, data.target.cells)
 	end
 
-	local map = TeMap()
-	map:setObserver(obs)
+	local map
+
+	if file then
+		map = TeImage()
+		map:setObserver(obs)
+		map:setFileName(file)
+		data.file = file
+	else
+		map = TeMap()
+		map:setObserver(obs)
+	end
 
 	data.id = idObs
 	data.cObj_ = map
@@ -2232,7 +2259,7 @@ function Map(data)
 		map:setGridVisible(1)
 	end
 
-	if data.title then
+	if data.title and not file then
 		map:setTitle(data.title)
 	end
 
@@ -2240,7 +2267,10 @@ function Map(data)
 	table.insert(_Gtme.createdObservers, data)
 
 	-- TODO: change the lines below by data:notify()
-	data.target:notify()
+	if not file then
+		data.target:notify()
+	end
+
 	data.target:notify()
 
 	return data
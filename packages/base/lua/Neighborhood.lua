@@ -196,6 +196,55 @@ metaTableNeighborhood_ = {
 	__tostring = _Gtme.tostring
 }
 
+-- Neighborhood shared by all the Cells of a CellularSpace and stored in C++. It is
+-- created by CellularSpace:createNeighborhood() in regular CellularSpaces, storing
+-- only the relative positions of the neighbors, and by CellularSpace:loadNeighborhood(),
+-- storing the connections as a compressed graph. It is converted into a Neighborhood
+-- only when a Cell needs to get it.
+SharedNeighborhood_ = {
+	type_ = "SharedNeighborhood",
+	-- Return a Neighborhood with the neighbors of a given Cell.
+	get = function(self, cell)
+		local neigh = Neighborhood()
+
+		self.neighbors_(self.cObj_, self.index_, cell.cObj_, neigh.connections, neigh.weights)
+
+		return neigh
+	end,
+	-- Apply a function to each neighbor of a given Cell, as in forEachNeighbor().
+	-- Each level of nested calls has its own buffers to store the neighbors.
+	forEachNeighbor = function(self, cell, f)
+		local depth = self.depth_ + 1
+		local buffer = self.buffers_[depth]
+
+		if not buffer then
+			buffer = {{}, {}}
+			self.buffers_[depth] = buffer
+		end
+
+		local connections = buffer[1]
+		local weights = buffer[2]
+
+		self.depth_ = depth
+		local quantity = self.neighbors_(self.cObj_, self.index_, cell.cObj_, connections, weights)
+
+		for i = 1, quantity do
+			if f(connections[i], weights[i], cell) == false then
+				self.depth_ = depth - 1
+				return false
+			end
+		end
+
+		self.depth_ = depth - 1
+		return true
+	end
+}
+
+metaTableSharedNeighborhood_ = {
+	__index = SharedNeighborhood_,
+	__tostring = _Gtme.tostring
+}
+
 --- A Neighborhood is a set of pairs (cell, weight), where cell is a neighbor Cell and weight
 -- is a number storing the relation's strength.
 -- Each Cell can have one or more Neighborhoods to represent its proximity relations. \
@@ -25,12 +25,31 @@
 local MersenneTwister
 local UniformReal
 local TerraLib = getPackage("gis").TerraLib
+local seed -- seed of MersenneTwister
+local draws = 0 -- values drawn from MersenneTwister since the seed was set
+local uniforms = 0 -- values drawn from UniformReal since the seed was set
+local samples = 0 -- values drawn from distributions since the seed was set
 
 local function getMT()
 	MersenneTwister()
+	draws = draws + 1
 	return MersenneTwister
 end
 
+local function setSeed(value)
+	seed = value
+	draws = 0
+	uniforms = 0
+	samples = 0
+	MersenneTwister = TerraLib().random().MersenneTwister(value)
+
+	local distribution = TerraLib().random().UniformRealDistribution(getMT(), 0, 1)
+	UniformReal = function()
+		uniforms = uniforms + 1
+		return distribution()
+	end
+end
+
 local function categorical(values)
 	local str = "return function(number)\n"
 
@@ -46,6 +65,26 @@ end
 
 Random_ = {
 	type_ = "Random",
+	--- Return the state of the generator of random numbers. It is a table with the seed
+	-- and the number of values drawn since the seed was set, which can be used by
+	-- Random:setState() to continue the same sequence of random numbers afterwards,
+	-- even in another execution of TerraME. The values drawn by Random objects with
+	-- distributions use the generator in ways that cannot be repeated, therefore the
+	-- state only counts how many of them were drawn, and it cannot be restored if any.
+	-- @usage random = Random{seed = 12345}
+	--
+	-- random:number()
+	-- state = random:getState()
+	-- print(state.seed)
+	getState = function(self)
+		optionalArgument(0, "Random", self)
+
+		if not MersenneTwister then
+			setSeed(os.time()) -- SKIP
+		end
+
+		return {seed = seed, draws = draws, uniforms = uniforms, samples = samples}
+	end,
 	--- Return an integer random number. It uses a discrete uniform distribution.
 	-- @arg v1 An integer number. If abscent, integer() will return zero or one.
 	-- If it is the only argument, it will return a number between zero and this value.
@@ -145,8 +184,7 @@ Random_ = {
 		optionalArgument(1, "number", seed)
 		integerArgument(1, seed)
 
-		MersenneTwister = TerraLib().random().MersenneTwister(seed)
-		UniformReal = TerraLib().random().UniformRealDistribution(getMT(), 0, 1)
+		setSeed(seed)
 	end,
 	--- Return a random element from the chosen distribution.
 	-- @usage random = Random{2, 3, 4, 6}
@@ -154,6 +192,41 @@ Random_ = {
 	-- random:sample()
 	sample = function()
 		customError("Cannot return a random number.")
+	end,
+	--- Restore the state of the generator of random numbers returned by Random:getState().
+	-- It sets the seed again and draws the same number of values drawn before, therefore
+	-- it takes longer as the simulation draws more values. It is not possible to restore
+	-- a state after values were drawn from Random objects with distributions.
+	-- The Random objects with distributions need to be created again afterwards.
+	-- @arg state A table returned by Random:getState().
+	-- @usage random = Random{seed = 12345}
+	--
+	-- state = random:getState()
+	-- value = random:number()
+	--
+	-- random:setState(state)
+	-- print(value == random:number())
+	setState = function(self, state)
+		optionalArgument(0, "Random", self)
+		mandatoryArgument(1, "table", state)
+		mandatoryTableArgument(state, "seed", "number")
+		mandatoryTableArgument(state, "draws", "number")
+		mandatoryTableArgument(state, "uniforms", "number")
+		optionalTableArgument(state, "samples", "number")
+
+		if state.samples and state.samples > 0 then
+			customError("The state cannot be restored because "..state.samples.." values were drawn from Random objects with distributions.")
+		end
+
+		setSeed(state.seed)
+
+		for _ = draws + 1, state.draws do
+			getMT()
+		end
+
+		for _ = 1, state.uniforms do
+			UniformReal()
+		end
 	end
 }
 
@@ -297,13 +370,10 @@ function Random(data)
 		integerTableArgument(data, "seed")
 		verify(data.seed ~= 0, "Argument 'seed' cannot be zero.")
 
-		MersenneTwister = TerraLib().random().MersenneTwister(data.seed)
-		UniformReal = TerraLib().random().UniformRealDistribution(getMT(), 0, 1)
+		setSeed(data.seed)
 		data.seed = nil
 	elseif not MersenneTwister then
-		local seed = os.time() -- SKIP
-		MersenneTwister = TerraLib().random().MersenneTwister(seed) -- SKIP
-		UniformReal = TerraLib().random().UniformRealDistribution(getMT(), 0, 1) -- SKIP
+		setSeed(os.time()) -- SKIP
 	end
 
 	switch(data, "distrib"):caseof{
@@ -449,6 +519,16 @@ function Random(data)
 		end
 	}
 
+	-- distributions draw from MersenneTwister without being counted by getMT()
+	if data.sample then
+		local sample = data.sample
+
+		data.sample = function()
+			samples = samples + 1
+			return sample()
+		end
+	end
+
 	setmetatable(data, metaTableRandom_)
 	return data
 end
@@ -204,6 +204,65 @@ metaTableSocialNetwork_ = {
 	__tostring = _Gtme.tostring
 }
 
+-- SocialNetwork shared by all the Agents of a Society and stored in C++ as a
+-- compressed graph. It is created by Society:createSocialNetwork() for the strategies
+-- that draw random connections only once, identifying the Agents by their positions
+-- in the Society. It is converted into a SocialNetwork only when an Agent needs to get it.
+-- Agents removed from the Society are replaced by false in agents_ and are not returned
+-- as connections, while Agents added to the Society have no connections.
+SharedSocialNetwork_ = {
+	type_ = "SharedSocialNetwork",
+	-- Return a SocialNetwork with the connections of a given Agent.
+	get = function(self, agent)
+		local sn = SocialNetwork()
+		local connections = {}
+		local weights = {}
+
+		local quantity = self.cObj_:getGraphConnections(self.index_, self.positions_[agent] or 0, self.agents_, connections, weights)
+
+		for i = 1, quantity do
+			local id = connections[i].id
+			sn.connections[id] = connections[i]
+			sn.weights[id] = weights[i]
+		end
+
+		sn.count = quantity
+		return sn
+	end,
+	-- Apply a function to each connection of a given Agent, as in forEachConnection().
+	-- Each level of nested calls has its own buffers to store the connections.
+	forEachConnection = function(self, agent, f)
+		local depth = self.depth_ + 1
+		local buffer = self.buffers_[depth]
+
+		if not buffer then
+			buffer = {{}, {}}
+			self.buffers_[depth] = buffer
+		end
+
+		local connections = buffer[1]
+		local weights = buffer[2]
+
+		self.depth_ = depth
+		local quantity = self.cObj_:getGraphConnections(self.index_, self.positions_[agent] or 0, self.agents_, connections, weights)
+
+		for i = 1, quantity do
+			if f(connections[i], weights[i], agent) == false then
+				self.depth_ = depth - 1
+				return false
+			end
+		end
+
+		self.depth_ = depth - 1
+		return true
+	end
+}
+
+metaTableSharedSocialNetwork_ = {
+	__index = SharedSocialNetwork_,
+	__tostring = _Gtme.tostring
+}
+
 --- SocialNetwork represents relations between A gents. It is a set of pairs (connection,
 -- weight), where connection is an A gent and weight
 -- is a number storing the relation's strength. \
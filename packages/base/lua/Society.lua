@@ -71,20 +71,75 @@ local function getSocialNetworkByNeighbor(_, data)
 end
 
 local function getSocialNetworkByProbability(soc, data)
+	local logq = math.log(1 - data.probability)
+
 	return function(agent)
 		local rs = SocialNetwork()
 		local rand = Random()
+		local agents = soc.agents
+		local position = 0
 
-		forEachAgent(soc, function(hint)
-			if hint ~= agent and rand:number() < data.probability then
+		-- the distance to the next connected Agent follows a geometric distribution
+		while true do
+			if data.probability == 1 then
+				position = position + 1
+			else
+				position = position + 1 + math.floor(math.log(1 - rand:number()) / logq)
+			end
+
+			local hint = agents[position]
+			if not hint then break end
+
+			if hint ~= agent then
 				rs:add(hint, 1)
 			end
-		end)
+		end
 
 		return rs
 	end
 end
 
+-- Create a SocialNetwork stored in C++ and add it to all Agents. A SocialNetwork
+-- created again with the same name replaces the graph of the previous one.
+local function addSharedSocialNetwork(self, data, first, second)
+	local agents = {}
+	local positions = {}
+
+	forEachAgent(self, function(agent, position)
+		agents[position] = agent
+		positions[agent] = position
+	end)
+
+	local seed = Random():integer(0, 2147483647)
+
+	if not self.sharednetworks_ then
+		self.sharednetworks_ = {}
+	end
+
+	local index = -1
+	local previous = self.sharednetworks_[data.name]
+	if previous then
+		index = previous.index_
+		previous.agents_ = {}
+	end
+
+	local shared = {
+		cObj_ = self.cObj_,
+		index_ = self.cObj_:createGraph(data.strategy, #agents, first, second, data.symmetric == true, seed, index),
+		agents_ = agents,
+		positions_ = positions,
+		depth_ = 0,
+		buffers_ = {}
+	}
+
+	setmetatable(shared, metaTableSharedSocialNetwork_)
+	self.sharednetworks_[data.name] = shared
+
+	forEachAgent(self, function(agent)
+		agent.socialnetworks[data.name] = shared
+	end)
+end
+
 local function getSocialNetworkByQuantity(soc, data)
 	return function(agent)
 		local quant = 0
@@ -152,6 +207,15 @@ Society_ = {
 		if agent.id == nil then agent.id = tostring(self.autoincrement) end
 		self.autoincrement = self.autoincrement + 1
 
+		-- new Agents start without connections in the SocialNetworks shared by the Society
+		if self.sharednetworks_ then
+			forEachElement(self.sharednetworks_, function(name, shared)
+				if agent.socialnetworks[name] == nil then
+					agent.socialnetworks[name] = shared
+				end
+			end)
+		end
+
 		forEachElement(self.placements, function(placement, cs)
 			if agent[placement] == nil then
 				-- if the agent already has this placement then
@@ -186,6 +250,13 @@ Society_ = {
 	clear = function(self)
 		self.agents = {}
 		self.autoincrement = 1
+
+		if self.sharednetworks_ then
+			forEachElement(self.sharednetworks_, function(_, shared)
+				shared.agents_ = {}
+				shared.positions_ = {}
+			end)
+		end
 	end,
 	--- Create a directed SocialNetwork for each Agent of the Society.
 	-- @arg data.strategy A string with the strategy to be used for creating the SocialNetwork.
@@ -205,6 +276,11 @@ Society_ = {
 	-- SocialNetworks not inmemory also help the simulation to run with larger datasets,
 	-- as they are not explicitly represented, but they consume more
 	-- time as they need to be built again and again along the simulation.
+	-- SocialNetworks in memory created by strategies that draw random connections
+	-- ("barabasi", "erdos", "probability", "quantity", and "watts") are stored as a single
+	-- graph within the Society. An Agent gets its own copy of the SocialNetwork only when it
+	-- calls Agent:getSocialNetwork(), while Utils:forEachConnection() traverses the graph
+	-- directly, in the order the connections were created.
 	-- Note that not inmemory relations cannot be changed manually (for example by using
 	-- SocialNetwork:add()), because the relation is recomputed every time it is needed.
 	-- @arg data.neighborhood A string with the name of the Neighborhood that will be used to
@@ -331,7 +407,11 @@ Society_ = {
 					incompatibleValueError("probability", "a number between 0 and 1", data.probability)
 				end
 
-				data.mfunc = getSocialNetworkByProbability
+				if data.inmemory then
+					addSharedSocialNetwork(self, data, data.probability)
+				else
+					data.mfunc = getSocialNetworkByProbability
+				end
 			end,
 			["function"] = function()
 				verifyUnnecessaryArguments(data, {"strategy", "filter", "name", "inmemory"})
@@ -393,7 +473,11 @@ Society_ = {
 					customWarning("Connecting more than 90% of the Agents randomly might take too much time.")
 				end
 
-				data.mfunc = getSocialNetworkByQuantity
+				if data.inmemory then
+					addSharedSocialNetwork(self, data, data.quantity)
+				else
+					data.mfunc = getSocialNetworkByQuantity
+				end
 			end,
 			erdos = function()
 				verifyUnnecessaryArguments(data, {"strategy", "name", "quantity"})
@@ -402,21 +486,10 @@ Society_ = {
 				integerTableArgument(data, "quantity")
 				positiveTableArgument(data, "quantity")
 
-				local name = data.name
-				if name == "1" then name = nil end
-				self:createSocialNetwork{strategy = "void", name = name}
-
-				for _ = 1, data.quantity do
-					local ag1 = self:sample()
-					local ag2 = ag1
-
-					while ag2 == ag1 or ag2:getSocialNetwork(data.name):isConnection(ag1) do
-						ag2 = self:sample()
-					end
+				local maximum = math.floor(#self * (#self - 1) / 2)
+				verify(data.quantity <= maximum, "Argument 'quantity' should be less than or equal to the number of pairs of Agents ("..maximum..").")
 
-					ag1:getSocialNetwork(data.name):add(ag2, 1)
-					ag2:getSocialNetwork(data.name):add(ag1, 1)
-				end
+				addSharedSocialNetwork(self, data, data.quantity)
 			end,
 			barabasi = function()
 				verifyUnnecessaryArguments(data, {"strategy", "start", "name", "quantity"})
@@ -432,36 +505,7 @@ Society_ = {
 				verify(data.start < #self, "Argument 'start' should be less than the total of Agents in the Society.")
 				verify(data.quantity < data.start, "Argument 'quantity' should be less than 'start'.")
 
-				local name = data.name
-				if name == "1" then name = nil end
-				self:createSocialNetwork{strategy = "void", name = name}
-
-				local count = data.start
-
-				for i = data.start + 1, #self do
-					local agent = self.agents[i]
-					local sn = agent:getSocialNetwork(data.name)
-
-					while #sn < data.quantity do
-						local value = Random():integer(1, count)
-						local position = 0
-
-						while value > 0 do
-							position = position + 1
-							value = value - #self.agents[position]:getSocialNetwork(data.name) - 1
-						end
-
-						local candidate = self.agents[position]
-
-						if not sn:isConnection(candidate) then
-							candidate:getSocialNetwork(data.name):add(agent)
-							sn:add(candidate)
-							count = count + 1
-						end
-					end
-
-					count = count + data.quantity + 1
-				end
+				addSharedSocialNetwork(self, data, data.start, data.quantity)
 			end,
 			watts = function()
 				verifyUnnecessaryArguments(data, {"strategy", "name", "quantity", "probability"})
@@ -473,30 +517,7 @@ Society_ = {
 				mandatoryTableArgument(data, "probability", "number")
 				verify(data.probability >= 0 and data.probability <= 1, "Argument 'probability' should be between 0 and 1.")
 
-				local name = data.name
-				if name == "1" then name = nil end
-				self:createSocialNetwork{strategy = "void", name = name}
-
-				for i = 1, #self do
-					local ag1 = self.agents[i]
-					local sn = ag1:getSocialNetwork(data.name)
-					local ag2
-
-					for dist = 1, data.quantity do
-						if Random():number() < data.probability then
-							ag2 = ag1
-						else
-							ag2 = self.agents[((i - 1 + dist) % #self) + 1]
-						end
-
-						while ag2 == ag1 or sn:isConnection(ag2) do
-							ag2 = self:sample()
-						end
-
-						ag2:getSocialNetwork(data.name):add(ag1)
-						sn:add(ag2)
-					end
-				end
+				addSharedSocialNetwork(self, data, data.quantity, data.probability)
 			end,
 			void = function()
 				verifyUnnecessaryArguments(data, {"strategy", "name"})
@@ -633,6 +654,17 @@ Society_ = {
 				if v.id == arg.id and v == arg then
 					table.remove(self.agents, k)
 
+					-- the Agent is not a connection of the shared SocialNetworks anymore
+					if self.sharednetworks_ then
+						forEachElement(self.sharednetworks_, function(_, shared)
+							local position = shared.positions_[arg]
+							if position then
+								shared.positions_[arg] = nil
+								shared.agents_[position] = false
+							end
+						end)
+					end
+
 					if self.observerId then
 						return arg.cObj_:kill(self.observerId)
 					end
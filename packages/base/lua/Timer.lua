@@ -22,6 +22,20 @@
 --
 -------------------------------------------------------------------------------------------
 
+-- Events of each Timer, indexed by the handles of its C++ queue
+local queues = setmetatable({}, {__mode = "k"})
+
+local function getEvents(self)
+	local queue = queues[self]
+	local events = {}
+
+	for i, handle in ipairs(self.cObj_:getEvents()) do
+		events[i] = queue[handle]
+	end
+
+	return events
+end
+
 Timer_ = {
 	type_ = "Timer",
 	--- Add a new Event to the timer. If the Event has a start time less than the current
@@ -44,17 +58,8 @@ Timer_ = {
 			customWarning(msg)
 		end
 
-		local pos = 1
-		local evp = self.events[pos]
-		local quant = #self.events
-		local time = event.time
-		local prio = event.priority
-		while pos <= quant and (time > evp.time or (time == evp.time and prio >= evp.priority)) do
-			pos = pos + 1
-			evp = self.events[pos]
-		end
-
-		table.insert(self.events, pos, event)
+		local handle = self.cObj_:addEvent(event.time, event.priority)
+		queues[self][handle] = event
 		event.parent = self
 	end,
 	--- Remove all the Events from the Timer. Note that, when this function is called
@@ -67,7 +72,8 @@ Timer_ = {
 	--
 	-- timer:clear()
 	clear = function(self)
-		self.events = {}
+		self.cObj_:clearEvents()
+		queues[self] = {}
 	end,
 	--- Return a vector with the Events of the Timer.
 	-- @usage timer = Timer{
@@ -76,7 +82,7 @@ Timer_ = {
 	--
 	-- print(timer:getEvents()[1]:getTime())
 	getEvents = function(self)
-		return self.events
+		return getEvents(self)
 	end,
 	--- Return the current simulation time.
 	-- @usage timer = Timer{
@@ -140,10 +146,14 @@ Timer_ = {
 			customWarning(msg)
 		end
 
+		local cObj = self.cObj_
+
 		while true do
-			if getn(self.events) == 0 then return end
+			local handle = cObj:getFirst()
+			if not handle then return end
 
-			local ev = self.events[1]
+			local queue = queues[self]
+			local ev = queue[handle]
 			if ev.time > finalTime then
 				self.time = finalTime
 				return
@@ -151,7 +161,8 @@ Timer_ = {
 
 			self.time = ev.time
 
-			table.remove(self.events, 1)
+			cObj:removeFirst()
+			queue[handle] = nil
 
 			local result = ev.action(ev, self)
 
@@ -176,7 +187,26 @@ Timer_ = {
 }
 
 metaTableTimer_ = {
-	__index = Timer_,
+	__index = function(self, idx)
+		if idx == "events" then
+			return getEvents(self)
+		end
+
+		return Timer_[idx]
+	end,
+	__pairs = function(self)
+		local events = false
+
+		return function(_, key)
+			if not events then
+				local k, v = next(self, key)
+				if k ~= nil then return k, v end
+
+				events = true
+				return "events", getEvents(self)
+			end
+		end, self, nil
+	end,
 	__tostring = _Gtme.tostring,
 	--- Return the number of Events in the Timer.
 	-- @usage timer = Timer{
@@ -190,7 +220,7 @@ metaTableTimer_ = {
 	--
 	-- print(#timer)
 	__len = function(self)
-		return #self.events
+		return self.cObj_:getSize()
 	end
 }
 
@@ -202,7 +232,8 @@ metaTableTimer_ = {
 -- Events before that time were already executed. See Timer:run() for more details.
 -- @arg data.... A set of Events.
 -- @output cObj_ A pointer to a C++ representation of the Timer. Never use this object.
--- @output events An ordered vector with the Events.
+-- @output events An ordered vector with the Events. It is built from the
+-- internal queue of the Timer each time it is accessed.
 -- @output time The current simulation time.
 -- @usage timer = Timer{
 --     Event{action = function()
@@ -229,10 +260,11 @@ function Timer(data)
 	local cObj = TeTimer()
 
 	local mdata = {
-		events = {},
+		cObj_ = cObj,
 		time = -math.huge,
 	}
 
+	queues[mdata] = {}
 	setmetatable(mdata, metaTableTimer_)
 
 	forEachOrderedElement(data, function(idx, value, mtype)
@@ -243,7 +275,6 @@ function Timer(data)
 		end
 	end)
 
-	mdata.cObj_ = cObj
 	cObj:setReference(mdata)
 	return mdata
 end
@@ -521,7 +521,7 @@ UnitTest_ = {
 			observer:save(newImage)
 
 			self.test = self.test + 1
-			local merror = cpp_imagecompare(newImage, oldImage)
+			local merror, pixels, delta, xmin, ymin, xmax, ymax = cpp_imagecompare(newImage, oldImage)
 
 			if merror <= tolerance then
 				self.success = self.success + 1
@@ -534,8 +534,13 @@ UnitTest_ = {
 
 				if wnew ~= wold or hnew ~= hold then -- SKIP (to test this line, run execution tests, package 'unittest')
 					message = message.." Image sizes are different: "..string.format("%.0fx%.0f", wnew, hnew).." (created) and "..string.format("%.0fx%.0f", wold, hold).." (log)." -- SKIP (to test this line, run execution tests, package 'unittest')
-				else
+				elseif xmin then -- SKIP (to test this line, run execution tests, package 'unittest')
 					message = message.." The maximum tolerance is "..tolerance..", but got "..merror.."." -- SKIP (to test this line, run execution tests, package 'unittest')
+					message = message.." There are "..string.format("%.0f", pixels).." different pixels, with a maximum difference of " -- SKIP (to test this line, run execution tests, package 'unittest')
+						..string.format("%.0f", delta).." in a color channel, between ("..string.format("%.0f, %.0f", xmin, ymin) -- SKIP (to test this line, run execution tests, package 'unittest')
+						..") and ("..string.format("%.0f, %.0f", xmax, ymax)..")." -- SKIP (to test this line, run execution tests, package 'unittest')
+				else
+					message = message.." The images could not be loaded." -- SKIP (to test this line, run execution tests, package 'unittest')
 				end
 
 				self:printError(message)
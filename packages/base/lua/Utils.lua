@@ -344,6 +344,77 @@ function forEachAttribute(obj, _sof_)
 	customError("#1 should be Cell or Agent, got "..objt..".")
 end
 
+-- Execute a function for each Cell of a columnar CellularSpace using several threads in C++.
+local function forEachCellParallel(cs, _sof_, data)
+	if not cs.columns_ then
+		customError("Parallel traversal requires a CellularSpace created with 'columnar = true'.")
+	end
+
+	defaultTableValue(data, "outputs", {})
+	defaultTableValue(data, "threads", 0)
+	defaultTableValue(data, "partitions", 256)
+	verifyUnnecessaryArguments(data, {"outputs", "threads", "partitions"})
+
+	integerTableArgument(data, "threads")
+	integerTableArgument(data, "partitions")
+	positiveTableArgument(data, "threads", true)
+	positiveTableArgument(data, "partitions")
+
+	local outputs = {}
+	forEachElement(data.outputs, function(_, attribute)
+		local column = cs.columns_.index[attribute]
+
+		if not column then
+			customError("Attribute '"..tostring(attribute).."' is not stored in the columns of the CellularSpace and cannot be updated in parallel.")
+		end
+
+		table.insert(outputs, column)
+	end)
+
+	local constants = {}
+	local position = 1
+	while true do
+		local name, value = debug.getupvalue(_sof_, position)
+		if not name then break end
+
+		if name ~= "_ENV" then
+			local vtype = type(value)
+
+			if vtype == "number" or vtype == "string" or vtype == "boolean" then
+				constants[position] = value
+			elseif value ~= nil then
+				customError("Variable '"..name.."' ("..vtype..") cannot be used in a parallel traversal. Only numbers, strings, and booleans declared outside the function can be used.")
+			end
+		end
+
+		position = position + 1
+	end
+
+	local stencils = {}
+	local graphs = {}
+	local first = cs.cells[1]
+
+	if first then
+		forEachElement(first.neighborhoods, function(name, shared)
+			if type(shared) == "SharedNeighborhood" then
+				if shared.neighbors_ == cs.cObj_.getStencilNeighbors then
+					stencils[name] = shared.index_
+				else
+					graphs[name] = shared.index_
+				end
+			end
+		end)
+	end
+
+	local seed = Random():integer(0, 2147483647)
+	local result, merror = cs.cObj_:traverse(string.dump(_sof_), constants, outputs, stencils, graphs, data.partitions, data.threads, seed)
+
+	if result == nil then
+		customError(string.match(merror, "^.-:%d+: (.*)$") or merror)
+	end
+
+	return result
+end
 
 --- Second order function to traverse a given CellularSpace, Trajectory, or Agent,
 -- applying a given function to each of its Cells. If any of the function calls returns
@@ -358,13 +429,35 @@ end
 -- the Cell in the vector of Cells. If it returns false when processing a given Cell,
 -- forEachCell() stops and does not process any other Cell. In the case where the second argument
 -- is missing, this function becomes the second argument.
+-- @arg parallel (Optional) A table to traverse the Cells of a CellularSpace using several
+-- threads. It can only be used with CellularSpaces created with columnar = true, when the
+-- function becomes the second argument and this table the third one. The Cells are split
+-- into blocks of lines, and each block is executed in a separate Lua state, where the function
+-- can read the columnar attributes, x, y, and past of the Cells and call forEachNeighbor()
+-- using the Neighborhoods created by CellularSpace:createNeighborhood() or
+-- CellularSpace:loadNeighborhood(). Variables declared outside the function are copied to
+-- the threads and must be numbers, strings, or booleans. Only the attributes listed in outputs
+-- can be updated, and only in the Cell being visited. All the Cells read the values from
+-- before the traversal, and the new values are applied after all the Cells are visited. The
+-- function math.random uses one stream of random numbers per block, whose seeds are taken
+-- from Random, so the results do not depend on the number of threads. If some call returns
+-- false, the threads stop as soon as possible. The table has the following named arguments:
+-- outputs, a vector with the names of the attributes to be updated (default {});
+-- threads, the number of threads (default 0, meaning one per processor);
+-- partitions, the maximum number of blocks (default 256).
 -- @usage cellularspace = CellularSpace{xdim = 10}
 --
 -- forEachCell(cellularspace, function(cell)
 --     cell.water = 0
 -- end)
+--
+-- cellularspace = CellularSpace{xdim = 10, columnar = true, instance = Cell{water = 0}}
+--
+-- forEachCell(cellularspace, function(cell)
+--     cell.water = cell.x + math.random()
+-- end, {outputs = {"water"}, threads = 4})
 -- @see Environment:createPlacement
-function forEachCell(object, name, _sof_)
+function forEachCell(object, name, _sof_, parallel)
 	local t = type(object)
 
 	if t == "Agent" then
@@ -379,6 +472,7 @@ function forEachCell(object, name, _sof_)
 
 		return true
 	else
+		parallel = _sof_
 		_sof_ = name
 	end
 
@@ -388,6 +482,16 @@ function forEachCell(object, name, _sof_)
 		incompatibleTypeError(2, "function", _sof_)
 	end
 
+	if parallel ~= nil then
+		if type(parallel) ~= "table" then
+			incompatibleTypeError(3, "table", parallel)
+		elseif t ~= "CellularSpace" then
+			customError("Parallel traversal can only be used with a CellularSpace, got "..t..".")
+		end
+
+		return forEachCellParallel(object, _sof_, parallel)
+	end
+
 	for i, cell in ipairs(object.cells) do
 		if _sof_(cell, i) == false then return false end
 	end
@@ -470,6 +574,11 @@ function forEachConnection(agent, name, _sof_)
 		incompatibleTypeError(3, "function", _sof_)
 	end
 
+	local shared = agent.socialnetworks[name]
+	if type(shared) == "SharedSocialNetwork" then
+		return shared:forEachConnection(agent, _sof_)
+	end
+
 	local socialnetwork = agent:getSocialNetwork(name)
 	if not socialnetwork then
 		customError("Agent does not have a SocialNetwork named '"..name.."'.")
@@ -742,6 +851,11 @@ function forEachNeighbor(cell, name, _sof_)
 		incompatibleTypeError(3, "function", _sof_)
 	end
 
+	local shared = cell.neighborhoods[name]
+	if type(shared) == "SharedNeighborhood" then
+		return shared:forEachNeighbor(cell, _sof_)
+	end
+
 	local neighborhood = cell:getNeighborhood(name)
 	if neighborhood == nil then
 		if name == "1" then
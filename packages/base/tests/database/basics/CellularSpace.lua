@@ -358,6 +358,9 @@ return{
 
 		cs1:loadNeighborhood{file = filePath("cabecadeboi-neigh.gpm", "base")}
 
+		unitTest:assertType(cs1.cells[1].neighborhoods["1"], "SharedNeighborhood")
+		unitTest:assertEquals(cs1.cells[1].neighborhoods["1"], cs1.cells[2].neighborhoods["1"])
+
 		local sizes = {}
 		local minSize = math.huge
 		local maxSize = -math.huge
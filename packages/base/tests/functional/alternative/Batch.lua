@@ -0,0 +1,89 @@
+-------------------------------------------------------------------------------------------
+-- TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+-- Copyright (C) 2001-2014 INPE and TerraLAB/UFOP.
+--
+-- This code is part of the TerraME framework.
+-- This framework is free software; you can redistribute it and/or
+-- modify it under the terms of the GNU Lesser General Public
+-- License as published by the Free Software Foundation; either
+-- version 2.1 of the License, or (at your option) any later version.
+--
+-- You should have received a copy of the GNU Lesser General Public
+-- License along with this library.
+--
+-- The authors reassure the license terms regarding the warranties.
+-- They specifically disclaim any warranties, including, but not limited to,
+-- the implied warranties of merchantability and fitness for a particular purpose.
+-- The framework provided hereunder is on an "as is" basis, and the authors have no
+-- obligation to provide maintenance, support, updates, enhancements, or modifications.
+-- In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+-- indirect, special, incidental, or consequential damages arising out of the use
+-- of this library and its documentation.
+--
+-- Authors: Tiago Garcia de Senna Carneiro (tiago@dpi.inpe.br)
+--          Pedro R. Andrade (pedro.andrade@inpe.br)
+
+local Sum = Model{
+	a = 1,
+	finalTime = 2,
+	init = function(model)
+		model.value = 0
+		model.timer = Timer{Event{action = function()
+			model.value = model.value + model.a
+		end}}
+	end
+}
+
+return{
+	Batch = function(unitTest)
+		local error_func = function()
+			Batch()
+		end
+		unitTest:assertError(error_func, tableArgumentMsg())
+
+		error_func = function()
+			Batch{}
+		end
+		unitTest:assertError(error_func, mandatoryArgumentMsg("model"))
+
+		error_func = function()
+			Batch{model = 2}
+		end
+		unitTest:assertError(error_func, incompatibleTypeMsg("model", "Model", 2))
+
+		error_func = function()
+			Batch{model = Sum, workers = -1}
+		end
+		unitTest:assertError(error_func, positiveArgumentMsg("workers", -1, true))
+
+		error_func = function()
+			Batch{model = Sum, repetition = 1.5}
+		end
+		unitTest:assertError(error_func, integerArgumentMsg("repetition", 1.5))
+
+		error_func = function()
+			Batch{model = Sum, repetition = 0}
+		end
+		unitTest:assertError(error_func, positiveArgumentMsg("repetition", 0))
+
+		error_func = function()
+			Batch{model = Sum, output = 2}
+		end
+		unitTest:assertError(error_func, incompatibleTypeMsg("output", "table or function", 2))
+
+		error_func = function()
+			Batch{model = Sum, parameters = {{a = 1}, 2}}
+		end
+		unitTest:assertError(error_func, "Position 2 of argument 'parameters' should be a table, got number.")
+
+		error_func = function()
+			Batch{model = Sum, parameters = {a = Choice{min = 1, max = 5}}}
+		end
+		unitTest:assertError(error_func, "Choice 'a' should have a vector of values or arguments 'max' and 'step' to be used in a Batch.")
+
+		error_func = function()
+			Batch{model = Sum, worker = 2}
+		end
+		unitTest:assertError(error_func, unnecessaryArgumentMsg("worker", "workers"))
+	end
+}
@@ -59,6 +59,39 @@ return{
 
 		unitTest:assertError(error_func, incompatibleTypeMsg("xdim", "number", "terralab"))
 
+		error_func = function()
+			CellularSpace{
+				xdim = 5,
+				columnar = 1
+			}
+		end
+
+		unitTest:assertError(error_func, incompatibleTypeMsg("columnar", "boolean", 1))
+
+		local cs = CellularSpace{
+			xdim = 5,
+			columnar = true,
+			instance = Cell{value = 1, forest = true}
+		}
+
+		error_func = function()
+			cs.cells[1].value = "high"
+		end
+
+		unitTest:assertError(error_func, "Attribute 'value' can only store number values.")
+
+		error_func = function()
+			cs.cells[1].forest = 0
+		end
+
+		unitTest:assertError(error_func, "Attribute 'forest' can only store boolean values.")
+
+		error_func = function()
+			cs.cells[1].value = nil
+		end
+
+		unitTest:assertError(error_func, "Attribute 'value' cannot be removed from a columnar CellularSpace.")
+
 		error_func = function()
 			CellularSpace{
 				xdim = 1.23,
@@ -716,6 +749,27 @@ return{
 
 		unitTest:assertError(error_func, positiveArgumentMsg(1, -1, true))
 	end,
+	restore = function(unitTest)
+		local cs = CellularSpace{xdim = 5}
+
+		local error_func = function()
+			cs:restore()
+		end
+		unitTest:assertError(error_func, mandatoryArgumentMsg(1))
+
+		error_func = function()
+			cs:restore(CellularSpace{xdim = 5}:snapshot())
+		end
+		unitTest:assertError(error_func, "The snapshot does not belong to the CellularSpace.")
+
+		local snapshot = cs:snapshot()
+		cs:add(Cell{x = 6, y = 6})
+
+		error_func = function()
+			cs:restore(snapshot)
+		end
+		unitTest:assertError(error_func, "The CellularSpace has 26 Cells, but the snapshot has 25.")
+	end,
 	save = function(unitTest)
 		local cs = CellularSpace{xdim = 10}
 		local saveNoProjectLoaded = function()
@@ -724,6 +778,27 @@ return{
 
 		unitTest:assertError(saveNoProjectLoaded, "CellularSpace should be created from a project or directory to allow saving it.")
 	end,
+	saveNeighborhood = function(unitTest)
+		local cs = CellularSpace{xdim = 10}
+
+		local error_func = function()
+			cs:saveNeighborhood{file = "moore.gpmb"}
+		end
+
+		unitTest:assertError(error_func, "Neighborhood '1' does not exist.")
+
+		error_func = function()
+			cs:saveNeighborhood{file = "moore.gpm"}
+		end
+
+		unitTest:assertError(error_func, invalidFileExtensionMsg("file", "gpm"))
+
+		error_func = function()
+			cs:saveNeighborhood{file = "moore.gpmb", value = 2}
+		end
+
+		unitTest:assertError(error_func, unnecessaryArgumentMsg("value"))
+	end,
 	split = function(unitTest)
 		local cs = CellularSpace{xdim = 10}
 
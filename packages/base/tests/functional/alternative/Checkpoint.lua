@@ -0,0 +1,116 @@
+-------------------------------------------------------------------------------------------
+-- TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+-- Copyright (C) 2001-2014 INPE and TerraLAB/UFOP.
+--
+-- This code is part of the TerraME framework.
+-- This framework is free software; you can redistribute it and/or
+-- modify it under the terms of the GNU Lesser General Public
+-- License as published by the Free Software Foundation; either
+-- version 2.1 of the License, or (at your option) any later version.
+--
+-- You should have received a copy of the GNU Lesser General Public
+-- License along with this library.
+--
+-- The authors reassure the license terms regarding the warranties.
+-- They specifically disclaim any warranties, including, but not limited to,
+-- the implied warranties of merchantability and fitness for a particular purpose.
+-- The framework provided hereunder is on an "as is" basis, and the authors have no
+-- obligation to provide maintenance, support, updates, enhancements, or modifications.
+-- In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+-- indirect, special, incidental, or consequential damages arising out of the use
+-- of this library and its documentation.
+--
+-- Authors: Tiago Garcia de Senna Carneiro (tiago@dpi.inpe.br)
+--          Pedro R. Andrade (pedro.andrade@inpe.br)
+
+return{
+	Checkpoint = function(unitTest)
+		local error_func = function()
+			Checkpoint()
+		end
+		unitTest:assertError(error_func, tableArgumentMsg())
+
+		error_func = function()
+			Checkpoint{}
+		end
+		unitTest:assertError(error_func, mandatoryArgumentMsg("target"))
+
+		error_func = function()
+			Checkpoint{target = Random{}}
+		end
+		unitTest:assertError(error_func, incompatibleTypeMsg("target", "Model instance, Environment, CellularSpace, Society, Agent, Cell, or Timer", Random{}))
+
+		error_func = function()
+			Checkpoint{target = Cell{}}
+		end
+		unitTest:assertError(error_func, mandatoryArgumentMsg("file"))
+
+		error_func = function()
+			Checkpoint{target = Cell{}, file = 2}
+		end
+		unitTest:assertError(error_func, incompatibleTypeMsg("file", "File", 2))
+
+		error_func = function()
+			Checkpoint{target = Cell{}, file = "checkpoint.tmc", value = 2}
+		end
+		unitTest:assertError(error_func, unnecessaryArgumentMsg("value"))
+	end,
+	load = function(unitTest)
+		local file = File("checkpoint.tmc")
+		local checkpoint = Checkpoint{target = Cell{}, file = file}
+
+		local error_func = function()
+			checkpoint:load()
+		end
+		unitTest:assertError(error_func, resourceNotFoundMsg("file", file))
+
+		file:writeLine("checkpoint")
+		file:close()
+
+		error_func = function()
+			checkpoint:load()
+		end
+		unitTest:assertError(error_func, "File '"..file.."' is not a checkpoint file.")
+
+		checkpoint = Checkpoint{target = Timer{}, file = file}
+		checkpoint:save()
+
+		checkpoint = Checkpoint{target = Cell{}, file = file}
+		error_func = function()
+			checkpoint:load()
+		end
+		unitTest:assertError(error_func, "'target' should be a Timer, got Cell.")
+
+		local cs = CellularSpace{xdim = 2}
+		checkpoint = Checkpoint{target = cs, file = file}
+		checkpoint:save()
+
+		checkpoint = Checkpoint{target = CellularSpace{xdim = 3}, file = file}
+		error_func = function()
+			checkpoint:load()
+		end
+		unitTest:assertError(error_func, "CellularSpace 'target' has 9 Cells, but the checkpoint has 4.")
+
+		file:delete()
+	end,
+	save = function(unitTest)
+		local file = File("checkpoint.tmc")
+		local timer = Timer{}
+		local checkpoint = Checkpoint{target = timer, file = file}
+
+		timer:add(Event{action = function() end})
+
+		local error_func = function()
+			checkpoint:save()
+		end
+		unitTest:assertError(error_func, "The Timer has an Event added after the Checkpoint was created.")
+
+		checkpoint = Checkpoint{target = Cell{}, file = file}
+		Random{distrib = "normal"}:sample()
+
+		error_func = function()
+			checkpoint:save()
+		end
+		unitTest:assertError(error_func, "Checkpoint cannot be saved because 1 values were drawn from Random objects with distributions.")
+	end
+}
@@ -86,6 +86,36 @@ return{
 
 		unitTest:assertError(error_func, "File '"..file.."' does not exist.")
 	end,
+	chunks = function(unitTest)
+		local file = filePath("agents.csv", "base")
+
+		local error_func = function()
+			file:chunks(2)
+		end
+
+		unitTest:assertError(error_func, incompatibleTypeMsg(1, "string", 2))
+
+		error_func = function()
+			file:chunks(",", 0)
+		end
+
+		unitTest:assertError(error_func, positiveArgumentMsg(2, 0))
+
+		error_func = function()
+			file:chunks(",", 1.5)
+		end
+
+		unitTest:assertError(error_func, integerArgumentMsg(2, 1.5))
+
+		file = File("abc.txt")
+		file:deleteIfExists()
+
+		error_func = function()
+			file:chunks()
+		end
+
+		unitTest:assertError(error_func, "File '"..file.."' does not exist.")
+	end,
 	copy = function(unitTest)
 		local file = File("123")
 
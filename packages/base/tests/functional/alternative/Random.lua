@@ -169,6 +169,25 @@ return{
 		end
 
 		unitTest:assertError(error_func, "Argument 'seed' cannot be zero.")
+	end,
+	setState = function(unitTest)
+		local random = Random{}
+		local error_func = function()
+			random:setState()
+		end
+
+		unitTest:assertError(error_func, mandatoryArgumentMsg(1))
+
+		error_func = function()
+			random:setState{seed = 1, draws = 1}
+		end
+
+		unitTest:assertError(error_func, mandatoryArgumentMsg("uniforms"))
+
+		error_func = function()
+			random:setState{seed = 1, draws = 1, uniforms = 0, samples = 2}
+		end
+
+		unitTest:assertError(error_func, "The state cannot be restored because 2 values were drawn from Random objects with distributions.")
 	end
 }
-
@@ -393,6 +393,12 @@ return{
 
 		unitTest:assertError(error_func, positiveArgumentMsg("quantity", 0))
 
+		error_func = function()
+			sc1:createSocialNetwork{strategy = "erdos", quantity = 191}
+		end
+
+		unitTest:assertError(error_func, "Argument 'quantity' should be less than or equal to the number of pairs of Agents (190).")
+
 		error_func = function()
 			sc1:createSocialNetwork{strategy = "erdos", quantity = 5, inmemory = true}
 		end
@@ -128,6 +128,70 @@ return{
 		end
 
 		unitTest:assertError(error_func, incompatibleTypeMsg(2, "function"))
+
+		local cs = CellularSpace{xdim = 5}
+
+		error_func = function()
+			forEachCell(cs, function() end, 2)
+		end
+
+		unitTest:assertError(error_func, incompatibleTypeMsg(3, "table", 2))
+
+		error_func = function()
+			forEachCell(Trajectory{target = cs}, function() end, {})
+		end
+
+		unitTest:assertError(error_func, "Parallel traversal can only be used with a CellularSpace, got Trajectory.")
+
+		error_func = function()
+			forEachCell(cs, function() end, {})
+		end
+
+		unitTest:assertError(error_func, "Parallel traversal requires a CellularSpace created with 'columnar = true'.")
+
+		cs = CellularSpace{xdim = 5, columnar = true, instance = Cell{value = 1}}
+
+		error_func = function()
+			forEachCell(cs, function() end, {thread = 2})
+		end
+
+		unitTest:assertError(error_func, unnecessaryArgumentMsg("thread", "threads"))
+
+		error_func = function()
+			forEachCell(cs, function() end, {threads = -1})
+		end
+
+		unitTest:assertError(error_func, positiveArgumentMsg("threads", -1, true))
+
+		error_func = function()
+			forEachCell(cs, function() end, {outputs = {"water"}})
+		end
+
+		unitTest:assertError(error_func, "Attribute 'water' is not stored in the columns of the CellularSpace and cannot be updated in parallel.")
+
+		error_func = function()
+			forEachCell(cs, function(cell) unitTest:assert(cell) end, {})
+		end
+
+		unitTest:assertError(error_func, "Variable 'unitTest' (UnitTest) cannot be used in a parallel traversal. Only numbers, strings, and booleans declared outside the function can be used.")
+
+		error_func = function()
+			forEachCell(cs, function(cell) cell.value = 2 end, {})
+		end
+
+		unitTest:assertError(error_func, "Attribute 'value' cannot be updated because it does not belong to argument 'outputs'.")
+
+		error_func = function()
+			forEachCell(cs, function(cell) cell.value = "abc" end, {outputs = {"value"}})
+		end
+
+		unitTest:assertError(error_func, "Attribute 'value' should be number, got string.")
+
+		error_func = function()
+			forEachCell(cs, function(cell) forEachNeighbor(cell, function() end) end, {})
+		end
+
+		unitTest:assertError(error_func, "The CellularSpace does not have a default neighborhood. Please call 'CellularSpace:createNeighborhood' first.")
 	end,
 	forEachCellPair = function(unitTest)
 		local cs1 = CellularSpace{xdim = 10}
@@ -0,0 +1,101 @@
+-------------------------------------------------------------------------------------------
+-- TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+-- Copyright (C) 2001-2014 INPE and TerraLAB/UFOP.
+--
+-- This code is part of the TerraME framework.
+-- This framework is free software; you can redistribute it and/or
+-- modify it under the terms of the GNU Lesser General Public
+-- License as published by the Free Software Foundation; either
+-- version 2.1 of the License, or (at your option) any later version.
+--
+-- You should have received a copy of the GNU Lesser General Public
+-- License along with this library.
+--
+-- The authors reassure the license terms regarding the warranties.
+-- They specifically disclaim any warranties, including, but not limited to,
+-- the implied warranties of merchantability and fitness for a particular purpose.
+-- The framework provided hereunder is on an "as is" basis, and the authors have no
+-- obligation to provide maintenance, support, updates, enhancements, or modifications.
+-- In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+-- indirect, special, incidental, or consequential damages arising out of the use
+-- of this library and its documentation.
+--
+-- Authors: Tiago Garcia de Senna Carneiro (tiago@dpi.inpe.br)
+--          Pedro R. Andrade (pedro.andrade@inpe.br)
+
+local Sum = Model{
+	a = 1,
+	b = Choice{1, 2, 3},
+	finalTime = 2,
+	init = function(model)
+		if model.a < 0 then
+			customError("Argument 'a' should be positive.")
+		end
+
+		model.value = 0
+		model.timer = Timer{Event{action = function()
+			model.value = model.value + model.a * model.b
+		end}}
+	end
+}
+
+return{
+	Batch = function(unitTest)
+		local batch = Batch{
+			model = Sum,
+			parameters = {a = {1, 2}, b = Choice{1, 2, 3}},
+			workers = 2,
+			output = {"value"}
+		}
+
+		unitTest:assertType(batch, "Batch")
+		unitTest:assertType(batch.output, "DataFrame")
+		unitTest:assertEquals(#batch.output, 6)
+		unitTest:assertEquals(batch.failures, 0)
+		unitTest:assertEquals(batch.output.a[1], 1)
+		unitTest:assertEquals(batch.output.b[1], 1)
+		unitTest:assertEquals(batch.output.value[1], 2)
+		unitTest:assertEquals(batch.output.a[4], 2)
+		unitTest:assertEquals(batch.output.b[4], 1)
+		unitTest:assertEquals(batch.output.value[4], 4)
+		unitTest:assertEquals(batch.output.value[6], 12)
+		unitTest:assertEquals(batch.output.error[6], "")
+
+		batch = Batch{
+			model = Sum,
+			parameters = {{a = 1, b = 2}, {a = 3, b = 1}},
+			repetition = 2,
+			output = function(model)
+				return {double = model.value * 2}
+			end
+		}
+
+		unitTest:assertEquals(#batch.output, 4)
+		unitTest:assertEquals(batch.output.repetition[1], 1)
+		unitTest:assertEquals(batch.output.repetition[2], 2)
+		unitTest:assertEquals(batch.output.double[2], 8)
+		unitTest:assertEquals(batch.output.double[3], 12)
+		unitTest:assert(batch.output.seed[1] ~= batch.output.seed[2])
+
+		batch = Batch{
+			model = Sum,
+			parameters = {a = Choice{min = 1, max = 2, step = 0.5}}
+		}
+
+		unitTest:assertEquals(#batch.output, 3)
+		unitTest:assertEquals(batch.output.a[2], 1.5)
+		unitTest:assertEquals(batch.output.value[2], 3)
+		unitTest:assertEquals(batch.output.finalTime[3], 2)
+
+		batch = Batch{
+			model = Sum,
+			parameters = {a = {-1, 1}},
+			output = "value"
+		}
+
+		unitTest:assertEquals(batch.failures, 1)
+		unitTest:assert(string.find(batch.output.error[1], "Argument 'a' should be positive.") ~= nil)
+		unitTest:assertEquals(batch.output.error[2], "")
+		unitTest:assertEquals(batch.output.value[2], 2)
+	end
+}
@@ -477,7 +477,60 @@ return{
 			proj.file:delete()
 		end
 
+		local columnarTests = function()
+			local cs = CellularSpace{
+				xdim = 10,
+				columnar = true,
+				instance = Cell{
+					value = 1,
+					cover = "forest",
+					forest = true,
+					init = function(cell)
+						cell.height = cell.x * 0.5
+					end
+				}
+			}
+
+			local cell = cs:get(2, 3)
+
+			unitTest:assertNil(rawget(cell, "value"))
+			unitTest:assertNil(rawget(cell, "forest"))
+			unitTest:assertNil(rawget(cell, "height"))
+			unitTest:assertEquals(rawget(cell, "cover"), "forest")
+			unitTest:assertEquals(cell.value, 1)
+			unitTest:assertEquals(math.type(cell.value), "integer")
+			unitTest:assertEquals(cell.height, 1)
+			unitTest:assert(cell.forest)
+
+			cell.value = 2.5
+			cell.forest = false
+			cell.owner = "john"
+
+			unitTest:assertEquals(cell.value, 2.5)
+			unitTest:assert(not cell.forest)
+			unitTest:assertEquals(rawget(cell, "owner"), "john")
+			unitTest:assertEquals(cs:value(), 101.5)
+			unitTest:assertEquals(cs:forest(), 99)
+
+			local attributes = {}
+			forEachElement(cell, function(idx, value)
+				attributes[idx] = value
+			end)
+
+			unitTest:assertEquals(attributes.value, 2.5)
+			unitTest:assertEquals(attributes.height, 1)
+			unitTest:assertEquals(attributes.cover, "forest")
+
+			local c = Cell{x = 20, y = 20, value = 7, forest = true, height = 3}
+			cs:add(c)
+
+			unitTest:assertNil(rawget(c, "value"))
+			unitTest:assertEquals(c.value, 7)
+			unitTest:assertEquals(cs:value(), 108.5)
+		end
+
 		unitTest:assert(basicTests)
+		unitTest:assert(columnarTests)
 		unitTest:assert(shapeFileTests)
 		if _Gtme.sessionInfo().system == "windows" then
 			unitTest:assert(tifTests) -- SKIP
@@ -1455,6 +1508,74 @@ ydim    number [20]
 			m = 5,
 			name = "3"
 		}
+
+		local cell = cs:get(0, 0)
+		local count = 0
+		forEachNeighbor(cell, function(_, weight)
+			unitTest:assertEquals(weight, 0.25)
+			count = count + 1
+		end)
+
+		unitTest:assertEquals(count, 2)
+		unitTest:assertEquals(#cell:getNeighborhood("2"), 3)
+		unitTest:assertEquals(cell:getNeighborhood("2"):getWeight(cs:get(1, 1)), 1 / 8)
+		unitTest:assertEquals(#cell:getNeighborhood("3"), 4)
+		unitTest:assert(cell:getNeighborhood("3"):isNeighbor(cell))
+
+		-- stencils
+		cs = CellularSpace{xdim = 10}
+		cs:createNeighborhood()
+
+		cell = cs:get(5, 5)
+		unitTest:assertType(cell.neighborhoods["1"], "SharedNeighborhood")
+		unitTest:assertEquals(cell.neighborhoods["1"], cs:get(0, 0).neighborhoods["1"])
+
+		count = 0
+		forEachNeighbor(cell, function(neighbor, weight, center)
+			unitTest:assertEquals(center, cell)
+			unitTest:assertEquals(weight, 1 / 8)
+			unitTest:assert(math.abs(neighbor.x - cell.x) <= 1)
+			unitTest:assert(math.abs(neighbor.y - cell.y) <= 1)
+
+			forEachNeighbor(neighbor, function(nneighbor)
+				unitTest:assert(math.abs(nneighbor.x - cell.x) <= 2)
+				count = count + 1
+			end)
+		end)
+
+		unitTest:assertEquals(count, 8 * 8)
+
+		count = 0
+		forEachNeighbor(cell, function()
+			count = count + 1
+			return count < 3
+		end)
+
+		unitTest:assertEquals(count, 3)
+
+		local neighborhood = cell:getNeighborhood()
+		unitTest:assertType(neighborhood, "Neighborhood")
+		unitTest:assertType(cell.neighborhoods["1"], "Neighborhood")
+		unitTest:assertEquals(#neighborhood, 8)
+		unitTest:assertEquals(cell:getNeighborhood(), neighborhood)
+
+		neighborhood:remove(cs:get(4, 4))
+		count = 0
+		forEachNeighbor(cell, function()
+			count = count + 1
+		end)
+
+		unitTest:assertEquals(count, 7)
+		unitTest:assertEquals(#cs:get(4, 4):getNeighborhood(), 8)
+
+		cs:createNeighborhood{strategy = "mxn", m = 5, n = 3, name = "mxn"}
+		unitTest:assertType(cell.neighborhoods["mxn"], "SharedNeighborhood")
+		unitTest:assertEquals(#cell:getNeighborhood("mxn"), 15)
+		unitTest:assertEquals(cell:getNeighborhood("mxn"):getWeight(cs:get(7, 6)), 1)
+		unitTest:assertEquals(#cs:get(0, 0):getNeighborhood("mxn"), 6)
+
+		cs:createNeighborhood{strategy = "mxn", m = 5, name = "filter", filter = function() return true end}
+		unitTest:assertType(cell.neighborhoods["filter"], "Neighborhood")
 	end,
 	cut = function(unitTest)
 		local cs = CellularSpace{xdim = 10}
@@ -1500,6 +1621,15 @@ ydim    number [20]
 		unitTest:assertWarning(warningFunc, "As #1 is string, #2 should be nil, but got number.")
 		unitTest:assertEquals(c.x, 0)
 		unitTest:assertEquals(c.y, 3)
+
+		c:setId("newid")
+		unitTest:assertEquals(cs:get("newid"), c)
+		unitTest:assertNil(cs:get("4"))
+
+		c = Cell{id = "added", x = 10, y = 10}
+		cs:add(c)
+		unitTest:assertEquals(cs:get("added"), c)
+		unitTest:assertNil(cs:get("missing"))
 	end,
 	load = function(unitTest)
 		local cs = CellularSpace{xdim = 5}
@@ -1512,6 +1642,83 @@ ydim    number [20]
 
 		unitTest:assertNil(cs:sample().w)
 	end,
+	restore = function(unitTest)
+		local cs = CellularSpace{xdim = 5, value = 1, cover = "forest"}
+		local cell = cs:get(2, 2)
+		local neigh = Neighborhood()
+
+		neigh:add(cs:get(1, 1))
+		neigh:add(cs:get(3, 3), 0.5)
+		cell:addNeighborhood(neigh)
+
+		local snapshot = cs:snapshot()
+
+		forEachCell(cs, function(c)
+			c.value = c.value + 1
+			c.cover = "pasture"
+			c.extra = true
+		end)
+
+		cs:synchronize()
+		neigh:clear()
+		cell:addNeighborhood(Neighborhood(), "other")
+
+		cs:restore(snapshot)
+
+		unitTest:assertEquals(cell.value, 1)
+		unitTest:assertEquals(cell.cover, "forest")
+		unitTest:assertNil(cell.extra)
+		unitTest:assertNil(cell.past.value)
+		unitTest:assertEquals(#cell:getNeighborhood(), 2)
+		unitTest:assertEquals(cell:getNeighborhood():getWeight(cs:get(3, 3)), 0.5)
+		unitTest:assertNil(cell:getNeighborhood("other"))
+
+		cell.value = 5
+		cs:restore(snapshot)
+		unitTest:assertEquals(cell.value, 1)
+
+		cs = CellularSpace{xdim = 5, value = 1, forest = true, columnar = true}
+		cell = cs:get(1, 1)
+		cs:synchronize()
+		snapshot = cs:snapshot()
+
+		forEachCell(cs, function(c)
+			c.value = c.value + 0.5
+			c.forest = false
+		end)
+
+		cs:synchronize()
+		cs:restore(snapshot)
+
+		unitTest:assertEquals(cell.value, 1)
+		unitTest:assertEquals(cell.forest, true)
+		unitTest:assertEquals(cell.past.value, 1)
+
+		local agent = Agent{}
+		local soc = Society{instance = agent, quantity = 5}
+		cs = CellularSpace{xdim = 5}
+
+		local env = Environment{cs, soc}
+		env:createPlacement{strategy = "uniform"}
+
+		snapshot = cs:snapshot()
+
+		local first = soc.agents[1]
+		local firstCell = first:getCell()
+
+		forEachAgent(soc, function(ag)
+			ag:move(cs:get(4, 4))
+		end)
+
+		unitTest:assertEquals(#cs:get(4, 4):getAgents(), 5)
+
+		cs:restore(snapshot)
+
+		unitTest:assertEquals(first:getCell(), firstCell)
+		unitTest:assertEquals(#firstCell:getAgents(), 1)
+		unitTest:assertEquals(#cs:get(4, 4):getAgents(), 0)
+		unitTest:assertEquals(firstCell.agents, firstCell.placement.agents)
+	end,
 	sample = function(unitTest)
 		local cs = CellularSpace{xdim = 3}
 
@@ -1657,6 +1864,46 @@ ydim    number [20]
 		File(fn3):deleteIfExists()
 		File(fn4):deleteIfExists()
 	end,
+	saveNeighborhood = function(unitTest)
+		local cs = CellularSpace{xdim = 10}
+		local file = File("cellspace_moore.gpmb")
+
+		cs:createNeighborhood{strategy = "vonneumann", self = true}
+		cs:saveNeighborhood{file = file}
+		cs:loadNeighborhood{file = file, name = "loaded"}
+
+		forEachCell(cs, function(cell)
+			local neigh = cell:getNeighborhood()
+			local loaded = cell:getNeighborhood("loaded")
+
+			unitTest:assertEquals(#loaded, #neigh)
+
+			forEachNeighbor(cell, function(neighbor, weight)
+				unitTest:assertEquals(loaded:getWeight(neighbor), weight)
+			end)
+		end)
+
+		cs:saveNeighborhood{file = file, name = "loaded"}
+		cs:loadNeighborhood{file = file, name = "reloaded"}
+
+		unitTest:assertEquals(#cs:get(0, 0):getNeighborhood("reloaded"), 3)
+		unitTest:assertEquals(#cs:get(5, 5):getNeighborhood("reloaded"), 5)
+
+		file:delete()
+	end,
+	snapshot = function(unitTest)
+		local cs = CellularSpace{xdim = 3, value = 2, columnar = true}
+		local snapshot = cs:snapshot()
+
+		unitTest:assertType(snapshot, "table")
+		unitTest:assertEquals(#snapshot.cells, 9)
+		unitTest:assertNil(snapshot.cells[1].value)
+
+		cs = CellularSpace{xdim = 3, value = 2}
+		snapshot = cs:snapshot()
+
+		unitTest:assertEquals(snapshot.cells[1].value, 2)
+	end,
 	split = function(unitTest)
 		local cs = CellularSpace{xdim = 3}
 
@@ -1753,6 +2000,44 @@ ydim    number [20]
 
 		forEachCell(cs, function(cell) unitTest:assertEquals(3, cell.past.value) end)
 		forEachCell(cs, function(cell) unitTest:assertEquals(0, cell.value) end)
+
+		cs = CellularSpace{
+			xdim = 3,
+			columnar = true,
+			instance = Cell{
+				value = 3,
+				forest = true,
+				cover = "forest",
+				on_synchronize = function(self)
+					self.value = self.value - 1
+				end
+			}
+		}
+
+		local past = cs.cells[1].past
+		cs:synchronize()
+
+		unitTest:assertEquals(cs.cells[1].past, past)
+		forEachCell(cs, function(cell) unitTest:assertEquals(3, cell.past.value) end)
+		forEachCell(cs, function(cell) unitTest:assertEquals(2, cell.value) end)
+		forEachCell(cs, function(cell) unitTest:assert(cell.past.forest) end)
+		forEachCell(cs, function(cell) unitTest:assertEquals("forest", cell.past.cover) end)
+
+		cs.cells[1].forest = false
+		cs:synchronize("forest")
+
+		unitTest:assert(not cs.cells[1].past.forest)
+		unitTest:assert(cs.cells[2].past.forest)
+		unitTest:assertNil(cs.cells[1].past.value)
+		unitTest:assertNil(cs.cells[1].past.cover)
+		unitTest:assertEquals(cs.cells[1].value, 1)
+
+		local count = 0
+		forEachElement(cs.cells[1].past, function()
+			count = count + 1
+		end)
+
+		unitTest:assertEquals(count, 1)
 	end
 }
 
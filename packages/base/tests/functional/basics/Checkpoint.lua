@@ -0,0 +1,139 @@
+-------------------------------------------------------------------------------------------
+-- TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+-- Copyright (C) 2001-2014 INPE and TerraLAB/UFOP.
+--
+-- This code is part of the TerraME framework.
+-- This framework is free software; you can redistribute it and/or
+-- modify it under the terms of the GNU Lesser General Public
+-- License as published by the Free Software Foundation; either
+-- version 2.1 of the License, or (at your option) any later version.
+--
+-- You should have received a copy of the GNU Lesser General Public
+-- License along with this library.
+--
+-- The authors reassure the license terms regarding the warranties.
+-- They specifically disclaim any warranties, including, but not limited to,
+-- the implied warranties of merchantability and fitness for a particular purpose.
+-- The framework provided hereunder is on an "as is" basis, and the authors have no
+-- obligation to provide maintenance, support, updates, enhancements, or modifications.
+-- In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+-- indirect, special, incidental, or consequential damages arising out of the use
+-- of this library and its documentation.
+--
+-- Authors: Tiago Garcia de Senna Carneiro (tiago@dpi.inpe.br)
+--          Pedro R. Andrade (pedro.andrade@inpe.br)
+
+local Walkers = Model{
+	finalTime = 10,
+	init = function(model)
+		model.cs = CellularSpace{xdim = 5}
+		model.agent = Agent{}
+		model.soc = Society{instance = model.agent, quantity = 5}
+		model.env = Environment{model.cs, model.soc}
+		model.env:createPlacement()
+		model.total = 0
+
+		model.timer = Timer{
+			Event{action = function()
+				forEachCell(model.cs, function(cell)
+					cell.value = (cell.value or 0) + Random():integer(10)
+				end)
+			end},
+			Event{period = 2, action = function()
+				forEachAgent(model.soc, function(agent)
+					agent:move(model.cs:sample())
+				end)
+
+				model.total = model.total + Random():number()
+			end}
+		}
+	end
+}
+
+local function getCells(model)
+	local result = {}
+
+	forEachAgent(model.soc, function(agent)
+		table.insert(result, agent:getCell().id)
+	end)
+
+	return table.concat(result, ",")
+end
+
+return{
+	Checkpoint = function(unitTest)
+		local instance = Walkers{}
+		local checkpoint = Checkpoint{target = instance, file = "checkpoint.tmc"}
+
+		unitTest:assertType(checkpoint, "Checkpoint")
+		unitTest:assertType(checkpoint.file, "File")
+		unitTest:assertEquals(checkpoint.target, instance)
+	end,
+	load = function(unitTest)
+		local file = File("checkpoint.tmc")
+
+		Random{seed = 12345}
+		local instance = Walkers{}
+		local checkpoint = Checkpoint{target = instance, file = file}
+
+		instance.timer:run(5)
+		checkpoint:save()
+		instance.timer:run(10)
+
+		local other = Walkers{}
+		checkpoint = Checkpoint{target = other, file = file}
+		checkpoint:load()
+
+		unitTest:assertEquals(other.timer:getTime(), 5)
+		unitTest:assertEquals(#other.timer, 2)
+
+		other.timer:run(10)
+
+		unitTest:assertEquals(other.total, instance.total)
+		unitTest:assertEquals(other.cs.cells[7].value, instance.cs.cells[7].value)
+		unitTest:assertEquals(other.cs.cells[25].value, instance.cs.cells[25].value)
+		unitTest:assertEquals(getCells(other), getCells(instance))
+		unitTest:assertEquals(#other.soc.agents[1]:getCell():getAgents(), #instance.soc.agents[1]:getCell():getAgents())
+
+		file:delete()
+	end,
+	save = function(unitTest)
+		local file = File("checkpoint.tmc")
+		local cell = Cell{value = 2, name = "cell"}
+		local checkpoint = Checkpoint{target = cell, file = file}
+
+		checkpoint:save()
+		unitTest:assert(file:exists())
+
+		cell.value = 5
+		cell.other = true
+		checkpoint:save()
+
+		cell.value = 3
+		cell.other = nil
+		checkpoint:load()
+
+		unitTest:assertEquals(cell.value, 5)
+		unitTest:assertEquals(cell.name, "cell")
+		unitTest:assert(cell.other)
+
+		local timer
+		timer = Timer{Event{action = function(event)
+			if event:getTime() == 3 then
+				checkpoint:save()
+			end
+		end}}
+
+		checkpoint = Checkpoint{target = timer, file = file}
+		timer:run(5)
+
+		timer = Timer{Event{action = function() end}}
+		checkpoint = Checkpoint{target = timer, file = file}
+		checkpoint:load()
+
+		unitTest:assertEquals(timer:getTime(), 3)
+		unitTest:assertEquals(timer:getEvents()[1]:getTime(), 4)
+
+		file:delete()
+	end
+}
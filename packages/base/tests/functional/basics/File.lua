@@ -71,6 +71,32 @@ return{
 
 		unitTest:assertType(result, "File")
 	end,
+	chunks = function(unitTest)
+		local file = filePath("agents.csv", "base")
+		local sizes = {}
+		local ages = {}
+
+		for csv in file:chunks(",", 3) do
+			unitTest:assertType(csv, "DataFrame")
+			table.insert(sizes, #csv)
+			table.insert(ages, csv[1].age)
+		end
+
+		unitTest:assertEquals(#sizes, 2)
+		unitTest:assertEquals(sizes[1], 3)
+		unitTest:assertEquals(sizes[2], 1)
+		unitTest:assertEquals(ages[1], 20)
+
+		local s = sessionInfo().separator
+		file = filePath("test/error"..s.."csv-error.csv")
+
+		local warning_func = function()
+			for csv in file:chunks() do
+				unitTest:assertEquals(3, #csv)
+			end
+		end
+		unitTest:assertWarning(warning_func, "Line 3 ('\"mary\",18,100,3,1') should contain 6 attributes but has 5.")
+	end,
 	copy = function(unitTest)
 		local dir = Directory("abcd123efg")
 		dir:create()
@@ -365,6 +365,24 @@ sample   function
 		self:assertEquals(randomObj:integer(33, 45), 36)
 		self:assertEquals(randomObj:integer(33, 45), 43)
 	end,
+	getState = function(unitTest)
+		local random = Random{seed = 54321}
+		local state = random:getState()
+
+		unitTest:assertEquals(state.seed, 54321)
+		unitTest:assertEquals(state.draws, 1)
+		unitTest:assertEquals(state.uniforms, 0)
+
+		random:number()
+		random:integer(10)
+
+		state = random:getState()
+		unitTest:assertEquals(state.uniforms, 2)
+		unitTest:assertEquals(state.samples, 0)
+
+		Random{p = 0.5}:sample()
+		unitTest:assertEquals(random:getState().samples, 1)
+	end,
 	sample = function(unitTest)
 		local bern = Random{p = 0.3}
 		local counter = 0
@@ -563,6 +581,25 @@ sample   function
 		end
 
 		unitTest:assertEquals(sum / 5000, 0.496, 0.001)
+	end,
+	setState = function(unitTest)
+		local random = Random{seed = 54321}
+		random:number()
+
+		local state = random:getState()
+		local values = {}
+
+		for i = 1, 5 do
+			values[i] = random:number()
+		end
+
+		Random{seed = 12345}:integer(5)
+		random:setState(state)
+
+		unitTest:assertEquals(random:getState().uniforms, 1)
+
+		for i = 1, 5 do
+			unitTest:assertEquals(random:number(), values[i], 0)
+		end
 	end
 }
-
@@ -24,6 +24,33 @@
 --          Rodrigo Reis Pereira
 -------------------------------------------------------------------------------------------
 
+-- returns the number of connections expected from the placement of the agents of a
+-- Society: with the agents in the same cell and with the agents in the neighbor cells
+local function placementConnections(society)
+	local cell = 0
+	local neighbor = 0
+
+	forEachAgent(society, function(ag)
+		cell = cell + #ag:getCell():getAgents() - 1
+
+		forEachNeighbor(ag:getCell(), function(neigh)
+			neighbor = neighbor + #neigh:getAgents()
+		end)
+	end)
+
+	return cell, neighbor
+end
+
+local function countConnections(society, name)
+	local count = 0
+
+	forEachAgent(society, function(ag)
+		count = count + #ag:getSocialNetwork(name)
+	end)
+
+	return count
+end
+
 return {
 	Society = function(unitTest)
 		local singleFooAgent = Agent{}
@@ -474,10 +501,27 @@ state_          State
 			count_all   = count_all   + #ag:getSocialNetwork("all")
 		end)
 
-		unitTest:assertEquals(194, count_prob)
+		unitTest:assert(count_prob > 0)
 		unitTest:assertEquals(20,  count_quant)
 		unitTest:assertEquals(400, count_all)
 
+		-- the networks drawn after the same seed are the same
+		Random{seed = 12345}
+		predators:createSocialNetwork{probability = 0.5, name = "friends2"}
+		Random{seed = 12345}
+		predators:createSocialNetwork{probability = 0.5, name = "friends3"}
+
+		forEachAgent(predators, function(ag)
+			local friends2 = ag:getSocialNetwork("friends2")
+			local friends3 = ag:getSocialNetwork("friends3")
+
+			unitTest:assertEquals(#friends2, #friends3)
+
+			forEachConnection(ag, "friends2", function(friend)
+				unitTest:assert(friends3:isConnection(friend))
+			end)
+		end)
+
 		local cs = CellularSpace{xdim = 5}
 		cs:createNeighborhood()
 		cs:createNeighborhood{name = "2"}
@@ -508,9 +552,11 @@ state_          State
 			count_n2 = count_n2 + #ag:getSocialNetwork("n2")
 		end)
 
-		unitTest:assertEquals(80, count_c)
-		unitTest:assertEquals(50, count_n)
-		unitTest:assertEquals(50, count_n2)
+		local expected_c, expected_n = placementConnections(predators)
+
+		unitTest:assertEquals(expected_c, count_c)
+		unitTest:assertEquals(expected_n, count_n)
+		unitTest:assertEquals(expected_n, count_n2)
 
 		local ag1 = Agent{
 			name = "nonfoo",
@@ -580,23 +626,20 @@ state_          State
 			count_all   = count_all   + #ag:getSocialNetwork("all")
 		end)
 
-		unitTest:assertEquals(192, count_prob)
+		unitTest:assert(count_prob > 0)
 		unitTest:assertEquals(20,  count_quant)
 		unitTest:assertEquals(400, count_all)
 
-		count_prob = 0
-		count_quant = 0
-		count_all = 0
-
-		forEachAgent(predators, function(ag)
-			count_prob  = count_prob  + #ag:getSocialNetwork("friends")
-			count_quant = count_quant + #ag:getSocialNetwork("boss")
-			count_all   = count_all   + #ag:getSocialNetwork("all")
-		end)
+		-- the networks are drawn again each time, following the seed
+		Random{seed = 12345}
+		count_prob = countConnections(predators, "friends")
+		count_quant = countConnections(predators, "boss")
 
-		unitTest:assertEquals(192, count_prob)
-		unitTest:assertEquals(20,  count_quant)
-		unitTest:assertEquals(400, count_all)
+		Random{seed = 12345}
+		unitTest:assertEquals(count_prob, countConnections(predators, "friends"))
+		unitTest:assertEquals(count_quant, countConnections(predators, "boss"))
+		unitTest:assertEquals(20, count_quant)
+		unitTest:assertEquals(400, countConnections(predators, "all"))
 
 		cs = CellularSpace{xdim = 5}
 		cs:createNeighborhood()
@@ -614,8 +657,10 @@ state_          State
 			count_n  = count_n + #ag:getSocialNetwork("n")
 		end)
 
-		unitTest:assertEquals(60, count_c)
-		unitTest:assertEquals(64, count_n)
+		expected_c, expected_n = placementConnections(predators)
+
+		unitTest:assertEquals(expected_c, count_c)
+		unitTest:assertEquals(expected_n, count_n)
 
 		predators:sample():die()
 
@@ -626,8 +671,10 @@ state_          State
 			count_n  = count_n + #ag:getSocialNetwork("n")
 		end)
 
-		unitTest:assertEquals(54, count_c)
-		unitTest:assertEquals(56, count_n)
+		expected_c, expected_n = placementConnections(predators)
+
+		unitTest:assertEquals(expected_c, count_c)
+		unitTest:assertEquals(expected_n, count_n)
 
 		predator = Agent{
 			energy = 40,
@@ -650,8 +697,19 @@ state_          State
 			count_quant = count_quant + #ag:getSocialNetwork("boss")
 		end)
 
-		unitTest:assertEquals(28, count_prob)
-		unitTest:assertEquals(40, count_quant)
+		-- each connection has its reverse
+		unitTest:assertEquals(0, count_prob % 2)
+		unitTest:assert(count_quant >= 20 and count_quant <= 40)
+
+		forEachAgent(predators, function(ag)
+			forEachConnection(ag, "friends", function(friend)
+				unitTest:assert(friend:getSocialNetwork("friends"):isConnection(ag))
+			end)
+
+			forEachConnection(ag, "boss", function(boss)
+				unitTest:assert(boss:getSocialNetwork("boss"):isConnection(ag))
+			end)
+		end)
 
 		-- social networks that must be "in memory"
 		predator = Agent{
@@ -679,6 +737,8 @@ state_          State
 		end
 		unitTest:assertWarning(warning_func, unnecessaryArgumentMsg("abc"))
 
+		unitTest:assertType(predators.agents[1].socialnetworks.erdos, "SharedSocialNetwork")
+
 		local count_barabasi = 0
 		local count_erdos = 0
 		local count_watts = 0
@@ -692,6 +752,27 @@ state_          State
 		unitTest:assertEquals(40, count_barabasi)
 		unitTest:assertEquals(80,  count_erdos)
 		unitTest:assertEquals(80,  count_watts)
+
+		-- Agents that leave the Society are not connections anymore and new Agents have none
+		predators:createSocialNetwork{strategy = "erdos", quantity = 40, name = "erdos2"}
+
+		local dead = predators.agents[1]
+		dead:die()
+
+		local newcomer = predators:add()
+		local count_newcomer = 0
+
+		forEachConnection(newcomer, "erdos2", function()
+			count_newcomer = count_newcomer + 1
+		end)
+
+		unitTest:assertEquals(0, count_newcomer)
+
+		forEachAgent(predators, function(ag)
+			forEachConnection(ag, "erdos2", function(friend)
+				unitTest:assert(friend ~= dead)
+			end)
+		end)
 	end,
 	clear = function(unitTest)
 		local agent1 = Agent{}
@@ -129,6 +129,25 @@ return {
 		}
 
 		unitTest:assertEquals(#timer:getEvents(), 2)
+
+		local first = Event{start = 2, priority = 1, action = function() end}
+		local second = Event{start = 2, priority = 1, action = function() end}
+		local third = Event{start = 2, action = function() end}
+		local fourth = Event{start = 1, priority = 5, action = function() end}
+
+		timer = Timer{}
+		timer:add(first)
+		timer:add(second)
+		timer:add(third)
+		timer:add(fourth)
+
+		local events = timer:getEvents()
+
+		unitTest:assertEquals(events[1], fourth)
+		unitTest:assertEquals(events[2], third)
+		unitTest:assertEquals(events[3], first)
+		unitTest:assertEquals(events[4], second)
+		unitTest:assertEquals(timer.events[1], fourth)
 	end,
 	__len = function(unitTest)
 		local timer = Timer{
@@ -190,6 +209,34 @@ time    number [-inf]
 
 		unitTest:assertEquals(6, timer2:getTime())
 		unitTest:assertEquals(10, cont)
+
+		local order = {}
+		local timer3 = Timer{}
+
+		for i = 1, 1000 do
+			timer3:add(Event{start = 1000 - i, period = 1000, action = function()
+				table.insert(order, i)
+				return false
+			end})
+		end
+
+		for i = 1, 10 do
+			timer3:add(Event{start = 500, action = function()
+				table.insert(order, -i)
+				return false
+			end})
+		end
+
+		timer3:run(1000)
+
+		unitTest:assertEquals(#order, 1010)
+		unitTest:assertEquals(order[1], 1000)
+		unitTest:assertEquals(order[500], 501)
+		unitTest:assertEquals(order[501], 500)
+		unitTest:assertEquals(order[502], -1)
+		unitTest:assertEquals(order[511], -10)
+		unitTest:assertEquals(order[1010], 1)
+		unitTest:assertEquals(#timer3, 0)
 	end,
 	run = function(unitTest)
 		local qt1 = 0
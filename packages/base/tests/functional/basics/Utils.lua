@@ -276,6 +276,47 @@ return{
 		end)
 
 		unitTest:assertEquals(r, 40)
+
+		cs = CellularSpace{xdim = 10, columnar = true, instance = Cell{value = 1, alive = false}}
+		cs:createNeighborhood()
+
+		local factor = 3
+		r = forEachCell(cs, function(cell)
+			local sum = 0
+			forEachNeighbor(cell, function(neighbor, weight)
+				sum = sum + neighbor.value * weight
+			end)
+
+			cell.value = cell.x * factor + sum
+			cell.alive = cell.value > 10
+		end, {outputs = {"value", "alive"}, threads = 2})
+
+		unitTest:assert(r)
+		unitTest:assertEquals(cs:get(0, 0).value, 1)
+		unitTest:assertEquals(cs:get(4, 4).value, 13)
+		unitTest:assert(cs:get(4, 4).alive)
+		unitTest:assert(not cs:get(1, 1).alive)
+
+		Random{seed = 12345}
+		local first = {}
+		forEachCell(cs, function(cell) cell.value = math.random() end, {outputs = {"value"}, threads = 1})
+		forEachCell(cs, function(cell) first[#first + 1] = cell.value end)
+
+		Random{seed = 12345}
+		local second = {}
+		forEachCell(cs, function(cell) cell.value = math.random() end, {outputs = {"value"}, threads = 4})
+		forEachCell(cs, function(cell) second[#second + 1] = cell.value end)
+
+		unitTest:assertEquals(#first, 100)
+		for i = 1, #first do
+			unitTest:assertEquals(first[i], second[i])
+		end
+
+		r = forEachCell(cs, function(cell)
+			if cell.x > 5 then return false end
+		end, {})
+
+		unitTest:assert(not r)
 	end,
 	forEachCellPair = function(unitTest)
 		local cs1 = CellularSpace{xdim = 10}
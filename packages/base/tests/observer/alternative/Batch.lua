@@ -0,0 +1,46 @@
+-------------------------------------------------------------------------------------------
+-- TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+-- Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+-- This code is part of the TerraME framework.
+-- This framework is free software; you can redistribute it and/or
+-- modify it under the terms of the GNU Lesser General Public
+-- License as published by the Free Software Foundation; either
+-- version 2.1 of the License, or (at your option) any later version.
+
+-- You should have received a copy of the GNU Lesser General Public
+-- License along with this library.
+
+-- The authors reassure the license terms regarding the warranties.
+-- They specifically disclaim any warranties, including, but not limited to,
+-- the implied warranties of merchantability and fitness for a particular purpose.
+-- The framework provided hereunder is on an "as is" basis, and the authors have no
+-- obligation to provide maintenance, support, updates, enhancements, or modifications.
+-- In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+-- indirect, special, incidental, or consequential damages arising out of the use
+-- of this software and its documentation.
+--
+-------------------------------------------------------------------------------------------
+
+local Sum = Model{
+	a = 1,
+	finalTime = 2,
+	init = function(model)
+		model.value = 0
+		model.timer = Timer{Event{action = function()
+			model.value = model.value + model.a
+		end}}
+	end
+}
+
+return{
+	Batch = function(unitTest)
+		Clock{target = Timer{}}
+
+		local error_func = function()
+			Batch{model = Sum}
+		end
+
+		unitTest:assertError(error_func, "Batch cannot be executed while there are observers, as their threads are not copied to the processes of the runs. Use clean() before the Batch.")
+	end
+}
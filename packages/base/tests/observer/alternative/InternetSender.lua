@@ -134,6 +134,25 @@ return{
 
 		unitTest:assertWarning(warning_func, defaultValueMsg("compress", true))
 
+		error_func = function()
+			InternetSender{target = c, bandwidth = "5"}
+		end
+
+		unitTest:assertError(error_func, incompatibleTypeMsg("bandwidth", "number", "5"))
+
+		error_func = function()
+			InternetSender{target = c, bandwidth = -1}
+		end
+
+		unitTest:assertError(error_func, positiveArgumentMsg("bandwidth", -1, true))
+
+		-- TODO(#1911)
+		warning_func = function()
+			InternetSender{target = c, bandwidth = 0}
+		end
+
+		unitTest:assertWarning(warning_func, defaultValueMsg("bandwidth", 0))
+
 		error_func = function()
 			InternetSender{target = c, select = {}}
 		end
@@ -72,6 +72,16 @@ return{
 		end
 		unitTest:assertError(error_func, incompatibleTypeMsg("separator", "string", 2))
 
+		error_func = function()
+			Log{target = c, format = "binary"}
+		end
+		unitTest:assertError(error_func, switchInvalidArgumentMsg("binary", "format", {csv = true, raw = true, columnar = true}))
+
+		error_func = function()
+			Log{target = c, format = "colunar"}
+		end
+		unitTest:assertError(error_func, switchInvalidArgumentSuggestionMsg("colunar", "format", "columnar"))
+
 		local unit = Cell{}
 
 		error_func = function()
@@ -57,6 +57,12 @@ return{
 
 		unitTest:assertError(error_func, incompatibleTypeMsg("select", "string", 5))
 
+		error_func = function()
+			Map{target = c, select = "value", min = 0, max = 1, color = "Blues", file = 2}
+		end
+
+		unitTest:assertError(error_func, incompatibleTypeMsg("file", "string", 2))
+
 		error_func = function()
 			Map{target = c, select = "value"}
 		end
@@ -565,6 +571,12 @@ return{
 
 		unitTest:assertError(error_func, incompatibleTypeMsg("grid", "boolean", 2))
 
+		error_func = function()
+			Map{target = soc, file = "map.png"}
+		end
+
+		unitTest:assertError(error_func, "Argument 'file' can only be used with a CellularSpace.")
+
 		error_func = function()
 			Map{target = soc, color = "Blues"}
 		end
@@ -22,6 +22,35 @@
 --
 -------------------------------------------------------------------------------------------
 
+local function uint32(content, pos)
+	local b1, b2, b3, b4 = string.byte(content, pos, pos + 3)
+	return b1 + b2 * 256 + b3 * 65536 + b4 * 16777216
+end
+
+-- returns the content of a binary log, its format, the names and types
+-- of its attributes, and the position where the values start
+local function readBinaryLog(name)
+	local file = File(name)
+	local content = file:open("rb"):read("*all")
+	file:close()
+
+	local attributes = {}
+	local pos = 13
+
+	for _ = 1, uint32(content, 9) do
+		local size = uint32(content, pos)
+
+		table.insert(attributes, {
+			name = string.sub(content, pos + 4, pos + 3 + size),
+			type = string.byte(content, pos + 4 + size)
+		})
+
+		pos = pos + 5 + size
+	end
+
+	return content, string.byte(content, 8), attributes, pos
+end
+
 return{
 	Log = function(unitTest)
 		local world = Cell{
@@ -153,6 +182,69 @@ return{
 		log:update()
 		unitTest:assertFile("logfile-7.csv")
 		unitTest:assertFile("logfile-8.csv")
+
+		world = Agent{
+			count = 0,
+			name = "abc"
+		}
+
+		Log{
+			target = world,
+			select = {"count", "name"},
+			file = "logfile-9.bin",
+			format = "raw"
+		}
+
+		log = Log{
+			target = world,
+			select = {"count", "name"},
+			file = "logfile-10.bin",
+			format = "columnar"
+		}
+
+		log:update()
+		world.count = 1
+		log:update()
+
+		-- the types of the attributes are taken from the first notification
+		world.count = "x"
+		world.name = 5
+		log:update()
+
+		-- the binary files are complete only after closing the observers
+		clean()
+
+		local content, format, attributes, pos = readBinaryLog("logfile-9.bin")
+
+		unitTest:assertEquals(File("logfile-9.bin"):attributes("size"), 79)
+		unitTest:assertEquals(string.sub(content, 1, 7), "TMELOG\1")
+		unitTest:assertEquals(format, 1)
+		unitTest:assertEquals(#attributes, 2)
+		unitTest:assertEquals(attributes[1].name, "count")
+		unitTest:assertEquals(attributes[1].type, 1)
+		unitTest:assertEquals(attributes[2].name, "name")
+		unitTest:assertEquals(attributes[2].type, 1)
+		unitTest:assertEquals(#content - pos + 1, 3 * 2 * 8)
+
+		File("logfile-9.bin"):delete()
+
+		content, format, attributes, pos = readBinaryLog("logfile-10.bin")
+
+		unitTest:assertEquals(File("logfile-10.bin"):attributes("size"), 78)
+		unitTest:assertEquals(string.sub(content, 1, 7), "TMELOG\1")
+		unitTest:assertEquals(format, 2)
+		unitTest:assertEquals(#attributes, 2)
+		unitTest:assertEquals(attributes[1].name, "count")
+		unitTest:assertEquals(attributes[1].type, 1)
+		unitTest:assertEquals(attributes[2].name, "name")
+		unitTest:assertEquals(attributes[2].type, 3)
+
+		-- a single block with three numbers and the texts "abc", "abc", and "5"
+		unitTest:assertEquals(uint32(content, pos), 3)
+		unitTest:assertEquals(#content - pos + 1, 4 + 3 * 8 + 7 + 7 + 5)
+		unitTest:assertEquals(string.sub(content, -5), "\1\0\0\0005")
+
+		File("logfile-10.bin"):delete()
 	end,
 	update = function(unitTest)
 		local world = Cell{
@@ -461,6 +461,25 @@ return{
 		}
 
 		unitTest:assertSnapshot(m, "save_map.bmp", 0.05)
+
+		cs = CellularSpace{xdim = 10}
+
+		m = Map{
+			target = cs,
+			file = "save_map_file.png"
+		}
+
+		unitTest:assertType(m, "Map")
+		m:update()
+		m:save("save_map_file.bmp")
+
+		unitTest:assert(File("save_map_file-1.png"):exists())
+		unitTest:assert(File("save_map_file-2.png"):exists())
+		unitTest:assert(File("save_map_file.bmp"):exists())
+
+		File("save_map_file-1.png"):deleteIfExists()
+		File("save_map_file-2.png"):deleteIfExists()
+		File("save_map_file.bmp"):deleteIfExists()
 	end,
 	update = function(unitTest)
 		local cs = CellularSpace{xdim = 10}
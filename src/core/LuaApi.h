@@ -44,12 +44,14 @@ namespace terrame
 			public:
 				virtual void pushString(lua_State* L, const std::string& str) = 0;
 				virtual void pushNumber(lua_State* L, double number) = 0;
+				virtual void pushInteger(lua_State* L, long long number) = 0;
 				virtual void pushNil(lua_State* L) = 0;
 				virtual void pushLightUserdata(lua_State* L, void* pointer) = 0;
 				virtual void pushBoolean(lua_State* L, bool b) = 0;
 
 				virtual int pushGlobalByName(lua_State* L, const std::string& name) = 0;
 				virtual int pushTableAt(lua_State* L, int index) = 0;
+				virtual void setIndexAt(lua_State* L, int index, long long n) = 0;
 
 				virtual void pop(lua_State* L, int numberOfElements) = 0;
 				virtual void popOneElement(lua_State* L) = 0;
@@ -70,6 +72,7 @@ namespace terrame
 
 				virtual bool isStringAt(lua_State* L, int index) = 0;
 				virtual bool isNumberAt(lua_State* L, int index) = 0;
+				virtual bool isIntegerAt(lua_State* L, int index) = 0;
 				virtual bool isBooleanAt(lua_State* L, int index) = 0;
 				virtual bool isTableAt(lua_State* L, int index) = 0;
 				virtual bool isUserdataAt(lua_State* L, int index, const std::string& type) = 0;
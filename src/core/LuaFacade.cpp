@@ -51,6 +51,11 @@ void terrame::lua::LuaFacade::pushNumber(lua_State* L, double number)
     lua_pushnumber(L, number);
 }
 
+void terrame::lua::LuaFacade::pushInteger(lua_State* L, long long number)
+{
+	lua_pushinteger(L, number);
+}
+
 void terrame::lua::LuaFacade::pushNil(lua_State* L)
 {
 	lua_pushnil(L);
@@ -71,6 +76,11 @@ int terrame::lua::LuaFacade::pushTableAt(lua_State* L, int index)
 	return lua_gettable(L, index);
 }
 
+void terrame::lua::LuaFacade::setIndexAt(lua_State* L, int index, long long n)
+{
+	lua_rawseti(L, index, n);
+}
+
 void terrame::lua::LuaFacade::pop(lua_State* L, int numberOfElements)
 {
 	lua_pop(L, numberOfElements);
@@ -93,8 +103,9 @@ void terrame::lua::LuaFacade::call(lua_State* L, int numberOfArguments, int numb
 
 std::string terrame::lua::LuaFacade::getStringAt(lua_State* L, int index)
 {
-	const char* str = luaL_checkstring(L , index);
-	return std::string(str);
+	size_t size;
+	const char* str = luaL_checklstring(L , index, &size);
+	return std::string(str, size);
 }
 
 std::string terrame::lua::LuaFacade::getStringAtTop(lua_State* L)
@@ -147,6 +158,11 @@ bool terrame::lua::LuaFacade::isNumberAt(lua_State* L, int index)
 	return lua_type(L, index) == getNumberType();
 }
 
+bool terrame::lua::LuaFacade::isIntegerAt(lua_State* L, int index)
+{
+	return lua_isinteger(L, index) != 0;
+}
+
 bool terrame::lua::LuaFacade::isBooleanAt(lua_State* L, int index)
 {
 	return lua_isboolean(L, index);
@@ -45,12 +45,14 @@ namespace terrame
 
 				void pushString(lua_State* L, const std::string& str);
 				void pushNumber(lua_State* L, double number);
+				void pushInteger(lua_State* L, long long number);
 				void pushNil(lua_State* L);
 				void pushLightUserdata(lua_State* L, void* pointer);
 				void pushBoolean(lua_State* L, bool b);
 
 				int pushGlobalByName(lua_State* L, const std::string& name);
 				int pushTableAt(lua_State* L, int index);
+				void setIndexAt(lua_State* L, int index, long long n);
 
 				void pop(lua_State* L, int numberOfElements);
 				void popOneElement(lua_State* L);
@@ -71,6 +73,7 @@ namespace terrame
 
 				bool isStringAt(lua_State* L, int index);
 				bool isNumberAt(lua_State* L, int index);
+				bool isIntegerAt(lua_State* L, int index);
 				bool isBooleanAt(lua_State* L, int index);
 				bool isTableAt(lua_State* L, int index);
 				bool isUserdataAt(lua_State* L, int index, const std::string& type);
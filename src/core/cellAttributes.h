@@ -0,0 +1,333 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+/*! \file cellAttributes.h
+	\brief Columnar storage for the attributes of the cells of a CellularSpace.
+*/
+
+#ifndef CELL_ATTRIBUTES_H
+#define CELL_ATTRIBUTES_H
+
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstring>
+
+/**
+* \brief
+*  Stores cell attributes as dense arrays, one array per attribute, indexed
+*  by the ordinal of the cell within its CellularSpace.
+*/
+class CellAttributes
+{
+public:
+	/// Types of values that can be stored in a column.
+	enum Type
+	{
+		TNumber,
+		TInteger,
+		TBoolean
+	};
+
+	/// Constructor
+	CellAttributes() : cells(0) {}
+
+	/// Adds a new column and returns its index. If the column already
+	/// exists, returns its index without changing its type.
+	int addAttribute(const std::string& name, Type type)
+	{
+		int idx = find(name);
+		if(idx >= 0) return idx;
+
+		Column col;
+		col.name = name;
+		col.type = type;
+		col.synchronized = false;
+		columns.push_back(col);
+		allocate(columns.back());
+		return (int)columns.size() - 1;
+	}
+
+	/// Returns the index of a column given its name, or -1 if it does not exist.
+	int find(const std::string& name) const
+	{
+		for(unsigned int i = 0; i < columns.size(); i++)
+		{
+			if(columns[i].name == name) return i;
+		}
+		return -1;
+	}
+
+	/// Returns the number of columns.
+	int count() const { return (int)columns.size(); }
+
+	/// Returns the number of cells.
+	int size() const { return cells; }
+
+	/// Returns the name of a column.
+	const std::string& getName(int col) const { return columns[col].name; }
+
+	/// Returns the type of a column.
+	Type getType(int col) const { return columns[col].type; }
+
+	/// Changes the number of cells of all columns.
+	void resize(int size)
+	{
+		cells = size;
+		for(unsigned int i = 0; i < columns.size(); i++)
+			allocate(columns[i]);
+	}
+
+	/// Removes all columns and cells.
+	void clear()
+	{
+		columns.clear();
+		cells = 0;
+	}
+
+	/// Returns the value of a cell as a number, whatever the type of the column.
+	double getNumber(int col, int cell) const
+	{
+		const Column& c = columns[col];
+		switch(c.type)
+		{
+			case TInteger: return c.integers[cell];
+			case TBoolean: return c.booleans[cell];
+			default: return c.numbers[cell];
+		}
+	}
+
+	/// Returns the value of a cell of an integer column.
+	int getInteger(int col, int cell) const { return columns[col].integers[cell]; }
+
+	/// Returns the value of a cell of a boolean column.
+	bool getBoolean(int col, int cell) const { return columns[col].booleans[cell] != 0; }
+
+	/// Sets the value of a numeric column. Integer columns are promoted to
+	/// number when the value is not integral. Returns false if the column is boolean.
+	bool setNumber(int col, int cell, double value)
+	{
+		Column& c = columns[col];
+		if(c.type == TBoolean) return false;
+
+		if(c.type == TInteger)
+		{
+			if(value == std::floor(value) && std::fabs(value) <= 2147483647.0)
+			{
+				c.integers[cell] = (int)value;
+				return true;
+			}
+			promote(c);
+		}
+
+		c.numbers[cell] = value;
+		return true;
+	}
+
+	/// Sets the value of a boolean column. Returns false if the column is numeric.
+	bool setBoolean(int col, int cell, bool value)
+	{
+		Column& c = columns[col];
+		if(c.type != TBoolean) return false;
+		c.booleans[cell] = value;
+		return true;
+	}
+
+	/// Copies the current values of a column to its past buffer.
+	void synchronize(int col)
+	{
+		Column& c = columns[col];
+		c.pastNumbers = c.numbers;
+		c.pastIntegers = c.integers;
+		c.pastBooleans = c.booleans;
+		c.synchronized = true;
+	}
+
+	/// Discards the past buffers of all columns, without releasing their memory.
+	void resetPast()
+	{
+		for(unsigned int i = 0; i < columns.size(); i++)
+			columns[i].synchronized = false;
+	}
+
+	/// Copies back the columns of a snapshot, which is a copy of this object taken
+	/// before. The arrays are copied in bulk, reusing the memory already allocated.
+	/// Columns created after the snapshot keep their values. Returns false if the
+	/// number of cells changed or if the snapshot does not match the columns.
+	bool restore(const CellAttributes& snapshot)
+	{
+		if(snapshot.cells != cells || snapshot.columns.size() > columns.size()) return false;
+
+		for(unsigned int i = 0; i < snapshot.columns.size(); i++)
+		{
+			if(columns[i].name != snapshot.columns[i].name) return false;
+		}
+
+		for(unsigned int i = 0; i < snapshot.columns.size(); i++)
+			columns[i] = snapshot.columns[i];
+
+		return true;
+	}
+
+	/// Returns the array with the values of a column, or with its past values, as bytes.
+	/// \param bytes returns the size of the array
+	const char* getData(int col, bool past, size_t& bytes) const
+	{
+		const Column& c = columns[col];
+		switch(c.type)
+		{
+			case TInteger: return bytesOf(past ? c.pastIntegers : c.integers, bytes);
+			case TBoolean: return bytesOf(past ? c.pastBooleans : c.booleans, bytes);
+			default: return bytesOf(past ? c.pastNumbers : c.numbers, bytes);
+		}
+	}
+
+	/// Replaces the values of a column by an array returned by getData(), possibly
+	/// changing its type. The past values are replaced only if past is not null,
+	/// otherwise the column is no longer synchronized. Returns false if the size
+	/// of the arrays does not match the number of cells.
+	bool setData(int col, Type type, const char* values, size_t bytes, const char* past, size_t pastBytes)
+	{
+		size_t size = type == TInteger ? sizeof(int) : (type == TBoolean ? sizeof(char) : sizeof(double));
+
+		if(bytes != size * cells || (past && pastBytes != size * cells)) return false;
+
+		Column& c = columns[col];
+		std::vector<double>().swap(c.numbers);
+		std::vector<int>().swap(c.integers);
+		std::vector<char>().swap(c.booleans);
+		std::vector<double>().swap(c.pastNumbers);
+		std::vector<int>().swap(c.pastIntegers);
+		std::vector<char>().swap(c.pastBooleans);
+
+		c.type = type;
+		c.synchronized = past != 0;
+		allocate(c);
+
+		switch(type)
+		{
+			case TInteger:
+				copyBytes(c.integers, values);
+				if(past) copyBytes(c.pastIntegers, past);
+				break;
+			case TBoolean:
+				copyBytes(c.booleans, values);
+				if(past) copyBytes(c.pastBooleans, past);
+				break;
+			default:
+				copyBytes(c.numbers, values);
+				if(past) copyBytes(c.pastNumbers, past);
+		}
+
+		return true;
+	}
+
+	/// Returns whether a column was synchronized since the last call to resetPast().
+	bool isSynchronized(int col) const { return columns[col].synchronized; }
+
+	/// Returns the past value of a cell as a number, whatever the type of the column.
+	double getPastNumber(int col, int cell) const
+	{
+		const Column& c = columns[col];
+		switch(c.type)
+		{
+			case TInteger: return c.pastIntegers[cell];
+			case TBoolean: return c.pastBooleans[cell];
+			default: return c.pastNumbers[cell];
+		}
+	}
+
+	/// Returns the past value of a cell of an integer column.
+	int getPastInteger(int col, int cell) const { return columns[col].pastIntegers[cell]; }
+
+	/// Returns the past value of a cell of a boolean column.
+	bool getPastBoolean(int col, int cell) const { return columns[col].pastBooleans[cell] != 0; }
+
+	/// Returns the array of a number column, to be used by native kernels.
+	double* numbers(int col) { return columns[col].numbers.empty() ? 0 : &columns[col].numbers[0]; }
+
+	/// Returns the array of an integer column, to be used by native kernels.
+	int* integers(int col) { return columns[col].integers.empty() ? 0 : &columns[col].integers[0]; }
+
+	/// Returns the array of a boolean column, to be used by native kernels.
+	char* booleans(int col) { return columns[col].booleans.empty() ? 0 : &columns[col].booleans[0]; }
+
+private:
+	struct Column
+	{
+		std::string name;
+		Type type;
+		std::vector<double> numbers;
+		std::vector<int> integers;
+		std::vector<char> booleans;
+		std::vector<double> pastNumbers;
+		std::vector<int> pastIntegers;
+		std::vector<char> pastBooleans;
+		bool synchronized;
+	};
+
+	void allocate(Column& c)
+	{
+		switch(c.type)
+		{
+			case TInteger: c.integers.resize(cells, 0); break;
+			case TBoolean: c.booleans.resize(cells, 0); break;
+			default: c.numbers.resize(cells, 0.0);
+		}
+
+		if(c.synchronized)
+		{
+			c.pastNumbers.resize(c.numbers.size(), 0.0);
+			c.pastIntegers.resize(c.integers.size(), 0);
+			c.pastBooleans.resize(c.booleans.size(), 0);
+		}
+	}
+
+	template <class T>
+	static const char* bytesOf(const std::vector<T>& values, size_t& bytes)
+	{
+		bytes = values.size() * sizeof(T);
+		return values.empty() ? 0 : (const char*)&values[0];
+	}
+
+	template <class T>
+	static void copyBytes(std::vector<T>& values, const char* bytes)
+	{
+		if(!values.empty())
+			memcpy(&values[0], bytes, values.size() * sizeof(T));
+	}
+
+	void promote(Column& c)
+	{
+		c.numbers.assign(c.integers.begin(), c.integers.end());
+		std::vector<int>().swap(c.integers);
+		c.pastNumbers.assign(c.pastIntegers.begin(), c.pastIntegers.end());
+		std::vector<int>().swap(c.pastIntegers);
+		c.type = TNumber;
+	}
+
+	std::vector<Column> columns;
+	int cells;
+};
+
+#endif // CELL_ATTRIBUTES_H
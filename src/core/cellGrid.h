@@ -0,0 +1,223 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+/*! \file cellGrid.h
+	\brief This file contains the index of the cells of a CellularSpace by their coordinates.
+*/
+
+#ifndef CELL_GRID_H
+#define CELL_GRID_H
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <unordered_map>
+
+/**
+* \brief
+*  Index of the ordinals of the cells of a CellularSpace by their (x, y)
+*  coordinates. When the cells fill most of the rectangle defined by their
+*  coordinates, it uses a dense two-dimensional array, where positions without
+*  cells store -1. Otherwise, and for cells added out of the array after
+*  it was built, it uses a hash table.
+*/
+class CellGrid
+{
+public:
+	/// Constructor
+	CellGrid() : xMin(0), xMax(-1), yMin(0), yMax(-1),
+		arrayXMin(0), arrayYMin(0), arrayXDim(0), arrayYDim(0), built(false) {}
+
+	/// Builds the grid from the coordinates of the cells. When two cells share
+	/// the same coordinates, the first one is stored.
+	/// \param cellCoords the coordinates (x, y) of each cell, indexed by its ordinal
+	void build(const std::vector<std::pair<int, int> >& cellCoords)
+	{
+		coords = cellCoords;
+		index();
+	}
+
+	/// Adds a cell whose ordinal is the number of cells already added. If the grid
+	/// is already built, the cell is indexed immediately, otherwise in the next update().
+	void add(int x, int y)
+	{
+		int ordinal = coords.size();
+		coords.push_back(std::make_pair(x, y));
+
+		if(!built) return;
+
+		if(ordinal == 0)
+		{
+			xMin = xMax = x;
+			yMin = yMax = y;
+		}
+		else
+		{
+			xMin = std::min(xMin, x);
+			xMax = std::max(xMax, x);
+			yMin = std::min(yMin, y);
+			yMax = std::max(yMax, y);
+		}
+
+		if(inArray(x, y))
+		{
+			int& current = ordinals[position(x, y)];
+			if(current < 0) current = ordinal;
+		}
+		else
+		{
+			sparse.insert(std::make_pair(key(x, y), ordinal));
+
+			// too many cells out of the array, build it again in the next update()
+			if(!ordinals.empty() && sparse.size() > ordinals.size() / 2)
+				built = false;
+		}
+	}
+
+	/// Builds the grid if it was not built after the last changes.
+	void update()
+	{
+		if(!built) index();
+	}
+
+	/// Returns the ordinal of the cell located at (x, y), or -1 if there is no such cell.
+	/// The grid must be updated.
+	int find(int x, int y) const
+	{
+		if(x < xMin || x > xMax || y < yMin || y > yMax)
+			return -1;
+
+		if(inArray(x, y))
+			return ordinals[position(x, y)];
+
+		std::unordered_map<long long, int>::const_iterator it = sparse.find(key(x, y));
+		if(it == sparse.end()) return -1;
+
+		return it->second;
+	}
+
+	/// Returns whether the grid has no cells.
+	bool empty() const { return coords.empty(); }
+
+	/// Returns the number of cells added to the grid.
+	int size() const { return (int)coords.size(); }
+
+	/// Returns the coordinates (x, y) of a cell given its ordinal.
+	const std::pair<int, int>& getCoord(int ordinal) const { return coords[ordinal]; }
+
+	/// Removes all the cells from the grid.
+	void clear()
+	{
+		coords.clear();
+		ordinals.clear();
+		sparse.clear();
+		xMin = yMin = 0;
+		xMax = yMax = -1;
+		arrayXMin = arrayYMin = arrayXDim = arrayYDim = 0;
+		built = false;
+	}
+
+	int getXMin() const { return xMin; }
+	int getXMax() const { return xMax; }
+	int getYMin() const { return yMin; }
+	int getYMax() const { return yMax; }
+
+	/// Returns the number of columns of the grid
+	int getXDim() const { return xMax - xMin + 1; }
+
+	/// Returns the number of lines of the grid
+	int getYDim() const { return yMax - yMin + 1; }
+
+private:
+	/// Maximum ratio between the area of the rectangle and the number of cells to use the dense array
+	static const int density = 4;
+
+	void index()
+	{
+		ordinals.clear();
+		sparse.clear();
+		xMin = yMin = 0;
+		xMax = yMax = -1;
+		arrayXMin = arrayYMin = arrayXDim = arrayYDim = 0;
+		built = true;
+
+		if(coords.empty()) return;
+
+		xMin = xMax = coords[0].first;
+		yMin = yMax = coords[0].second;
+
+		for(unsigned int i = 1; i < coords.size(); i++)
+		{
+			xMin = std::min(xMin, coords[i].first);
+			xMax = std::max(xMax, coords[i].first);
+			yMin = std::min(yMin, coords[i].second);
+			yMax = std::max(yMax, coords[i].second);
+		}
+
+		if((double)getXDim() * getYDim() <= (double)density * coords.size())
+		{
+			arrayXMin = xMin;
+			arrayYMin = yMin;
+			arrayXDim = getXDim();
+			arrayYDim = getYDim();
+			ordinals.assign((size_t)arrayXDim * arrayYDim, -1);
+
+			for(unsigned int i = 0; i < coords.size(); i++)
+			{
+				int& ordinal = ordinals[position(coords[i].first, coords[i].second)];
+				if(ordinal < 0) ordinal = i;
+			}
+		}
+		else
+		{
+			sparse.reserve(coords.size());
+
+			for(unsigned int i = 0; i < coords.size(); i++)
+				sparse.insert(std::make_pair(key(coords[i].first, coords[i].second), (int)i));
+		}
+	}
+
+	bool inArray(int x, int y) const
+	{
+		return x >= arrayXMin && x < arrayXMin + arrayXDim && y >= arrayYMin && y < arrayYMin + arrayYDim;
+	}
+
+	size_t position(int x, int y) const
+	{
+		return (size_t)(y - arrayYMin) * arrayXDim + (x - arrayXMin);
+	}
+
+	static long long key(int x, int y)
+	{
+		return ((long long)x << 32) | (unsigned int)y;
+	}
+
+	std::vector<std::pair<int, int> > coords; ///< coordinates of each cell, indexed by its ordinal
+	std::vector<int> ordinals; ///< ordinal of the cell of each position of the array, line by line
+	std::unordered_map<long long, int> sparse; ///< ordinals of the cells out of the array
+	int xMin, xMax, yMin, yMax;
+	int arrayXMin, arrayYMin, arrayXDim, arrayYDim;
+	bool built;
+};
+
+#endif // CELL_GRID_H
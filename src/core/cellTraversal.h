@@ -0,0 +1,227 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+/*! \file cellTraversal.h
+	\brief Partitions and output buffers used to traverse the cells of a CellularSpace in parallel.
+*/
+
+#ifndef CELL_TRAVERSAL_H
+#define CELL_TRAVERSAL_H
+
+#include <vector>
+#include <random>
+
+#include "cellAttributes.h"
+#include "cellGrid.h"
+
+/**
+* \brief
+*  Stream of random numbers of a partition of a parallel traversal. Each partition
+*  has its own stream, computed from the seed of the traversal and the position of
+*  the partition, so the numbers drawn for a cell do not depend on the number of
+*  threads or on the order the partitions are executed.
+*/
+class CellRandom
+{
+public:
+	/// Constructor
+	/// \param seed the seed of the traversal
+	/// \param stream the position of the partition
+	CellRandom(unsigned int seed, unsigned int stream)
+	{
+		std::seed_seq sequence{seed, stream};
+		generator.seed(sequence);
+	}
+
+	/// Returns a number in the interval [0, 1) with 53 random bits.
+	double number()
+	{
+		unsigned int a = generator() >> 5;
+		unsigned int b = generator() >> 6;
+		return (a * 67108864.0 + b) * (1.0 / 9007199254740992.0);
+	}
+
+	/// Returns an integer number in the interval [min, max].
+	long long integer(long long min, long long max)
+	{
+		return min + (long long)(number() * (double)(max - min + 1));
+	}
+
+private:
+	std::mt19937 generator;
+};
+
+/**
+* \brief
+*  Splits the cells of a CellularSpace into blocks of consecutive ordinals that can be
+*  traversed at the same time, and stores the values written to the output attributes
+*  until all the cells are visited. Cells read the values from before the traversal,
+*  whatever the order of the partitions, and commit() applies the new values at the end.
+*/
+class CellTraversal
+{
+public:
+	/// Constructor
+	/// \param attributes the columnar attributes of the cells
+	/// \param grid the coordinates of the cells
+	CellTraversal(CellAttributes& attributes, const CellGrid& grid)
+		: attributes(attributes), grid(grid), slots(attributes.count(), -1) {}
+
+	/// Splits the cells into blocks with approximately the same number of cells. When
+	/// possible, the limits of the blocks are moved forward to the beginning of the next
+	/// line of the grid, so that each line belongs to a single block.
+	/// \param blocks the maximum number of blocks
+	void partition(int blocks)
+	{
+		int cells = attributes.size();
+
+		limits.clear();
+		limits.push_back(0);
+
+		if(blocks < 1) blocks = 1;
+
+		for(int i = 1; i <= blocks; i++)
+		{
+			int nominal = (int)((long long)cells * i / blocks);
+			int limit = nominal;
+
+			if(i < blocks && grid.size() == cells)
+			{
+				int next = (int)((long long)cells * (i + 1) / blocks);
+
+				while(limit > limits.back() && limit < next && sameLine(limit - 1, limit))
+					limit++;
+
+				if(limit == next) limit = nominal;
+			}
+
+			if(limit > limits.back())
+				limits.push_back(limit);
+		}
+	}
+
+	/// Returns the number of partitions
+	int getPartitions() const { return (int)limits.size() - 1; }
+
+	/// Returns the ordinal of the first cell of a partition
+	int begin(int partition) const { return limits[partition]; }
+
+	/// Returns the ordinal after the last cell of a partition
+	int end(int partition) const { return limits[partition + 1]; }
+
+	/// Allows the cells to update a column and returns the position of its buffer
+	/// \param column the index of the column
+	int addOutput(int column)
+	{
+		if(slots[column] >= 0) return slots[column];
+
+		Output output;
+		output.column = column;
+		output.values.resize(attributes.size(), 0.0);
+		output.written.resize(attributes.size(), 0);
+		outputs.push_back(output);
+
+		slots[column] = (int)outputs.size() - 1;
+		return slots[column];
+	}
+
+	/// Returns the position of the buffer of a column, or -1 if it is not an output
+	int getOutput(int column) const { return slots[column]; }
+
+	/// Returns the number of output columns
+	int getOutputs() const { return (int)outputs.size(); }
+
+	/// Stores a new value of a cell. Returns false if the column is boolean.
+	bool setNumber(int output, int cell, double value)
+	{
+		Output& o = outputs[output];
+		if(attributes.getType(o.column) == CellAttributes::TBoolean) return false;
+
+		o.values[cell] = value;
+		o.written[cell] = 1;
+		return true;
+	}
+
+	/// Stores a new value of a cell. Returns false if the column is numeric.
+	bool setBoolean(int output, int cell, bool value)
+	{
+		Output& o = outputs[output];
+		if(attributes.getType(o.column) != CellAttributes::TBoolean) return false;
+
+		o.values[cell] = value ? 1 : 0;
+		o.written[cell] = 1;
+		return true;
+	}
+
+	/// Returns whether a new value was stored for a cell
+	bool isWritten(int output, int cell) const { return outputs[output].written[cell] != 0; }
+
+	/// Returns the new value of a cell, with booleans stored as zero or one
+	double getValue(int output, int cell) const { return outputs[output].values[cell]; }
+
+	/// Copies the new values to the columns, in the order of the cells.
+	void commit()
+	{
+		for(unsigned int i = 0; i < outputs.size(); i++)
+		{
+			const Output& o = outputs[i];
+			bool boolean = attributes.getType(o.column) == CellAttributes::TBoolean;
+
+			for(int cell = 0; cell < attributes.size(); cell++)
+			{
+				if(!o.written[cell]) continue;
+
+				if(boolean)
+					attributes.setBoolean(o.column, cell, o.values[cell] != 0);
+				else
+					attributes.setNumber(o.column, cell, o.values[cell]);
+			}
+		}
+	}
+
+	CellAttributes& getAttributes() { return attributes; }
+	const CellGrid& getGrid() const { return grid; }
+
+private:
+	struct Output
+	{
+		int column;
+		std::vector<double> values;
+		std::vector<char> written;
+	};
+
+	bool sameLine(int cell1, int cell2) const
+	{
+		const std::pair<int, int>& c1 = grid.getCoord(cell1);
+		const std::pair<int, int>& c2 = grid.getCoord(cell2);
+		return c1.first == c2.first || c1.second == c2.second;
+	}
+
+	CellAttributes& attributes;
+	const CellGrid& grid;
+	std::vector<int> limits; ///< ordinal of the first cell of each partition, followed by the number of cells
+	std::vector<int> slots; ///< position of the buffer of each column, or -1
+	std::vector<Output> outputs;
+};
+
+#endif // CELL_TRAVERSAL_H
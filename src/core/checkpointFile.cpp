@@ -0,0 +1,199 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+/*! \file checkpointFile.cpp
+	\brief This file contains the implementation of the classes to write and read checkpoints.
+*/
+
+#include "checkpointFile.h"
+
+namespace
+{
+	const char magic[] = {'T', 'M', 'C', 'P'};
+	const unsigned int version = 1;
+}
+
+CheckpointWriter::CheckpointWriter() : file(0), tables(0)
+{
+}
+
+CheckpointWriter::~CheckpointWriter()
+{
+	if(file)
+	{
+		fclose(file);
+		remove((fileName + ".tmp").c_str());
+	}
+}
+
+std::string CheckpointWriter::open(const std::string& name)
+{
+	fileName = name;
+	tables = 0;
+	file = fopen((fileName + ".tmp").c_str(), "wb");
+
+	if(!file)
+		return "Could not write file '" + fileName + "'.";
+
+	fwrite(magic, 1, sizeof(magic), file);
+	write(version);
+	return "";
+}
+
+void CheckpointWriter::writeType(CheckpointValue::Type type)
+{
+	fputc(type, file);
+}
+
+void CheckpointWriter::writeNil()
+{
+	writeType(CheckpointValue::TNil);
+}
+
+void CheckpointWriter::writeBoolean(bool value)
+{
+	writeType(value ? CheckpointValue::TTrue : CheckpointValue::TFalse);
+}
+
+void CheckpointWriter::writeInteger(long long value)
+{
+	writeType(CheckpointValue::TInteger);
+	write(value);
+}
+
+void CheckpointWriter::writeNumber(double value)
+{
+	writeType(CheckpointValue::TNumber);
+	write(value);
+}
+
+void CheckpointWriter::writeString(const char* text, size_t size)
+{
+	writeType(CheckpointValue::TString);
+	write((unsigned long long)size);
+	fwrite(text, 1, size, file);
+}
+
+unsigned int CheckpointWriter::beginTable()
+{
+	writeType(CheckpointValue::TTable);
+	return tables++;
+}
+
+void CheckpointWriter::endTable()
+{
+	writeType(CheckpointValue::TEnd);
+}
+
+void CheckpointWriter::writeReference(unsigned int table)
+{
+	writeType(CheckpointValue::TReference);
+	write(table);
+}
+
+std::string CheckpointWriter::close()
+{
+	std::string tmp = fileName + ".tmp";
+	bool error = ferror(file) != 0;
+
+	error = fclose(file) != 0 || error;
+	file = 0;
+
+	if(error)
+	{
+		remove(tmp.c_str());
+		return "Could not write file '" + fileName + "'.";
+	}
+
+#ifdef WIN32
+	remove(fileName.c_str());
+#endif
+
+	if(rename(tmp.c_str(), fileName.c_str()) != 0)
+		return "Could not replace file '" + fileName + "'.";
+
+	return "";
+}
+
+CheckpointReader::CheckpointReader() : position(0), tables(0)
+{
+}
+
+std::string CheckpointReader::open(const std::string& fileName)
+{
+	position = 0;
+	tables = 0;
+
+	if(!file.open(fileName))
+		return "Could not open file '" + fileName + "'.";
+
+	if(file.size() < sizeof(magic) || memcmp(file.data(), magic, sizeof(magic)) != 0)
+		return "File '" + fileName + "' is not a checkpoint file.";
+
+	position = sizeof(magic);
+
+	unsigned int fileVersion;
+	if(!read(fileVersion) || fileVersion != version)
+		return "File '" + fileName + "' was created by an incompatible version of TerraME.";
+
+	return "";
+}
+
+bool CheckpointReader::read(CheckpointValue& value)
+{
+	if(position >= file.size()) return false;
+
+	unsigned char type = (unsigned char)file.data()[position++];
+
+	value.type = (CheckpointValue::Type)type;
+
+	switch(type)
+	{
+		case CheckpointValue::TNil:
+		case CheckpointValue::TFalse:
+		case CheckpointValue::TTrue:
+		case CheckpointValue::TEnd:
+			return true;
+		case CheckpointValue::TInteger:
+			return read(value.integer);
+		case CheckpointValue::TNumber:
+			return read(value.number);
+		case CheckpointValue::TString:
+		{
+			unsigned long long size;
+			if(!read(size) || file.size() - position < size) return false;
+
+			value.text = file.data() + position;
+			value.size = (size_t)size;
+			position += (size_t)size;
+			return true;
+		}
+		case CheckpointValue::TTable:
+			value.table = tables++;
+			return true;
+		case CheckpointValue::TReference:
+			return read(value.table) && value.table < tables;
+	}
+
+	return false;
+}
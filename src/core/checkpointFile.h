@@ -0,0 +1,168 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+/*! \file checkpointFile.h
+	\brief This file contains the classes to write and read checkpoints of simulations.
+*/
+
+#ifndef CHECKPOINT_FILE_H
+#define CHECKPOINT_FILE_H
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "neighborhoodFile.h"
+
+/**
+* \brief
+*  A value stored in a checkpoint file. Texts point to the memory of the file,
+*  being valid while the CheckpointReader is open.
+*/
+struct CheckpointValue
+{
+	/// Types of values. Each value starts with a byte with its type.
+	enum Type
+	{
+		TNil = 0,
+		TFalse = 1,
+		TTrue = 2,
+		TInteger = 3,
+		TNumber = 4,
+		TString = 5,
+		TTable = 6,
+		TEnd = 7,
+		TReference = 8
+	};
+
+	Type type;
+	long long integer;   ///< the value of a TInteger
+	double number;       ///< the value of a TNumber
+	const char* text;    ///< the characters of a TString
+	size_t size;         ///< the number of characters of a TString
+	unsigned int table;  ///< the index of a TTable or of the table referred by a TReference
+};
+
+/**
+* \brief
+*  Writes a tree of values to a checkpoint file. A table is written as a TTable followed by
+*  its keys and values, alternately, and a TEnd. Tables are numbered in the order they are
+*  written, starting from zero, and a table written before can be written again as a
+*  TReference to its number.
+*
+*  A checkpoint file stores, in the byte order of the machine that created it: the magic
+*  number "TMCP"; a 32-bit version; and a single value. Integers, numbers, references, and
+*  the sizes of the strings (which follow their sizes) have 64, 64, 32, and 64 bits. The
+*  file is first written with the extension ".tmp" and then renamed, so that a checkpoint
+*  interrupted in the middle does not replace the previous one.
+*/
+class CheckpointWriter
+{
+public:
+	/// Constructor
+	CheckpointWriter();
+
+	/// Destructor. It discards the file if it was not closed.
+	~CheckpointWriter();
+
+	/// Creates the file and writes its header.
+	/// \return an empty string if the file was created, otherwise an error message
+	std::string open(const std::string& fileName);
+
+	void writeNil();
+	void writeBoolean(bool value);
+	void writeInteger(long long value);
+	void writeNumber(double value);
+	void writeString(const char* text, size_t size);
+
+	/// Starts a table and returns its number
+	unsigned int beginTable();
+
+	/// Finishes the last table started
+	void endTable();
+
+	/// Writes a table already written
+	void writeReference(unsigned int table);
+
+	/// Finishes the file, replacing the previous file with the same name.
+	/// \return an empty string if the file was saved, otherwise an error message
+	std::string close();
+
+private:
+	CheckpointWriter(const CheckpointWriter&);
+	CheckpointWriter& operator=(const CheckpointWriter&);
+
+	template <class T>
+	void write(const T& value)
+	{
+		fwrite(&value, sizeof(T), 1, file);
+	}
+
+	void writeType(CheckpointValue::Type type);
+
+	FILE* file;
+	std::string fileName;
+	unsigned int tables;
+};
+
+/**
+* \brief
+*  Reads the values of a checkpoint file mapped into memory, in the order they were written.
+*/
+class CheckpointReader
+{
+public:
+	/// Constructor
+	CheckpointReader();
+
+	/// Opens a file and checks its header.
+	/// \return an empty string if the file was opened, otherwise an error message
+	std::string open(const std::string& fileName);
+
+	/// Reads the next value.
+	/// \return false if the file is corrupted
+	bool read(CheckpointValue& value);
+
+	/// Returns whether the whole file was read
+	bool atEnd() const { return position == file.size(); }
+
+	/// Returns the number of tables read
+	unsigned int getTables() const { return tables; }
+
+private:
+	template <class T>
+	bool read(T& value)
+	{
+		if(file.size() - position < sizeof(T)) return false;
+
+		memcpy(&value, file.data() + position, sizeof(T));
+		position += sizeof(T);
+		return true;
+	}
+
+	MappedFile file;
+	size_t position;
+	unsigned int tables;
+};
+
+#endif // CHECKPOINT_FILE_H
@@ -0,0 +1,160 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+/*! \file csrNeighborhood.h
+	\brief This file contains the neighborhoods loaded from files, stored as a
+	graph in compressed sparse row format.
+*/
+
+#ifndef CSR_NEIGHBORHOOD_H
+#define CSR_NEIGHBORHOOD_H
+
+#include <vector>
+#include <algorithm>
+
+/**
+* \brief
+*  Neighborhood shared by all the cells of a CellularSpace, stored as a weighted
+*  directed graph in compressed sparse row (CSR) format. Cells are identified by their
+*  ordinals. The neighbors of a cell are stored contiguously between begin(cell) and
+*  end(cell), using one integer and one double for each connection.
+*/
+class CSRNeighborhood
+{
+public:
+	/// Constructor
+	CSRNeighborhood() : sorted(true) {}
+
+	/// Adds a connection. Connections can be added in any order before build()
+	/// is called. Connections from the same origin keep the order they were added.
+	/// \param origin the ordinal of the cell that owns the connection
+	/// \param neighbor the ordinal of the neighbor cell
+	/// \param weight the weight of the connection
+	void add(int origin, int neighbor, double weight)
+	{
+		if(!origins.empty() && origin < origins.back())
+			sorted = false;
+
+		origins.push_back(origin);
+		neighbors.push_back(neighbor);
+		weights.push_back(weight);
+	}
+
+	/// Reserves memory for a given number of connections.
+	void reserve(size_t connections)
+	{
+		origins.reserve(connections);
+		neighbors.reserve(connections);
+		weights.reserve(connections);
+	}
+
+	/// Builds the compressed rows from the added connections.
+	/// \param cells the number of cells of the CellularSpace
+	void build(int cells)
+	{
+		offsets.assign(cells + 1, 0);
+
+		for(unsigned int i = 0; i < origins.size(); i++)
+			offsets[origins[i] + 1]++;
+
+		for(int i = 0; i < cells; i++)
+			offsets[i + 1] += offsets[i];
+
+		if(!sorted)
+		{
+			std::vector<int> position(offsets.begin(), offsets.end() - 1);
+			std::vector<int> sortedNeighbors(neighbors.size());
+			std::vector<double> sortedWeights(weights.size());
+
+			for(unsigned int i = 0; i < origins.size(); i++)
+			{
+				int p = position[origins[i]]++;
+				sortedNeighbors[p] = neighbors[i];
+				sortedWeights[p] = weights[i];
+			}
+
+			neighbors.swap(sortedNeighbors);
+			weights.swap(sortedWeights);
+		}
+
+		std::vector<int>().swap(origins);
+		sorted = true;
+	}
+
+	/// Returns the position of the first connection whose neighbor already appeared
+	/// in the same row, or -1 if there is no repeated connection.
+	int findRepeated() const
+	{
+		int cells = offsets.size() - 1;
+		std::vector<int> mark(cells, -1);
+
+		for(int origin = 0; origin < cells; origin++)
+		{
+			for(int p = offsets[origin]; p < offsets[origin + 1]; p++)
+			{
+				if(mark[neighbors[p]] == origin)
+					return p;
+
+				mark[neighbors[p]] = origin;
+			}
+		}
+
+		return -1;
+	}
+
+	/// Returns the ordinal of the cell that owns the connection at a given position.
+	int getOrigin(int position) const
+	{
+		return std::upper_bound(offsets.begin(), offsets.end(), position) - offsets.begin() - 1;
+	}
+
+	/// Returns the position of the first neighbor of a cell.
+	int begin(int origin) const { return offsets[origin]; }
+
+	/// Returns the position after the last neighbor of a cell.
+	int end(int origin) const { return offsets[origin + 1]; }
+
+	/// Returns the number of neighbors of a cell.
+	int degree(int origin) const { return offsets[origin + 1] - offsets[origin]; }
+
+	/// Returns the ordinal of the neighbor stored in a given position.
+	int getNeighbor(int position) const { return neighbors[position]; }
+
+	/// Returns the weight of the connection stored in a given position.
+	double getWeight(int position) const { return weights[position]; }
+
+	/// Returns the number of cells, or zero if build() was not called.
+	int cells() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+	/// Returns the number of connections.
+	int size() const { return neighbors.size(); }
+
+private:
+	std::vector<int> offsets; ///< position of the first neighbor of each cell, plus the total
+	std::vector<int> neighbors; ///< ordinals of the neighbors
+	std::vector<double> weights; ///< weights of the connections
+	std::vector<int> origins; ///< origins of the connections, used only before build()
+	bool sorted; ///< whether the connections were added ordered by origin
+};
+
+#endif // CSR_NEIGHBORHOOD_H
@@ -0,0 +1,308 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+/*! \file csvReader.cpp
+	\brief This file contains the implementation of the reader of CSV files.
+*/
+
+#include "csvReader.h"
+
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+static bool isSpace(char c)
+{
+	return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+/// Converts a text into an integer as Lua 5.3 does. Decimal integers that do not
+/// fit in 64 bits are not integers, while hexadecimal ones wrap around.
+static bool toInteger(const char* text, long long& integer)
+{
+	const unsigned long long maxBy10 = LLONG_MAX / 10;
+	const int maxLastDigit = LLONG_MAX % 10;
+	unsigned long long value = 0;
+	bool empty = true;
+
+	while(isSpace(*text)) text++;
+
+	bool negative = *text == '-';
+	if(*text == '-' || *text == '+') text++;
+
+	if(text[0] == '0' && (text[1] == 'x' || text[1] == 'X'))
+	{
+		for(text += 2; isxdigit((unsigned char)*text); text++)
+		{
+			int digit = isdigit((unsigned char)*text) ? *text - '0' : (tolower((unsigned char)*text) - 'a' + 10);
+			value = value * 16 + digit;
+			empty = false;
+		}
+	}
+	else
+	{
+		for(; isdigit((unsigned char)*text); text++)
+		{
+			int digit = *text - '0';
+
+			if(value >= maxBy10 && (value > maxBy10 || digit > maxLastDigit + negative))
+				return false;
+
+			value = value * 10 + digit;
+			empty = false;
+		}
+	}
+
+	while(isSpace(*text)) text++;
+
+	if(empty || *text != '\0') return false;
+
+	integer = (long long)(negative ? 0 - value : value);
+	return true;
+}
+
+/// Returns a value without the spaces around it
+static std::string trim(const char* begin, const char* end)
+{
+	while(begin < end && isSpace(*begin)) begin++;
+	while(end > begin && isSpace(*(end - 1))) end--;
+
+	return std::string(begin, end);
+}
+
+void CsvColumn::clear()
+{
+	kinds.clear();
+	numbers.clear();
+	integers.clear();
+	texts.clear();
+}
+
+CsvReader::CsvReader(const std::string& separator)
+	: separator(separator.empty() ? std::string(",") : separator), offset(0), line(0), rows(0)
+{
+}
+
+std::string CsvReader::open(const std::string& fileName)
+{
+	offset = 0;
+	line = 0;
+	rows = 0;
+	header.clear();
+	columns.clear();
+	warnings.clear();
+
+	if(!file.open(fileName))
+		return "Could not open file '" + fileName + "'.";
+
+	const char* begin;
+	const char* end;
+
+	if(!nextLine(begin, end))
+		return "File '" + fileName + "' is empty.";
+
+	line = 1;
+
+	if(!parseLine(begin, end, separator, header))
+		return invalidLine(begin, end);
+
+	columns.resize(header.size());
+	return "";
+}
+
+void CsvReader::seek(size_t position, int lastLine)
+{
+	offset = std::min(position, file.size());
+	line = lastLine;
+}
+
+std::string CsvReader::read(size_t maxRows)
+{
+	for(size_t i = 0; i < columns.size(); i++)
+		columns[i].clear();
+
+	warnings.clear();
+	rows = 0;
+
+	const char* begin;
+	const char* end;
+
+	while((maxRows == 0 || rows < maxRows) && nextLine(begin, end))
+	{
+		line++;
+
+		if(!parseLine(begin, end, separator, values))
+			return invalidLine(begin, end);
+
+		if(values.size() != header.size())
+		{
+			CsvWarning warning;
+			warning.line = line;
+			warning.text = std::string(begin, end);
+			warning.values = (int)values.size();
+			warnings.push_back(warning);
+			continue;
+		}
+
+		for(size_t i = 0; i < columns.size(); i++)
+		{
+			CsvColumn& column = columns[i];
+			double value = 0;
+			long long integer = 0;
+			CsvColumn::Kind kind = toNumber(values[i], value, integer);
+
+			column.kinds.push_back((unsigned char)kind);
+			column.numbers.push_back(value);
+
+			if(kind == CsvColumn::Text)
+				column.texts.push_back(values[i]);
+			else if(kind == CsvColumn::Integer)
+				column.integers.push_back(integer);
+		}
+
+		rows++;
+	}
+
+	return "";
+}
+
+bool CsvReader::nextLine(const char*& begin, const char*& end)
+{
+	if(offset >= file.size())
+		return false;
+
+	const char* data = file.data();
+	const char* last = data + file.size();
+
+	begin = data + offset;
+	end = (const char*)memchr(begin, '\n', last - begin);
+
+	if(end)
+		offset = end - data + 1;
+	else
+	{
+		end = last;
+		offset = file.size();
+	}
+
+	// files created on Windows
+	if(end > begin && *(end - 1) == '\r')
+		end--;
+
+	return true;
+}
+
+std::string CsvReader::invalidLine(const char* begin, const char* end) const
+{
+	std::stringstream stream;
+	stream << "Line " << line << " ('" << std::string(begin, end) << "') is invalid.";
+	return stream.str();
+}
+
+bool CsvReader::parseLine(const char* begin, const char* end, const std::string& separator,
+	std::vector<std::string>& values)
+{
+	values.clear();
+
+	const char* pos = begin;
+
+	while(pos < end)
+	{
+		if(*pos == '"')
+		{
+			// quoted value, which can contain the separator
+			std::string text;
+
+			for(;;)
+			{
+				const char* close = (const char*)memchr(pos + 1, '"', end - pos - 1);
+				if(!close) return false;
+
+				text.append(pos + 1, close);
+				pos = close + 1;
+
+				// a quoted value followed by another one represents a quote
+				if(pos == end || *pos != '"') break;
+				text += '"';
+			}
+
+			values.push_back(trim(text.data(), text.data() + text.size()));
+
+			if(pos == end) break;
+
+			if((size_t)(end - pos) < separator.size() || !std::equal(separator.begin(), separator.end(), pos))
+				return false;
+
+			pos += separator.size();
+		}
+		else
+		{
+			const char* found = std::search(pos, end, separator.begin(), separator.end());
+			values.push_back(trim(pos, found));
+
+			if(found == end) break;
+			pos = found + separator.size();
+		}
+	}
+
+	return true;
+}
+
+CsvColumn::Kind CsvReader::toNumber(const std::string& text, double& value)
+{
+	long long integer;
+	return toNumber(text, value, integer);
+}
+
+CsvColumn::Kind CsvReader::toNumber(const std::string& text, double& value, long long& integer)
+{
+	value = 0;
+	integer = 0;
+
+	if(text.empty()) return CsvColumn::Text;
+
+	if(toInteger(text.c_str(), integer))
+	{
+		value = (double)integer;
+		return CsvColumn::Integer;
+	}
+
+	// strtod also accepts infinity and nan, which are not numbers in Lua
+	if(text.find_first_of("iInN") != std::string::npos)
+		return CsvColumn::Text;
+
+	const char* begin = text.c_str();
+	char* end;
+	double result = stringToDouble(begin, &end);
+
+	if(end == begin) return CsvColumn::Text;
+
+	while(isSpace(*end)) end++;
+	if(*end != '\0') return CsvColumn::Text;
+
+	value = result;
+	return CsvColumn::Float;
+}
@@ -0,0 +1,149 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+/*! \file csvReader.h
+	\brief This file contains a reader of CSV files that stores the values by column.
+*/
+
+#ifndef CSV_READER_H
+#define CSV_READER_H
+
+#include <string>
+#include <vector>
+
+#include "neighborhoodFile.h"
+
+/**
+* \brief
+*  Values of a column of a CSV file. Each value is converted to a number when possible,
+*  as tonumber() does in Lua, otherwise it is kept as a text.
+*/
+struct CsvColumn
+{
+	/// How each value was converted
+	enum Kind
+	{
+		Text = 0,
+		Float = 1,
+		Integer = 2
+	};
+
+	std::vector<unsigned char> kinds; ///< the kind of each value
+	std::vector<double> numbers;      ///< the value of each row, or zero for texts
+	std::vector<long long> integers;  ///< the values that are integers, in the order of the rows
+	std::vector<std::string> texts;   ///< the values that are not numbers, in the order of the rows
+
+	/// Returns whether all the values of the column are numbers
+	bool isNumeric() const { return texts.empty(); }
+
+	void clear();
+};
+
+/// Line of a CSV file whose number of values is different from the header
+struct CsvWarning
+{
+	int line;
+	std::string text;
+	int values;
+};
+
+/**
+* \brief
+*  Reads CSV files mapped into memory, filling their columns directly. The first line of
+*  the file has the names of the columns. The values follow the rules of the former Lua
+*  parser: values starting with a quote can contain the separator, two quotes in sequence
+*  within a quoted value represent a quote, and the spaces around the values are removed.
+*  Lines with a different number of values from the header are skipped and reported as
+*  warnings. The file can be read in chunks of rows, continuing from the offset where the
+*  previous chunk stopped.
+*/
+class CsvReader
+{
+public:
+	/// Constructor
+	/// \param separator the separator of the values
+	CsvReader(const std::string& separator);
+
+	/// Opens a file and reads its header.
+	/// \return an empty string if the file was opened, otherwise an error message
+	std::string open(const std::string& fileName);
+
+	/// Continues reading from a given position of the file, returned by getOffset
+	/// \param offset the position in bytes
+	/// \param line the number of the last line read before the position
+	void seek(size_t offset, int line);
+
+	/// Reads the next rows, replacing the values of the columns.
+	/// \param maxRows the maximum number of rows, or zero to read until the end of the file
+	/// \return an empty string if the rows were read, otherwise an error message
+	std::string read(size_t maxRows = 0);
+
+	/// Returns whether the whole file was read
+	bool atEnd() const { return offset >= file.size(); }
+
+	/// Returns the position of the next line to be read
+	size_t getOffset() const { return offset; }
+
+	/// Returns the number of the last line read
+	int getLine() const { return line; }
+
+	/// Returns the number of rows stored in the columns
+	size_t getRows() const { return rows; }
+
+	const std::vector<std::string>& getHeader() const { return header; }
+	const std::vector<CsvColumn>& getColumns() const { return columns; }
+	const std::vector<CsvWarning>& getWarnings() const { return warnings; }
+
+	/// Splits a line into its values.
+	/// \return false if a quoted value is not followed by the separator or by the end of the line
+	static bool parseLine(const char* begin, const char* end, const std::string& separator,
+		std::vector<std::string>& values);
+
+	/// Converts a text to a number, as tonumber() does in Lua
+	/// \return the kind of the value, CsvColumn::Text if it is not a number
+	static CsvColumn::Kind toNumber(const std::string& text, double& value);
+
+	/// Converts a text to a number, as tonumber() does in Lua
+	/// \param integer returns the exact value of integers, which might not fit in a double
+	/// \return the kind of the value, CsvColumn::Text if it is not a number
+	static CsvColumn::Kind toNumber(const std::string& text, double& value, long long& integer);
+
+private:
+	/// Returns the next line of the file, without its end of line
+	bool nextLine(const char*& begin, const char*& end);
+
+	std::string invalidLine(const char* begin, const char* end) const;
+
+	std::string separator;
+	MappedFile file;
+	size_t offset;
+	int line;
+	size_t rows;
+
+	std::vector<std::string> header;
+	std::vector<CsvColumn> columns;
+	std::vector<CsvWarning> warnings;
+	std::vector<std::string> values;
+};
+
+#endif // CSV_READER_H
@@ -69,8 +69,12 @@ extern bool step;
 class EnvironmentImpl :  public Implementation
 {
     double finalTime_;	///< Time instant when the simulation should stop
+    SchedulerQueueType queueType_; ///< Event-Message queue used by the Schedulers
 
 public:
+    /// Default constructor
+    EnvironmentImpl(void) { queueType_ = TMultimapQueue; }
+
     /// Configures the time instant when the Environment should stop
     /// \param finTime is a real number when the simulation engine should stop
     void config(double finTime) {
@@ -84,6 +88,12 @@ public:
     /// Gets the time instant when the Environment should stop to run.
     /// \return A real number representing the time instant when the Environment should stop to run
     double getFinalTime() { return finalTime_; }
+
+    /// Sets the Event-Message queue used by the Schedulers of the Environment
+    void setQueueType(SchedulerQueueType type) { queueType_ = type; }
+
+    /// Gets the Event-Message queue used by the Schedulers of the Environment
+    SchedulerQueueType getQueueType() { return queueType_; }
 };
 
 class Environment;
@@ -188,6 +198,22 @@ public:
     /// \return A real number representing the time instant when the Environment should stopo to run
     double getFinalTime() { return EnvironmentInterf::pImpl_->getFinalTime(); }
 
+    /// Selects the Event-Message queue used by the Schedulers of the Environment. It changes
+    /// the Schedulers already added and the ones that will be added afterwards.
+    /// \param type is the type of the queue
+    void setSchedulerQueue(SchedulerQueueType type)
+    {
+        EnvironmentInterf::pImpl_->setQueueType(type);
+
+        TimeSchedulerPairCompositeInterf::iterator itSch;
+        itSch = TimeSchedulerPairCompositeInterf::pImpl_->begin();
+        while (itSch != TimeSchedulerPairCompositeInterf::pImpl_->end())
+        {
+            itSch->second.setQueueType(type);
+            itSch++;
+        }
+    }
+
     /// Executes the Environment. The internal Scheduler data structure is put to work.
     /// \return Always returns true.
     virtual bool execute(void) {
@@ -365,6 +391,8 @@ public:
     /// \param timeSchedulerPair is a reference to a Time-Scheduler pair being added.
     void add(const pair<Event, Scheduler> &timeSchedulerPair)
 	{
+        Scheduler scheduler = timeSchedulerPair.second;
+        scheduler.setQueueType(EnvironmentInterf::pImpl_->getQueueType());
         TimeSchedulerPairCompositeInterf::add(timeSchedulerPair);
     }
 
@@ -0,0 +1,141 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+/*! \file eventQueue.h
+	\brief This file contains the priority queue used by luaTimer to order its Events.
+*/
+
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+#include <vector>
+#include <algorithm>
+
+/**
+* \brief
+*  Binary heap of Events ordered by time, priority, and insertion order.
+*  Each Event is identified by an integer handle returned by push(). Handles of
+*  removed Events are reused by the next insertions.
+*/
+class EventQueue
+{
+public:
+	/// Constructor
+	EventQueue() : counter(0) {}
+
+	/// Inserts a new Event and returns its handle.
+	/// \param time the instant the Event will occur
+	/// \param priority the Event priority. Higher numbers mean lower priority.
+	int push(double time, double priority)
+	{
+		Entry entry;
+		entry.time = time;
+		entry.priority = priority;
+		entry.order = counter++;
+
+		if(freeHandles.empty())
+		{
+			entry.handle = (int)heap.size() + (int)freeHandles.size();
+		}
+		else
+		{
+			entry.handle = freeHandles.back();
+			freeHandles.pop_back();
+		}
+
+		heap.push_back(entry);
+		std::push_heap(heap.begin(), heap.end(), After());
+		return entry.handle;
+	}
+
+	/// Returns the handle of the next Event to be executed. The queue must not be empty.
+	int top() const { return heap.front().handle; }
+
+	/// Returns the time of the next Event to be executed. The queue must not be empty.
+	double topTime() const { return heap.front().time; }
+
+	/// Removes the next Event to be executed. Its handle can be reused afterwards.
+	void pop()
+	{
+		std::pop_heap(heap.begin(), heap.end(), After());
+		freeHandles.push_back(heap.back().handle);
+		heap.pop_back();
+	}
+
+	/// Returns whether the queue is empty.
+	bool empty() const { return heap.empty(); }
+
+	/// Returns the number of Events in the queue.
+	int size() const { return (int)heap.size(); }
+
+	/// Removes all Events.
+	void clear()
+	{
+		heap.clear();
+		freeHandles.clear();
+		counter = 0;
+	}
+
+	/// Fills a vector with the handles of the Events in execution order.
+	void sorted(std::vector<int>& handles) const
+	{
+		std::vector<Entry> entries(heap);
+		std::sort(entries.begin(), entries.end(), Before());
+
+		handles.clear();
+		handles.reserve(entries.size());
+		for(unsigned int i = 0; i < entries.size(); i++)
+			handles.push_back(entries[i].handle);
+	}
+
+private:
+	struct Entry
+	{
+		double time;
+		double priority;
+		unsigned long long order;
+		int handle;
+	};
+
+	struct Before
+	{
+		bool operator()(const Entry& a, const Entry& b) const
+		{
+			if(a.time != b.time) return a.time < b.time;
+			if(a.priority != b.priority) return a.priority < b.priority;
+			return a.order < b.order;
+		}
+	};
+
+	// std heap functions keep the greatest element on top
+	struct After
+	{
+		bool operator()(const Entry& a, const Entry& b) const { return Before()(b, a); }
+	};
+
+	std::vector<Entry> heap;
+	std::vector<int> freeHandles;
+	unsigned long long counter;
+};
+
+#endif // EVENT_QUEUE_H
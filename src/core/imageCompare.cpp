@@ -23,10 +23,19 @@ of this software and its documentation.
 
 #include "imageCompare.h"
 
-#include <iostream>
+#include <QRunnable>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
 
 using namespace std;
 
+/// Number of lines below which the images are compared by a single thread
+static const int MIN_PARALLEL_LINES = 128;
+
 void imageSize(const QString &img, int &width, int &height)
 {
 	QImage image(img);
@@ -35,28 +44,148 @@ void imageSize(const QString &img, int &width, int &height)
 	height = image.height();
 }
 
-double comparePerPixel(const QString &img1, const QString &img2)
+/// Converts an image to a format with one 32-bit word per pixel, as returned by QImage::pixel
+static QImage toWords(const QImage &image)
 {
-	QImage image1(img1);
-	QImage image2(img2);
+	if ((image.format() == QImage::Format_RGB32) || (image.format() == QImage::Format_ARGB32))
+		return image;
 
-	if (image1.width() == 0 || image1.height() == 0)
-		return 1;
+	return image.convertToFormat(QImage::Format_ARGB32);
+}
 
-	if (image2.width() == 0 || image2.height() == 0)
-		return 1;
+static int channelDelta(QRgb p1, QRgb p2)
+{
+	int delta = abs(qRed(p1) - qRed(p2));
+	delta = max(delta, abs(qGreen(p1) - qGreen(p2)));
+	delta = max(delta, abs(qBlue(p1) - qBlue(p2)));
+	return max(delta, abs(qAlpha(p1) - qAlpha(p2)));
+}
 
-	if (image1.width() != image2.width() || image1.height() != image2.height())
-		return 1;
+/// Compares a band of lines of two images
+class CompareBand : public QRunnable
+{
+public:
+	CompareBand(const QImage &image1, const QImage &image2, int top, int bottom)
+		: image1(image1), image2(image2), top(top), bottom(bottom)
+	{
+		setAutoDelete(false);
+	}
 
-    double count = 0;
-    for (int i = 0; i < image1.height(); i++)
-        for (int j = 0; j < image1.width(); j++)
-			if (image1.pixel(j, i) != image2.pixel(j, i))
+	void run()
+	{
+		int width = image1.width();
+		int left = width, right = -1, first = -1, last = -1;
+
+		for (int i = top; i < bottom; i++)
+		{
+			const QRgb *line1 = reinterpret_cast<const QRgb *>(image1.constScanLine(i));
+			const QRgb *line2 = reinterpret_cast<const QRgb *>(image2.constScanLine(i));
+
+			// most of the lines are equal, and memcmp compares whole vectors at once
+			if (memcmp(line1, line2, width * sizeof(QRgb)) == 0)
+				continue;
+
+			// branchless, so that the compiler can use vector instructions
+			int count = 0;
+			for (int j = 0; j < width; j++)
+				count += line1[j] != line2[j];
+
+			diff.pixels += count;
+
+			int begin = 0;
+			while (line1[begin] == line2[begin])
+				begin++;
+
+			int end = width - 1;
+			while (line1[end] == line2[end])
+				end--;
+
+			for (int j = begin; j <= end; j++)
 			{
-                count = count + 1;
-            }
+				if (line1[j] != line2[j])
+					diff.maxDelta = max(diff.maxDelta, channelDelta(line1[j], line2[j]));
+			}
+
+			left = min(left, begin);
+			right = max(right, end);
+
+			if (first < 0)
+				first = i;
+			last = i;
+		}
+
+		if (first >= 0)
+			diff.bounds = QRect(QPoint(left, first), QPoint(right, last));
+	}
+
+	ImageDifference diff;
 
-	return count /(image1.width() * image1.height());
+private:
+	const QImage &image1;
+	const QImage &image2;
+	int top, bottom;
+};
+
+bool compareImages(const QImage &image1, const QImage &image2, ImageDifference &diff)
+{
+	diff = ImageDifference();
+
+	if (image1.isNull() || image2.isNull() || (image1.size() != image2.size()))
+		return false;
+
+	QImage words1 = toWords(image1);
+	QImage words2 = toWords(image2);
+
+	int height = words1.height();
+	int bands = 1;
+	QThreadPool pool;
+
+	if (height >= MIN_PARALLEL_LINES)
+		bands = min(pool.maxThreadCount(), height / (MIN_PARALLEL_LINES / 2));
+	bands = max(bands, 1);
+
+	int bandHeight = (height + bands - 1) / bands;
+	vector<CompareBand *> tasks;
+
+	for (int top = 0; top < height; top += bandHeight)
+		tasks.push_back(new CompareBand(words1, words2, top, min(top + bandHeight, height)));
+
+	if (tasks.size() == 1)
+	{
+		tasks.front()->run();
+	}
+	else
+	{
+		for (unsigned i = 0; i < tasks.size(); i++)
+			pool.start(tasks[i]);
+
+		pool.waitForDone();
+	}
+
+	for (unsigned i = 0; i < tasks.size(); i++)
+	{
+		diff.pixels += tasks[i]->diff.pixels;
+		diff.maxDelta = max(diff.maxDelta, tasks[i]->diff.maxDelta);
+		diff.bounds |= tasks[i]->diff.bounds;
+		delete tasks[i];
+	}
+
+	return true;
 }
 
+double comparePerPixel(const QString &img1, const QString &img2)
+{
+	ImageDifference diff;
+	return comparePerPixel(img1, img2, diff);
+}
+
+double comparePerPixel(const QString &img1, const QString &img2, ImageDifference &diff)
+{
+	QImage image1(img1);
+	QImage image2(img2);
+
+	if (!compareImages(image1, image2, diff))
+		return 1;
+
+	return diff.pixels / (double(image1.width()) * image1.height());
+}
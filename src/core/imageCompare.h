@@ -25,9 +25,27 @@ of this software and its documentation.
 #define IMAGE_COMPARE
 
 #include <qimage.h>
+#include <qrect.h>
+
+/// Differences found between two images with the same size
+struct ImageDifference
+{
+	ImageDifference() : pixels(0), maxDelta(0) {}
+
+	int pixels;   ///< number of pixels that differ
+	int maxDelta; ///< largest difference between the two images in a single channel
+	QRect bounds; ///< smallest rectangle with all the pixels that differ
+};
 
 void imageSize(const QString &img, int &width, int &height);
+
+/// Compares two images pixel by pixel, splitting their lines among threads.
+/// Returns false if some image is empty or if they have different sizes
+bool compareImages(const QImage &image1, const QImage &image2, ImageDifference &diff);
+
+/// Returns the fraction of pixels that differ, or 1 if the images cannot be compared
 double comparePerPixel(const QString &img1, const QString &img2);
+double comparePerPixel(const QString &img1, const QString &img2, ImageDifference &diff);
 
 #endif
 
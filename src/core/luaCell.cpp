@@ -60,6 +60,9 @@ luaCell::luaCell(lua_State *L)
 
     attrNeighName = "";
 
+	space = 0;
+	ordinal = -1;
+
 	lua = terrame::lua::LuaSystem::getInstance().getLuaApi();
 }
 
@@ -250,7 +253,12 @@ const char* luaCell::getID()
 
 int luaCell::setID(lua_State *L)
 {
+    string oldID = objectId_;
     objectId_ = lua->getStringAtTop(L);
+
+	if(space)
+		space->updateCellID(this, oldID);
+
     return 0;
 }
 
@@ -269,6 +277,133 @@ CellIndex luaCell::getIndex()
     return this->idx;
 }
 
+/// Gets the value of an attribute stored in the columns of the CellularSpace
+/// parameters: column index
+int luaCell::getAttribute(lua_State *L)
+{
+	if(!space)
+	{
+		lua->pushNil(L);
+		return 1;
+	}
+
+	CellAttributes& columns = space->getAttributes();
+	int col = lua->getIntegerAt(L, -1);
+
+	if(col < 0 || col >= columns.count())
+	{
+		lua->pushNil(L);
+		return 1;
+	}
+
+	switch(columns.getType(col))
+	{
+		case CellAttributes::TInteger:
+			lua->pushInteger(L, columns.getInteger(col, ordinal));
+			break;
+		case CellAttributes::TBoolean:
+			lua->pushBoolean(L, columns.getBoolean(col, ordinal));
+			break;
+		default:
+			lua->pushNumber(L, columns.getNumber(col, ordinal));
+	}
+
+	return 1;
+}
+
+/// Sets the value of an attribute stored in the columns of the CellularSpace
+/// parameters: column index, value
+int luaCell::setAttribute(lua_State *L)
+{
+	if(!space)
+	{
+		lua->callError(L, "Cell does not belong to a CellularSpace with columnar attributes.");
+		return 0;
+	}
+
+	CellAttributes& columns = space->getAttributes();
+	int col = lua->getIntegerAt(L, -2);
+
+	if(col < 0 || col >= columns.count())
+	{
+		lua->callError(L, "Invalid attribute column.");
+		return 0;
+	}
+
+	const std::string& name = columns.getName(col);
+
+	if(columns.getType(col) == CellAttributes::TBoolean)
+	{
+		if(!lua->isBooleanAt(L, -1))
+		{
+			lua->callError(L, "Attribute '" + name + "' can only store boolean values.");
+			return 0;
+		}
+
+		columns.setBoolean(col, ordinal, lua->toBooleanAt(L, -1));
+	}
+	else
+	{
+		if(!lua->isNumberAt(L, -1))
+		{
+			lua->callError(L, "Attribute '" + name + "' can only store number values.");
+			return 0;
+		}
+
+		if(lua->isIntegerAt(L, -1))
+			columns.setNumber(col, ordinal, (double)lua->toIntegerAt(L, -1));
+		else
+			columns.setNumber(col, ordinal, lua->getNumberAt(L, -1));
+	}
+
+	return 0;
+}
+
+/// Gets the value of an attribute at the last synchronization of the CellularSpace
+/// parameters: column index
+int luaCell::getPastAttribute(lua_State *L)
+{
+	if(!space)
+	{
+		lua->pushNil(L);
+		return 1;
+	}
+
+	CellAttributes& columns = space->getAttributes();
+	int col = lua->getIntegerAt(L, -1);
+
+	if(col < 0 || col >= columns.count() || !columns.isSynchronized(col))
+	{
+		lua->pushNil(L);
+		return 1;
+	}
+
+	switch(columns.getType(col))
+	{
+		case CellAttributes::TInteger:
+			lua->pushInteger(L, columns.getPastInteger(col, ordinal));
+			break;
+		case CellAttributes::TBoolean:
+			lua->pushBoolean(L, columns.getPastBoolean(col, ordinal));
+			break;
+		default:
+			lua->pushNumber(L, columns.getPastNumber(col, ordinal));
+	}
+
+	return 1;
+}
+
+void luaCell::setCellularSpace(luaCellularSpace* cs, int position)
+{
+	space = cs;
+	ordinal = position;
+}
+
+int luaCell::getOrdinal()
+{
+	return ordinal;
+}
+
 /// Creates several types of observers
 /// parameters: observer type, observeb attributes table, observer type parameters
 // verif. ref (endereco na pilha lua)
@@ -315,6 +450,14 @@ int luaCell::createObserver(lua_State *)
             lua->popOneElement(luaL);
         }
 
+        // atributos armazenados nas colunas do espaco celular
+        if (space)
+        {
+            CellAttributes& columns = space->getAttributes();
+            for (int col = 0; col < columns.count(); col++)
+                allAttribs.push_back(QString(columns.getName(col).c_str()));
+        }
+
         //------------------------
         // pecorre a pilha lua recuperando
         // os atributos celula que se quer observar
@@ -633,6 +776,23 @@ int luaCell::createObserver(lua_State *)
 
             return 2;
         }
+
+        if (obsTCPSender)
+        {
+            obsTCPSender->setAttributes(obsAttribs);
+
+            for (int i = 1; i < cols.size(); i++)
+            {
+                if (!cols.at(i).isEmpty())
+                    obsTCPSender->addHost(cols.at(i));
+            }
+            obsTCPSender->connectTo(cols.at(0).toInt());
+
+            lua->pushNumber(luaL, obsId);
+            lua->pushLightUserdata(luaL, (void*) obsTCPSender);
+
+            return 2;
+        }
     }
     //@RAIAN
     // Comeca a criacao do Observer do tipo Neighborhood
@@ -955,6 +1115,8 @@ QString luaCell::pop(lua_State *luaL, QStringList& attribs)
             lua->popOneElement(luaL);
         }
 
+        popColumns(attribs, attrs, attrCounter);
+
         //@RAIAN: Para uso na serializacao da Vizinhanca
         if (attribs.contains("@getWeight"))
         {
@@ -983,6 +1145,41 @@ QString luaCell::pop(lua_State *luaL, QStringList& attribs)
     return msg;
 }
 
+/// Serializes the observed attributes stored in the columns of the CellularSpace
+void luaCell::popColumns(QStringList& attribs, QString& attrs, int& attrCounter)
+{
+	if(!space) return;
+
+	CellAttributes& columns = space->getAttributes();
+	QString text;
+
+	for(int col = 0; col < columns.count(); col++)
+	{
+		QString key(columns.getName(col).c_str());
+
+		if(!attribs.contains(key)) continue;
+
+		attrCounter++;
+		attrs.append(key);
+		attrs.append(PROTOCOL_SEPARATOR);
+
+		if(columns.getType(col) == CellAttributes::TBoolean)
+		{
+			attrs.append(QString::number(TObsBool));
+			attrs.append(PROTOCOL_SEPARATOR);
+			attrs.append(QString::number(columns.getBoolean(col, ordinal)));
+		}
+		else
+		{
+			doubleToQString(columns.getNumber(col, ordinal), text, 20);
+			attrs.append(QString::number(TObsNumber));
+			attrs.append(PROTOCOL_SEPARATOR);
+			attrs.append(text);
+		}
+		attrs.append(PROTOCOL_SEPARATOR);
+	}
+}
+
 QString luaCell::getChanges(QDataStream& in, int observerId, QStringList& attribs)
 {
     return getAll(in, observerId, attribs);
@@ -36,6 +36,8 @@ of this software and its documentation.
 #include "luaCellularSpace.h"
 #include "LuaApi.h"
 
+class luaCellularSpace;
+
 //@Rodrigo /Antonio
 // class ServerSession;
 
@@ -146,6 +148,26 @@ public:
 	/// \author Raian Vargas Maretto
         CellIndex getIndex();
 
+	/// Gets the value of an attribute stored in the columns of the CellularSpace
+	/// parameters: column index
+	int getAttribute(lua_State *L);
+
+	/// Sets the value of an attribute stored in the columns of the CellularSpace
+	/// parameters: column index, value
+	int setAttribute(lua_State *L);
+
+	/// Gets the value of an attribute at the last synchronization of the CellularSpace
+	/// parameters: column index
+	int getPastAttribute(lua_State *L);
+
+	/// Links the luaCell to the columnar attributes of a luaCellularSpace
+	/// \param cs the luaCellularSpace that stores the attributes
+	/// \param position the ordinal of the cell within cs
+	void setCellularSpace(luaCellularSpace* cs, int position);
+
+	/// Gets the ordinal of the cell within its luaCellularSpace, or -1 if it does not belong to one
+	int getOrdinal();
+
     /// Creates several types of observers
     /// parameters: observer type, observeb attributes table, observer type parameters
     int createObserver(lua_State *L);
@@ -188,6 +210,11 @@ private:
     QStringList observedAttribs;
     QString attrNeighName;
 
+	luaCellularSpace* space; ///< CellularSpace that stores the columnar attributes
+	int ordinal; ///< Position of the cell in the columns of space
+
+	void popColumns(QStringList& attribs, QString& attrs, int& attrCounter);
+
     QString getAll(QDataStream& in, int obsId, QStringList& attribs);
     QString getChanges(QDataStream& in, int obsId, QStringList& attribs);
 };
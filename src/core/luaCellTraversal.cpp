@@ -0,0 +1,587 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+/*! \file luaCellTraversal.cpp
+	\brief This file contains the execution of Lua functions over the cells of a CellularSpace in parallel.
+*/
+
+#include "luaCellTraversal.h"
+
+#include <cstring>
+
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+
+extern "C"
+{
+	#include "lua.h"
+	#include "lauxlib.h"
+	#include "lualib.h"
+}
+
+/// Proxy of a cell within a worker: the cell being visited, a neighbor, or their past values
+struct CellView
+{
+	CellWorker* worker;
+	const int* ordinal;
+	bool visited;
+	bool past;
+};
+
+/// Returns the error at the top of the stack as a string. Functions can raise
+/// values that are not strings, such as error({}) or error()
+static std::string errorMessage(lua_State* L)
+{
+	const char* message = lua_tostring(L, -1);
+
+	if(message)
+		return message;
+
+	return std::string("(error object is a ") + luaL_typename(L, -1) + " value)";
+}
+
+/**
+* \brief
+*  Thread that executes partitions of a LuaCellTraversal in its own lua_State.
+*/
+class CellWorker : public QRunnable
+{
+public:
+	CellWorker(LuaCellTraversal& owner) : owner(owner), L(0), cell(0), neighbor(0), random(0)
+	{
+		setAutoDelete(false);
+	}
+
+	~CellWorker()
+	{
+		if(L) lua_close(L);
+	}
+
+	void run()
+	{
+		if(!load()) return;
+
+		CellTraversal& traversal = owner.traversal;
+		int partition;
+
+		while((partition = owner.nextPartition()) >= 0)
+		{
+			CellRandom stream(owner.seed, partition);
+			random = &stream;
+
+			int last = traversal.end(partition);
+
+			for(cell = traversal.begin(partition); cell < last; cell++)
+			{
+				if(owner.isStopped()) return;
+
+				lua_rawgeti(L, LUA_REGISTRYINDEX, functionRef);
+				lua_rawgeti(L, LUA_REGISTRYINDEX, cellRef);
+				lua_pushinteger(L, cell + 1);
+
+				if(lua_pcall(L, 2, 1, 0) != LUA_OK)
+				{
+					owner.fail(errorMessage(L));
+					return;
+				}
+
+				if(lua_isboolean(L, -1) && !lua_toboolean(L, -1))
+					owner.interrupt();
+
+				lua_pop(L, 1);
+			}
+
+			random = 0;
+		}
+	}
+
+	/// Calls a function for each neighbor of the cell being visited.
+	/// The arguments are the neighbor, the weight, and the cell.
+	int forEachNeighbor(const char* name, int function)
+	{
+		std::map<std::string, LuaCellTraversal::Neighborhood>::const_iterator it = owner.neighborhoods.find(name);
+
+		if(it == owner.neighborhoods.end())
+		{
+			if(!strcmp(name, "1"))
+				return luaL_error(L, "The CellularSpace does not have a default neighborhood. Please call 'CellularSpace:createNeighborhood' first.");
+
+			return luaL_error(L, "Neighborhood '%s' does not exist.", name);
+		}
+
+		const CellGrid& grid = owner.traversal.getGrid();
+		const std::pair<int, int>& coord = grid.getCoord(cell);
+		const LuaCellTraversal::Neighborhood& neighborhood = it->second;
+		int first = 0;
+		int last;
+		double weight = 1;
+		const CSRNeighborhood* csr = 0;
+
+		if(neighborhood.stencil)
+		{
+			weight = owner.stencils[neighborhood.index].neighbors(grid, coord.first, coord.second, buffer);
+			last = buffer.size();
+		}
+		else
+		{
+			csr = &owner.graphs[neighborhood.index];
+			if(cell >= csr->cells())
+			{
+				lua_pushboolean(L, 1);
+				return 1;
+			}
+
+			first = csr->begin(cell);
+			last = csr->end(cell);
+		}
+
+		for(int p = first; p < last; p++)
+		{
+			if(csr)
+			{
+				neighbor = csr->getNeighbor(p);
+				weight = csr->getWeight(p);
+			}
+			else
+				neighbor = buffer[p];
+
+			lua_pushvalue(L, function);
+			lua_rawgeti(L, LUA_REGISTRYINDEX, neighborRef);
+			lua_pushnumber(L, weight);
+			lua_rawgeti(L, LUA_REGISTRYINDEX, cellRef);
+			lua_call(L, 3, 1);
+
+			if(lua_isboolean(L, -1) && !lua_toboolean(L, -1))
+				return 1;
+
+			lua_pop(L, 1);
+		}
+
+		lua_pushboolean(L, 1);
+		return 1;
+	}
+
+	CellTraversal& getTraversal() { return owner.traversal; }
+
+	LuaCellTraversal& owner;
+	lua_State* L;
+	int cell;
+	int neighbor;
+	CellRandom* random;
+	int cellRef;
+
+private:
+	bool load();
+	int createView(CellView& view, int pastRef);
+
+	std::vector<int> buffer;
+	CellView views[4];
+	int functionRef;
+	int columnsRef;
+	int neighborRef;
+};
+
+static void pushValue(lua_State* L, const CellView* view, int column)
+{
+	CellTraversal& traversal = view->worker->getTraversal();
+	const CellAttributes& attributes = traversal.getAttributes();
+	int ordinal = *view->ordinal;
+	CellAttributes::Type type = attributes.getType(column);
+
+	if(view->past)
+	{
+		if(!attributes.isSynchronized(column))
+			lua_pushnil(L);
+		else if(type == CellAttributes::TInteger)
+			lua_pushinteger(L, attributes.getPastInteger(column, ordinal));
+		else if(type == CellAttributes::TBoolean)
+			lua_pushboolean(L, attributes.getPastBoolean(column, ordinal));
+		else
+			lua_pushnumber(L, attributes.getPastNumber(column, ordinal));
+
+		return;
+	}
+
+	int output = view->visited ? traversal.getOutput(column) : -1;
+
+	if(output >= 0 && traversal.isWritten(output, ordinal))
+	{
+		double value = traversal.getValue(output, ordinal);
+
+		if(type == CellAttributes::TBoolean)
+			lua_pushboolean(L, value != 0);
+		else if(type == CellAttributes::TInteger && value == (lua_Integer)value)
+			lua_pushinteger(L, (lua_Integer)value);
+		else
+			lua_pushnumber(L, value);
+	}
+	else if(type == CellAttributes::TInteger)
+		lua_pushinteger(L, attributes.getInteger(column, ordinal));
+	else if(type == CellAttributes::TBoolean)
+		lua_pushboolean(L, attributes.getBoolean(column, ordinal));
+	else
+		lua_pushnumber(L, attributes.getNumber(column, ordinal));
+}
+
+/// __index of the cell proxies. Upvalues: CellView, table of columns, past proxy
+static int viewIndex(lua_State* L)
+{
+	const CellView* view = (const CellView*)lua_touserdata(L, lua_upvalueindex(1));
+
+	lua_pushvalue(L, 2);
+	lua_rawget(L, lua_upvalueindex(2));
+
+	if(lua_isinteger(L, -1))
+	{
+		pushValue(L, view, (int)lua_tointeger(L, -1));
+		return 1;
+	}
+
+	if(lua_type(L, 2) == LUA_TSTRING)
+	{
+		const char* key = lua_tostring(L, 2);
+		const std::pair<int, int>& coord = view->worker->getTraversal().getGrid().getCoord(*view->ordinal);
+
+		if(!strcmp(key, "x"))
+		{
+			lua_pushinteger(L, coord.first);
+			return 1;
+		}
+		else if(!strcmp(key, "y"))
+		{
+			lua_pushinteger(L, coord.second);
+			return 1;
+		}
+		else if(!strcmp(key, "past"))
+		{
+			lua_pushvalue(L, lua_upvalueindex(3));
+			return 1;
+		}
+	}
+
+	lua_pushnil(L);
+	return 1;
+}
+
+/// __newindex of the cell proxies. Upvalues: CellView, table of columns
+static int viewNewIndex(lua_State* L)
+{
+	const CellView* view = (const CellView*)lua_touserdata(L, lua_upvalueindex(1));
+
+	if(!view->visited || view->past)
+		return luaL_error(L, "Only the Cell being visited can be updated in a parallel traversal.");
+
+	CellTraversal& traversal = view->worker->getTraversal();
+	int output = -1;
+	int column = -1;
+
+	lua_pushvalue(L, 2);
+	lua_rawget(L, lua_upvalueindex(2));
+
+	if(lua_isinteger(L, -1))
+	{
+		column = (int)lua_tointeger(L, -1);
+		output = traversal.getOutput(column);
+	}
+
+	if(output < 0)
+		return luaL_error(L, "Attribute '%s' cannot be updated because it does not belong to argument 'outputs'.",
+			luaL_tolstring(L, 2, NULL));
+
+	bool valid = false;
+
+	if(lua_type(L, 3) == LUA_TBOOLEAN)
+		valid = traversal.setBoolean(output, *view->ordinal, lua_toboolean(L, 3) != 0);
+	else if(lua_type(L, 3) == LUA_TNUMBER)
+		valid = traversal.setNumber(output, *view->ordinal, lua_tonumber(L, 3));
+
+	if(!valid)
+	{
+		bool boolean = traversal.getAttributes().getType(column) == CellAttributes::TBoolean;
+		return luaL_error(L, "Attribute '%s' should be %s, got %s.", luaL_tolstring(L, 2, NULL),
+			boolean ? "boolean" : "number", luaL_typename(L, 3));
+	}
+
+	return 0;
+}
+
+/// forEachNeighbor(cell, [name], function) within the workers. Upvalue: CellWorker
+static int workerForEachNeighbor(lua_State* L)
+{
+	CellWorker* worker = (CellWorker*)lua_touserdata(L, lua_upvalueindex(1));
+
+	lua_rawgeti(L, LUA_REGISTRYINDEX, worker->cellRef);
+	if(!lua_rawequal(L, 1, -1))
+		return luaL_error(L, "Only the neighbors of the Cell being visited can be traversed in a parallel traversal.");
+
+	lua_pop(L, 1);
+
+	const char* name = "1";
+	int function = 2;
+
+	if(lua_type(L, 2) == LUA_TSTRING)
+	{
+		name = lua_tostring(L, 2);
+		function = 3;
+	}
+
+	luaL_checktype(L, function, LUA_TFUNCTION);
+	return worker->forEachNeighbor(name, function);
+}
+
+/// math.random within the workers, using the stream of the partition. Upvalue: CellWorker
+static int workerRandom(lua_State* L)
+{
+	CellWorker* worker = (CellWorker*)lua_touserdata(L, lua_upvalueindex(1));
+	CellRandom* random = worker->random;
+	lua_Integer low, up;
+
+	switch(lua_gettop(L))
+	{
+		case 0:
+			lua_pushnumber(L, random->number());
+			return 1;
+		case 1:
+			low = 1;
+			up = luaL_checkinteger(L, 1);
+			break;
+		case 2:
+			low = luaL_checkinteger(L, 1);
+			up = luaL_checkinteger(L, 2);
+			break;
+		default:
+			return luaL_error(L, "wrong number of arguments");
+	}
+
+	luaL_argcheck(L, low <= up, lua_gettop(L), "interval is empty");
+	lua_pushinteger(L, random->integer(low, up));
+	return 1;
+}
+
+static int workerRandomSeed(lua_State* L)
+{
+	return luaL_error(L, "Function math.randomseed cannot be used in a parallel traversal.");
+}
+
+int CellWorker::createView(CellView& view, int pastRef)
+{
+	lua_newtable(L);
+	lua_newtable(L);
+
+	lua_pushlightuserdata(L, &view);
+	lua_rawgeti(L, LUA_REGISTRYINDEX, columnsRef);
+	if(pastRef == LUA_NOREF)
+		lua_pushnil(L);
+	else
+		lua_rawgeti(L, LUA_REGISTRYINDEX, pastRef);
+	lua_pushcclosure(L, viewIndex, 3);
+	lua_setfield(L, -2, "__index");
+
+	lua_pushlightuserdata(L, &view);
+	lua_rawgeti(L, LUA_REGISTRYINDEX, columnsRef);
+	lua_pushcclosure(L, viewNewIndex, 2);
+	lua_setfield(L, -2, "__newindex");
+
+	lua_setmetatable(L, -2);
+	return luaL_ref(L, LUA_REGISTRYINDEX);
+}
+
+bool CellWorker::load()
+{
+	L = luaL_newstate();
+	luaL_openlibs(L);
+
+	const std::string& chunk = owner.chunk;
+	if(luaL_loadbuffer(L, chunk.data(), chunk.size(), "=forEachCell") != LUA_OK)
+	{
+		owner.fail(errorMessage(L));
+		return false;
+	}
+
+	const char* name;
+	for(int i = 1; (name = lua_getupvalue(L, -1, i)) != NULL; i++)
+	{
+		lua_pop(L, 1);
+
+		if(!strcmp(name, "_ENV"))
+		{
+			lua_rawgeti(L, LUA_REGISTRYINDEX, LUA_RIDX_GLOBALS);
+			lua_setupvalue(L, -2, i);
+		}
+	}
+
+	for(unsigned int i = 0; i < owner.constants.size(); i++)
+	{
+		const LuaCellTraversal::Constant& constant = owner.constants[i];
+
+		if(constant.type == LUA_TBOOLEAN)
+			lua_pushboolean(L, constant.integer);
+		else if(constant.type == LUA_TSTRING)
+			lua_pushlstring(L, constant.text.data(), constant.text.size());
+		else if(constant.integer)
+			lua_pushinteger(L, (lua_Integer)constant.number);
+		else
+			lua_pushnumber(L, constant.number);
+
+		if(!lua_setupvalue(L, -2, constant.upvalue))
+			lua_pop(L, 1);
+	}
+
+	functionRef = luaL_ref(L, LUA_REGISTRYINDEX);
+
+	const CellAttributes& attributes = owner.traversal.getAttributes();
+
+	lua_createtable(L, 0, attributes.count());
+	for(int i = 0; i < attributes.count(); i++)
+	{
+		lua_pushinteger(L, i);
+		lua_setfield(L, -2, attributes.getName(i).c_str());
+	}
+	columnsRef = luaL_ref(L, LUA_REGISTRYINDEX);
+
+	CellView cellView = {this, &cell, true, false};
+	CellView neighborView = {this, &neighbor, false, false};
+
+	views[0] = cellView;
+	views[1] = cellView;
+	views[1].past = true;
+	views[2] = neighborView;
+	views[3] = neighborView;
+	views[3].past = true;
+
+	cellRef = createView(views[0], createView(views[1], LUA_NOREF));
+	neighborRef = createView(views[2], createView(views[3], LUA_NOREF));
+
+	lua_pushlightuserdata(L, this);
+	lua_pushcclosure(L, workerForEachNeighbor, 1);
+	lua_setglobal(L, "forEachNeighbor");
+
+	lua_getglobal(L, "math");
+	lua_pushlightuserdata(L, this);
+	lua_pushcclosure(L, workerRandom, 1);
+	lua_setfield(L, -2, "random");
+	lua_pushcfunction(L, workerRandomSeed);
+	lua_setfield(L, -2, "randomseed");
+	lua_pop(L, 1);
+
+	return true;
+}
+
+LuaCellTraversal::LuaCellTraversal(CellTraversal& traversal, const std::vector<StencilNeighborhood>& stencils,
+		const std::vector<CSRNeighborhood>& graphs)
+	: traversal(traversal), stencils(stencils), graphs(graphs), seed(0)
+{
+}
+
+void LuaCellTraversal::setFunction(const std::string& chunk)
+{
+	this->chunk = chunk;
+}
+
+void LuaCellTraversal::addConstant(int upvalue, double value, bool integer)
+{
+	Constant constant = {upvalue, LUA_TNUMBER, value, integer, ""};
+	constants.push_back(constant);
+}
+
+void LuaCellTraversal::addConstant(int upvalue, const std::string& value)
+{
+	Constant constant = {upvalue, LUA_TSTRING, 0, false, value};
+	constants.push_back(constant);
+}
+
+void LuaCellTraversal::addConstant(int upvalue, bool value)
+{
+	Constant constant = {upvalue, LUA_TBOOLEAN, 0, value, ""};
+	constants.push_back(constant);
+}
+
+void LuaCellTraversal::addNeighborhood(const std::string& name, bool stencil, int index)
+{
+	Neighborhood neighborhood = {stencil, index};
+	neighborhoods[name] = neighborhood;
+}
+
+std::string LuaCellTraversal::run(int threads, unsigned int seed, bool& completed)
+{
+	this->seed = seed;
+	next.store(0);
+	state.store(Running);
+	error.clear();
+
+	int partitions = traversal.getPartitions();
+
+	if(threads < 1)
+		threads = QThread::idealThreadCount();
+
+	if(threads > partitions)
+		threads = partitions;
+
+	std::vector<CellWorker*> workers;
+	QThreadPool pool;
+	pool.setMaxThreadCount(threads < 1 ? 1 : threads);
+
+	for(int i = 0; i < threads; i++)
+	{
+		workers.push_back(new CellWorker(*this));
+		pool.start(workers.back());
+	}
+
+	pool.waitForDone();
+
+	for(unsigned int i = 0; i < workers.size(); i++)
+		delete workers[i];
+
+	if(state.load() == Failed)
+		return error;
+
+	traversal.commit();
+	completed = state.load() == Running;
+	return "";
+}
+
+int LuaCellTraversal::nextPartition()
+{
+	int partition = next.fetchAndAddOrdered(1);
+	return partition < traversal.getPartitions() ? partition : -1;
+}
+
+bool LuaCellTraversal::isStopped() const
+{
+	return state.load() != Running;
+}
+
+void LuaCellTraversal::interrupt()
+{
+	state.testAndSetOrdered(Running, Interrupted);
+}
+
+void LuaCellTraversal::fail(const std::string& message)
+{
+	QMutexLocker locker(&errorMutex);
+
+	if(state.fetchAndStoreOrdered(Failed) != Failed)
+		error = message;
+}
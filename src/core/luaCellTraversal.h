@@ -0,0 +1,134 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+/*! \file luaCellTraversal.h
+	\brief This file contains the execution of Lua functions over the cells of a CellularSpace in parallel.
+*/
+
+#ifndef LUA_CELL_TRAVERSAL_H
+#define LUA_CELL_TRAVERSAL_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <QAtomicInt>
+#include <QMutex>
+
+#include "cellTraversal.h"
+#include "stencilNeighborhood.h"
+#include "csrNeighborhood.h"
+
+class CellWorker;
+
+/**
+* \brief
+*  Executes a Lua function for each cell of a columnar CellularSpace using several
+*  threads. Each thread has its own lua_State, where the function is loaded from its
+*  binary chunk. Cells are represented by proxies that read the columnar attributes,
+*  their coordinates, and their past values. Only the output attributes of the cell
+*  being visited can be updated, and the new values are applied after all the cells
+*  are visited. math.random uses the stream of random numbers of the partition of
+*  the cell, therefore results do not depend on the number of threads.
+*/
+class LuaCellTraversal
+{
+public:
+	/// Constructor
+	/// \param traversal the partitions and the output buffers of the cells
+	/// \param stencils the neighborhoods defined by offsets
+	/// \param graphs the neighborhoods stored as graphs
+	LuaCellTraversal(CellTraversal& traversal, const std::vector<StencilNeighborhood>& stencils,
+		const std::vector<CSRNeighborhood>& graphs);
+
+	/// Sets the function to be executed, as returned by string.dump
+	void setFunction(const std::string& chunk);
+
+	/// Sets the value of an upvalue of the function
+	/// \param upvalue the position of the upvalue
+	void addConstant(int upvalue, double value, bool integer);
+	void addConstant(int upvalue, const std::string& value);
+	void addConstant(int upvalue, bool value);
+
+	/// Makes a neighborhood available to forEachNeighbor
+	/// \param name the name of the neighborhood
+	/// \param stencil whether it is a stencil (true) or a graph (false)
+	/// \param index the position of the neighborhood in its vector
+	void addNeighborhood(const std::string& name, bool stencil, int index);
+
+	/// Executes the function for each cell and updates the output attributes.
+	/// \param threads the number of threads, or zero to use one per processor
+	/// \param seed the seed of the random numbers
+	/// \param completed false if some call returned false, stopping the traversal
+	/// \return an empty string if all the calls were executed, otherwise the error message
+	std::string run(int threads, unsigned int seed, bool& completed);
+
+private:
+	friend class CellWorker;
+
+	/// Constant value copied to an upvalue of the function
+	struct Constant
+	{
+		int upvalue;
+		int type;
+		double number;
+		bool integer;
+		std::string text;
+	};
+
+	struct Neighborhood
+	{
+		bool stencil;
+		int index;
+	};
+
+	/// Returns the next partition to be executed, or -1 if there is none
+	int nextPartition();
+
+	bool isStopped() const;
+	void interrupt();
+	void fail(const std::string& message);
+
+	CellTraversal& traversal;
+	const std::vector<StencilNeighborhood>& stencils;
+	const std::vector<CSRNeighborhood>& graphs;
+
+	std::string chunk;
+	std::vector<Constant> constants;
+	std::map<std::string, Neighborhood> neighborhoods;
+	unsigned int seed;
+
+	QAtomicInt next;   ///< next partition to be executed
+	QAtomicInt state;  ///< Running, Interrupted, or Failed
+	QMutex errorMutex;
+	std::string error;
+
+	enum State
+	{
+		Running = 0,
+		Interrupted = 1,
+		Failed = 2
+	};
+};
+
+#endif // LUA_CELL_TRAVERSAL_H
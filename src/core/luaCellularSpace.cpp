@@ -35,7 +35,9 @@ of this software and its documentation.
 
 // Observadores
 #include "../observer/types/observerUDPSender.h"
+#include "../observer/types/observerTCPSender.h"
 #include "../observer/types/agentObserverMap.h"
+#include "../observer/types/observerImage.h"
 #include "../observer/types/observerTextScreen.h"
 #include "../observer/types/observerGraphic.h"
 #include "../observer/types/observerLogFile.h"
@@ -48,6 +50,7 @@ of this software and its documentation.
 
 #include <fstream>
 #include <algorithm>
+#include <limits>
 
 #ifndef WIN32
 #define stricmp strcasecmp
@@ -90,6 +93,7 @@ luaCellularSpace::luaCellularSpace(lua_State *L)
     subjectType = TObsCellularSpace;
     observedAttribs.clear();
     port = -1;
+    frameSequence = 0;
 
 	lua = terrame::lua::LuaSystem::getInstance().getLuaApi();
 }
@@ -182,6 +186,16 @@ int luaCellularSpace::setWhereClause(lua_State *L)
 int luaCellularSpace::clear(lua_State *)
 {
     CellularSpace::clear();
+
+	for(unsigned int i = 0; i < cells.size(); i++)
+		cells[i]->setCellularSpace(0, -1);
+
+	cells.clear();
+	ids.clear();
+	attributes.clear();
+	grid.clear();
+	stencils.clear();
+	graphs.clear();
     return 0;
 }
 
@@ -195,6 +209,12 @@ int luaCellularSpace::addCell(lua_State *L)
     indx.first = lua->getNumberAt(L, -3);
     CellularSpace::add(indx, cell);
 
+	cell->setCellularSpace(this, cells.size());
+	ids[cell->getID()] = cells.size();
+	cells.push_back(cell);
+	attributes.resize(cells.size());
+	grid.add(indx.first, indx.second);
+
     return 0;
 }
 
@@ -206,6 +226,490 @@ int luaCellularSpace::size(lua_State* L)
     return 1;
 }
 
+/// Adds a new columnar attribute to the cells and returns its column index
+/// parameters: attribute name, type ("number", "integer", or "boolean")
+int luaCellularSpace::addAttribute(lua_State* L)
+{
+	string name = lua->getStringAt(L, -2);
+	string type = lua->getStringAt(L, -1);
+	CellAttributes::Type ctype;
+
+	if(type == "number")
+		ctype = CellAttributes::TNumber;
+	else if(type == "integer")
+		ctype = CellAttributes::TInteger;
+	else if(type == "boolean")
+		ctype = CellAttributes::TBoolean;
+	else
+	{
+		lua->callError(L, "Invalid attribute type '" + type + "'.");
+		return 0;
+	}
+
+	lua->pushInteger(L, attributes.addAttribute(name, ctype));
+	return 1;
+}
+
+/// Copies the current values of the columnar attributes to their past buffers
+/// parameters: table with the indexes of the columns to be synchronized
+int luaCellularSpace::synchronize(lua_State* L)
+{
+	int top = lua->getTopIndex(L);
+	attributes.resetPast();
+
+	lua->pushNil(L);
+	while(lua->nextAt(L, top) != 0)
+	{
+		int col = lua->toIntegerAt(L, -1);
+
+		if(col >= 0 && col < attributes.count())
+			attributes.synchronize(col);
+
+		lua->popOneElement(L);
+	}
+
+	return 0;
+}
+
+/// Copies the columnar attributes of the cells, including their past buffers,
+/// and returns the index of the copy
+int luaCellularSpace::saveSnapshot(lua_State* L)
+{
+	snapshots.push_back(attributes);
+	lua->pushInteger(L, (int)snapshots.size() - 1);
+	return 1;
+}
+
+/// Copies back the columnar attributes saved by saveSnapshot. Returns false if
+/// the attributes of the cells do not match the snapshot anymore
+/// parameters: snapshot index
+int luaCellularSpace::loadSnapshot(lua_State* L)
+{
+	int idx = lua->toIntegerAt(L, -1);
+
+	if(idx < 0 || idx >= (int)snapshots.size())
+	{
+		lua->callError(L, "Invalid snapshot index.");
+		return 0;
+	}
+
+	lua->pushBoolean(L, attributes.restore(snapshots[idx]));
+	return 1;
+}
+
+/// Releases the memory of a snapshot created by saveSnapshot
+/// parameters: snapshot index
+int luaCellularSpace::removeSnapshot(lua_State* L)
+{
+	int idx = lua->toIntegerAt(L, -1);
+
+	if(idx >= 0 && idx < (int)snapshots.size())
+	{
+		CellAttributes empty;
+		std::swap(snapshots[idx], empty);
+	}
+
+	return 0;
+}
+
+/// Returns the type of a columnar attribute and its values as a binary string. If the
+/// past values are requested and the column was not synchronized, returns only the type
+/// parameters: column index, whether the past values should be returned
+int luaCellularSpace::getColumn(lua_State* L)
+{
+	bool past = lua->toBooleanAt(L, -1);
+	int col = lua->toIntegerAt(L, -2);
+
+	if(col < 0 || col >= attributes.count())
+	{
+		lua->callError(L, "Invalid column index.");
+		return 0;
+	}
+
+	switch(attributes.getType(col))
+	{
+		case CellAttributes::TInteger: lua->pushString(L, "integer"); break;
+		case CellAttributes::TBoolean: lua->pushString(L, "boolean"); break;
+		default: lua->pushString(L, "number");
+	}
+
+	if(past && !attributes.isSynchronized(col))
+		return 1;
+
+	size_t bytes;
+	const char* data = attributes.getData(col, past, bytes);
+	lua->pushString(L, string(data ? data : "", bytes));
+	return 2;
+}
+
+/// Replaces the values of a columnar attribute by binary strings returned by getColumn.
+/// Returns false if their sizes do not match the number of cells
+/// parameters: column index, type, values, past values or nil
+int luaCellularSpace::setColumn(lua_State* L)
+{
+	int top = lua->getTopIndex(L);
+	int col = lua->toIntegerAt(L, top - 3);
+	string type = lua->getStringAt(L, top - 2);
+	string values = lua->getStringAt(L, top - 1);
+	bool synchronized = lua->isStringAt(L, top);
+	string past = synchronized ? lua->getStringAt(L, top) : string();
+	CellAttributes::Type ctype = CellAttributes::TNumber;
+
+	if(type == "integer")
+		ctype = CellAttributes::TInteger;
+	else if(type == "boolean")
+		ctype = CellAttributes::TBoolean;
+
+	if(col < 0 || col >= attributes.count())
+	{
+		lua->callError(L, "Invalid column index.");
+		return 0;
+	}
+
+	lua->pushBoolean(L, attributes.setData(col, ctype, values.data(), values.size(),
+		synchronized ? past.data() : 0, past.size()));
+	return 1;
+}
+
+/// Adds a neighborhood defined by offsets, shared by all the cells, and returns its index
+/// parameters: table with the offsets {dx1, dy1, dx2, dy2, ...}, wrap, uniform weights
+int luaCellularSpace::addStencil(lua_State* L)
+{
+	int top = lua->getTopIndex(L);
+	bool uniform = lua->toBooleanAt(L, top);
+	bool wrap = lua->toBooleanAt(L, top - 1);
+	int offsets = top - 2;
+	vector<int> dx, dy;
+
+	for(int i = 1; ; i += 2)
+	{
+		lua->pushInteger(L, i);
+		lua->pushTableAt(L, offsets);
+		lua->pushInteger(L, i + 1);
+		lua->pushTableAt(L, offsets);
+
+		if(!lua->isNumberAt(L, -2) || !lua->isNumberAt(L, -1))
+		{
+			lua->pop(L, 2);
+			break;
+		}
+
+		dx.push_back(lua->toIntegerAt(L, -2));
+		dy.push_back(lua->toIntegerAt(L, -1));
+		lua->pop(L, 2);
+	}
+
+	stencils.push_back(StencilNeighborhood(dx, dy, uniform, wrap));
+	lua->pushInteger(L, stencils.size() - 1);
+	return 1;
+}
+
+/// Fills two tables with the neighbors of a cell in a neighborhood created by addStencil
+/// and with the weights of the connections, returning the number of neighbors
+/// parameters: stencil index, luaCell, table of cells, table of weights
+int luaCellularSpace::getStencilNeighbors(lua_State* L)
+{
+	int top = lua->getTopIndex(L);
+	int weights = top;
+	int neighs = top - 1;
+	luaCell* cell = terrame::lua::LuaBindingDelegate<luaCell>::getInstance().check(L, top - 2);
+	int stencil = lua->toIntegerAt(L, top - 3);
+
+	if(stencil < 0 || stencil >= (int)stencils.size() || getOrdinal(cell) < 0)
+	{
+		lua->pushInteger(L, 0);
+		return 1;
+	}
+
+	grid.update();
+
+	CellIndex idx = cell->getIndex();
+	double weight = stencils[stencil].neighbors(grid, idx.first, idx.second, neighbors);
+
+	for(unsigned int i = 0; i < neighbors.size(); i++)
+	{
+		cells[neighbors[i]]->getReference(L);
+		lua->setIndexAt(L, neighs, i + 1);
+		lua->pushNumber(L, weight);
+		lua->setIndexAt(L, weights, i + 1);
+	}
+
+	lua->pushInteger(L, neighbors.size());
+	return 1;
+}
+
+/// Adds an empty neighborhood stored as a graph, shared by all the cells, and returns its index
+int luaCellularSpace::addGraph(lua_State* L)
+{
+	graphs.push_back(CSRNeighborhood());
+	lua->pushInteger(L, graphs.size() - 1);
+	return 1;
+}
+
+/// Adds connections from a cell to a graph created by addGraph
+/// parameters: graph index, luaCell, table of luaCells, table of weights
+int luaCellularSpace::addGraphConnections(lua_State* L)
+{
+	int top = lua->getTopIndex(L);
+	int weights = top;
+	int neighs = top - 1;
+	luaCell* cell = terrame::lua::LuaBindingDelegate<luaCell>::getInstance().check(L, top - 2);
+	int graph = lua->toIntegerAt(L, top - 3);
+	int origin = getOrdinal(cell);
+
+	if(graph < 0 || graph >= (int)graphs.size() || origin < 0)
+		return 0;
+
+	for(int i = 1; ; i++)
+	{
+		lua->pushInteger(L, i);
+		lua->pushTableAt(L, neighs);
+
+		if(!lua->isUserdataAt(L, -1, luaCell::className))
+		{
+			lua->popOneElement(L);
+			break;
+		}
+
+		int neighbor = getOrdinal(terrame::lua::LuaBindingDelegate<luaCell>::getInstance().check(L, -1));
+		lua->popOneElement(L);
+
+		lua->pushInteger(L, i);
+		lua->pushTableAt(L, weights);
+		double weight = lua->isNumberAt(L, -1) ? lua->getNumberAtTop(L) : 1;
+		lua->popOneElement(L);
+
+		if(neighbor >= 0)
+			graphs[graph].add(origin, neighbor, weight);
+	}
+
+	return 0;
+}
+
+/// Builds the graph after all the connections were added. If a cell is connected
+/// twice to the same neighbor, it returns the two luaCells
+/// parameters: graph index
+int luaCellularSpace::buildGraph(lua_State* L)
+{
+	int graph = lua->toIntegerAt(L, -1);
+
+	if(graph < 0 || graph >= (int)graphs.size())
+		return 0;
+
+	graphs[graph].build(cells.size());
+
+	int repeated = graphs[graph].findRepeated();
+	if(repeated < 0)
+		return 0;
+
+	cells[graphs[graph].getOrigin(repeated)]->getReference(L);
+	cells[graphs[graph].getNeighbor(repeated)]->getReference(L);
+	return 2;
+}
+
+/// Loads a graph from a GAL, GPM, GWT, or GPMB file and returns its index. The graph
+/// still needs to be built. GPMB files also return the layer name stored in the file.
+/// In case of error, it returns nil and the error message
+/// parameters: file name, format, whether GPM neighbors are followed by weights
+int luaCellularSpace::loadGraph(lua_State* L)
+{
+	string fileName = lua->getStringAt(L, 1);
+	string format = lua->getStringAt(L, 2);
+	bool weighted = lua->toBooleanAt(L, 3);
+
+	graphs.push_back(CSRNeighborhood());
+
+	string layer;
+	string error;
+
+	if(format == "gpmb")
+		error = NeighborhoodFile::loadBinary(fileName, ids, graphs.back(), layer);
+	else
+		error = NeighborhoodFile::loadText(fileName, format, weighted, ids, graphs.back());
+
+	if(!error.empty())
+	{
+		graphs.pop_back();
+		lua->pushNil(L);
+		lua->pushString(L, error);
+		return 2;
+	}
+
+	lua->pushInteger(L, graphs.size() - 1);
+
+	if(format != "gpmb")
+		return 1;
+
+	lua->pushString(L, layer);
+	return 2;
+}
+
+/// Saves a graph as a GPMB file. In case of error, it returns the error message
+/// parameters: graph index, file name, layer name
+int luaCellularSpace::saveGraph(lua_State* L)
+{
+	int graph = lua->toIntegerAt(L, 1);
+	string fileName = lua->getStringAt(L, 2);
+	string layer = lua->getStringAt(L, 3);
+
+	if(graph < 0 || graph >= (int)graphs.size())
+		return 0;
+
+	vector<string> names(cells.size());
+	for(unsigned int i = 0; i < cells.size(); i++)
+		names[i] = cells[i]->getID();
+
+	string error = NeighborhoodFile::saveBinary(fileName, layer, names, graphs[graph]);
+
+	if(error.empty())
+		return 0;
+
+	lua->pushString(L, error);
+	return 1;
+}
+
+/// Fills two tables with the neighbors of a cell in a graph and with the weights
+/// of the connections, returning the number of neighbors
+/// parameters: graph index, luaCell, table of cells, table of weights
+int luaCellularSpace::getGraphNeighbors(lua_State* L)
+{
+	int top = lua->getTopIndex(L);
+	int weights = top;
+	int neighs = top - 1;
+	luaCell* cell = terrame::lua::LuaBindingDelegate<luaCell>::getInstance().check(L, top - 2);
+	int graph = lua->toIntegerAt(L, top - 3);
+	int origin = getOrdinal(cell);
+
+	if(graph < 0 || graph >= (int)graphs.size() || origin < 0 || origin >= graphs[graph].cells())
+	{
+		lua->pushInteger(L, 0);
+		return 1;
+	}
+
+	const CSRNeighborhood& csr = graphs[graph];
+	int first = csr.begin(origin);
+	int last = csr.end(origin);
+
+	for(int p = first; p < last; p++)
+	{
+		cells[csr.getNeighbor(p)]->getReference(L);
+		lua->setIndexAt(L, neighs, p - first + 1);
+		lua->pushNumber(L, csr.getWeight(p));
+		lua->setIndexAt(L, weights, p - first + 1);
+	}
+
+	lua->pushInteger(L, last - first);
+	return 1;
+}
+
+/// Executes a function for each cell using several threads, each one with its own
+/// lua_State. Returns false if some call returned false. In case of error, it returns
+/// nil and the error message
+/// parameters: function dumped by string.dump, table with the values of its upvalues,
+/// table with the indexes of the output columns, table with the indexes of the stencils
+/// by name, table with the indexes of the graphs by name, number of partitions,
+/// number of threads, seed
+int luaCellularSpace::traverse(lua_State* L)
+{
+	int top = lua->getTopIndex(L);
+	unsigned int seed = (unsigned int)lua->toIntegerAt(L, top);
+	int threads = lua->toIntegerAt(L, top - 1);
+	int partitions = lua->toIntegerAt(L, top - 2);
+	int graphIndexes = top - 3;
+	int stencilIndexes = top - 4;
+	int outputs = top - 5;
+	int constants = top - 6;
+
+	grid.update();
+
+	CellTraversal traversal(attributes, grid);
+	LuaCellTraversal executor(traversal, stencils, graphs);
+
+	traversal.partition(partitions);
+	executor.setFunction(lua->getStringAt(L, top - 7));
+
+	lua->pushNil(L);
+	while(lua->nextAt(L, outputs) != 0)
+	{
+		int col = lua->toIntegerAt(L, -1);
+
+		if(col >= 0 && col < attributes.count())
+			traversal.addOutput(col);
+
+		lua->popOneElement(L);
+	}
+
+	lua->pushNil(L);
+	while(lua->nextAt(L, constants) != 0)
+	{
+		int upvalue = lua->toIntegerAt(L, -2);
+		int type = lua->getTypeAt(L, -1);
+
+		if(lua->isBoolean(type))
+			executor.addConstant(upvalue, lua->toBooleanAt(L, -1));
+		else if(lua->isNumber(type))
+			executor.addConstant(upvalue, lua->getNumberAt(L, -1), lua->isIntegerAt(L, -1));
+		else if(lua->isString(type))
+			executor.addConstant(upvalue, lua->getStringAt(L, -1));
+
+		lua->popOneElement(L);
+	}
+
+	lua->pushNil(L);
+	while(lua->nextAt(L, stencilIndexes) != 0)
+	{
+		int stencil = lua->toIntegerAt(L, -1);
+
+		if(stencil >= 0 && stencil < (int)stencils.size())
+			executor.addNeighborhood(lua->getStringAt(L, -2), true, stencil);
+
+		lua->popOneElement(L);
+	}
+
+	lua->pushNil(L);
+	while(lua->nextAt(L, graphIndexes) != 0)
+	{
+		int graph = lua->toIntegerAt(L, -1);
+
+		if(graph >= 0 && graph < (int)graphs.size())
+			executor.addNeighborhood(lua->getStringAt(L, -2), false, graph);
+
+		lua->popOneElement(L);
+	}
+
+	bool completed = true;
+	string error = executor.run(threads, seed, completed);
+
+	if(!error.empty())
+	{
+		lua->pushNil(L);
+		lua->pushString(L, error);
+		return 2;
+	}
+
+	lua->pushBoolean(L, completed);
+	return 1;
+}
+
+/// Returns the ordinal of a cell, or -1 if it does not belong to the luaCellularSpace
+int luaCellularSpace::getOrdinal(luaCell* cell)
+{
+	int ordinal = cell->getOrdinal();
+	return getCell(ordinal) == cell ? ordinal : -1;
+}
+
+CellAttributes& luaCellularSpace::getAttributes()
+{
+	return attributes;
+}
+
+luaCell* luaCellularSpace::getCell(int ordinal)
+{
+	if(ordinal < 0 || ordinal >= (int)cells.size())
+		return 0;
+	return cells[ordinal];
+}
+
 /// Sets the name of the TerraLib layer related to the CellularSpace object
 /// parameter: layerName is a string containing the new layerName
 /// \author Raian Vargas Maretto
@@ -305,6 +809,14 @@ int luaCellularSpace::createObserver(lua_State * luaL)
         lua->popOneElement(luaL);
     }
 
+    // atributos armazenados nas colunas do espaco celular
+    for (int col = 0; col < attributes.count(); col++)
+    {
+        QString key(attributes.getName(col).c_str());
+        if (!allCellAttribs.contains(key))
+            allCellAttribs.append(key);
+    }
+
     // Recupera a tabela de parametros
     lua->pushNil(luaL);
     while (lua->nextAt(luaL, top - 2) != 0)
@@ -494,10 +1006,12 @@ int luaCellularSpace::createObserver(lua_State * luaL)
 
     AgentObserverMap *obsMap = 0;
     ObserverUDPSender *obsUDPSender = 0;
+    ObserverTCPSender *obsTCPSender = 0;
     ObserverTextScreen *obsText = 0;
     ObserverTable *obsTable = 0;
     ObserverGraphic *obsGraphic = 0;
     ObserverLogFile *obsLog = 0;
+    ObserverImage *obsImage = 0;
 
     int obsId = -1;
 
@@ -587,6 +1101,20 @@ int luaCellularSpace::createObserver(lua_State * luaL)
                 qWarning("%s", qPrintable(TerraMEObserver::MEMORY_ALLOC_FAILED));
         }
         break;
+
+    case TObsImage:
+        obsImage =(ObserverImage *) CellSpaceSubjectInterf::createObserver(TObsImage);
+        if (obsImage)
+        {
+            obsId = obsImage->getId();
+        }
+        else
+        {
+            if (execModes != Quiet)
+                qWarning("%s", qPrintable(TerraMEObserver::MEMORY_ALLOC_FAILED));
+        }
+        break;
+
     case TObsUDPSender:
         obsUDPSender =(ObserverUDPSender *) CellSpaceSubjectInterf::createObserver(TObsUDPSender);
         if (obsUDPSender)
@@ -603,6 +1131,23 @@ int luaCellularSpace::createObserver(lua_State * luaL)
                 qWarning("%s", qPrintable(TerraMEObserver::MEMORY_ALLOC_FAILED));
         }
         break;
+
+    case TObsTCPSender:
+        obsTCPSender =(ObserverTCPSender *) CellSpaceSubjectInterf::createObserver(TObsTCPSender);
+        if (obsTCPSender)
+        {
+            obsId = obsTCPSender->getId();
+            obsTCPSender->setCompress(compressDatagram);
+
+            if (obsVisible)
+                obsTCPSender->show();
+        }
+        else
+        {
+            if (execModes != Quiet)
+                qWarning("%s", qPrintable(TerraMEObserver::MEMORY_ALLOC_FAILED));
+        }
+        break;
     default:
         if (execModes != Quiet)
         {
@@ -612,6 +1157,15 @@ int luaCellularSpace::createObserver(lua_State * luaL)
         return 0;
     }
 
+    if (obsId >= 0)
+    {
+        // a new map needs a keyframe, and the other observers need the whole state
+        if (obsMap || obsImage)
+            lastFrames.clear();
+        else
+            textObservers.insert(obsId);
+    }
+
     if (obsLog)
     {
         obsLog->setAttributes(obsAttribs);
@@ -679,6 +1233,19 @@ int luaCellularSpace::createObserver(lua_State * luaL)
 		return 2;
     }
 
+    if (obsImage)
+    {
+        if (getSpaceDimensions)
+            obsImage->setCellSpaceSize(width, height);
+
+        obsImage->setAttributes(obsAttribs, obsParams, obsParamsAtribs);
+
+        lua->pushNumber(luaL, obsId);
+        lua->pushLightUserdata(luaL, (void*) obsImage);
+
+        return 2;
+    }
+
     if (obsUDPSender)
     {
         obsUDPSender->setAttributes(obsAttribs);
@@ -707,6 +1274,23 @@ int luaCellularSpace::createObserver(lua_State * luaL)
         return 2;
     }
 
+    if (obsTCPSender)
+    {
+        obsTCPSender->setAttributes(obsAttribs);
+
+        for (int i = 1; i < obsParamsAtribs.size(); i++)
+        {
+            if (!obsParamsAtribs.at(i).isEmpty())
+                obsTCPSender->addHost(obsParamsAtribs.at(i));
+        }
+        obsTCPSender->connectTo(obsParamsAtribs.at(0).toInt());
+
+        lua->pushNumber(luaL, obsId);
+        lua->pushLightUserdata(luaL, (void*) obsTCPSender);
+
+        return 2;
+    }
+
     return 0;
 }
 
@@ -745,187 +1329,228 @@ QString luaCellularSpace::getChanges(QDataStream& in, int observerId , QStringLi
 
 //------------
 /// Serializes the luaCellularSpace object to the Observer objects
+/// When all the observers are maps or images, it only sends the cells that changed since the last
+/// frame, with a keyframe every KEYFRAME_INTERVAL frames and whenever the observed
+/// attributes, the cells, or the observers change.
 #ifdef TME_BLACK_BOARD
-QDataStream& luaCellularSpace::getState(QDataStream& in, Subject *, int observerId, QStringList & /* attribs */)
+QDataStream& luaCellularSpace::getState(QDataStream& in, Subject *, int /* observerId */, QStringList & /* attribs */)
 #else
 QDataStream& luaCellularSpace::getState(QDataStream& in, Subject *, int observerId, QStringList &  attribs)
 #endif
 {
-    int obsCurrentState = 0; //serverSession->getState(observerId);
-    QString content;
+    StateFrame frame;
 
-    switch (obsCurrentState)
-    {
-    case 0:
 #ifdef TME_BLACK_BOARD
-        content = getAll(in, observerId, observedAttribs);
+    popFrame(luaL, observedAttribs, frame);
+
+    // the BlackBoard shares the same state among all the observers
+    int observerId = -1;
 #else
-        content = getAll(in, observerId, attribs);
+    popFrame(luaL, attribs, frame);
 #endif
 
-        // serverSession->setState(observerId, 1);
-        //if (execModes == Quiet)
-        // 	qWarning(QString("Observer %1 passou ao estado %2").arg(observerId).arg(1).toLatin1().constData());
-        break;
+    frame.sequence = ++frameSequence;
 
-    case 1:
-#ifdef TME_BLACK_BOARD
-        content = getChanges(in, observerId, observedAttribs);
-#else
-        content = getChanges(in, observerId, attribs);
-#endif
+    StateFrame delta;
+    QHash<int, StateFrame>::const_iterator last = lastFrames.constFind(observerId);
+    bool keyframe = !textObservers.isEmpty() || (frame.sequence % KEYFRAME_INTERVAL == 0)
+        || (last == lastFrames.constEnd())
+        || !frame.diff(last.value(), delta, frame.elementIds.size() / 2);
 
-        // serverSession->setState(observerId, 0);
-        //if (execModes != Quiet)
-        // 	qWarning(QString("Observer %1 passou ao estado %2").arg(observerId).arg(0).toLatin1().constData());
-        break;
-    }
-    // cleans the stack
-    // lua_settop(L, 0);
+    if (keyframe)
+        frame.write(in);
+    else
+        delta.write(in);
 
-    in << content;
+    lastFrames.insert(observerId, frame);
     return in;
 }
 
 QString luaCellularSpace::pop(lua_State *luaL, QStringList& attribs)
 {
-    QString msg;
+	StateFrame frame;
+	popFrame(luaL, attribs, frame);
+	return frame.toText();
+}
 
-    // id
-    msg.append(QString::number(getId()));
-    msg.append(PROTOCOL_SEPARATOR);
+/// Converts the Lua value at the top of the stack to its type and text in the observer protocol
+static void popValue(terrame::lua::LuaApi* lua, lua_State* luaL, TypesOfData& type, QString& text)
+{
+	int luaType = lua->getTypeAt(luaL, -1);
+
+	if(lua->isBoolean(luaType))
+	{
+		type = TObsBool;
+		text = QString::number(lua->toBooleanAt(luaL, -1));
+	}
+	else if(lua->isNumber(luaType))
+	{
+		type = TObsNumber;
+		doubleToQString(lua->getNumberAt(luaL, -1), text, 20);
+	}
+	else if(lua->isString(luaType))
+	{
+		type = TObsText;
+		text = QString(lua->getStringAtTop(luaL).c_str());
+
+		if(text.isEmpty())
+			text = VALUE_NOT_INFORMED;
+	}
+	else
+	{
+		char result[100];
+		sprintf(result, "%p", lua->toPointerAt(luaL, -1));
+		type = TObsText;
+
+		if(lua->isTable(luaType))
+			text = QString("Lua-Address(TB): ") + QString(result);
+		else if(lua->isUserdata(luaType))
+			text = QString("Lua-Address(UD): ") + QString(result);
+		else if(lua->isFunction(luaType))
+			text = QString("Lua-Address(FT): ") + QString(result);
+		else
+			text = QString("Lua-Address(O): ") + QString(result);
+	}
+}
 
-    // subjectType
-    msg.append(QString::number(subjectType));
-    msg.append(PROTOCOL_SEPARATOR);
+/// Encodes the observed attributes of the CellularSpace and of its cells as a StateFrame
+void luaCellularSpace::popFrame(lua_State *luaL, QStringList& attribs, StateFrame& frame)
+{
+	frame.id = getId();
+	frame.subjectType = subjectType;
 
-    // recupero a referencia na pilha lua
 	getReference(luaL);
+	int cellSpacePos = lua->getTopIndex(luaL);
+	TypesOfData type;
+	QString key, text;
+
+	lua->pushNil(luaL);
+	while(lua->nextAt(luaL, cellSpacePos) != 0)
+	{
+		key = QString(lua->getStringAt(luaL, -2).c_str());
+
+		if(attribs.contains(key) || (key == "cells"))
+		{
+			popValue(lua, luaL, type, text);
+			frame.addAttribute(key, type, text);
+		}
 
-    int cellSpacePos = lua->getTopIndex(luaL);
+		lua->popOneElement(luaL);
+	}
+	lua->popOneElement(luaL);
 
-    int attrCounter = 0;
-    int elementCounter = 0;
-    // bool contains = false;
-    double num = 0;
-    QString text, key, attrs, elements;
+	frame.elementType = TObsCell;
+	frame.elementIds.resize(cells.size());
+	for(unsigned int i = 0; i < cells.size(); i++)
+		frame.elementIds[i] = cells[i]->getId();
 
-    lua->pushNil(luaL);
-    while (lua->nextAt(luaL, cellSpacePos) != 0)
-    {
-        key = QString(lua->getStringAt(luaL, -2).c_str());
+	for(int i = 0; i < attribs.size(); i++)
+	{
+		key = attribs.at(i);
 
-        if ((attribs.contains(key)) ||(key == "cells"))
-        {
-            attrCounter++;
-            attrs.append(key);
-            attrs.append(PROTOCOL_SEPARATOR);
+		if(key == "cells") continue;
+
+		if((key == "x") || (key == "y"))
+		{
+			StateFrame::Column& column = frame.addColumn(key, TObsNumber);
+			column.numbers.resize(cells.size());
 
-			int luaType = lua->getTypeAt(luaL, -1);
-			if(lua->isBoolean(luaType))
+			for(unsigned int j = 0; j < cells.size(); j++)
 			{
-                attrs.append(QString::number(TObsBool));
-                attrs.append(PROTOCOL_SEPARATOR);
-                attrs.append(QString::number(lua->toBooleanAt(luaL, -1)));
-                attrs.append(PROTOCOL_SEPARATOR);
+				CellIndex idx = cells[j]->getIndex();
+				column.numbers[j] = (key == "x") ? idx.first : idx.second;
 			}
-			else if(lua->isNumber(luaType))
+			continue;
+		}
+
+		int col = attributes.find(key.toStdString());
+
+		if(col >= 0)
+		{
+			bool boolean = attributes.getType(col) == CellAttributes::TBoolean;
+			StateFrame::Column& column = frame.addColumn(key, boolean ? TObsBool : TObsNumber);
+			column.numbers.resize(cells.size());
+
+			for(unsigned int j = 0; j < cells.size(); j++)
+				column.numbers[j] = boolean ? attributes.getBoolean(col, j) : attributes.getNumber(col, j);
+			continue;
+		}
+
+		popColumn(luaL, key, frame);
+	}
+}
+
+/// Encodes an attribute stored in the Lua tables of the cells as a column of a StateFrame.
+/// The type of the column is the type of the first value that is not nil, and the cells
+/// without a value of this type are missing values. Attributes that are not numbers,
+/// booleans, or strings are ignored.
+void luaCellularSpace::popColumn(lua_State *luaL, const QString& key, StateFrame& frame)
+{
+	string name = key.toStdString();
+	StateFrame::Column* column = 0;
+	double missing = std::numeric_limits<double>::quiet_NaN();
+	int skipped = 0; // cells without a value before the first one with a value
+
+	for(unsigned int i = 0; i < cells.size(); i++)
+	{
+		cells[i]->getReference(luaL);
+		lua->pushString(luaL, name);
+		lua->pushTableAt(luaL, -2);
+
+		int luaType = lua->getTypeAt(luaL, -1);
+
+		if(!column)
+		{
+			if(lua->isNumber(luaType))
+				column = &frame.addColumn(key, TObsNumber);
+			else if(lua->isBoolean(luaType))
+				column = &frame.addColumn(key, TObsBool);
+			else if(lua->isString(luaType))
+				column = &frame.addColumn(key, TObsText);
+			else if(lua->isTable(luaType) || lua->isUserdata(luaType) || lua->isFunction(luaType))
 			{
-                num = lua->getNumberAt(luaL, -1);
-                doubleToQString(num, text, 20);
-                attrs.append(QString::number(TObsNumber));
-                attrs.append(PROTOCOL_SEPARATOR);
-                attrs.append(text);
-                attrs.append(PROTOCOL_SEPARATOR);
+				lua->pop(luaL, 2);
+				return;
 			}
-			else if(lua->isString(luaType))
+			else
 			{
-                text = QString(lua->getStringAtTop(luaL).c_str());
-                attrs.append(QString::number(TObsText));
-                attrs.append(PROTOCOL_SEPARATOR);
-                attrs.append((text.isEmpty() || text.isNull() ? VALUE_NOT_INFORMED : text));
-                attrs.append(PROTOCOL_SEPARATOR);
+				skipped++;
+				lua->pop(luaL, 2);
+				continue;
 			}
-			else if(lua->isTable(luaType))
-            {
-                char result[100];
-                sprintf(result, "%p", lua->toPointerAt(luaL, -1));
-                attrs.append(QString::number(TObsText));
-                attrs.append(PROTOCOL_SEPARATOR);
-                attrs.append(QString("Lua-Address(TB): ") + QString(result));
-                attrs.append(PROTOCOL_SEPARATOR);
-
-                // Recupera a tabela de cells e delega a cada
-                // celula sua serializacao
-                // if (key == "cells")
-                //{
-                int top = lua->getTopIndex(luaL);
-
-                lua->pushNil(luaL);
-                while (lua->nextAt(luaL, top) != 0)
-                {
-                    int cellTop = lua->getTopIndex(luaL);
-                    lua->pushString(luaL, "cObj_");
-                    lua->pushTableAt(luaL, cellTop);
-
-                    luaCell*  cell;
-                    cell = terrame::lua::LuaBindingDelegate<luaCell>::getInstance().check(L, -1);
-                    lua->popOneElement(luaL);
 
-                    // luaCell->pop(...) requer uma celula no topo da pilha
-                    QString cellMsg = cell->pop(L, attribs);
-                    elements.append(cellMsg);
-                    elementCounter++;
-
-                    lua->popOneElement(luaL);
-                }
-            }
-			else if(lua->isUserdata(luaType))
-            {
-                char result[100];
-                sprintf(result, "%p", lua->toPointerAt(luaL, -1));
-                attrs.append(QString::number(TObsText));
-                attrs.append(PROTOCOL_SEPARATOR);
-                attrs.append(QString("Lua-Address(UD): ") + QString(result));
-                attrs.append(PROTOCOL_SEPARATOR);
-            }
-			else if(lua->isFunction(luaType))
-            {
-                char result[100];
-                sprintf(result, "%p", lua->toPointerAt(luaL, -1));
-                attrs.append(QString::number(TObsText));
-                attrs.append(PROTOCOL_SEPARATOR);
-                attrs.append(QString("Lua-Address(FT): ") + QString(result));
-                attrs.append(PROTOCOL_SEPARATOR);
-            }
+			if(column->type == TObsText)
+			{
+				column->texts.reserve(cells.size());
+				column->texts.fill(VALUE_NOT_INFORMED, skipped);
+			}
 			else
-            {
-                char result[100];
-                sprintf(result, "%p", lua->toPointerAt(luaL, -1));
-                attrs.append(QString::number(TObsText));
-                attrs.append(PROTOCOL_SEPARATOR);
-                attrs.append(QString("Lua-Address(O): ") + QString(result));
-                attrs.append(PROTOCOL_SEPARATOR);
-            }
+			{
+				column->numbers.reserve(cells.size());
+				column->numbers.fill(missing, skipped);
+			}
 		}
 
-        lua->popOneElement(luaL);
-    }
+		if(column->type == TObsText)
+		{
+			QString text;
 
-    // #attrs
-    msg.append(QString::number(attrCounter));
-    msg.append(PROTOCOL_SEPARATOR);
+			if(lua->isString(luaType))
+				text = QString(lua->getStringAtTop(luaL).c_str());
 
-    // #elements
-    msg.append(QString::number(elementCounter));
-    msg.append(PROTOCOL_SEPARATOR);
-    msg.append(attrs);
+			column->texts.append(text.isEmpty() ? VALUE_NOT_INFORMED : text);
+		}
+		else if(column->type == TObsBool)
+			column->numbers.append(lua->isBoolean(luaType) ? lua->toBooleanAt(luaL, -1) : missing);
+		else
+			column->numbers.append(lua->isNumber(luaType) ? lua->getNumberAt(luaL, -1) : missing);
 
-    msg.append(PROTOCOL_SEPARATOR);
-    msg.append(elements);
-    msg.append(PROTOCOL_SEPARATOR);
+		lua->pop(luaL, 2);
+	}
 
-    return msg;
+	// the attribute is nil in all the cells
+	if(!column && skipped > 0)
+		frame.addColumn(key, TObsNumber).numbers.fill(missing, skipped);
 }
 
 int luaCellularSpace::kill(lua_State *luaL)
@@ -933,6 +1558,12 @@ int luaCellularSpace::kill(lua_State *luaL)
     int id = lua->getNumberAt(luaL, 1);
 
     bool result = CellSpaceSubjectInterf::kill(id);
+
+    if (result)
+        textObservers.remove(id);
+
+    observersHash.remove(id);
+    lastFrames.remove(id);
     lua->pushBoolean(luaL, result);
     return 1;
 }
@@ -941,28 +1572,70 @@ int luaCellularSpace::kill(lua_State *luaL)
 /// \author Raian Vargas Maretto
 luaCell * luaCellularSpace::findCellByID(const char* cellID)
 {
-    luaCell *cell;
-    CellularSpace::iterator it = this->begin();
-    const char *idAux;
-    while (it != this->end())
-    {
-        cell =(luaCell*)it->second;
-        idAux = cell->getID();
-        if (strcmp(idAux, cellID) == 0)
-        {
-            return cell;
-        }
-        it++;
-    }
-    return NULL;
-    //return(luaCell*)0;
+	NeighborhoodFile::IdIndex::iterator it = ids.find(cellID);
+
+	if(it == ids.end())
+		return NULL;
+
+	return cells[it->second];
+}
+
+/// Updates the index of ids after the id of a cell has changed
+void luaCellularSpace::updateCellID(luaCell* cell, const string& oldID)
+{
+	NeighborhoodFile::IdIndex::iterator it = ids.find(oldID);
+
+	if(it != ids.end() && it->second == cell->getOrdinal())
+		ids.erase(it);
+
+	ids[cell->getID()] = cell->getOrdinal();
+}
+
+/// Find a cell given its coordinates
+luaCell * luaCellularSpace::findCellByIndex(const CellIndex& cellIndex)
+{
+	grid.update();
+
+	int ordinal = grid.find(cellIndex.first, cellIndex.second);
+
+	if(ordinal < 0)
+		return NULL;
+
+	return cells[ordinal];
+}
+
+/// Returns the Cell located at given coordinates, or nil if there is no such Cell
+/// parameters: x, y
+int luaCellularSpace::getCellByIndex(lua_State* L)
+{
+	CellIndex cellIndex((int)lua->getNumberAt(L, 1), (int)lua->getNumberAt(L, 2));
+	luaCell* cell = findCellByIndex(cellIndex);
+
+	if(cell)
+		cell->getReference(L);
+	else
+		lua->pushNil(L);
+
+	return 1;
+}
+
+/// Returns the Cell with a given id, or nil if it does not belong to the CellularSpace
+/// parameters: cell id
+int luaCellularSpace::getCellByID(lua_State* L)
+{
+	luaCell* cell = findCellByID(lua->getStringAt(L, 1).c_str());
+
+	if(cell)
+		cell->getReference(L);
+	else
+		lua->pushNil(L);
+
+	return 1;
 }
 
 //@RAIAN: Fim.
 /// Find a cell given a luaCellularSpace object and a luaCellIndex object
 luaCell * findCell(luaCellularSpace* cs, CellIndex& cellIndex)
 {
-    Region_<CellIndex>::iterator it = cs->find(cellIndex);
-    if (it != cs->end()) return(luaCell*)it->second;
-    return(luaCell*)0;
+    return cs->findCellByIndex(cellIndex);
 }
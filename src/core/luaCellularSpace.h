@@ -29,11 +29,18 @@ of this software and its documentation.
 #define LUACELLULARSPACE_H
 
 #include <QHash>
+#include <QSet>
 #include <QString>
 
 #include "../observer/cellSpaceSubjectInterf.h"
+#include "../observer/protocol/decoder/stateFrame.h"
 #include "reference.h"
 #include "luaCell.h"
+#include "cellAttributes.h"
+#include "stencilNeighborhood.h"
+#include "csrNeighborhood.h"
+#include "luaCellTraversal.h"
+#include "neighborhoodFile.h"
 #include "LuaApi.h"
 
 /**
@@ -99,6 +106,96 @@ public:
     /// no parameters
     int size(lua_State* L);
 
+	/// Adds a new columnar attribute to the cells and returns its column index
+	/// parameters: attribute name, type ("number", "integer", or "boolean")
+	int addAttribute(lua_State* L);
+
+	/// Copies the current values of the columnar attributes to their past buffers
+	/// parameters: table with the indexes of the columns to be synchronized
+	int synchronize(lua_State* L);
+
+	/// Copies the columnar attributes of the cells, including their past buffers,
+	/// and returns the index of the copy
+	int saveSnapshot(lua_State* L);
+
+	/// Copies back the columnar attributes saved by saveSnapshot. Returns false if
+	/// the attributes of the cells do not match the snapshot anymore
+	/// parameters: snapshot index
+	int loadSnapshot(lua_State* L);
+
+	/// Releases the memory of a snapshot created by saveSnapshot
+	/// parameters: snapshot index
+	int removeSnapshot(lua_State* L);
+
+	/// Returns the type of a columnar attribute and its values as a binary string. If the
+	/// past values are requested and the column was not synchronized, returns only the type
+	/// parameters: column index, whether the past values should be returned
+	int getColumn(lua_State* L);
+
+	/// Replaces the values of a columnar attribute by binary strings returned by getColumn.
+	/// Returns false if their sizes do not match the number of cells
+	/// parameters: column index, type, values, past values or nil
+	int setColumn(lua_State* L);
+
+	/// Adds a neighborhood defined by offsets, shared by all the cells, and returns its index
+	/// parameters: table with the offsets {dx1, dy1, dx2, dy2, ...}, wrap, uniform weights
+	int addStencil(lua_State* L);
+
+	/// Fills two tables with the neighbors of a cell in a neighborhood created by addStencil
+	/// and with the weights of the connections, returning the number of neighbors
+	/// parameters: stencil index, luaCell, table of cells, table of weights
+	int getStencilNeighbors(lua_State* L);
+
+	/// Adds an empty neighborhood stored as a graph, shared by all the cells, and returns its index
+	int addGraph(lua_State* L);
+
+	/// Adds connections from a cell to a graph created by addGraph
+	/// parameters: graph index, luaCell, table of luaCells, table of weights
+	int addGraphConnections(lua_State* L);
+
+	/// Builds the graph after all the connections were added. If a cell is connected
+	/// twice to the same neighbor, it returns the two luaCells
+	/// parameters: graph index
+	int buildGraph(lua_State* L);
+
+	/// Loads a graph from a GAL, GPM, GWT, or GPMB file and returns its index. The graph
+	/// still needs to be built. GPMB files also return the layer name stored in the file.
+	/// In case of error, it returns nil and the error message
+	/// parameters: file name, format, whether GPM neighbors are followed by weights
+	int loadGraph(lua_State* L);
+
+	/// Saves a graph as a GPMB file. In case of error, it returns the error message
+	/// parameters: graph index, file name, layer name
+	int saveGraph(lua_State* L);
+
+	/// Returns the Cell with a given id, or nil if it does not belong to the CellularSpace
+	/// parameters: cell id
+	int getCellByID(lua_State* L);
+
+	/// Returns the Cell located at given coordinates, or nil if there is no such Cell
+	/// parameters: x, y
+	int getCellByIndex(lua_State* L);
+
+	/// Fills two tables with the neighbors of a cell in a graph and with the weights
+	/// of the connections, returning the number of neighbors
+	/// parameters: graph index, luaCell, table of cells, table of weights
+	int getGraphNeighbors(lua_State* L);
+
+	/// Executes a function for each cell using several threads, each one with its own
+	/// lua_State. Returns false if some call returned false. In case of error, it returns
+	/// nil and the error message
+	/// parameters: function dumped by string.dump, table with the values of its upvalues,
+	/// table with the indexes of the output columns, table with the indexes of the stencils
+	/// by name, table with the indexes of the graphs by name, number of partitions,
+	/// number of threads, seed
+	int traverse(lua_State* L);
+
+	/// Returns the columnar attributes of the cells
+	CellAttributes& getAttributes();
+
+	/// Returns the luaCell stored in a given position of the columnar attributes
+	luaCell* getCell(int ordinal);
+
     /// Registers the luaCellularSpace object in the Lua stack
     // @DANIEL
     // Movido para Reference
@@ -157,6 +254,14 @@ public:
 	/// Find a cell given a cell ID
 	/// \author Raian Vargas Maretto
 	luaCell * findCellByID(const char* cellID);
+
+	/// Find a cell given its coordinates
+	luaCell * findCellByIndex(const CellIndex& cellIndex);
+
+	/// Updates the index of ids after the id of a cell has changed
+	/// \param cell a luaCell of the luaCellularSpace
+	/// \param oldID the previous id of the cell
+	void updateCellID(luaCell* cell, const string& oldID);
 private:
     string dbType; ///< database type, e. g., MySQL, etc...
     string host;  ///< host name
@@ -179,6 +284,28 @@ private:
 
 	terrame::lua::LuaApi* lua;
 
+	CellAttributes attributes; ///< Columnar attributes of the cells
+	vector<CellAttributes> snapshots; ///< Copies of the columnar attributes
+	vector<luaCell*> cells; ///< Cells indexed by their position in the columns
+	NeighborhoodFile::IdIndex ids; ///< Positions of the cells indexed by their ids
+
+	CellGrid grid; ///< Ordinals of the cells indexed by their coordinates
+	vector<StencilNeighborhood> stencils; ///< Neighborhoods defined by offsets
+	vector<int> neighbors; ///< Buffer with the ordinals of the neighbors of a cell
+	vector<CSRNeighborhood> graphs; ///< Neighborhoods stored as graphs
+
+	int getOrdinal(luaCell* cell);
+
+	static const unsigned int KEYFRAME_INTERVAL = 50; ///< Maximum number of frames between two keyframes
+	QSet<int> textObservers; ///< Observers that convert the state to text, which cannot apply deltas
+	quint32 frameSequence; ///< Sequence of the last frame sent to the observers
+	QHash<int, StateFrame> lastFrames; ///< Last frames sent to the observers, indexed by observer
+
+	void popFrame(lua_State *L, QStringList& attribs, StateFrame& frame);
+	void popColumn(lua_State *L, const QString& key, StateFrame& frame);
+
+	friend class LuaCellTest; ///< tests popColumn()
+
 //    void loadLegendsFromDatabase(TeDatabase *db, TeTheme *inputTheme, QString& luaLegend);
 };
 
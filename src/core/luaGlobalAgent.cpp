@@ -33,6 +33,7 @@ of this software and its documentation.
 #include "../observer/types/observerLogFile.h"
 #include "../observer/types/observerTable.h"
 #include "../observer/types/observerUDPSender.h"
+#include "../observer/types/observerTCPSender.h"
 #include "../observer/types/agentObserverMap.h"
 #include "../observer/types/observerStateMachine.h"
 
@@ -376,6 +377,7 @@ int luaGlobalAgent::createObserver(lua_State *L)
         ObserverGraphic *obsGraphic = 0;
         ObserverLogFile *obsLog = 0;
         ObserverUDPSender *obsUDPSender = 0;
+        ObserverTCPSender *obsTCPSender = 0;
         ObserverStateMachine *obsStateMachine = 0;
 
         int obsId = -1;
@@ -443,6 +445,24 @@ int luaGlobalAgent::createObserver(lua_State *L)
             }
             break;
 
+        case TObsTCPSender:
+            obsTCPSender =(ObserverTCPSender *)
+                GlobalAgentSubjectInterf::createObserver(TObsTCPSender);
+            if (obsTCPSender)
+            {
+                obsId = obsTCPSender->getId();
+                obsTCPSender->setCompress(compressDatagram);
+
+                if (obsVisible)
+                    obsTCPSender->show();
+            }
+            else
+            {
+                if (execModes != Quiet)
+                    qWarning("%s", qPrintable(TerraMEObserver::MEMORY_ALLOC_FAILED));
+            }
+            break;
+
         case TObsStateMachine:
             obsStateMachine =(ObserverStateMachine *)
                 GlobalAgentSubjectInterf::createObserver(TObsStateMachine);
@@ -553,6 +573,23 @@ int luaGlobalAgent::createObserver(lua_State *L)
 
             return 2;
         }
+
+        if (obsTCPSender)
+        {
+            obsTCPSender->setAttributes(obsAttribs);
+
+            for (int i = 1; i < cols.size(); i++)
+            {
+                if (!cols.at(i).isEmpty())
+                    obsTCPSender->addHost(cols.at(i));
+            }
+            obsTCPSender->connectTo(cols.at(0).toInt());
+
+            lua_pushnumber(luaL, obsId);
+            lua_pushlightuserdata(luaL, (void*) obsTCPSender);
+
+            return 2;
+        }
         ///////////////////////////////////////////
 
         if (obsGraphic)
@@ -38,6 +38,20 @@ int luaLogFile::setObserver(lua_State* L)
     return 0;
 }
 
+int luaLogFile::setFormat(lua_State* L)
+{
+	std::string format = luaL_checkstring(L, -1);
+
+	if (format == "raw")
+		obs->setFormat(ObserverLogFile::Raw);
+	else if (format == "columnar")
+		obs->setFormat(ObserverLogFile::Columnar);
+	else
+		obs->setFormat(ObserverLogFile::Text);
+
+	return 0;
+}
+
 luaLogFile::~luaLogFile(void)
 {
 }
@@ -51,6 +51,9 @@ public:
 
 	int setObserver(lua_State* L);
 
+	/// Sets the format of the file: "csv", "raw", or "columnar"
+	int setFormat(lua_State* L);
+
 	/// destructor
         ~luaLogFile(void);
 
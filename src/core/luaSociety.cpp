@@ -35,9 +35,12 @@ of this software and its documentation.
 #include "../observer/types/observerLogFile.h"
 #include "../observer/types/observerTable.h"
 #include "../observer/types/observerUDPSender.h"
+#include "../observer/types/observerTCPSender.h"
 #include "../observer/types/agentObserverMap.h"
 #include "luaUtils.h"
 #include "terrameGlobals.h"
+#include "LuaSystem.h"
+#include "socialNetworkGenerator.h"
 
 ///< Gobal variabel: Lua stack used for comunication with C++ modules.
 extern lua_State * L;
@@ -51,6 +54,8 @@ luaSociety::luaSociety(lua_State *L)
     observedAttribs.clear();
 
     attrNeighName = "";
+
+	lua = terrame::lua::LuaSystem::getInstance().getLuaApi();
 }
 
 /// destructor
@@ -243,6 +248,7 @@ int luaSociety::createObserver(lua_State *)
         ObserverGraphic *obsGraphic = 0;
         ObserverLogFile *obsLog = 0;
         ObserverUDPSender *obsUDPSender = 0;
+        ObserverTCPSender *obsTCPSender = 0;
 
         int obsId = -1;
 
@@ -337,6 +343,24 @@ int luaSociety::createObserver(lua_State *)
             }
             break;
 
+        case TObsTCPSender:
+            obsTCPSender =(ObserverTCPSender *)
+                    SocietySubjectInterf::createObserver(TObsTCPSender);
+            if (obsTCPSender)
+            {
+                obsId = obsTCPSender->getId();
+                obsTCPSender->setCompress(compressDatagram);
+
+                if (obsVisible)
+                    obsTCPSender->show();
+            }
+            else
+            {
+                if (execModes != Quiet)
+                    qWarning("%s", qPrintable(TerraMEObserver::MEMORY_ALLOC_FAILED));
+            }
+            break;
+
         case TObsMap:
         default:
             if (execModes != Quiet)
@@ -426,6 +450,23 @@ int luaSociety::createObserver(lua_State *)
             return 2;
         }
 
+        if (obsTCPSender)
+        {
+            obsTCPSender->setAttributes(obsAttribs);
+
+            for (int i = 1; i < cols.size(); i++)
+            {
+                if (!cols.at(i).isEmpty())
+                    obsTCPSender->addHost(cols.at(i));
+            }
+            obsTCPSender->connectTo(cols.at(0).toInt());
+
+            lua_pushnumber(luaL, obsId);
+            lua_pushlightuserdata(luaL, (void*) obsTCPSender);
+
+            return 2;
+        }
+
     return 0;
 }
 
@@ -628,6 +669,102 @@ int luaSociety::kill(lua_State *luaL)
     return 1;
 }
 
+/// Creates a social network stored as a graph, shared by all the agents, and returns
+/// its index. Agents are identified by their positions in the Society
+/// parameters: strategy ("probability", "quantity", "erdos", "barabasi", or "watts"),
+/// number of agents, quantity or start, probability or quantity, symmetric, seed,
+/// index of a graph to be replaced (-1 to create a new one)
+int luaSociety::createGraph(lua_State *L)
+{
+	int top = lua->getTopIndex(L);
+	int index = (int)lua->toIntegerAt(L, top);
+	unsigned int seed = (unsigned int)lua->toIntegerAt(L, top - 1);
+	bool symmetric = lua->toBooleanAt(L, top - 2);
+	double second = lua->isNumberAt(L, top - 3) ? lua->getNumberAt(L, top - 3) : 0;
+	double first = lua->getNumberAt(L, top - 4);
+	int agents = (int)lua->toIntegerAt(L, top - 5);
+	string strategy = lua->getStringAt(L, top - 6);
+
+	SocialNetworkGenerator generator(agents, seed);
+
+	if(strategy == "probability")
+		generator.probability(first);
+	else if(strategy == "quantity")
+		generator.quantity((int)first);
+	else if(strategy == "erdos")
+		generator.erdos((long long)first);
+	else if(strategy == "barabasi")
+		generator.barabasi((int)first, (int)second);
+	else if(strategy == "watts")
+		generator.watts((int)first, second);
+	else
+	{
+		lua->callError(L, "Strategy '" + strategy + "' cannot be stored as a graph.");
+		return 0;
+	}
+
+	if(index < 0 || index >= (int)graphs.size())
+	{
+		index = (int)graphs.size();
+		graphs.push_back(CSRNeighborhood());
+	}
+
+	// a network created again under the same name replaces the previous graph
+	graphs[index] = CSRNeighborhood();
+	generator.build(graphs[index], symmetric);
+
+	lua->pushInteger(L, index);
+	return 1;
+}
+
+/// Fills two tables with the agents connected to an agent in a graph created by
+/// createGraph and with the weights of the connections, returning the number of connections.
+/// Positions whose value in the table with the agents of the graph is not a table (the
+/// agents that left the Society) are skipped
+/// parameters: graph index, position of the agent, table with the agents of the graph,
+/// table of agents, table of weights
+int luaSociety::getGraphConnections(lua_State *L)
+{
+	int top = lua->getTopIndex(L);
+	int weights = top;
+	int connections = top - 1;
+	int agents = top - 2;
+	int origin = (int)lua->toIntegerAt(L, top - 3) - 1;
+	int graph = (int)lua->toIntegerAt(L, top - 4);
+
+	if(graph < 0 || graph >= (int)graphs.size() || origin < 0 || origin >= graphs[graph].cells())
+	{
+		lua->pushInteger(L, 0);
+		return 1;
+	}
+
+	const CSRNeighborhood& csr = graphs[graph];
+	int first = csr.begin(origin);
+	int last = csr.end(origin);
+
+	int quantity = 0;
+
+	for(int p = first; p < last; p++)
+	{
+		lua->pushInteger(L, csr.getNeighbor(p) + 1);
+		lua->pushTableAt(L, agents);
+
+		if(!lua->isTableAt(L, -1))
+		{
+			lua->pop(L, 1);
+			continue;
+		}
+
+		quantity++;
+		lua->setIndexAt(L, connections, quantity);
+		lua->pushNumber(L, csr.getWeight(p));
+		lua->setIndexAt(L, weights, quantity);
+	}
+
+	lua->pushInteger(L, quantity);
+	return 1;
+}
+
 /// Gets the luaSociety position of the luaSociety in the Lua stack
 /// \param L is a pointer to the Lua stack
 /// \param cell is a pointer to the cell within the Lua stack
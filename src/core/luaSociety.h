@@ -37,6 +37,8 @@ extern "C"
 }
 #include "luna.h"
 #include "reference.h"
+#include "csrNeighborhood.h"
+#include "LuaApi.h"
 
 /**
 * \brief
@@ -60,6 +62,10 @@ class luaSociety : public SocietySubjectInterf, public Reference<luaSociety>
 
     QString attrNeighName;
 
+	terrame::lua::LuaApi* lua;
+
+	vector<CSRNeighborhood> graphs; ///< Social networks stored as graphs
+
     QString getAll(QDataStream& in, int obsId, QStringList& attribs);
     QString getChanges(QDataStream& in, int obsId, QStringList& attribs);
 
@@ -184,6 +190,20 @@ public:
 
     /// Destroys the observer object instance
     int kill(lua_State *L);
+
+	/// Creates a social network stored as a graph, shared by all the agents, and returns
+	/// its index. Agents are identified by their positions in the Society
+	/// parameters: strategy ("probability", "quantity", "erdos", "barabasi", or "watts"),
+	/// number of agents, quantity or start, probability or quantity, symmetric, seed,
+	/// index of a graph to be replaced (-1 to create a new one)
+	int createGraph(lua_State *L);
+
+	/// Fills two tables with the agents connected to an agent in a graph created by
+	/// createGraph and with the weights of the connections, returning the number of connections.
+	/// Agents that are not tables in the table with the agents of the graph are skipped
+	/// parameters: graph index, position of the agent, table with the agents of the graph,
+	/// table of agents, table of weights
+	int getGraphConnections(lua_State *L);
 };
 
 
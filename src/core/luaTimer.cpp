@@ -90,6 +90,63 @@ int luaTimer::reset(lua_State *)
     return 0;
 }
 
+/// Inserts an Event in the queue and returns its handle
+/// parameters: time, priority
+int luaTimer::addEvent(lua_State *L)
+{
+    double time = luaL_checknumber(L, -2);
+    double priority = luaL_checknumber(L, -1);
+    lua_pushinteger(L, queue.push(time, priority));
+    return 1;
+}
+
+/// Returns the handle of the next Event to be executed, or nil if the queue is empty
+int luaTimer::getFirst(lua_State *L)
+{
+    if (queue.empty())
+        lua_pushnil(L);
+    else
+        lua_pushinteger(L, queue.top());
+    return 1;
+}
+
+/// Removes the next Event to be executed from the queue
+int luaTimer::removeFirst(lua_State *)
+{
+    if (!queue.empty())
+        queue.pop();
+    return 0;
+}
+
+/// Returns the number of Events in the queue
+int luaTimer::getSize(lua_State *L)
+{
+    lua_pushinteger(L, queue.size());
+    return 1;
+}
+
+/// Removes all the Events from the queue
+int luaTimer::clearEvents(lua_State *)
+{
+    queue.clear();
+    return 0;
+}
+
+/// Returns a vector with the handles of the Events in execution order
+int luaTimer::getEvents(lua_State *L)
+{
+    std::vector<int> handles;
+    queue.sorted(handles);
+
+    lua_createtable(L, handles.size(), 0);
+    for (unsigned int i = 0; i < handles.size(); i++)
+    {
+        lua_pushinteger(L, handles[i]);
+        lua_rawseti(L, -2, i + 1);
+    }
+    return 1;
+}
+
 int luaTimer::createObserver(lua_State *luaL)
 {
     // recupero a referencia da celula
@@ -32,6 +32,7 @@ of this software and its documentation.
 #include "luaUtils.h"
 #include "reference.h"
 #include "observerScheduler.h"
+#include "eventQueue.h"
 
 /**
 * \brief
@@ -51,6 +52,8 @@ private:
 
     ObserverScheduler *obs;
 
+    EventQueue queue; ///< Events of the Lua Timer
+
 public:
     ///< Data structure issued by Luna<T>
     static const char className[];
@@ -82,6 +85,25 @@ public:
     /// Resets the luaTimer
     int reset(lua_State* L);
 
+    /// Inserts an Event in the queue and returns its handle
+    /// parameters: time, priority
+    int addEvent(lua_State* L);
+
+    /// Returns the handle of the next Event to be executed, or nil if the queue is empty
+    int getFirst(lua_State* L);
+
+    /// Removes the next Event to be executed from the queue
+    int removeFirst(lua_State* L);
+
+    /// Returns the number of Events in the queue
+    int getSize(lua_State* L);
+
+    /// Removes all the Events from the queue
+    int clearEvents(lua_State* L);
+
+    /// Returns a vector with the handles of the Events in execution order
+    int getEvents(lua_State* L);
+
     /// Creates several types of observers to the luaCellularSpace object
     /// parameters: observer type, observeb attributes table, observer type parameters
     int createObserver(lua_State *L);
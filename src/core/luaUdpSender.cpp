@@ -29,6 +29,7 @@ of this software and its documentation.
 luaUdpSender::luaUdpSender(lua_State* L)
 {
 	luaL = L;
+	obs = 0;
 }
 
 int luaUdpSender::setObserver(lua_State* L)
@@ -38,6 +39,15 @@ int luaUdpSender::setObserver(lua_State* L)
     return 0;
 }
 
+int luaUdpSender::setBandwidth(lua_State* L)
+{
+    int bandwidth = (int) lua_tonumber(L, -1);
+
+    if (obs)
+        obs->setBandwidth(bandwidth);
+    return 0;
+}
+
 luaUdpSender::~luaUdpSender(void)
 {
 }
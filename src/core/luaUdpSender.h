@@ -51,6 +51,10 @@ public:
 
 	int setObserver(lua_State* L);
 
+	/// Limits the number of bytes sent per second, 0 means no limit
+	/// parameters: bandwidth
+	int setBandwidth(lua_State* L);
+
 	/// destructor
         ~luaUdpSender(void);
 
@@ -0,0 +1,640 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+/*! \file neighborhoodFile.cpp
+	\brief This file contains the implementation of the functions to load and save neighborhoods.
+*/
+
+#include "neighborhoodFile.h"
+
+#include <clocale>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile() : begin(0), length(0)
+#ifdef WIN32
+	, file(INVALID_HANDLE_VALUE), mapping(0)
+#else
+	, descriptor(-1)
+#endif
+{
+}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open(const std::string& fileName)
+{
+	close();
+
+#ifdef WIN32
+	file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+	if(file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	if(!GetFileSizeEx(file, &fileSize))
+	{
+		close();
+		return false;
+	}
+
+	length = (size_t)fileSize.QuadPart;
+	if(length == 0) return true;
+
+	mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+	if(!mapping)
+	{
+		close();
+		return false;
+	}
+
+	begin = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+#else
+	descriptor = ::open(fileName.c_str(), O_RDONLY);
+	if(descriptor < 0)
+		return false;
+
+	struct stat status;
+	if(fstat(descriptor, &status) != 0)
+	{
+		close();
+		return false;
+	}
+
+	length = (size_t)status.st_size;
+	if(length == 0) return true;
+
+	void* address = mmap(0, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+	begin = address == MAP_FAILED ? 0 : (const char*)address;
+
+	if(begin)
+		madvise(address, length, MADV_SEQUENTIAL);
+#endif
+
+	if(!begin)
+	{
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+void MappedFile::close()
+{
+#ifdef WIN32
+	if(begin) UnmapViewOfFile(begin);
+	if(mapping) CloseHandle(mapping);
+	if(file != INVALID_HANDLE_VALUE) CloseHandle(file);
+
+	mapping = 0;
+	file = INVALID_HANDLE_VALUE;
+#else
+	if(begin) munmap((void*)begin, length);
+	if(descriptor >= 0) ::close(descriptor);
+
+	descriptor = -1;
+#endif
+
+	begin = 0;
+	length = 0;
+}
+
+double stringToDouble(const char* text, char** end)
+{
+	char point = *localeconv()->decimal_point;
+
+	if(point == '.' || point == '\0')
+		return strtod(text, end);
+
+	// strtod uses the decimal point of the locale, therefore it converts a copy of
+	// the text with this decimal point, which must stop where the text already has it
+	std::string copy(text);
+
+	for(size_t i = 0; i < copy.size(); i++)
+	{
+		if(copy[i] == point)
+		{
+			copy.resize(i);
+			break;
+		}
+
+		if(copy[i] == '.')
+			copy[i] = point;
+	}
+
+	char* last;
+	double value = strtod(copy.c_str(), &last);
+	*end = (char*)text + (last - copy.c_str());
+	return value;
+}
+
+namespace
+{
+	/// A field of a line, pointing to the memory of the file
+	struct Token
+	{
+		const char* text;
+		size_t size;
+	};
+
+	/// Splits the lines of a file in memory following the rules of File:readLine(" "):
+	/// fields are separated by single spaces and have their surrounding whitespaces
+	/// removed, and a separator at the end of a line does not create an empty field.
+	class LineReader
+	{
+	public:
+		LineReader(const char* data, size_t size) : pos(data), end(data + size) {}
+
+		/// Reads the next line, returning false at the end of the file or in an empty line.
+		bool next(std::vector<Token>& tokens)
+		{
+			tokens.clear();
+
+			if(pos >= end) return false;
+
+			const char* line = pos;
+			const char* eol = (const char*)memchr(pos, '\n', end - pos);
+
+			if(!eol) eol = end;
+
+			pos = eol < end ? eol + 1 : end;
+
+			if(eol == line) return false;
+
+			const char* start = line;
+			while(true)
+			{
+				const char* sep = (const char*)memchr(start, ' ', eol - start);
+
+				if(!sep)
+				{
+					push(tokens, start, eol);
+					break;
+				}
+
+				push(tokens, start, sep);
+				start = sep + 1;
+
+				if(start == eol) break;
+			}
+
+			return true;
+		}
+
+	private:
+		static bool isSpace(char c)
+		{
+			return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+		}
+
+		static void push(std::vector<Token>& tokens, const char* first, const char* last)
+		{
+			while(first < last && isSpace(*first)) first++;
+			while(last > first && isSpace(*(last - 1))) last--;
+
+			Token token;
+			token.text = first;
+			token.size = last - first;
+			tokens.push_back(token);
+		}
+
+		const char* pos;
+		const char* end;
+	};
+
+	/// Converts the ids of a file into ordinals reusing the same string buffer
+	class IdFinder
+	{
+	public:
+		IdFinder(const NeighborhoodFile::IdIndex& ids) : ids(ids) {}
+
+		int find(const Token& token)
+		{
+			buffer.assign(token.text, token.size);
+
+			NeighborhoodFile::IdIndex::const_iterator it = ids.find(buffer);
+			return it == ids.end() ? -1 : it->second;
+		}
+
+		/// Converts a token into a number, returning false if it is not a number
+		bool number(const Token& token, double& value)
+		{
+			if(token.size == 0) return false;
+
+			buffer.assign(token.text, token.size);
+
+			char* last;
+			value = stringToDouble(buffer.c_str(), &last);
+			return *last == '\0';
+		}
+
+	private:
+		const NeighborhoodFile::IdIndex& ids;
+		std::string buffer;
+	};
+
+	std::string text(const Token& token)
+	{
+		return std::string(token.text, token.size);
+	}
+
+	std::string notFound(const std::string& id, int line)
+	{
+		std::stringstream message;
+		message << "Could not find id '" << id << "' in line " << line << ". It seems that it is corrupted.";
+		return message.str();
+	}
+
+	std::string invalidNumber(int line)
+	{
+		std::stringstream message;
+		message << "Could not read the number of neighbors in line " << line << ". It seems that it is corrupted.";
+		return message.str();
+	}
+
+	std::string loadGAL(LineReader& reader, IdFinder& finder, CSRNeighborhood& graph)
+	{
+		std::vector<Token> line, lineID;
+		int counterLine = 2;
+		bool read = reader.next(line);
+
+		while(read)
+		{
+			int origin = finder.find(line[0]);
+
+			if(origin < 0)
+				return notFound(text(line[0]), counterLine);
+
+			double quantity;
+			if(line.size() < 2 || !finder.number(line[1], quantity))
+				return invalidNumber(counterLine);
+
+			reader.next(lineID);
+			counterLine++;
+
+			for(int i = 0; i < quantity; i++)
+			{
+				if(i >= (int)lineID.size())
+					return notFound("nil", counterLine);
+
+				int neighbor = finder.find(lineID[i]);
+
+				if(neighbor < 0)
+					return notFound(text(lineID[i]), counterLine);
+
+				graph.add(origin, neighbor, 1);
+			}
+
+			read = reader.next(line);
+			counterLine++;
+		}
+
+		return "";
+	}
+
+	std::string loadGPM(LineReader& reader, IdFinder& finder, bool weighted, CSRNeighborhood& graph)
+	{
+		std::vector<Token> line, lineID;
+		int counterLine = 2;
+		int values = weighted ? 2 : 1;
+		bool read = reader.next(line);
+
+		while(read)
+		{
+			int origin = finder.find(line[0]);
+
+			// keeps the message of the former Lua loader, which did not show the id
+			if(origin < 0)
+				return notFound("nil", counterLine);
+
+			double quantity;
+			if(line.size() < 2 || !finder.number(line[1], quantity))
+				return invalidNumber(counterLine);
+
+			reader.next(lineID);
+			counterLine++;
+
+			for(int i = 1; i <= quantity * 2; i += values)
+			{
+				if(i > (int)lineID.size())
+				{
+					if(quantity * values >= i)
+						return notFound("nil", counterLine);
+
+					continue;
+				}
+
+				int neighbor = finder.find(lineID[i - 1]);
+
+				if(neighbor < 0) continue;
+
+				double weight = 1;
+				if(weighted && (i < (int)lineID.size()) && !finder.number(lineID[i], weight))
+					weight = 1;
+
+				graph.add(origin, neighbor, weight);
+			}
+
+			read = reader.next(line);
+			counterLine++;
+		}
+
+		return "";
+	}
+
+	std::string loadGWT(LineReader& reader, IdFinder& finder, CSRNeighborhood& graph)
+	{
+		std::vector<Token> line;
+		int counterLine = 2;
+		bool read = reader.next(line);
+
+		while(read)
+		{
+			int origin = finder.find(line[0]);
+
+			if(origin < 0)
+				return notFound(text(line[0]), counterLine);
+			else if(line.size() < 3)
+				return notFound("nil", counterLine);
+
+			int neighbor = finder.find(line[1]);
+
+			if(neighbor < 0)
+				return notFound(text(line[1]), counterLine);
+
+			double weight;
+			if(!finder.number(line[2], weight))
+				weight = 1;
+
+			graph.add(origin, neighbor, weight);
+
+			read = reader.next(line);
+			counterLine++;
+		}
+
+		return "";
+	}
+
+	const char magic[] = {'G', 'P', 'M', 'B'};
+	const unsigned int version = 1;
+
+	const size_t uintSize = 4;
+	const size_t doubleSize = 8;
+
+	/// Decodes an unsigned 32-bit integer stored in little-endian byte order
+	unsigned int decodeUInt(const char* data)
+	{
+		const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+		return (unsigned int)bytes[0] | ((unsigned int)bytes[1] << 8) |
+			((unsigned int)bytes[2] << 16) | ((unsigned int)bytes[3] << 24);
+	}
+
+	/// Decodes an IEEE 754 double stored in little-endian byte order
+	double decodeDouble(const char* data)
+	{
+		uint64_t bits = (uint64_t)decodeUInt(data) | ((uint64_t)decodeUInt(data + uintSize) << 32);
+		double value;
+		memcpy(&value, &bits, sizeof(double));
+		return value;
+	}
+
+	/// Reads the fields of a GPMB file checking its bounds
+	class BinaryReader
+	{
+	public:
+		BinaryReader(const char* data, size_t size) : pos(data), end(data + size), valid(true) {}
+
+		unsigned int readUInt()
+		{
+			const char* data = skip(uintSize);
+			return data ? decodeUInt(data) : 0;
+		}
+
+		std::string readString()
+		{
+			unsigned int size = readUInt();
+			const char* data = skip(size);
+			return data ? std::string(data, size) : "";
+		}
+
+		/// Returns the current position and skips a block of bytes
+		const char* skip(size_t size)
+		{
+			const char* block = pos;
+			if(!valid || (size_t)(end - pos) < size)
+			{
+				valid = false;
+				return 0;
+			}
+
+			pos += size;
+			return block;
+		}
+
+		bool isValid() const { return valid; }
+
+		/// Returns whether all the bytes were read
+		bool atEnd() const { return pos == end; }
+
+	private:
+		const char* pos;
+		const char* end;
+		bool valid;
+	};
+
+	void writeUInt(FILE* file, unsigned int value)
+	{
+		unsigned char bytes[uintSize];
+		for(size_t i = 0; i < uintSize; i++)
+			bytes[i] = (unsigned char)(value >> (8 * i));
+
+		fwrite(bytes, 1, uintSize, file);
+	}
+
+	void writeDouble(FILE* file, double value)
+	{
+		uint64_t bits;
+		memcpy(&bits, &value, sizeof(double));
+		writeUInt(file, (unsigned int)bits);
+		writeUInt(file, (unsigned int)(bits >> 32));
+	}
+
+	void writeString(FILE* file, const std::string& value)
+	{
+		writeUInt(file, (unsigned int)value.size());
+		fwrite(value.data(), 1, value.size(), file);
+	}
+}
+
+std::string NeighborhoodFile::loadText(const std::string& fileName, const std::string& format, bool weighted,
+	const IdIndex& ids, CSRNeighborhood& graph)
+{
+	MappedFile file;
+
+	if(!file.open(fileName))
+		return "Could not open file '" + fileName + "'.";
+
+	LineReader reader(file.data(), file.size());
+	IdFinder finder(ids);
+	std::vector<Token> header;
+
+	reader.next(header);
+
+	if(format == "gal")
+		return loadGAL(reader, finder, graph);
+	else if(format == "gpm")
+		return loadGPM(reader, finder, weighted, graph);
+	else if(format == "gwt")
+		return loadGWT(reader, finder, graph);
+
+	return "Invalid neighborhood format '" + format + "'.";
+}
+
+std::string NeighborhoodFile::loadBinary(const std::string& fileName, const IdIndex& ids,
+	CSRNeighborhood& graph, std::string& layer)
+{
+	MappedFile file;
+
+	if(!file.open(fileName))
+		return "Could not open file '" + fileName + "'.";
+
+	std::string corrupted = "Could not read file '" + fileName + "'. It seems that it is corrupted.";
+	BinaryReader reader(file.data(), file.size());
+
+	const char* fileMagic = reader.skip(sizeof(magic));
+	if(!fileMagic || memcmp(fileMagic, magic, sizeof(magic)) != 0)
+		return "File '" + fileName + "' is not a GPMB file.";
+
+	if(reader.readUInt() != version)
+		return "File '" + fileName + "' was created by an incompatible version of TerraME.";
+
+	layer = reader.readString();
+
+	unsigned int cells = reader.readUInt();
+	unsigned int connections = reader.readUInt();
+
+	if(!reader.isValid())
+		return corrupted;
+
+	std::vector<int> ordinals(cells);
+	for(unsigned int i = 0; i < cells; i++)
+	{
+		std::string id = reader.readString();
+
+		if(!reader.isValid())
+			return corrupted;
+
+		IdIndex::const_iterator it = ids.find(id);
+		if(it == ids.end())
+			return "Could not find id '" + id + "' from file '" + fileName + "' in the CellularSpace.";
+
+		ordinals[i] = it->second;
+	}
+
+	const char* degrees = reader.skip((size_t)cells * uintSize);
+	const char* neighbors = reader.skip((size_t)connections * uintSize);
+	const char* weights = reader.skip((size_t)connections * doubleSize);
+
+	if(!reader.isValid() || !reader.atEnd())
+		return corrupted;
+
+	uint64_t total = 0;
+	for(unsigned int i = 0; i < cells; i++)
+		total += decodeUInt(degrees + (size_t)i * uintSize);
+
+	if(total != connections)
+		return corrupted;
+
+	graph.reserve(connections);
+
+	unsigned int p = 0;
+	for(unsigned int i = 0; i < cells; i++)
+	{
+		unsigned int degree = decodeUInt(degrees + (size_t)i * uintSize);
+
+		for(unsigned int j = 0; j < degree; j++, p++)
+		{
+			unsigned int neighbor = decodeUInt(neighbors + (size_t)p * uintSize);
+			double weight = decodeDouble(weights + (size_t)p * doubleSize);
+
+			if(neighbor >= cells)
+				return corrupted;
+
+			graph.add(ordinals[i], ordinals[neighbor], weight);
+		}
+	}
+
+	return "";
+}
+
+std::string NeighborhoodFile::saveBinary(const std::string& fileName, const std::string& layer,
+	const std::vector<std::string>& ids, const CSRNeighborhood& graph)
+{
+	FILE* file = fopen(fileName.c_str(), "wb");
+
+	if(!file)
+		return "Could not write file '" + fileName + "'.";
+
+	unsigned int cells = graph.cells();
+
+	fwrite(magic, 1, sizeof(magic), file);
+	writeUInt(file, version);
+	writeString(file, layer);
+	writeUInt(file, cells);
+	writeUInt(file, (unsigned int)graph.size());
+
+	for(unsigned int i = 0; i < cells; i++)
+		writeString(file, ids[i]);
+
+	for(unsigned int i = 0; i < cells; i++)
+		writeUInt(file, (unsigned int)graph.degree(i));
+
+	for(int p = 0; p < graph.size(); p++)
+		writeUInt(file, (unsigned int)graph.getNeighbor(p));
+
+	for(int p = 0; p < graph.size(); p++)
+		writeDouble(file, graph.getWeight(p));
+
+	bool error = ferror(file) != 0;
+
+	if(fclose(file) != 0 || error)
+		return "Could not write file '" + fileName + "'.";
+
+	return "";
+}
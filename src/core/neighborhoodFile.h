@@ -0,0 +1,126 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+/*! \file neighborhoodFile.h
+	\brief This file contains the functions to load neighborhoods from GAL, GPM, and GWT
+	files, and to load and save them in the binary GPMB format.
+*/
+
+#ifndef NEIGHBORHOOD_FILE_H
+#define NEIGHBORHOOD_FILE_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "csrNeighborhood.h"
+
+/**
+* \brief
+*  Read-only view of a file mapped into memory.
+*/
+class MappedFile
+{
+public:
+	/// Constructor
+	MappedFile();
+
+	/// Destructor. It unmaps the file.
+	~MappedFile();
+
+	/// Maps a file into memory, returning whether it was possible to open it.
+	bool open(const std::string& fileName);
+
+	/// Unmaps the file.
+	void close();
+
+	/// Returns the first byte of the file
+	const char* data() const { return begin; }
+
+	/// Returns the size of the file in bytes
+	size_t size() const { return length; }
+
+private:
+	MappedFile(const MappedFile&);
+	MappedFile& operator=(const MappedFile&);
+
+	const char* begin;
+	size_t length;
+#ifdef WIN32
+	void* file;
+	void* mapping;
+#else
+	int descriptor;
+#endif
+};
+
+/// Converts the beginning of a text into a double as strtod does, but always using '.'
+/// as decimal point, whatever the locale of the program.
+/// \param end returns the position after the last character converted
+double stringToDouble(const char* text, char** end);
+
+/**
+* \brief
+*  Loads and saves neighborhoods, converting the ids of the cells to their ordinals
+*  within the CellularSpace. Text files are parsed directly from memory, with the same
+*  rules and error messages of the former Lua loaders.
+*
+*  A GPMB file stores, in little-endian byte order whatever the machine that created it:
+*  the magic number "GPMB"; a 32-bit version; the layer name (32-bit length followed by
+*  its characters); the number of cells and of connections (32 bits each); the id of each
+*  cell (32-bit length followed by its characters); the number of connections of each cell
+*  (32 bits each); the index of the neighbor cell of each connection (32 bits each);
+*  and the weight of each connection (64-bit IEEE 754 double each). A file is rejected if
+*  the numbers of connections of the cells do not add up to the number of connections or
+*  if there are bytes after the weights.
+*/
+class NeighborhoodFile
+{
+public:
+	/// Index from the ids of the cells to their ordinals
+	typedef std::unordered_map<std::string, int> IdIndex;
+
+	/// Loads a GAL, GPM, or GWT file. The first line of the file (header) is ignored.
+	/// \param fileName the name of the file
+	/// \param format "gal", "gpm", or "gwt"
+	/// \param weighted whether each neighbor of a GPM file is followed by the weight of the connection
+	/// \param ids the ordinals of the cells indexed by their ids
+	/// \param graph the neighborhood that receives the connections
+	/// \return an empty string if the file was loaded, otherwise an error message
+	static std::string loadText(const std::string& fileName, const std::string& format, bool weighted,
+		const IdIndex& ids, CSRNeighborhood& graph);
+
+	/// Loads a GPMB file.
+	/// \param layer returns the name of the layer stored in the file
+	/// \return an empty string if the file was loaded, otherwise an error message
+	static std::string loadBinary(const std::string& fileName, const IdIndex& ids,
+		CSRNeighborhood& graph, std::string& layer);
+
+	/// Saves a neighborhood as a GPMB file.
+	/// \param ids the ids of the cells indexed by their ordinals
+	/// \return an empty string if the file was saved, otherwise an error message
+	static std::string saveBinary(const std::string& fileName, const std::string& layer,
+		const std::vector<std::string>& ids, const CSRNeighborhood& graph);
+};
+
+#endif // NEIGHBORHOOD_FILE_H
@@ -0,0 +1,255 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+/*! \file processPool.cpp
+	\brief This file contains a pool of child processes that execute independent runs.
+*/
+
+#include "processPool.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+
+#ifndef WIN32
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+ProcessPool::~ProcessPool()
+{
+	terminate();
+}
+
+bool ProcessPool::isSupported()
+{
+#ifdef WIN32
+	return false;
+#else
+	return true;
+#endif
+}
+
+int ProcessPool::processors()
+{
+#ifdef WIN32
+	return 1;
+#else
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 0 ? (int)count : 1;
+#endif
+}
+
+#ifdef WIN32
+
+bool ProcessPool::start(int run, Task task, void* data)
+{
+	Result result;
+	result.run = run;
+	result.ok = task(run, result.text, data);
+	finished.push_back(result);
+	return true;
+}
+
+bool ProcessPool::wait(int& run, bool& ok, std::string& text)
+{
+	if(finished.empty()) return false;
+
+	run = finished.front().run;
+	ok = finished.front().ok;
+	text = finished.front().text;
+	finished.pop_front();
+	return true;
+}
+
+void ProcessPool::terminate()
+{
+	finished.clear();
+}
+
+#else
+
+static bool writeAll(int fd, const char* data, size_t size)
+{
+	while(size > 0)
+	{
+		ssize_t written = write(fd, data, size);
+
+		if(written < 0)
+		{
+			if(errno == EINTR) continue;
+			return false;
+		}
+
+		data += written;
+		size -= written;
+	}
+
+	return true;
+}
+
+bool ProcessPool::start(int run, Task task, void* data)
+{
+	int fds[2];
+
+	if(pipe(fds) != 0)
+		return false;
+
+	fflush(stdout);
+	fflush(stderr);
+
+	pid_t pid = fork();
+
+	if(pid < 0)
+	{
+		close(fds[0]);
+		close(fds[1]);
+		return false;
+	}
+
+	if(pid == 0)
+	{
+		close(fds[0]);
+
+		for(unsigned int i = 0; i < processes.size(); i++)
+			close(processes[i].fd);
+
+		std::string result;
+		char ok = task(run, result, data) ? 1 : 0;
+
+		fflush(stdout);
+		fflush(stderr);
+
+		writeAll(fds[1], &ok, 1);
+		writeAll(fds[1], result.data(), result.size());
+		close(fds[1]);
+
+		// atexit handlers and destructors belong to the parent
+		_exit(0);
+	}
+
+	close(fds[1]);
+
+	Process process;
+	process.pid = pid;
+	process.fd = fds[0];
+	process.run = run;
+	processes.push_back(process);
+	return true;
+}
+
+void ProcessPool::finish(Process& process, Result& result)
+{
+	int status = 0;
+
+	close(process.fd);
+	while(waitpid(process.pid, &status, 0) < 0 && errno == EINTR);
+
+	result.run = process.run;
+	result.ok = false;
+
+	if(WIFEXITED(status) && WEXITSTATUS(status) == 0 && !process.data.empty())
+	{
+		result.ok = process.data[0] == 1;
+		result.text = process.data.substr(1);
+		return;
+	}
+
+	std::ostringstream stream;
+	stream << "Run " << process.run << " finished unexpectedly";
+
+	if(WIFSIGNALED(status))
+		stream << " (signal " << WTERMSIG(status) << ")";
+	else if(WIFEXITED(status) && WEXITSTATUS(status) != 0)
+		stream << " (exit code " << WEXITSTATUS(status) << ")";
+
+	stream << ".";
+	result.text = stream.str();
+}
+
+bool ProcessPool::wait(int& run, bool& ok, std::string& text)
+{
+	if(processes.empty()) return false;
+
+	std::vector<pollfd> fds(processes.size());
+	char buffer[65536];
+
+	while(true)
+	{
+		for(unsigned int i = 0; i < processes.size(); i++)
+		{
+			fds[i].fd = processes[i].fd;
+			fds[i].events = POLLIN;
+			fds[i].revents = 0;
+		}
+
+		if(poll(&fds[0], fds.size(), -1) < 0)
+		{
+			if(errno == EINTR) continue;
+			return false;
+		}
+
+		for(unsigned int i = 0; i < processes.size(); i++)
+		{
+			if(!fds[i].revents) continue;
+
+			ssize_t size = read(processes[i].fd, buffer, sizeof(buffer));
+
+			if(size < 0 && errno == EINTR) continue;
+
+			if(size > 0)
+			{
+				processes[i].data.append(buffer, size);
+				continue;
+			}
+
+			Result result;
+			finish(processes[i], result);
+			processes.erase(processes.begin() + i);
+
+			run = result.run;
+			ok = result.ok;
+			text = result.text;
+			return true;
+		}
+	}
+}
+
+void ProcessPool::terminate()
+{
+	for(unsigned int i = 0; i < processes.size(); i++)
+	{
+		int status;
+
+		kill(processes[i].pid, SIGKILL);
+		close(processes[i].fd);
+		while(waitpid(processes[i].pid, &status, 0) < 0 && errno == EINTR);
+	}
+
+	processes.clear();
+}
+
+#endif
@@ -0,0 +1,105 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+/*! \file processPool.h
+	\brief This file contains a pool of child processes that execute independent runs.
+*/
+
+#ifndef PROCESS_POOL_H
+#define PROCESS_POOL_H
+
+#include <string>
+#include <vector>
+#include <deque>
+
+/**
+* \brief
+*  Executes tasks in child processes created by fork(), which share the memory of the
+*  parent process copy-on-write until they change it. Each child sends a text back to
+*  the parent through a pipe. In systems without fork(), the tasks are executed in the
+*  current process when they are started. A child has only the thread that started it,
+*  and the mutexes held by other threads at that moment remain locked in the child.
+*  Therefore, tasks must be started while the parent has no other threads running.
+*/
+class ProcessPool
+{
+public:
+	/// Function executed by the child process
+	/// \param run the number of the run
+	/// \param result the text to be sent to the parent
+	/// \param data the pointer given to start()
+	/// \return whether the run succeeded
+	typedef bool (*Task)(int run, std::string& result, void* data);
+
+	/// Constructor
+	ProcessPool() {}
+
+	/// Destructor. Kills the processes still running.
+	~ProcessPool();
+
+	/// Creates a process to execute a task.
+	/// \return false if the process could not be created
+	bool start(int run, Task task, void* data);
+
+	/// Waits until a process finishes.
+	/// \param run the number of the run of the process
+	/// \param ok whether the task succeeded
+	/// \param result the text sent by the process, or a description of why it failed
+	/// \return false if there is no process running
+	bool wait(int& run, bool& ok, std::string& result);
+
+	/// Returns the number of processes started and not waited yet
+	int running() const { return (int)processes.size() + (int)finished.size(); }
+
+	/// Kills all the processes still running
+	void terminate();
+
+	/// Returns whether the runs are executed in separate processes
+	static bool isSupported();
+
+	/// Returns the number of processors available
+	static int processors();
+
+private:
+	struct Process
+	{
+		int pid;
+		int fd;
+		int run;
+		std::string data;
+	};
+
+	struct Result
+	{
+		int run;
+		bool ok;
+		std::string text;
+	};
+
+	void finish(Process& process, Result& result);
+
+	std::vector<Process> processes;
+	std::deque<Result> finished;
+};
+
+#endif // PROCESS_POOL_H
@@ -110,6 +110,8 @@ Luna<luaSociety>::RegType luaSociety::methods[] = {
 	method(luaSociety, createObserver),
 	method(luaSociety, notify),
 	method(luaSociety, kill),
+	method(luaSociety, createGraph),
+	method(luaSociety, getGraphConnections),
 	{0, 0}
 };
 
@@ -139,6 +141,9 @@ Luna<luaCell>::RegType luaCell::methods[] = {
 	method(luaCell, createObserver),
 	method(luaCell, notify),
 	method(luaCell, kill),
+	method(luaCell, getAttribute),
+	method(luaCell, setAttribute),
+	method(luaCell, getPastAttribute),
 	{0, 0}
 };
 //----------------------------------------------------------------------------------------------//////////////////////////////
@@ -169,6 +174,25 @@ Luna<luaCellularSpace>::RegType luaCellularSpace::methods[] = {
 	method(luaCellularSpace, kill),
 
 	method(luaCellularSpace, getLayerName),
+
+	method(luaCellularSpace, addAttribute),
+	method(luaCellularSpace, synchronize),
+	method(luaCellularSpace, saveSnapshot),
+	method(luaCellularSpace, loadSnapshot),
+	method(luaCellularSpace, removeSnapshot),
+	method(luaCellularSpace, getColumn),
+	method(luaCellularSpace, setColumn),
+	method(luaCellularSpace, addStencil),
+	method(luaCellularSpace, getStencilNeighbors),
+	method(luaCellularSpace, addGraph),
+	method(luaCellularSpace, addGraphConnections),
+	method(luaCellularSpace, buildGraph),
+	method(luaCellularSpace, getGraphNeighbors),
+	method(luaCellularSpace, getCellByID),
+	method(luaCellularSpace, getCellByIndex),
+	method(luaCellularSpace, loadGraph),
+	method(luaCellularSpace, saveGraph),
+	method(luaCellularSpace, traverse),
 	{0, 0}
 };
 
@@ -285,6 +309,16 @@ Luna<luaMap>::RegType luaMap::methods[] = {
 	{0, 0}
 };
 
+const char luaImage::className[] = "TeImage";
+
+Luna<luaImage>::RegType luaImage::methods[] = {
+	method(luaImage, save),
+	method(luaImage, setObserver),
+	method(luaImage, setGridVisible),
+	method(luaImage, setFileName),
+	{0, 0}
+};
+
 const char luaTextScreen::className[] = "TeTextScreen";
 
 Luna<luaTextScreen>::RegType luaTextScreen::methods[] = {
@@ -305,6 +339,7 @@ const char luaLogFile::className[] = "TeLogFile";
 
 Luna<luaLogFile>::RegType luaLogFile::methods[] = {
         method(luaLogFile, setObserver),
+        method(luaLogFile, setFormat),
         {0, 0}
 };
 
@@ -319,6 +354,7 @@ const char luaUdpSender::className[] = "TeUdpSender";
 
 Luna<luaUdpSender>::RegType luaUdpSender::methods[] = {
         method(luaUdpSender, setObserver),
+        method(luaUdpSender, setBandwidth),
         {0, 0}
 };
 
@@ -362,6 +398,12 @@ Luna<luaTimer>::RegType luaTimer::methods[] =
 	method(luaTimer, getTime),
 	method(luaTimer, isEmpty),
 	method(luaTimer, reset),
+	method(luaTimer, addEvent),
+	method(luaTimer, getFirst),
+	method(luaTimer, removeFirst),
+	method(luaTimer, getSize),
+	method(luaTimer, clearEvents),
+	method(luaTimer, getEvents),
 	method(luaTimer, execute),
 
 	method(luaTimer, getReference),
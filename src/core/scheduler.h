@@ -53,6 +53,7 @@ of this software and its documentation.
 
 #include "event.h"
 #include "message.h"
+#include "schedulerQueue.h"
 
 #include <QApplication>
 #include "player.h"
@@ -63,13 +64,6 @@ extern bool SHOW_GUI;
 extern bool paused;
 extern bool step;
 
-/**
-* \brief
-*  Event-Message Pair Composite Handle Type.
-*
-*/
-typedef CompositeInterface<multimapComposite<Event, Message*> > EventMessagePairCompositeInterf;
-
 /**
 * \brief
 *  Implementation for a Scheduler object.
@@ -86,8 +80,38 @@ public:
         if (SHOW_GUI)
             TerraMEObserver::Player::getInstance().setEnabled(true);
         time_.setTime(-DBL_MAX);
+        queueType = TMultimapQueue;
+        eventMessageQueue = createSchedulerQueue(queueType);
+    }
+
+    /// Destructor
+    ~SchedulerImpl(void)
+    {
+        delete eventMessageQueue;
+    }
+
+    /// Changes the data structure of the Event-Message queue, keeping its current pairs.
+    /// \param type is the type of the new queue
+    void setQueueType(SchedulerQueueType type)
+    {
+        if (type == queueType) return;
+
+        SchedulerQueue* queue = createSchedulerQueue(type);
+        while (!eventMessageQueue->empty())
+        {
+            Event event = eventMessageQueue->getEvent();
+            queue->add(event, eventMessageQueue->getMessage());
+            eventMessageQueue->pop();
+        }
+
+        delete eventMessageQueue;
+        eventMessageQueue = queue;
+        queueType = type;
     }
 
+    /// Gets the type of the Event-Message queue
+    SchedulerQueueType getQueueType() { return queueType; }
+
     /// Resets the Scheduler simulation time
     void reset(void)
 	{
@@ -111,14 +135,8 @@ public:
     /// \return A copy to the Event object on Event-Message head
     Event getEvent(void)
 	{
-        EventMessagePairCompositeInterf::iterator iterator = eventMessageQueue.begin();
-        pair<Event, Message*> eventMessagePair;
-
-        if (iterator != eventMessageQueue.end())
-        {
-            eventMessagePair.first = iterator->first;
-            return eventMessagePair.first;
-        }
+        if (!eventMessageQueue->empty())
+            return eventMessageQueue->getEvent();
 
         return time_;
     }
@@ -132,45 +150,35 @@ public:
     /// \param message is a pointer to message being linked to the Event
     void add(Event& event, Message* message)
 	{
-        pair<Event, Message*> eventMessagePair;
-        eventMessagePair.first = event;
-        eventMessagePair.second = message;
-        eventMessageQueue.add(eventMessagePair);
+        eventMessageQueue->add(event, message);
     }
 
     /// Executes the Scheduler object. Only one simulation time step is executed.
     /// Therefore, just the Message on the head of the Scheduler queue is executed.
-    /// \return A reference to Event object which has triggered the Message object
-    Event& execute()
+    /// \return A copy of the Event on the head of the queue after the execution, as the
+    /// queue may move its Events when new ones are added
+    Event execute()
 	{
-        pair<Event, Message*> eventMessagePair;
-        EventMessagePairCompositeInterf::iterator iterator;
-
-        iterator = eventMessageQueue.begin();
-        if (iterator != eventMessageQueue.end())
+        if (!eventMessageQueue->empty())
         {
-            Event& event = eventMessagePair.first = iterator->first;
-            Message *message = eventMessagePair.second = iterator->second;
+            Event event = eventMessageQueue->getEvent();
+            Message *message = eventMessageQueue->getMessage();
 
             time_ = event.getTime();
 
             Message msg = *message; // it's Important to keep the message implementation alive
-            eventMessageQueue.erase(iterator);
+            eventMessageQueue->pop();
 
             if (message->execute(event))
 			{
-                eventMessagePair.first.setTime(double(time_.getTime() + event.getPeriod()));
-                eventMessageQueue.add(eventMessagePair);
+                event.setTime(double(time_.getTime() + event.getPeriod()));
+                eventMessageQueue->add(event, message);
             }
-
-            iterator = eventMessageQueue.begin();
         }
 
-        if (!eventMessageQueue.empty())
-        {
-            Event& event =(Event&)iterator->first;
-            return event;
-        }
+        if (!eventMessageQueue->empty())
+            return eventMessageQueue->getEvent();
+
         return time_;
     }
 
@@ -182,16 +190,13 @@ public:
 	{
         Event event;
         Message *message;
-        pair<Event, Message*> eventMessagePair;
-        EventMessagePairCompositeInterf::iterator iterator;
 
-        iterator = eventMessageQueue.begin();
-        while (iterator != eventMessageQueue.end() && time_.getTime() <= finalTime)
+        while (!eventMessageQueue->empty() && time_.getTime() <= finalTime)
         {
             while (paused) qApp->processEvents();
 
-            event = eventMessagePair.first = iterator->first;
-            message = eventMessagePair.second = iterator->second;
+            event = eventMessageQueue->getEvent();
+            message = eventMessageQueue->getMessage();
 
             if (event.getTime() > finalTime)
 			{
@@ -201,16 +206,14 @@ public:
 
             time_ = event.getTime();
             Message msg = *message; // it's Important to keep the message implementation alive
-            eventMessageQueue.erase(iterator);
+            eventMessageQueue->pop();
 
             if (message->execute(event))
 			{
-                eventMessagePair.first.setTime(double(time_.getTime() + event.getPeriod()));
-                eventMessageQueue.add(eventMessagePair);
+                event.setTime(double(time_.getTime() + event.getPeriod()));
+                eventMessageQueue->add(event, message);
             }
 
-            iterator = eventMessageQueue.begin();
-
             if (step) paused = true;
         }
 		return finalTime;
@@ -224,10 +227,11 @@ public:
 
     /// Return true if the Event-Message queue is empty.
     /// \return A boolean value: returns true if the Scheduler queue is empty, otherwise returns false.
-    bool empty(void) { return eventMessageQueue.empty(); }
+    bool empty(void) { return eventMessageQueue->empty(); }
 
-public:
-    EventMessagePairCompositeInterf eventMessageQueue; ///< Event-Message Pair queue
+private:
+    SchedulerQueue* eventMessageQueue; ///< Event-Message Pair queue
+    SchedulerQueueType queueType; ///< Data structure used by eventMessageQueue
 };
 
 /**
@@ -257,8 +261,8 @@ public:
 
     /// Executes the Scheduler object. Only one simulation time step is executed.
     /// Therefore, just the Message on the head of the Scheduler queue is executed.
-    /// \return A reference to Event object which has triggered the Message object
-    Event& execute() { return SchedulerInterf::pImpl_->execute(); }
+    /// \return A copy of the Event on the head of the queue after the execution
+    Event execute() { return SchedulerInterf::pImpl_->execute(); }
 
     /// Executes the Scheduler object. Messages are executed until the end simulation time has been reached or
     /// until the Event-Message queue becomes empty.
@@ -287,6 +291,13 @@ public:
     /// \return A boolean value: returns true if the Scheduler queue is empty, otherwise returns false.
     bool empty(void) { return SchedulerInterf::pImpl_->empty(); }
 
+    /// Changes the data structure of the Event-Message queue, keeping its current pairs.
+    /// \param type is the type of the new queue
+    void setQueueType(SchedulerQueueType type) { SchedulerInterf::pImpl_->setQueueType(type); }
+
+    /// Gets the type of the Event-Message queue
+    SchedulerQueueType getQueueType() { return SchedulerInterf::pImpl_->getQueueType(); }
+
     /// Resets the Scheduler simulation time
     void reset(void) { SchedulerInterf::pImpl_->reset(); }
 
@@ -0,0 +1,402 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+/*!
+	\file schedulerQueue.h
+	\brief This file contains the Event-Message queues used by the Scheduler objects.
+		There are two implementations. MultimapSchedulerQueue keeps the pairs in a
+		multimap composite. CalendarSchedulerQueue is a calendar queue [Brown, 1988]
+		that reuses its nodes, so dispatching an Event does not allocate memory.
+		It works better when most Events are periodic.
+	Referece:
+	Brown, R.. "Calendar queues: a fast O(1) priority queue implementation for the
+	simulation event set problem", Communications of the ACM, 31(10), 1988.
+*/
+
+#ifndef SCHEDULER_QUEUE_H
+#define SCHEDULER_QUEUE_H
+
+#include "composite.h"
+#include "event.h"
+#include "message.h"
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+/**
+* \brief
+*  Event-Message Pair Composite Handle Type.
+*
+*/
+typedef CompositeInterface<multimapComposite<Event, Message*> > EventMessagePairCompositeInterf;
+
+/**
+* \brief
+*  Types of Event-Message queues that can be used by a Scheduler.
+*
+*/
+enum SchedulerQueueType
+{
+	TMultimapQueue,
+	TCalendarQueue
+};
+
+/**
+* \brief
+*  Interface of the Event-Message queues. Events are ordered by time and priority.
+*  Events with the same time and priority are ordered by insertion.
+*
+*/
+class SchedulerQueue
+{
+public:
+	/// Destructor
+	virtual ~SchedulerQueue() {}
+
+	/// Adds a new pair Event-Message to the queue
+	virtual void add(Event& event, Message* message) = 0;
+
+	/// Return true if the queue is empty
+	virtual bool empty() = 0;
+
+	/// Returns the number of Event-Message pairs in the queue
+	virtual int size() = 0;
+
+	/// Gets the Event on the head of the queue. The queue must not be empty.
+	/// The reference is valid only until the queue is changed.
+	virtual Event& getEvent() = 0;
+
+	/// Gets the Message on the head of the queue. The queue must not be empty.
+	virtual Message* getMessage() = 0;
+
+	/// Removes the pair on the head of the queue
+	virtual void pop() = 0;
+};
+
+/**
+* \brief
+*  Event-Message queue based on a multimap composite.
+*
+*/
+class MultimapSchedulerQueue : public SchedulerQueue
+{
+public:
+	void add(Event& event, Message* message)
+	{
+		eventMessageQueue.add(pair<Event, Message*>(event, message));
+	}
+
+	bool empty() { return eventMessageQueue.empty(); }
+
+	int size() { return eventMessageQueue.size(); }
+
+	Event& getEvent() { return (Event&)eventMessageQueue.begin()->first; }
+
+	Message* getMessage() { return eventMessageQueue.begin()->second; }
+
+	void pop() { eventMessageQueue.erase(eventMessageQueue.begin()); }
+
+private:
+	EventMessagePairCompositeInterf eventMessageQueue; ///< Event-Message Pair queue
+};
+
+/**
+* \brief
+*  Event-Message queue based on a calendar queue. Each bucket stores a sorted
+*  list of nodes that covers an interval of time with size width. Nodes are kept
+*  in a pool, therefore adding and removing Events only allocates memory when
+*  the pool or the number of buckets grow.
+*
+*/
+class CalendarSchedulerQueue : public SchedulerQueue
+{
+public:
+	/// Constructor
+	/// \param buckets is the initial number of buckets
+	/// \param width is the initial size of the interval of time of each bucket
+	CalendarSchedulerQueue(int buckets = 16, double width = 1.0)
+	{
+		count = 0;
+		counter = 0;
+		freeNode = -1;
+		current = -1;
+		lastYear = HUGE_VAL;
+		initialize(buckets, width);
+	}
+
+	void add(Event& event, Message* message)
+	{
+		int n = allocate();
+		nodes[n].event = event;
+		nodes[n].message = message;
+		insert(n);
+		count++;
+
+		if(count > 2 * (int)heads.size())
+			resize(2 * heads.size());
+	}
+
+	bool empty() { return count == 0; }
+
+	int size() { return count; }
+
+	Event& getEvent() { return nodes[heads[locate()]].event; }
+
+	Message* getMessage() { return nodes[heads[locate()]].message; }
+
+	void pop()
+	{
+		if(count == 0) return;
+
+		int n = unlink(locate());
+		nodes[n].message = 0;
+		nodes[n].next = freeNode;
+		freeNode = n;
+		count--;
+
+		if(count < (int)heads.size() / 2 && heads.size() > 16)
+			resize(heads.size() / 2);
+	}
+
+	/// Returns the size of the interval of time of each bucket
+	double getWidth() { return width; }
+
+	/// Returns the number of buckets
+	int getBuckets() { return heads.size(); }
+
+private:
+	struct Node
+	{
+		Event event;
+		Message* message;
+		double time;
+		double priority;
+		double year; ///< index of the bucket without wrapping
+		unsigned long long order;
+		int next;
+	};
+
+	bool before(const Node& a, const Node& b) const
+	{
+		if(a.time != b.time) return a.time < b.time;
+		if(a.priority != b.priority) return a.priority < b.priority;
+		return a.order < b.order;
+	}
+
+	int bucketOf(double year) const
+	{
+		double b = std::fmod(year, (double)heads.size());
+		if(b < 0) b += heads.size();
+		return (int)b;
+	}
+
+	void initialize(int buckets, double newWidth)
+	{
+		width = newWidth;
+		heads.assign(buckets, -1);
+		tails.assign(buckets, -1);
+		current = -1;
+	}
+
+	int allocate()
+	{
+		if(freeNode >= 0)
+		{
+			int n = freeNode;
+			freeNode = nodes[n].next;
+			return n;
+		}
+
+		nodes.push_back(Node());
+		return nodes.size() - 1;
+	}
+
+	void insert(int n)
+	{
+		Node& node = nodes[n];
+		node.time = node.event.getTime();
+		node.priority = node.event.getPriority();
+		node.year = std::floor(node.time / width);
+		node.order = counter++;
+		node.next = -1;
+
+		// Events added before the last removed one
+		if(node.year < lastYear)
+			lastYear = node.year;
+
+		int b = bucketOf(node.year);
+		int tail = tails[b];
+
+		if(tail < 0)
+		{
+			heads[b] = tails[b] = n;
+		}
+		else if(!before(node, nodes[tail]))
+		{
+			// periodic Events are usually appended to the end of the bucket
+			nodes[tail].next = n;
+			tails[b] = n;
+		}
+		else if(before(node, nodes[heads[b]]))
+		{
+			node.next = heads[b];
+			heads[b] = n;
+		}
+		else
+		{
+			int prev = heads[b];
+			while(!before(node, nodes[nodes[prev].next]))
+				prev = nodes[prev].next;
+
+			node.next = nodes[prev].next;
+			nodes[prev].next = n;
+		}
+
+		if(current >= 0 && (node.year < currentYear || (b == current && heads[b] == n)))
+			current = -1;
+	}
+
+	int unlink(int b)
+	{
+		int n = heads[b];
+		heads[b] = nodes[n].next;
+		if(heads[b] < 0) tails[b] = -1;
+		current = -1;
+		lastYear = nodes[n].year;
+		return n;
+	}
+
+	/// Returns the bucket whose first node is the head of the queue
+	int locate()
+	{
+		if(current >= 0) return current;
+
+		int size = heads.size();
+		double year = lastYear;
+
+		for(int i = 0; i < size; i++, year++)
+		{
+			int b = bucketOf(year);
+			int h = heads[b];
+			if(h >= 0 && nodes[h].year <= year)
+			{
+				current = b;
+				currentYear = year;
+				return b;
+			}
+		}
+
+		// direct search when there is no Event within the next year
+		int best = -1;
+		for(int b = 0; b < size; b++)
+		{
+			if(heads[b] >= 0 && (best < 0 || before(nodes[heads[b]], nodes[heads[best]])))
+				best = b;
+		}
+
+		current = best;
+		if(best >= 0)
+		{
+			currentYear = nodes[heads[best]].year;
+			lastYear = currentYear;
+		}
+
+		return best;
+	}
+
+	/// Changes the number of buckets and estimates a new width from the first Events
+	void resize(int buckets)
+	{
+		std::vector<int> all;
+		all.reserve(count);
+		for(unsigned int b = 0; b < heads.size(); b++)
+		{
+			for(int n = heads[b]; n >= 0; n = nodes[n].next)
+				all.push_back(n);
+		}
+
+		std::vector<double> times;
+		for(unsigned int i = 0; i < all.size(); i++)
+			times.push_back(nodes[all[i]].time);
+
+		int sample = std::min((int)times.size(), 25);
+		std::partial_sort(times.begin(), times.begin() + sample, times.end());
+
+		double sum = 0;
+		int gaps = 0;
+		for(int i = 1; i < sample; i++)
+		{
+			double gap = times[i] - times[i - 1];
+			if(gap > 0)
+			{
+				sum += gap;
+				gaps++;
+			}
+		}
+
+		// periodic Events share the same times, therefore the width is the
+		// average separation between distinct times, one time per bucket
+		double newWidth = gaps > 0 ? sum / gaps : width;
+
+		// keeps the insertion order of the Events with the same time and priority
+		std::sort(all.begin(), all.end(), OrderOf(nodes));
+
+		initialize(buckets, newWidth);
+		lastYear = HUGE_VAL;
+		for(unsigned int i = 0; i < all.size(); i++)
+		{
+			unsigned long long order = nodes[all[i]].order;
+			insert(all[i]);
+			nodes[all[i]].order = order;
+		}
+	}
+
+	struct OrderOf
+	{
+		OrderOf(std::vector<Node>& n) : nodes(n) {}
+		bool operator()(int a, int b) const { return nodes[a].order < nodes[b].order; }
+		std::vector<Node>& nodes;
+	};
+
+	std::vector<Node> nodes; ///< pool of nodes
+	std::vector<int> heads; ///< first node of each bucket
+	std::vector<int> tails; ///< last node of each bucket
+	double width; ///< size of the interval of time of each bucket
+	double lastYear; ///< year of the last Event removed from the queue
+	double currentYear; ///< year of the head of the queue
+	int current; ///< bucket of the head of the queue, or -1 if unknown
+	int freeNode; ///< first node of the list of free nodes
+	int count; ///< number of Events in the queue
+	unsigned long long counter; ///< insertion counter
+};
+
+/// Creates a new Event-Message queue of a given type
+inline SchedulerQueue* createSchedulerQueue(SchedulerQueueType type)
+{
+	if(type == TCalendarQueue)
+		return new CalendarSchedulerQueue();
+	return new MultimapSchedulerQueue();
+}
+
+#endif // SCHEDULER_QUEUE_H
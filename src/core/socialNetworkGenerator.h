@@ -0,0 +1,283 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+/*! \file socialNetworkGenerator.h
+	\brief This file contains the random graphs used to create the social networks
+	of a Society.
+*/
+
+#ifndef SOCIAL_NETWORK_GENERATOR_H
+#define SOCIAL_NETWORK_GENERATOR_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <unordered_set>
+
+#include "csrNeighborhood.h"
+#include "cellTraversal.h"
+
+/**
+* \brief
+*  Draws the connections of a social network among the agents of a Society and
+*  stores them in a CSRNeighborhood. Agents are identified by their positions in
+*  the Society. Each strategy draws only the connections it creates, therefore the
+*  time to build a graph is proportional to its number of connections, instead of
+*  the number of pairs of agents. All the connections have weight one.
+*/
+class SocialNetworkGenerator
+{
+public:
+	/// Constructor
+	/// \param agents the number of agents of the Society
+	/// \param seed the seed of the random numbers
+	SocialNetworkGenerator(int agents, unsigned int seed)
+		: agents(agents), random(seed, 0), degrees(agents, 0) {}
+
+	/// Connects each agent to each other agent with a given probability. Instead of
+	/// drawing a number for each pair, it draws the distance to the next connection,
+	/// which follows a geometric distribution.
+	void probability(double probability)
+	{
+		int others = agents - 1;
+		double logq = std::log(1.0 - probability);
+
+		for(int origin = 0; origin < agents; origin++)
+		{
+			double candidate = -1;
+
+			while(true)
+			{
+				if(probability >= 1)
+					candidate += 1;
+				else
+					candidate += 1 + std::floor(std::log(1.0 - random.number()) / logq);
+
+				if(candidate >= others) break;
+
+				int neighbor = (int)candidate;
+				add(origin, neighbor < origin ? neighbor : neighbor + 1);
+			}
+		}
+	}
+
+	/// Connects each agent to a given number of other agents, chosen without
+	/// repetition using Floyd's algorithm.
+	void quantity(int quantity)
+	{
+		int others = agents - 1;
+		std::unordered_set<int> chosen;
+
+		for(int origin = 0; origin < agents; origin++)
+		{
+			chosen.clear();
+
+			for(int j = std::max(others - quantity, 0); j < others; j++)
+			{
+				int neighbor = (int)random.integer(0, j);
+				if(chosen.count(neighbor)) neighbor = j;
+
+				chosen.insert(neighbor);
+				add(origin, neighbor < origin ? neighbor : neighbor + 1);
+			}
+		}
+	}
+
+	/// Creates a given number of undirected connections, chosen uniformly among all the
+	/// pairs of agents, as proposed by Erdos and Renyi. The pairs are drawn by their
+	/// positions in the list of all the pairs, using Floyd's algorithm.
+	void erdos(long long quantity)
+	{
+		long long pairs = (long long)agents * (agents - 1) / 2;
+		std::unordered_set<long long> chosen;
+		chosen.reserve(quantity);
+
+		for(long long j = pairs - quantity; j < pairs; j++)
+		{
+			long long pair = random.integer(0, j);
+			if(chosen.count(pair)) pair = j;
+
+			chosen.insert(pair);
+
+			int first, second;
+			getPair(pair, first, second);
+			add(first, second);
+			add(second, first);
+		}
+	}
+
+	/// Creates a scale-free network by preferential attachment, as proposed by Barabasi
+	/// and Albert. The first agents start without connections and each of the other
+	/// agents connects to a given number of the previous ones, chosen with probability
+	/// proportional to their number of connections plus one. Each agent is stored in a
+	/// list once for each connection, plus one, so each choice is a single draw.
+	void barabasi(int start, int quantity)
+	{
+		std::vector<int> pool;
+		std::vector<int> chosen;
+
+		pool.reserve(start + (size_t)(agents - start) * (2 * quantity + 1));
+
+		for(int i = 0; i < start; i++)
+			pool.push_back(i);
+
+		for(int agent = start; agent < agents; agent++)
+		{
+			chosen.clear();
+
+			while((int)chosen.size() < quantity)
+			{
+				int candidate = pool[random.integer(0, pool.size() - 1)];
+
+				if(std::find(chosen.begin(), chosen.end(), candidate) == chosen.end())
+				{
+					add(candidate, agent);
+					add(agent, candidate);
+					pool.push_back(candidate);
+					chosen.push_back(candidate);
+				}
+			}
+
+			pool.insert(pool.end(), quantity + 1, agent);
+		}
+	}
+
+	/// Creates a small-world network, as proposed by Watts and Strogatz. Each agent
+	/// connects to the given number of next agents in the Society, as in a ring, and
+	/// each of these connections is rewired to a random agent with a given probability.
+	/// Connections are undirected, therefore an agent might get more connections than
+	/// the given number.
+	void watts(int quantity, double probability)
+	{
+		std::unordered_set<long long> existing;
+		existing.reserve((size_t)agents * quantity * 2);
+
+		for(int origin = 0; origin < agents; origin++)
+		{
+			for(int distance = 1; distance <= quantity && degrees[origin] < agents - 1; distance++)
+			{
+				int neighbor = random.number() < probability ? origin : (origin + distance) % agents;
+
+				while(neighbor == origin || existing.count(key(origin, neighbor)))
+					neighbor = (int)random.integer(0, agents - 1);
+
+				if(!existing.count(key(neighbor, origin)))
+				{
+					add(neighbor, origin);
+					existing.insert(key(neighbor, origin));
+				}
+
+				add(origin, neighbor);
+				existing.insert(key(origin, neighbor));
+			}
+		}
+	}
+
+	/// Stores the connections in a graph and builds it.
+	/// \param graph an empty graph
+	/// \param symmetric whether an agent must be connected to all the agents connected to it
+	void build(CSRNeighborhood& graph, bool symmetric)
+	{
+		if(symmetric)
+		{
+			// rows sorted by neighbor, to look for the reverse of each connection
+			std::vector<int> offsets(agents + 1, 0);
+			std::vector<int> rows(origins.size());
+
+			for(unsigned int i = 0; i < origins.size(); i++)
+				offsets[origins[i] + 1]++;
+
+			for(int i = 0; i < agents; i++)
+				offsets[i + 1] += offsets[i];
+
+			std::vector<int> position(offsets.begin(), offsets.end() - 1);
+
+			for(unsigned int i = 0; i < origins.size(); i++)
+				rows[position[origins[i]]++] = neighbors[i];
+
+			for(int i = 0; i < agents; i++)
+				std::sort(rows.begin() + offsets[i], rows.begin() + offsets[i + 1]);
+
+			size_t size = origins.size();
+
+			for(unsigned int i = 0; i < size; i++)
+			{
+				int origin = neighbors[i];
+
+				if(!std::binary_search(rows.begin() + offsets[origin], rows.begin() + offsets[origin + 1], origins[i]))
+					add(origin, origins[i]);
+			}
+		}
+
+		graph.reserve(origins.size());
+
+		for(unsigned int i = 0; i < origins.size(); i++)
+			graph.add(origins[i], neighbors[i], 1);
+
+		graph.build(agents);
+	}
+
+	/// Returns the number of connections created.
+	size_t size() const { return origins.size(); }
+
+private:
+	int agents; ///< number of agents
+	CellRandom random; ///< stream of random numbers
+	std::vector<int> origins; ///< agents that own the connections
+	std::vector<int> neighbors; ///< agents connected to the origins
+	std::vector<int> degrees; ///< number of connections of each agent
+
+	void add(int origin, int neighbor)
+	{
+		origins.push_back(origin);
+		neighbors.push_back(neighbor);
+		degrees[origin]++;
+	}
+
+	long long key(int origin, int neighbor) const
+	{
+		return (long long)origin * agents + neighbor;
+	}
+
+	/// Returns the pair of agents stored in a given position of the list of pairs
+	/// (0, 1), (0, 2), ..., (0, n - 1), (1, 2), ..., (n - 2, n - 1).
+	void getPair(long long pair, int& first, int& second) const
+	{
+		double n = agents;
+		long long row = (long long)((2 * n - 1 - std::sqrt((2 * n - 1) * (2 * n - 1) - 8.0 * pair)) / 2);
+
+		if(row < 0) row = 0;
+		while(row > 0 && rowStart(row) > pair) row--;
+		while(row < agents - 2 && rowStart(row + 1) <= pair) row++;
+
+		first = (int)row;
+		second = (int)(pair - rowStart(row) + row + 1);
+	}
+
+	long long rowStart(long long row) const
+	{
+		return row * (2LL * agents - row - 1) / 2;
+	}
+};
+
+#endif // SOCIAL_NETWORK_GENERATOR_H
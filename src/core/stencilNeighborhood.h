@@ -0,0 +1,112 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+/*! \file stencilNeighborhood.h
+	\brief This file contains the neighborhoods of regular CellularSpaces that are defined
+	by the relative positions of the neighbors, such as Moore and von Neumann.
+*/
+
+#ifndef STENCIL_NEIGHBORHOOD_H
+#define STENCIL_NEIGHBORHOOD_H
+
+#include <vector>
+#include <algorithm>
+
+#include "cellGrid.h"
+
+/**
+* \brief
+*  Neighborhood shared by all the cells of a regular CellularSpace. Instead of storing the
+*  neighbors of each cell, it stores a list of offsets (dx, dy) and computes the neighbors
+*  of a cell when they are needed. The weight of each connection is either one or one
+*  divided by the number of neighbors found within the CellularSpace.
+*/
+class StencilNeighborhood
+{
+public:
+	/// Constructor
+	/// \param dx the offsets along the x axis
+	/// \param dy the offsets along the y axis, with the same size of dx
+	/// \param uniform whether the weights are one divided by the number of neighbors (true) or one (false)
+	/// \param wrap whether the borders of the CellularSpace are connected to the opposite borders
+	StencilNeighborhood(const std::vector<int>& dx, const std::vector<int>& dy, bool uniform, bool wrap)
+		: dx(dx), dy(dy), uniform(uniform), wrap(wrap) {}
+
+	/// Finds the neighbors of the cell located at (x, y), following the order of the offsets.
+	/// When wrap is used in small CellularSpaces, offsets that reach the same cell are counted
+	/// to compute uniform weights, but the cell is stored only once.
+	/// \param grid the cells of the CellularSpace
+	/// \param result the ordinals of the neighbor cells
+	/// \return the weight of the connections
+	double neighbors(const CellGrid& grid, int x, int y, std::vector<int>& result) const
+	{
+		result.clear();
+
+		int found = 0;
+		for(unsigned int i = 0; i < dx.size(); i++)
+		{
+			int nx = x + dx[i];
+			int ny = y + dy[i];
+
+			if(wrap)
+			{
+				nx = modulo(nx - grid.getXMin(), grid.getXDim()) + grid.getXMin();
+				ny = modulo(ny - grid.getYMin(), grid.getYDim()) + grid.getYMin();
+			}
+
+			int ordinal = grid.find(nx, ny);
+			if(ordinal < 0) continue;
+
+			found++;
+
+			if(wrap && std::find(result.begin(), result.end(), ordinal) != result.end())
+				continue;
+
+			result.push_back(ordinal);
+		}
+
+		if(!uniform) return 1;
+
+		return found > 0 ? 1.0 / found : 0;
+	}
+
+	/// Returns the number of offsets
+	int size() const { return dx.size(); }
+
+	/// Returns whether the borders are connected to the opposite borders
+	bool isWrap() const { return wrap; }
+
+private:
+	static int modulo(int value, int dim)
+	{
+		int result = value % dim;
+		return result < 0 ? result + dim : result;
+	}
+
+	std::vector<int> dx;
+	std::vector<int> dy;
+	bool uniform;
+	bool wrap;
+};
+
+#endif // STENCIL_NEIGHBORHOOD_H
@@ -23,6 +23,7 @@ of this software and its documentation.
 
 #include <QApplication>
 #include "../observer/observerImpl.h"
+#include "../observer/types/observerLogFile.h"
 // #include <QSystemLocale>
 #include <QFontDatabase>
 #include <QMessageBox>
@@ -158,6 +159,7 @@ void registerClasses()
 	Luna<luaTrajectory>::getInstance()->setup(L);
 	Luna<luaVisualArrangement>::getInstance()->setup(L);
 	Luna<luaMap>::getInstance()->setup(L);
+	Luna<luaImage>::getInstance()->setup(L);
 	Luna<luaChart>::getInstance()->setup(L);
 	Luna<luaSociety>::getInstance()->setup(L);
 	Luna<luaTextScreen>::getInstance()->setup(L);
@@ -223,12 +225,390 @@ int cpp_imagecompare(lua_State *L)
 	QString f1(QString::fromLocal8Bit(s1));
 	QString f2(QString::fromLocal8Bit(s2));
 
-	double result = comparePerPixel(f1, f2);
+	ImageDifference diff;
+	double result = comparePerPixel(f1, f2, diff);
 
+	// the fraction of pixels that differ, followed by the number of pixels,
+	// the largest difference in a channel, and the area with the differences
 	lua_pushnumber(L, result);
+	lua_pushnumber(L, diff.pixels);
+	lua_pushnumber(L, diff.maxDelta);
+
+	if (diff.bounds.isNull())
+		return 3;
+
+	lua_pushnumber(L, diff.bounds.left());
+	lua_pushnumber(L, diff.bounds.top());
+	lua_pushnumber(L, diff.bounds.right());
+	lua_pushnumber(L, diff.bounds.bottom());
+	return 7;
+}
+
+/// Reads the rows of a CSV file, returning a table with the values of each column,
+/// the names of the columns, the lines with a wrong number of values, the position
+/// of the next row (nil at the end of the file), and the number of the last line read.
+/// In case of error, it returns nil and the error message.
+/// parameters: file name, separator, position, number of the line before the position,
+/// maximum number of rows (zero to read all of them)
+int cpp_readcsv(lua_State *L)
+{
+	std::string fileName = luaL_checkstring(L, 1);
+	std::string separator = luaL_optstring(L, 2, ",");
+	size_t offset = (size_t) luaL_optnumber(L, 3, 0);
+	int line = (int) luaL_optnumber(L, 4, 1);
+	size_t maxRows = (size_t) luaL_optnumber(L, 5, 0);
+
+	CsvReader reader(separator);
+	std::string error = reader.open(fileName);
+
+	if (error.empty())
+	{
+		if (offset > 0)
+			reader.seek(offset, line);
+
+		error = reader.read(maxRows);
+	}
+
+	if (!error.empty())
+	{
+		lua_pushnil(L);
+		lua_pushstring(L, error.c_str());
+		return 2;
+	}
+
+	const std::vector<std::string> &header = reader.getHeader();
+	const std::vector<CsvColumn> &columns = reader.getColumns();
+	int rows = (int) reader.getRows();
+
+	lua_createtable(L, 0, (int) header.size());
+	for (size_t i = 0; i < columns.size(); i++)
+	{
+		const CsvColumn &column = columns[i];
+		size_t text = 0;
+		size_t integer = 0;
+
+		lua_createtable(L, rows, 0);
+		for (int j = 0; j < rows; j++)
+		{
+			switch (column.kinds[j])
+			{
+				case CsvColumn::Integer:
+					lua_pushinteger(L, (lua_Integer) column.integers[integer]);
+					integer++;
+					break;
+				case CsvColumn::Float:
+					lua_pushnumber(L, column.numbers[j]);
+					break;
+				default:
+					lua_pushlstring(L, column.texts[text].data(), column.texts[text].size());
+					text++;
+			}
+			lua_rawseti(L, -2, j + 1);
+		}
+		lua_setfield(L, -2, header[i].c_str());
+	}
+
+	lua_createtable(L, (int) header.size(), 0);
+	for (size_t i = 0; i < header.size(); i++)
+	{
+		lua_pushstring(L, header[i].c_str());
+		lua_rawseti(L, -2, (int) i + 1);
+	}
+
+	const std::vector<CsvWarning> &warnings = reader.getWarnings();
+
+	lua_createtable(L, (int) warnings.size(), 0);
+	for (size_t i = 0; i < warnings.size(); i++)
+	{
+		lua_createtable(L, 0, 3);
+		lua_pushnumber(L, warnings[i].line);
+		lua_setfield(L, -2, "line");
+		lua_pushlstring(L, warnings[i].text.data(), warnings[i].text.size());
+		lua_setfield(L, -2, "text");
+		lua_pushnumber(L, warnings[i].values);
+		lua_setfield(L, -2, "values");
+		lua_rawseti(L, -2, (int) i + 1);
+	}
+
+	if (reader.atEnd())
+		lua_pushnil(L);
+	else
+		lua_pushnumber(L, (lua_Number) reader.getOffset());
+
+	lua_pushnumber(L, reader.getLine());
+	return 5;
+}
+
+/// Executes the function given as third argument of cpp_forkruns in a child process.
+static bool runForked(int run, std::string& result, void* data)
+{
+	lua_State *L = (lua_State*) data;
+
+	lua_pushvalue(L, 3);
+	lua_pushinteger(L, run);
+	bool ok = lua_pcall(L, 1, 1, 0) == LUA_OK;
+
+	size_t size = 0;
+	const char* text = lua_tolstring(L, -1, &size);
+	if (text)
+		result.assign(text, size);
+
+	lua_pop(L, 1);
+	return ok;
+}
+
+static std::string forkRuns(lua_State *L, int runs, int workers)
+{
+	ProcessPool pool;
+	int next = 1;
+
+	while (next <= runs || pool.running() > 0)
+	{
+		while (next <= runs && pool.running() < workers)
+		{
+			if (!pool.start(next, runForked, L))
+				return "Could not create a process to execute run " + std::to_string(next) + ".";
+
+			next++;
+		}
+
+		int run;
+		bool ok;
+		std::string result;
+
+		if (!pool.wait(run, ok, result))
+			return "Could not wait for the processes to finish.";
+
+		lua_pushvalue(L, 4);
+		lua_pushinteger(L, run);
+		lua_pushboolean(L, ok);
+		lua_pushlstring(L, result.data(), result.size());
+
+		if (lua_pcall(L, 3, 0, 0) != LUA_OK)
+		{
+			const char* message = lua_tostring(L, -1);
+			std::string error = message ? message : std::string("(error object is a ") + luaL_typename(L, -1) + " value)";
+			lua_pop(L, 1);
+			return error;
+		}
+	}
+
+	return "";
+}
+
+/// Executes a function for each run in child processes created with fork(), which share
+/// the packages already loaded. Each call returns a string that is given to the second
+/// function, executed in the current process as soon as the run finishes. In systems
+/// without fork(), the runs are executed in the current process. Only the thread that
+/// calls fork() exists in the children, therefore no other thread (such as the ones of
+/// the observers) should be running when this function is called.
+/// parameters: number of runs, number of simultaneous processes (zero to use one per
+/// processor), function(run) executed by the child, function(run, ok, result)
+int cpp_forkruns(lua_State *L)
+{
+	int runs = (int) luaL_checkinteger(L, 1);
+	int workers = (int) luaL_checkinteger(L, 2);
+	luaL_checktype(L, 3, LUA_TFUNCTION);
+	luaL_checktype(L, 4, LUA_TFUNCTION);
+	lua_settop(L, 4);
+
+	if (workers < 1)
+		workers = ProcessPool::processors();
+
+	{
+		std::string error = forkRuns(L, runs, workers);
+		if (error.empty())
+			return 0;
+
+		lua_pushlstring(L, error.data(), error.size());
+	}
+
+	return lua_error(L);
+}
+
+/// Writes the value at a given position of the stack to a checkpoint file. Tables
+/// already written are stored in the table at position refs, with their numbers.
+static std::string writeCheckpointValue(lua_State *L, int idx, CheckpointWriter &writer, int refs)
+{
+	switch (lua_type(L, idx))
+	{
+		case LUA_TNIL:
+			writer.writeNil();
+			return "";
+		case LUA_TBOOLEAN:
+			writer.writeBoolean(lua_toboolean(L, idx) != 0);
+			return "";
+		case LUA_TNUMBER:
+			if (lua_isinteger(L, idx))
+				writer.writeInteger((long long) lua_tointeger(L, idx));
+			else
+				writer.writeNumber(lua_tonumber(L, idx));
+			return "";
+		case LUA_TSTRING:
+		{
+			size_t size = 0;
+			const char *text = lua_tolstring(L, idx, &size);
+			writer.writeString(text, size);
+			return "";
+		}
+		case LUA_TTABLE:
+			break;
+		default:
+			return std::string("Cannot save a value of type '") + luaL_typename(L, idx) + "' in a checkpoint.";
+	}
+
+	lua_pushvalue(L, idx);
+	lua_rawget(L, refs);
+
+	if (!lua_isnil(L, -1))
+	{
+		writer.writeReference((unsigned int) lua_tointeger(L, -1));
+		lua_pop(L, 1);
+		return "";
+	}
+
+	lua_pop(L, 1);
+
+	if (!lua_checkstack(L, 4))
+		return "The checkpoint has too many nested tables.";
+
+	lua_pushvalue(L, idx);
+	lua_pushinteger(L, writer.beginTable());
+	lua_rawset(L, refs);
+
+	lua_pushnil(L);
+	while (lua_next(L, idx) != 0)
+	{
+		int top = lua_gettop(L);
+		std::string error = writeCheckpointValue(L, top - 1, writer, refs);
+
+		if (error.empty())
+			error = writeCheckpointValue(L, top, writer, refs);
+
+		if (!error.empty())
+		{
+			lua_pop(L, 2);
+			return error;
+		}
+
+		lua_pop(L, 1);
+	}
+
+	writer.endTable();
+	return "";
+}
+
+/// Reads the next value of a checkpoint file and pushes it onto the stack. The tables
+/// are also stored in the table at position refs, indexed by their numbers plus one.
+/// Returns one if a value was pushed, zero if the end of a table was found, and -1 if
+/// the file is corrupted.
+static int readCheckpointValue(lua_State *L, CheckpointReader &reader, int refs)
+{
+	CheckpointValue value;
+
+	if (!reader.read(value) || !lua_checkstack(L, 4))
+		return -1;
+
+	switch (value.type)
+	{
+		case CheckpointValue::TNil:
+			lua_pushnil(L);
+			return 1;
+		case CheckpointValue::TFalse:
+		case CheckpointValue::TTrue:
+			lua_pushboolean(L, value.type == CheckpointValue::TTrue);
+			return 1;
+		case CheckpointValue::TInteger:
+			lua_pushinteger(L, (lua_Integer) value.integer);
+			return 1;
+		case CheckpointValue::TNumber:
+			lua_pushnumber(L, value.number);
+			return 1;
+		case CheckpointValue::TString:
+			lua_pushlstring(L, value.text, value.size);
+			return 1;
+		case CheckpointValue::TReference:
+			lua_rawgeti(L, refs, (lua_Integer) value.table + 1);
+			return 1;
+		case CheckpointValue::TEnd:
+			return 0;
+		case CheckpointValue::TTable:
+			break;
+	}
+
+	lua_newtable(L);
+	lua_pushvalue(L, -1);
+	lua_rawseti(L, refs, (lua_Integer) value.table + 1);
+
+	int table = lua_gettop(L);
+
+	while (true)
+	{
+		int result = readCheckpointValue(L, reader, refs);
+
+		if (result == 0)
+			return 1;
+
+		if (result < 0 || lua_isnil(L, -1) || (lua_type(L, -1) == LUA_TNUMBER && lua_tonumber(L, -1) != lua_tonumber(L, -1)))
+			return -1;
+
+		if (readCheckpointValue(L, reader, refs) != 1)
+			return -1;
+
+		lua_rawset(L, table);
+	}
+}
+
+/// Saves a value with its nested tables to a checkpoint file. Tables referred more
+/// than once are saved only once. Metatables are not saved.
+/// Returns nothing if the file was saved, otherwise the error message
+/// parameters: file name, value
+int cpp_savecheckpoint(lua_State *L)
+{
+	std::string fileName = luaL_checkstring(L, 1);
+	lua_settop(L, 2);
+	lua_newtable(L);
+
+	CheckpointWriter writer;
+	std::string error = writer.open(fileName);
+
+	if (error.empty())
+		error = writeCheckpointValue(L, 2, writer, 3);
+
+	if (error.empty())
+		error = writer.close();
+
+	if (error.empty())
+		return 0;
+
+	lua_pushstring(L, error.c_str());
 	return 1;
 }
 
+/// Loads the value saved in a checkpoint file. Returns the value, or nil and the
+/// error message
+/// parameters: file name
+int cpp_loadcheckpoint(lua_State *L)
+{
+	std::string fileName = luaL_checkstring(L, 1);
+	lua_settop(L, 1);
+	lua_newtable(L);
+
+	CheckpointReader reader;
+	std::string error = reader.open(fileName);
+
+	if (error.empty() && (readCheckpointValue(L, reader, 2) != 1 || !reader.atEnd()))
+		error = "Could not read file '" + fileName + "'. It seems that it is corrupted.";
+
+	if (error.empty())
+		return 1;
+
+	lua_settop(L, 2);
+	lua_pushnil(L);
+	lua_pushstring(L, error.c_str());
+	return 2;
+}
+
 int cpp_listpackages(lua_State* L)
 {
     const char* s1 = lua_tostring(L, -1);
@@ -292,6 +672,14 @@ int cpp_restartobservercounter(lua_State *L)
 	return 0;
 }
 
+/// Writes the buffers of the binary log files and closes them. It must be called
+/// before the program exits, as the files are not closed automatically.
+int cpp_closelogfiles(lua_State *L)
+{
+	ObserverLogFile::closeAll();
+	return 0;
+}
+
 int cpp_putenv(lua_State* L)
 {
 	std::string path = lua_tostring(L, -1);
@@ -423,6 +811,18 @@ int main(int argc, char *argv[])
 	lua_pushcfunction(L, cpp_imagesize);
 	lua_setglobal(L, "cpp_imagesize");
 
+	lua_pushcfunction(L, cpp_readcsv);
+	lua_setglobal(L, "cpp_readcsv");
+
+	lua_pushcfunction(L, cpp_forkruns);
+	lua_setglobal(L, "cpp_forkruns");
+
+	lua_pushcfunction(L, cpp_savecheckpoint);
+	lua_setglobal(L, "cpp_savecheckpoint");
+
+	lua_pushcfunction(L, cpp_loadcheckpoint);
+	lua_setglobal(L, "cpp_loadcheckpoint");
+
 	lua_pushcfunction(L, cpp_loadfont);
 	lua_setglobal(L, "cpp_loadfont");
 
@@ -435,6 +835,9 @@ int main(int argc, char *argv[])
 	lua_pushcfunction(L, cpp_restartobservercounter);
 	lua_setglobal(L, "cpp_restartobservercounter");
 
+	lua_pushcfunction(L, cpp_closelogfiles);
+	lua_setglobal(L, "cpp_closelogfiles");
+
 	lua_pushcfunction(L, cpp_putenv);
 	lua_setglobal(L, "cpp_putenv");
 
@@ -471,6 +874,9 @@ int main(int argc, char *argv[])
 		lua_call(L, 1, 0);
 	}
 
+	// the simulation has finished
+	ObserverLogFile::closeAll();
+
 #ifdef NOCPP_RAIAN
 		if (argv[argument][0] == '-')
 		{
@@ -41,6 +41,9 @@ of this software and its documentation.
 #include "region.h"
 #include "terrameGlobals.h"
 #include "imageCompare.h"
+#include "csvReader.h"
+#include "processPool.h"
+#include "checkpointFile.h"
 
 #include <QtCore/QBuffer>
 #include <QtCore/QByteArray>
@@ -131,6 +134,7 @@ luaCell * findCell(luaCellularSpace*, CellIndex&);
 
 #include "luaVisualArrangement.h"
 #include "luaMap.h"
+#include "luaImage.h"
 #include "luaChart.h"
 #include "luaTextScreen.h"
 #include "luaTable.h"
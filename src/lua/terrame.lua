@@ -1026,6 +1026,7 @@ local function runScript(script)
 	local success, result = _Gtme.myxpcall(function() dofile(tostring(script)) end)
 	if not success then
 		_Gtme.printError(result)
+		cpp_closelogfiles()
 		os.exit(1)
 	end
 end
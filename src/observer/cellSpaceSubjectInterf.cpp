@@ -25,6 +25,8 @@ of this software and its documentation.
 
 #include "types/agentObserverMap.h"
 #include "types/observerUDPSender.h"
+#include "types/observerTCPSender.h"
+#include "types/observerImage.h"
 
 #include "types/observerTextScreen.h"
 #include "types/observerGraphic.h"
@@ -57,10 +59,18 @@ Observer * CellSpaceSubjectInterf::createObserver(TypesOfObservers type)
             obs = new ObserverUDPSender(this);
             break;
 
+        case TObsTCPSender:
+            obs = new ObserverTCPSender(this);
+            break;
+
         case TObsMap:
             obs = new AgentObserverMap(this);
             break;
 
+        case TObsImage:
+            obs = new ObserverImage(this);
+            break;
+
         case TObsTextScreen:
         default:
             obs = new ObserverTextScreen(this);
@@ -105,11 +115,21 @@ bool CellSpaceSubjectInterf::kill(int id)
             delete(ObserverUDPSender *)obs;
             break;
 
+        case TObsTCPSender:
+           ((ObserverTCPSender *)obs)->close();
+            delete(ObserverTCPSender *)obs;
+            break;
+
         case TObsMap:
            ((AgentObserverMap *)obs)->close();
             delete(AgentObserverMap *)obs;
             break;
 
+        case TObsImage:
+           ((ObserverImage *)obs)->close();
+            delete(ObserverImage *)obs;
+            break;
+
         default:
             delete obs;
             break;
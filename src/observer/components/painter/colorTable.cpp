@@ -0,0 +1,149 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+#include "colorTable.h"
+
+#include <algorithm>
+
+#include "../legend/legendAttributes.h"
+
+using namespace TerraMEObserver;
+
+ColorTable::ColorTable(Attributes *attrib)
+    : sorted(true), opaque(true), mode(attrib->getGroupMode()),
+    minValue(attrib->getMinValue()), val2Color(attrib->getVal2Color()), step(0.)
+{
+    QVector<ObsLegend> *legend = attrib->getLegend();
+    ramp = legend->isEmpty();
+
+    for (int i = 0; i < legend->size(); i++)
+    {
+        const ObsLegend &leg = legend->at(i);
+        QRgb color = leg.getColor().rgba();
+
+        froms.append(leg.getFromNumber());
+        tos.append(leg.getToNumber());
+        colors.append(color);
+
+        // the first item of the legend has precedence
+        if (!numberColors.contains(leg.getToNumber()))
+            numberColors.insert(leg.getToNumber(), color);
+
+        if (!textColors.contains(leg.getFrom()))
+            textColors.insert(leg.getFrom(), color);
+
+        if (qAlpha(color) != 255)
+            opaque = false;
+
+        if ((i > 0) && ((froms.at(i) < froms.at(i - 1)) || (froms.at(i) < tos.at(i - 1))))
+            sorted = false;
+    }
+
+    if (sorted && (mode == TObsEqualSteps) && (froms.size() > 1))
+        step = froms.at(1) - froms.at(0);
+}
+
+bool ColorTable::find(double value, QRgb &color) const
+{
+    if (ramp)
+    {
+        double c = (value - minValue) * val2Color;
+
+        if (!((c >= 0) && (c <= 255)))
+            return false;
+
+        color = qRgb((int) c, (int) c, (int) c);
+        return true;
+    }
+
+    if (mode == TObsUniqueValue)
+    {
+        QHash<double, QRgb>::const_iterator it = numberColors.constFind(value);
+
+        if (it == numberColors.constEnd())
+            return false;
+
+        color = it.value();
+        return true;
+    }
+
+    int i = findRange(value);
+
+    if ((i < 0) || !((froms.at(i) <= value) && (value < tos.at(i))))
+        return false;
+
+    color = colors.at(i);
+    return true;
+}
+
+bool ColorTable::find(const QString &value, QRgb &color) const
+{
+    QHash<QString, QRgb>::const_iterator it = textColors.constFind(value);
+
+    if (it == textColors.constEnd())
+        return false;
+
+    color = it.value();
+    return true;
+}
+
+bool ColorTable::isOpaque() const
+{
+    return opaque;
+}
+
+/// Returns the only range that can contain the value, or -1
+int ColorTable::findRange(double value) const
+{
+    int size = froms.size();
+
+    if (!sorted)
+    {
+        for (int i = 0; i < size; i++)
+        {
+            if ((froms.at(i) <= value) && (value < tos.at(i)))
+                return i;
+        }
+        return -1;
+    }
+
+    if (step > 0)
+    {
+        double index = (value - froms.at(0)) / step;
+
+        if (!(index >= 0))
+            return -1;
+
+        int i = (index >= size) ? size - 1 : (int) index;
+
+        // corrects the rounding errors of the bounds of the ranges
+        while ((i > 0) && (value < froms.at(i)))
+            i--;
+        while ((i < size - 1) && (froms.at(i + 1) <= value))
+            i++;
+
+        return i;
+    }
+
+    return (std::upper_bound(froms.constBegin(), froms.constEnd(), value) - froms.constBegin()) - 1;
+}
@@ -0,0 +1,97 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+#ifndef COLOR_TABLE_H
+#define COLOR_TABLE_H
+
+#include <QColor>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+#include "../../observerGlobals.h"
+
+namespace TerraMEObserver {
+
+class Attributes;
+
+/**
+ * \brief Lookup of the colors of the values of an Attributes according to its legend
+ *
+ * Without a legend, numeric values are mapped to a gray ramp. With a legend, unique
+ * values are found in a hash, and ranges are found by a direct index for equal steps
+ * or by a binary search otherwise, falling back to a linear scan only when the ranges
+ * of the legend overlap. The result is the same as scanning the legend for the first
+ * matching item.
+ * \see Attributes, \see ObsLegend
+ * \file colorTable.h
+ */
+class ColorTable
+{
+public:
+    /**
+     * Constructor
+     * \param attrib a pointer to the Attributes, whose legend is copied
+     */
+    ColorTable(Attributes *attrib);
+
+    /**
+     * Finds the color of a numeric value
+     * \param value the value
+     * \param color the resulting color
+     * \return whether some color is associated to the value
+     */
+    bool find(double value, QRgb &color) const;
+
+    /**
+     * Finds the color of a text value
+     * \param value the value
+     * \param color the resulting color
+     * \return whether some item of the legend has the value
+     */
+    bool find(const QString &value, QRgb &color) const;
+
+    /**
+     * Returns whether all the colors are opaque
+     */
+    bool isOpaque() const;
+
+private:
+    int findRange(double value) const;
+
+    bool ramp;      ///< whether numeric values are mapped to a gray ramp
+    bool sorted;    ///< whether the ranges are sorted and do not overlap
+    bool opaque;
+    GroupingMode mode;
+    double minValue, val2Color;
+    double step;    ///< size of the ranges when they have equal steps, or zero
+
+    QVector<double> froms, tos;
+    QVector<QRgb> colors;
+    QHash<double, QRgb> numberColors;
+    QHash<QString, QRgb> textColors;
+};
+
+} // namespace TerraMEObserver
+
+#endif // COLOR_TABLE_H
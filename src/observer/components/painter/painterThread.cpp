@@ -30,6 +30,10 @@ of this software and its documentation.
 #include "terrameGlobals.h"
 
 #include "../legend/legendAttributes.h"
+#include "colorTable.h"
+
+#include <QRunnable>
+#include <algorithm>
 
 ///< Gobal variabel: Lua stack used for comunication with C++ modules.
 extern lua_State * L;
@@ -37,6 +41,9 @@ extern ExecutionModes execModes;
 
 using namespace TerraMEObserver;
 
+/// Number of cells below which the image is painted by a single thread
+static const int MIN_PARALLEL_CELLS = 10000;
+
 PainterThread::PainterThread(QObject *parent)
     : QThread(parent)
 {
@@ -108,6 +115,12 @@ void PainterThread::drawAttrib(QPainter *p, Attributes *attrib)
     if (attrib->getType() == TObsAgent)
         return;
 
+    if ((attrib->getType() != TObsNeighborhood) && rasterize(attrib))
+        return;
+
+    ColorTable table(attrib);
+    QRgb rgb;
+
     //---- Desenha o atributo
     p->begin(attrib->getImage());
 
@@ -116,7 +129,6 @@ void PainterThread::drawAttrib(QPainter *p, Attributes *attrib)
 	//@RAIAN: Desenhando a vizinhanca
 	if (attrib->getType() == TObsNeighborhood)
 	{
-		QColor color(Qt::white);
                 QVector<QMap<QString, QList<double> > > *neighborhoods = attrib->getNeighValues();
 		QVector<ObsLegend> *vecLegend = attrib->getLegend();
 
@@ -147,44 +159,11 @@ void PainterThread::drawAttrib(QPainter *p, Attributes *attrib)
 					double yNeigh = neighbor.at(1);
 					double weight = neighbor.at(2);
 
-					if (vecLegend->isEmpty())
-					{
-						weight = weight - attrib->getMinValue();
-						double c = weight * attrib->getVal2Color();
-						if (c >= 0 && c <= 255)
-						{
-							color.setRgb(c, c, c);
-						}
-						else
-						{
-							color.setRgb(255, 255, 255);
-						}
-
-						pen.setColor(color);
-					}
-					else
-					{
-						for (int j = 0; j < vecLegend->size(); j++)
-						{
-							ObsLegend leg = vecLegend->at(j);
-							if (attrib->getGroupMode() == 3)
-							{
-								if (weight == leg.getTo().toDouble())
-								{
-									pen.setColor(leg.getColor());
-									break;
-								}
-							}
-							else
-							{
-								if ((leg.getFrom().toDouble() <= weight) && (weight < leg.getTo().toDouble()))
-								{
-									pen.setColor(leg.getColor());
-									break;
-								}
-							}
-						}
-					}
+					if (table.find(weight, rgb))
+						pen.setColor(QColor::fromRgba(rgb));
+					else if (vecLegend->isEmpty())
+						pen.setColor(Qt::white);
+
 					p->setPen(pen);
 
 					if ((xNeigh >= 0) && (yNeigh >= 0))
@@ -202,9 +181,7 @@ void PainterThread::drawAttrib(QPainter *p, Attributes *attrib)
 	{
 		if (attrib->getDataType() == TObsNumber)
 		{
-			QColor color(Qt::white);
 			QVector<double> *values = attrib->getNumericValues();
-			QVector<ObsLegend> *vecLegend = attrib->getLegend();
 
 			double x = -1.0, y = -1.0, v = 0.0;
 
@@ -223,46 +200,11 @@ void PainterThread::drawAttrib(QPainter *p, Attributes *attrib)
 				x = attrib->getXsValue()->at(pos);
 				y = attrib->getYsValue()->at(pos);
 
-				if (vecLegend->isEmpty())
-				{
-					v = v - attrib->getMinValue();
-
-					double c = v * attrib->getVal2Color();
-					if ((c >= 0) && (c <= 255))
-					{
-						color.setRgb(c, c, c);
-					}
-					else
-					{
-						color.setRgb(255, 255, 255);
-					}
-					p->setBrush(color);
-				}
+				if (table.find(v, rgb))
+					p->setBrush(QColor::fromRgba(rgb));
 				else
-				{
-					for (int j = 0; j < vecLegend->size(); j++)
-					{
-						p->setBrush(Qt::white);
-
-						const ObsLegend &leg = vecLegend->at(j);
-						if (attrib->getGroupMode() == TObsUniqueValue) // valor ?nico 3
-						{
-							if (v == leg.getToNumber())
-							{
-								p->setBrush(leg.getColor());
-								break;
-							}
-						}
-						else
-						{
-							if ((leg.getFromNumber() <= v) && (v < leg.getToNumber()))
-							{
-								p->setBrush(leg.getColor());
-								break;
-							}
-						}
-					}
-				}
+					p->setBrush(Qt::white);
+
 				if ((x >= 0) && (y >= 0))
 					draw(p, attrib->getType(), x, y);
 			}
@@ -291,22 +233,11 @@ void PainterThread::drawAttrib(QPainter *p, Attributes *attrib)
 				y = attrib->getYsValue()->at(pos);
 
 				if (vecLegend->isEmpty())
-				{
 					p->setBrush(QColor(random, random, random));
-				}
+				else if (table.find(v, rgb))
+					p->setBrush(QColor::fromRgba(rgb));
 				else
-				{
 					p->setBrush(Qt::white);
-					for (int j = 0; j < vecLegend->size(); j++)
-					{
-						const ObsLegend &leg = vecLegend->at(j);
-						if (v == leg.getFrom())
-						{
-							p->setBrush(leg.getColor());
-							break;
-						}
-					}
-				}
 
 				if ((x >= 0) && (y >= 0))
 					draw(p, attrib->getType(), x, y);
@@ -316,6 +247,172 @@ void PainterThread::drawAttrib(QPainter *p, Attributes *attrib)
     p->end();
 }
 
+/// Paints the cells whose rows intersect a band of an image
+class RasterBand : public QRunnable
+{
+public:
+    RasterBand(const ColorTable &table, Attributes *attrib, QRgb textColor,
+               uchar *bits, int top, int bottom, const int *cells, int count)
+        : table(table), textColor(textColor), bits(bits), top(top), bottom(bottom),
+          cells(cells), count(count)
+    {
+        QImage *image = attrib->getImage();
+        bytesPerLine = image->bytesPerLine();
+        width = image->width();
+
+        xs = attrib->getXsValue()->constData();
+        ys = attrib->getYsValue()->constData();
+
+        numbers = 0;
+        texts = 0;
+        if (attrib->getDataType() == TObsNumber)
+            numbers = attrib->getNumericValues()->constData();
+        else
+            texts = attrib->getTextValues()->constData();
+    }
+
+    void run()
+    {
+        for (int c = 0; c < count; c++)
+        {
+            int i = cells[c];
+
+            int y = qRound(SIZE_CELL * ys[i]);
+            int first = qMax(y, top);
+            int last = qMin(y + SIZE_CELL, bottom);
+
+            int x = qRound(SIZE_CELL * xs[i]);
+            int left = qMax(x, 0);
+            int right = qMin(x + SIZE_CELL, width);
+
+            if ((first >= last) || (left >= right))
+                continue;
+
+            QRgb color = textColor;
+            if (numbers)
+            {
+                if (!table.find(numbers[i], color))
+                    color = qRgb(255, 255, 255);
+            }
+            else
+            {
+                table.find(texts[i], color);
+            }
+
+            for (int row = first; row < last; row++)
+            {
+                QRgb *line = (QRgb *) (bits + row * bytesPerLine);
+                std::fill(line + left, line + right, color);
+            }
+        }
+    }
+
+private:
+    const ColorTable &table;
+    QRgb textColor;
+    uchar *bits;
+    int top, bottom, bytesPerLine, width;
+
+    const double *xs, *ys, *numbers;
+    const QString *texts;
+    const int *cells;
+    int count;
+};
+
+bool PainterThread::rasterize(Attributes *attrib)
+{
+    QImage *image = attrib->getImage();
+    bool numeric = attrib->getDataType() == TObsNumber;
+
+    if ((!numeric && (attrib->getDataType() != TObsText)) || image->isNull()
+        || (image->format() != QImage::Format_ARGB32_Premultiplied))
+        return false;
+
+    ColorTable table(attrib);
+
+    // translucent colors are blended by the QPainter
+    if (!table.isOpaque())
+        return false;
+
+    QRgb textColor = qRgb(255, 255, 255);
+    if (!numeric && attrib->getLegend()->isEmpty())
+    {
+        int random = qrand() % 256;
+        textColor = qRgb(random, random, random);
+    }
+
+    int cells = numeric ? attrib->getNumericValues()->size() : attrib->getTextValues()->size();
+    int bands = (cells < MIN_PARALLEL_CELLS) ? 1 : rasterPool.maxThreadCount();
+
+    // the bands have whole rows of cells, so that each cell is painted by a single thread
+    int height = image->height();
+    int cellRows = (height + SIZE_CELL - 1) / SIZE_CELL;
+    int bandHeight = qMax(1, (cellRows + bands - 1) / bands) * SIZE_CELL;
+    bands = (height + bandHeight - 1) / bandHeight;
+
+    const double *xs = attrib->getXsValue()->constData();
+    const double *ys = attrib->getYsValue()->constData();
+    int size = qMin(qMin(attrib->getXsValue()->size(), attrib->getYsValue()->size()), cells);
+
+    // distributes the cells among the bands their rows intersect, counting them first
+    // and then storing the indexes of the cells of each band contiguously
+    QVector<int> starts(bands + 1, 0);
+    for (int step = 0; step < 2; step++)
+    {
+        QVector<int> next = starts;
+
+        for (int i = 0; i < size; i++)
+        {
+            if (!((xs[i] >= 0) && (ys[i] >= 0)))
+                continue;
+
+            int y = qRound(SIZE_CELL * ys[i]);
+            if (y >= height)
+                continue;
+
+            int last = qMin((y + SIZE_CELL - 1) / bandHeight, bands - 1);
+            for (int band = y / bandHeight; band <= last; band++)
+            {
+                if (step == 0)
+                    starts[band + 1]++;
+                else
+                    indexes[next[band]++] = i;
+            }
+        }
+
+        if (step == 0)
+        {
+            for (int band = 0; band < bands; band++)
+                starts[band + 1] += starts[band];
+
+            indexes.resize(starts[bands]);
+        }
+    }
+
+    // detaches the image before sharing it among the threads
+    uchar *bits = image->bits();
+
+    for (int band = 0; band < bands; band++)
+    {
+        int top = band * bandHeight;
+        RasterBand *raster = new RasterBand(table, attrib, textColor, bits, top,
+                                            qMin(top + bandHeight, height),
+                                            indexes.constData() + starts[band],
+                                            starts[band + 1] - starts[band]);
+        if (bands == 1)
+        {
+            raster->run();
+            delete raster;
+        }
+        else
+        {
+            rasterPool.start(raster);
+        }
+    }
+
+    rasterPool.waitForDone();
+    return true;
+}
 
 //void PainterThread::setVectorPos(QVector<double> *xs, QVector<double> *ys)
 //{
@@ -29,6 +29,8 @@ of this software and its documentation.
 #include <QtCore/QWaitCondition>
 #include <QtGui/QImage>
 #include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+#include <QtCore/QVector>
 #include <QtGui/QPainter>
 
 #include "../../observer.h"
@@ -109,6 +111,14 @@ private:
      */
     void draw(QPainter *p, TypesOfSubjects subjType , double &x, double &y);
 
+    /**
+     * Writes the colors of the cells of an Attributes directly in its image,
+     * splitting the image in bands of rows painted in parallel
+     * \param attrib a pointer to an attribute
+     * \return false if the attribute must be drawn with a QPainter
+     */
+    bool rasterize(Attributes *attrib);
+
 	//@RAIAN: Desenha a vizinhanca
 		/// Draws a Neighborhood object
 		/// \author Raian Vargas Maretto
@@ -121,6 +131,8 @@ private:
     bool restart, abort, reconfigMaxMin;
 
     QPainter *p;
+    QThreadPool rasterPool;
+    QVector<int> indexes; ///< cells of each band of rasterize(), kept between the images
     // QPen defaultPen;
 };
 
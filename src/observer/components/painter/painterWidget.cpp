@@ -139,6 +139,16 @@ void PainterWidget::plotMap(Attributes *attrib)
     calculateResult();
 }
 
+void PainterWidget::plotMap(const QList<Attributes *> &attribs)
+{
+    QPainter p;
+
+    for (int i = 0; i < attribs.size(); i++)
+        painterThread.drawAttrib(&p, attribs.at(i));
+
+    calculateResult();
+}
+
 void PainterWidget::replotMap()
 {
     QPainter p;
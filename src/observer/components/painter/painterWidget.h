@@ -75,6 +75,13 @@ public:
      */
     void plotMap(Attributes *attrib);
 
+    /**
+     * Draws a list of attributes and composes the result only once
+     * \param attribs list of pointers to Attributes
+     * \see Attributes
+     */
+    void plotMap(const QList<Attributes *> &attribs);
+
     /**
      * Re-paints all attributes under observation
      */
@@ -121,73 +121,41 @@ void Receiver::blindButtonClicked()
     ui->lblReceiverStatus->setText(QString("Socket state: \"%1\", Port: %2").arg(state).arg(port));
 }
 
-// TENTATIVA 3
 void Receiver::processPendingDatagrams()
 {
-    // int totalDatagrams = 0;
-    bool compressDatagram = false;
-    qint64 dataSize = -1.0, pos = 0;
-    qint64 datagramSize = -1; // , dataRemainder = -1.0;
-
     QHostAddress host;
     quint16 port;
 
-    QByteArray datagram;
-    do
+    QByteArray datagram, data;
+    quint8 flags;
+
+    // every datagram is used, as they can belong to different states
+    while (udpSocket->hasPendingDatagrams())
     {
         datagram.resize(udpSocket->pendingDatagramSize());
         udpSocket->readDatagram(datagram.data(), datagram.size(), &host, &port);
-    } while (udpSocket->hasPendingDatagrams());
-
-
-    QByteArray data, auxData;
-    QDataStream in(&datagram, QIODevice::ReadOnly);
-    // in.setVersion(QDataStream::Qt_4_6);
-
-    // Reserva o espa?o necess?rio para o stream transmitido
-    in >> dataSize;         // tamanho total do stream enviado
-    in >> datagramSize;     // tamanho do datagrama enviado
-
-    in >> pos;  // indice do dado recebido
-    in >> compressDatagram; // flag formato do datagrama transmitido
-    in >> auxData; // dado recebido
+        msgReceiver++;
 
-    // totalDatagrams = dataSize / datagramSize;
+        if (!assembler.add(datagram, data, flags))
+            continue;
 
-    if ((completeData.isEmpty()))
-          completeData = QByteArray('\0', dataSize);
-
-
-    if (compressDatagram)
-    {
-        data = qUncompress(auxData);
-    }
-    else
-    {
-        data = auxData;
-    }
-
-    msgReceiver++;
-    ui->lblMessageStatus->setText("Datagrams received: " + QString::number(msgReceiver));
-
-    if ((pos > -1)) // && (data != COMPLETE_STATE.toLatin1()))
-    {
-        // redimensiona o objeto e insere lixo
-        // msg.insert((int)pos, data);
-        completeData.replace((int)pos, data.size(), data);
+        if (flags & TerraMEObserver::DatagramFrame::EndOfSimulation)
+        {
+            if (obsMap)
+            {
+                obsMap->close();
+                delete obsMap;
+                obsMap = 0;
+            }
 
-        message = tr("Messages received: %1. From: %2, Port: %3")
-            .arg(msgReceiver).arg(host.toString()).arg(port);
+            msgReceiver = 0;
+            statesReceiver = 0;
 
-        ui->logEdit->appendPlainText(
-            QDateTime::currentDateTime().toString("MM/dd/yyyy, hh:mm:ss: ") + message);
-    }
-    else
-    {
-        if (data == COMPLETE_STATE.toLatin1())
+            ui->logEdit->appendPlainText("Simulation fineshed!\n");
+        }
+        else
         {
-            processDatagram(completeData);
-            completeData.clear();
+            processDatagram(data);
             statesReceiver++;
 
             ui->lblStatesStatus->setText("States received: " +  QString::number(statesReceiver));
@@ -198,20 +166,16 @@ void Receiver::processPendingDatagrams()
             ui->logEdit->appendPlainText(
                 QDateTime::currentDateTime().toString("MM/dd/yyyy, hh:mm:ss: ") + message);
         }
-        else
-        {
-            if (data == COMPLETE_SIMULATION.toLatin1())
-            {
-                obsMap->close();
-                delete obsMap;
-                obsMap = 0;
+    }
 
-                msgReceiver = 0;
-                statesReceiver = 0;
+    ui->lblMessageStatus->setText("Datagrams received: " + QString::number(msgReceiver));
 
-                 ui->logEdit->appendPlainText("Simulation fineshed!\n");
-            }
-        }
+    int discarded = assembler.discardExpired();
+    if (discarded > 0)
+    {
+        message = tr("Incomplete states discarded: %1").arg(assembler.getDiscarded());
+        ui->logEdit->appendPlainText(
+            QDateTime::currentDateTime().toString("MM/dd/yyyy, hh:mm:ss: ") + message);
     }
 }
 
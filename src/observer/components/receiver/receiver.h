@@ -27,6 +27,8 @@ of this software and its documentation.
 #include <QDialog>
 #include <QUdpSocket>
 
+#include "../../protocol/decoder/datagramFrame.h"
+
 namespace TerraMEObserver {
 class AgentObserverMap;
 }
@@ -91,7 +93,7 @@ private:
 
 
     int msgReceiver, statesReceiver;
-    QByteArray completeData;
+    TerraMEObserver::DatagramAssembler assembler;
     QString message;
 
     Ui::receiverGUI *ui;
@@ -28,6 +28,7 @@ of this software and its documentation.
 #include "types/observerTextScreen.h"
 #include "types/observerGraphic.h"
 #include "types/observerUDPSender.h"
+#include "types/observerTCPSender.h"
 #include "types/observerStateMachine.h"
 
 //#include "../observer/types/agentObserverMap.h"
@@ -56,6 +57,10 @@ Observer * LocalAgentSubjectInterf::createObserver(TypesOfObservers typeObserver
             obs = new ObserverUDPSender(this);
             break;
 
+        case TObsTCPSender:
+            obs = new ObserverTCPSender(this);
+            break;
+
         case TObsStateMachine:
             obs = new ObserverStateMachine(this);
             break;
@@ -101,6 +106,11 @@ bool LocalAgentSubjectInterf::kill(int id)
             delete(ObserverUDPSender *)obs;
             break;
 
+        case TObsTCPSender:
+           ((ObserverTCPSender *)obs)->close();
+            delete(ObserverTCPSender *)obs;
+            break;
+
         case TObsTextScreen:
            ((ObserverTextScreen *)obs)->close();
             delete(ObserverTextScreen *)obs;
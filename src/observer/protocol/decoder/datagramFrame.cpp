@@ -0,0 +1,197 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+#include "datagramFrame.h"
+
+#include <QtEndian>
+
+using namespace TerraMEObserver;
+
+// Number of ids before the last completed message that are considered old
+static const qint32 MAXIMUM_AGE = 1024;
+
+// Number of incomplete messages assembled at the same time
+static const int MAXIMUM_PARTIALS = 64;
+
+const quint32 DatagramFrame::MAGIC;
+const int DatagramFrame::HEADER_SIZE;
+const int DatagramFrame::MINIMUM_CHUNK_SIZE;
+const int DatagramFrame::MAXIMUM_MESSAGE_SIZE;
+
+QList<QByteArray> DatagramFrame::split(quint32 id, const QByteArray &message,
+                                       int chunkSize, quint8 flags)
+{
+    QList<QByteArray> datagrams;
+    quint32 count = qMax(1, (message.size() + chunkSize - 1) / chunkSize);
+
+    for (quint32 i = 0; i < count; i++)
+    {
+        QByteArray chunk = message.mid(i * chunkSize, chunkSize);
+        QByteArray datagram(HEADER_SIZE, '\0');
+        uchar *header = (uchar *) datagram.data();
+
+        qToBigEndian<quint32>(MAGIC, header);
+        qToBigEndian<quint32>(id, header + 4);
+        qToBigEndian<quint32>(i, header + 8);
+        qToBigEndian<quint32>(count, header + 12);
+        header[16] = flags;
+
+        datagram.append(chunk);
+        datagrams.append(datagram);
+    }
+    return datagrams;
+}
+
+DatagramAssembler::DatagramAssembler(int timeout)
+    : timeout(timeout), discarded(0), completed(false), lastCompleted(0)
+{
+}
+
+bool DatagramAssembler::add(const QByteArray &datagram, QByteArray &message, quint8 &flags)
+{
+    if (datagram.size() < DatagramFrame::HEADER_SIZE)
+        return false;
+
+    const uchar *header = (const uchar *) datagram.constData();
+
+    if (qFromBigEndian<quint32>(header) != DatagramFrame::MAGIC)
+        return false;
+
+    quint32 id = qFromBigEndian<quint32>(header + 4);
+    quint32 index = qFromBigEndian<quint32>(header + 8);
+    quint32 count = qFromBigEndian<quint32>(header + 12);
+
+    if ((index >= count) || isOld(id))
+        return false;
+
+    // every datagram but the last one carries a whole chunk, so the size of
+    // the message is known before allocating space for its chunks
+    quint32 chunkSize = datagram.size() - DatagramFrame::HEADER_SIZE;
+    if (index < count - 1)
+        chunkSize = qMax(chunkSize, (quint32) DatagramFrame::MINIMUM_CHUNK_SIZE);
+    else
+        chunkSize = DatagramFrame::MINIMUM_CHUNK_SIZE;
+
+    if (count > (quint32) DatagramFrame::MAXIMUM_MESSAGE_SIZE / chunkSize)
+        return false;
+
+    if (!partials.contains(id) && (partials.size() >= MAXIMUM_PARTIALS))
+        discardOldest();
+
+    Partial &partial = partials[id];
+
+    if (partial.chunks.isEmpty())
+    {
+        partial.chunks.resize(count);
+        partial.present.resize(count);
+        partial.received = 0;
+        partial.flags = header[16];
+    }
+    else if (partial.chunks.size() != (int) count)
+    {
+        return false;
+    }
+    partial.lastDatagram.start();
+
+    // duplicated datagram
+    if (partial.present.testBit(index))
+        return false;
+
+    partial.chunks[index] = datagram.mid(DatagramFrame::HEADER_SIZE);
+    partial.present.setBit(index);
+    partial.received++;
+
+    if (partial.received < (int) count)
+        return false;
+
+    message.clear();
+    for (int i = 0; i < partial.chunks.size(); i++)
+        message.append(partial.chunks.at(i));
+
+    flags = partial.flags;
+    if (flags & DatagramFrame::Compressed)
+        message = qUncompress(message);
+
+    partials.remove(id);
+
+    // a new simulation can start again from any id
+    completed = !(flags & DatagramFrame::EndOfSimulation);
+    lastCompleted = id;
+
+    // the messages sent before this one will not be used anymore
+    QMutableHashIterator<quint32, Partial> it(partials);
+    while (it.hasNext())
+    {
+        if (isOld(it.next().key()))
+        {
+            it.remove();
+            discarded++;
+        }
+    }
+    return true;
+}
+
+int DatagramAssembler::discardExpired()
+{
+    int count = 0;
+
+    QMutableHashIterator<quint32, Partial> it(partials);
+    while (it.hasNext())
+    {
+        if (it.next().value().lastDatagram.elapsed() > timeout)
+        {
+            it.remove();
+            count++;
+        }
+    }
+
+    discarded += count;
+    return count;
+}
+
+void DatagramAssembler::discardOldest()
+{
+    QHash<quint32, Partial>::iterator oldest = partials.begin();
+
+    for (QHash<quint32, Partial>::iterator it = partials.begin(); it != partials.end(); ++it)
+    {
+        if (it.value().lastDatagram.elapsed() > oldest.value().lastDatagram.elapsed())
+            oldest = it;
+    }
+
+    partials.erase(oldest);
+    discarded++;
+}
+
+int DatagramAssembler::getDiscarded() const
+{
+    return discarded;
+}
+
+bool DatagramAssembler::isOld(quint32 id) const
+{
+    // the difference handles the wrap around of the ids. Ids much older
+    // than the last one come from another sender that has just started
+    qint32 age = (qint32) (lastCompleted - id);
+    return completed && (age >= 0) && (age < MAXIMUM_AGE);
+}
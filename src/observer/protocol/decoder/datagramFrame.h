@@ -0,0 +1,141 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+#ifndef DATAGRAM_FRAME_H
+#define DATAGRAM_FRAME_H
+
+#include <QByteArray>
+#include <QList>
+#include <QHash>
+#include <QVector>
+#include <QBitArray>
+#include <QElapsedTimer>
+
+namespace TerraMEObserver {
+
+/**
+ * \brief Splits a message into UDP datagrams. Each datagram starts with a
+ * header written in big endian: the magic number, the id of the message, the
+ * index of the datagram within the message, the number of datagrams of the
+ * message (quint32 each), and the flags of the message (quint8).
+ * \see DatagramAssembler
+ * \file datagramFrame.h
+ */
+class DatagramFrame
+{
+public:
+    /// Identifies a datagram sent by ObserverUDPSender
+    static const quint32 MAGIC = 0x544D4555;
+
+    /// Size of the header of each datagram
+    static const int HEADER_SIZE = 4 * sizeof(quint32) + sizeof(quint8);
+
+    /// Smallest number of bytes of the message in each datagram
+    static const int MINIMUM_CHUNK_SIZE = 32;
+
+    /// Largest message that can be reassembled
+    static const int MAXIMUM_MESSAGE_SIZE = 256 * 1024 * 1024;
+
+    enum Flags
+    {
+        Compressed = 1,     ///< The message was compressed with qCompress
+        EndOfSimulation = 2 ///< The message indicates the end of the simulation
+    };
+
+    /**
+     * Splits a message into datagrams
+     * \param id the id of the message
+     * \param message the data to be sent
+     * \param chunkSize the maximum number of bytes of the message in each datagram,
+     * at least MINIMUM_CHUNK_SIZE
+     * \param flags the flags of the message
+     */
+    static QList<QByteArray> split(quint32 id, const QByteArray &message,
+                                   int chunkSize, quint8 flags);
+};
+
+/**
+ * \brief Reassembles the messages split by DatagramFrame. Datagrams of
+ * different messages can arrive interleaved and out of order. Messages
+ * that stop receiving datagrams are discarded after a timeout, as well as
+ * messages older than the last one completed. Datagrams announcing messages
+ * larger than DatagramFrame::MAXIMUM_MESSAGE_SIZE are ignored, and only a
+ * limited number of messages are assembled at the same time.
+ * \see DatagramFrame
+ * \file datagramFrame.h
+ */
+class DatagramAssembler
+{
+public:
+    /**
+     * Constructor
+     * \param timeout the time in milliseconds to wait for the next datagram
+     * of an incomplete message
+     */
+    DatagramAssembler(int timeout = 2000);
+
+    /**
+     * Adds a received datagram
+     * \param datagram the datagram
+     * \param message the complete message, already uncompressed
+     * \param flags the flags of the complete message
+     * \return boolean, \a true if the datagram completed a message
+     */
+    bool add(const QByteArray &datagram, QByteArray &message, quint8 &flags);
+
+    /**
+     * Discards the incomplete messages that did not receive any datagram
+     * within the timeout
+     * \return the number of messages discarded
+     */
+    int discardExpired();
+
+    /**
+     * Gets the number of incomplete messages discarded so far
+     */
+    int getDiscarded() const;
+
+private:
+    struct Partial
+    {
+        QVector<QByteArray> chunks;
+        QBitArray present;
+        int received;
+        quint8 flags;
+        QElapsedTimer lastDatagram;
+    };
+
+    bool isOld(quint32 id) const;
+
+    /// Discards the incomplete message that has waited the longest for a datagram
+    void discardOldest();
+
+    QHash<quint32, Partial> partials;
+    int timeout, discarded;
+    bool completed;
+    quint32 lastCompleted;
+};
+
+} // namespace TerraMEObserver
+
+#endif // DATAGRAM_FRAME_H
@@ -159,8 +159,15 @@ bool Decoder::consumeTriple(QStringList &tokens, int &idx,
     if (tokens.size() <= idx + 2)
         return false;
 
-    QString key = tokens.at(idx);
-    TypesOfData type =(TypesOfData) tokens.at(idx + 1).toInt();
+    addTriple(tokens.at(idx), (TypesOfData) tokens.at(idx + 1).toInt(), tokens.at(idx + 2), xs, ys);
+
+    idx += 3;
+    return true;
+}
+
+void Decoder::addTriple(const QString &key, TypesOfData type, const QString &value,
+                        QVector<double> &xs, QVector<double> &ys)
+{
     Attributes *attrib = 0;
 
     if (mapAttributes->contains(key))
@@ -172,7 +179,7 @@ bool Decoder::consumeTriple(QStringList &tokens, int &idx,
                 if (attrib->getDataType() == TObsUnknownData)
                     attrib->setDataType(TObsNumber);
 
-                attrib->addValue(tokens.at(idx + 2).toDouble());
+                attrib->addValue(value.toDouble());
                 break;
 
             case TObsText:
@@ -180,7 +187,7 @@ bool Decoder::consumeTriple(QStringList &tokens, int &idx,
                 if (attrib->getDataType() == TObsUnknownData)
                     attrib->setDataType(TObsText);
 
-                attrib->addValue(tokens.at(idx + 2));
+                attrib->addValue(value);
                 break;
 
             case TObsBool:
@@ -193,7 +200,7 @@ bool Decoder::consumeTriple(QStringList &tokens, int &idx,
     {
         if (key == "x")
         {
-            xs.append(tokens.at(idx + 2).toDouble());
+            xs.append(value.toDouble());
 
             if ((parentSubjectType == TObsTrajectory) && (mapAttributes->contains("trajectory")))
             {
@@ -204,10 +211,143 @@ bool Decoder::consumeTriple(QStringList &tokens, int &idx,
         else
         {
             if (key == "y")
-                ys.append(tokens.at(idx + 2).toDouble());
+                ys.append(value.toDouble());
         }
     }
-    idx += 3;
+}
+
+bool Decoder::decode(const StateFrame &frame, QVector<double> &xs, QVector<double> &ys)
+{
+    parentSubjectType = frame.subjectType;
+
+    if (frame.delta)
+    {
+        bool applied = true;
+
+        // the attributes of the subject are not stored per element
+        for (int i = 0; i < frame.columns.size(); i++)
+            applied = applyColumn(frame.columns.at(i), frame.rows, xs, ys) && applied;
+
+        return applied;
+    }
+
+    for (int i = 0; i < frame.keys.size(); i++)
+        addTriple(frame.keys.at(i), frame.types.at(i), frame.values.at(i), xs, ys);
+
+    for (int i = 0; i < frame.columns.size(); i++)
+        addColumn(frame.columns.at(i), xs, ys);
+
+    return true;
+}
+
+void Decoder::addColumn(const StateFrame::Column &column, QVector<double> &xs, QVector<double> &ys)
+{
+    Attributes *attrib = 0;
+
+    if (mapAttributes->contains(column.key))
+    {
+        attrib = mapAttributes->value(column.key);
+
+        switch (column.type)
+        {
+            case TObsNumber:
+                if (attrib->getDataType() == TObsUnknownData)
+                    attrib->setDataType(TObsNumber);
+
+                // QVector is implicitly shared, therefore the values are not copied
+                if (attrib->getNumericValues()->isEmpty())
+                    *attrib->getNumericValues() = column.numbers;
+                else
+                    *attrib->getNumericValues() += column.numbers;
+                break;
+
+            case TObsText:
+                if (attrib->getDataType() == TObsUnknownData)
+                    attrib->setDataType(TObsText);
+
+                if (attrib->getTextValues()->isEmpty())
+                    *attrib->getTextValues() = column.texts;
+                else
+                    *attrib->getTextValues() += column.texts;
+                break;
+
+            case TObsBool:
+            case TObsDateTime:
+            default:
+                break;
+        }
+    }
+    else
+    {
+        if (column.key == "x")
+        {
+            if ((parentSubjectType == TObsTrajectory) && (mapAttributes->contains("trajectory")))
+            {
+                attrib = mapAttributes->value("trajectory");
+                for (int i = 0; i < column.numbers.size(); i++)
+                {
+                    xs.append(column.numbers.at(i));
+                    attrib->addValue((double) attrib->getXsValue()->size());
+                }
+            }
+            else
+            {
+                xs += column.numbers;
+            }
+        }
+        else
+        {
+            if (column.key == "y")
+                ys += column.numbers;
+        }
+    }
+}
+
+/// Replaces the values of the given positions of a vector
+template <typename T>
+static bool replaceRows(QVector<T> &values, const QVector<int> &rows, const QVector<T> &changes)
+{
+    T *data = values.data();
+    int size = values.size();
+
+    for (int i = 0; i < rows.size(); i++)
+    {
+        if ((rows.at(i) < 0) || (rows.at(i) >= size))
+            return false;
+
+        data[rows.at(i)] = changes.at(i);
+    }
+    return true;
+}
+
+bool Decoder::applyColumn(const StateFrame::Column &column, const QVector<int> &rows,
+                          QVector<double> &xs, QVector<double> &ys)
+{
+    if (mapAttributes->contains(column.key))
+    {
+        Attributes *attrib = mapAttributes->value(column.key);
+
+        switch (column.type)
+        {
+            case TObsNumber:
+                return replaceRows(*attrib->getNumericValues(), rows, column.numbers);
+
+            case TObsText:
+                return replaceRows(*attrib->getTextValues(), rows, column.texts);
+
+            case TObsBool:
+            case TObsDateTime:
+            default:
+                return true;
+        }
+    }
+
+    if (column.key == "x")
+        return replaceRows(xs, rows, column.numbers);
+
+    if (column.key == "y")
+        return replaceRows(ys, rows, column.numbers);
+
     return true;
 }
 
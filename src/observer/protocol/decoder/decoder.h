@@ -30,6 +30,7 @@ of this software and its documentation.
 
 #include "../../components/legend/legendAttributes.h"
 #include "../../observer.h"
+#include "stateFrame.h"
 
 namespace TerraMEObserver {
 
@@ -63,6 +64,18 @@ public:
      */
     bool decode(const QString &protocol, QVector<double> &xs, QVector<double> &ys);
 
+    /**
+     * Decodes the state encoded as a StateFrame. Numeric columns are
+     * shared with the Attributes when they are empty, otherwise appended.
+     * The values of a delta replace in place the values of the changed elements,
+     * which must have been decoded from the previous frames.
+     * \param frame the state of the subject and its elements
+     * \param xs a references to a x axis values
+     * \param ys a references to a y axis values
+     * \see StateFrame
+     */
+    bool decode(const StateFrame &frame, QVector<double> &xs, QVector<double> &ys);
+
 private:
     /**
      * Copy constructor
@@ -140,6 +153,28 @@ private:
     inline bool consumeTriple(QStringList &tokens, int &idx, QVector<double> &xs,
                               QVector<double> &ys);
 
+    /**
+     * Stores the value of an attribute in the Attributes or in the axis values
+     * \param key the name of the attribute
+     * \param type the type of the attribute
+     * \param value the value of the attribute as text
+     */
+    void addTriple(const QString &key, TypesOfData type, const QString &value,
+                   QVector<double> &xs, QVector<double> &ys);
+
+    /**
+     * Stores the values of a column of a StateFrame in the Attributes or in the axis values
+     */
+    void addColumn(const StateFrame::Column &column, QVector<double> &xs, QVector<double> &ys);
+
+    /**
+     * Replaces the values of the changed elements of a delta in the Attributes or in the axis values
+     * \param rows the positions of the changed elements
+     * \return false if some position is not stored in the Attributes
+     */
+    bool applyColumn(const StateFrame::Column &column, const QVector<int> &rows,
+                     QVector<double> &xs, QVector<double> &ys);
+
 	//@RAIAN: Decodifica a vizinhanca
 		/// \author Raian Vargas Maretto
                 inline void consumeNeighborhood(QStringList &tokens, int &idx, QString neighborhoodID, int &numElem, QMap<QString, QList<double> > &neighborhood);
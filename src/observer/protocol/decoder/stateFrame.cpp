@@ -0,0 +1,379 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+#include "stateFrame.h"
+
+#include <QIODevice>
+#include <QtEndian>
+
+#include "../../observer.h"
+
+using namespace TerraMEObserver;
+
+StateFrame::StateFrame() : id(0), subjectType(TObsUnknown), sequence(0), delta(false), base(0),
+    elementType(TObsUnknown) {}
+
+void StateFrame::addAttribute(const QString &key, TypesOfData type, const QString &value)
+{
+    keys.append(key);
+    types.append(type);
+    values.append(value);
+}
+
+StateFrame::Column & StateFrame::addColumn(const QString &key, TypesOfData type)
+{
+    Column column;
+    column.key = key;
+    column.type = type;
+    columns.append(column);
+    return columns.last();
+}
+
+/// Checks whether the stream still has a given number of values of at least a
+/// given size, before allocating space for them. A corrupt or truncated frame
+/// can announce more values than it has
+static bool hasValues(QDataStream &in, qint32 count, qint64 bytes)
+{
+    QIODevice *device = in.device();
+    return !device || (count * bytes <= device->bytesAvailable());
+}
+
+/// Compares two values of a numeric column, where NaN represents a missing value
+static bool sameNumber(double a, double b)
+{
+    return (a == b) || ((a != a) && (b != b));
+}
+
+bool StateFrame::diff(const StateFrame &previous, StateFrame &result, int maxRows) const
+{
+    if (delta || previous.delta || (columns.size() != previous.columns.size())
+        || (elementIds != previous.elementIds))
+        return false;
+
+    for (int i = 0; i < columns.size(); i++)
+    {
+        if ((columns.at(i).key != previous.columns.at(i).key)
+            || (columns.at(i).type != previous.columns.at(i).type))
+            return false;
+    }
+
+    int size = elementIds.size();
+    QVector<bool> changed(size, false);
+
+    for (int i = 0; i < columns.size(); i++)
+    {
+        const Column &column = columns.at(i);
+        const Column &old = previous.columns.at(i);
+
+        if (column.type == TObsText)
+        {
+            for (int j = 0; j < size; j++)
+            {
+                if (column.texts.at(j) != old.texts.at(j))
+                    changed[j] = true;
+            }
+        }
+        else
+        {
+            const double *numbers = column.numbers.constData();
+            const double *oldNumbers = old.numbers.constData();
+
+            for (int j = 0; j < size; j++)
+            {
+                if (!sameNumber(numbers[j], oldNumbers[j]))
+                    changed[j] = true;
+            }
+        }
+    }
+
+    result = StateFrame();
+    for (int j = 0; j < size; j++)
+    {
+        if (changed.at(j))
+        {
+            if (result.rows.size() == maxRows)
+                return false;
+            result.rows.append(j);
+        }
+    }
+
+    result.id = id;
+    result.subjectType = subjectType;
+    result.sequence = sequence;
+    result.delta = true;
+    result.base = previous.sequence;
+    result.keys = keys;
+    result.types = types;
+    result.values = values;
+    result.elementType = elementType;
+
+    for (int i = 0; i < columns.size(); i++)
+    {
+        const Column &column = columns.at(i);
+        Column &changes = result.addColumn(column.key, column.type);
+
+        if (column.type == TObsText)
+        {
+            changes.texts.resize(result.rows.size());
+            for (int j = 0; j < result.rows.size(); j++)
+                changes.texts[j] = column.texts.at(result.rows.at(j));
+        }
+        else
+        {
+            changes.numbers.resize(result.rows.size());
+            for (int j = 0; j < result.rows.size(); j++)
+                changes.numbers[j] = column.numbers.at(result.rows.at(j));
+        }
+    }
+    return true;
+}
+
+void StateFrame::write(QDataStream &out) const
+{
+    out << MAGIC << (qint32) id << (qint32) subjectType;
+
+    out << sequence << (quint8) delta;
+    if (delta)
+        out << base;
+
+    out << (qint32) keys.size();
+    for (int i = 0; i < keys.size(); i++)
+        out << keys.at(i) << (qint32) types.at(i) << values.at(i);
+
+    // a delta identifies its elements by their positions in the keyframe
+    const QVector<int> &elements = delta ? rows : elementIds;
+
+    out << (qint32) elements.size() << (qint32) elementType;
+    for (int i = 0; i < elements.size(); i++)
+        out << (qint32) elements.at(i);
+
+    out << (qint32) columns.size();
+    for (int i = 0; i < columns.size(); i++)
+    {
+        const Column &column = columns.at(i);
+        out << column.key << (qint32) column.type;
+
+        if (column.type == TObsText)
+        {
+            for (int j = 0; j < column.texts.size(); j++)
+                out << column.texts.at(j);
+        }
+        else
+        {
+            out.writeRawData((const char *) column.numbers.constData(),
+                             column.numbers.size() * sizeof(double));
+        }
+    }
+}
+
+bool StateFrame::read(QDataStream &in)
+{
+    quint32 magic;
+    qint32 value, size;
+
+    in >> magic;
+    if (magic != MAGIC)
+        return false;
+
+    in >> value;
+    id = value;
+    in >> value;
+    subjectType = (TypesOfSubjects) value;
+
+    quint8 isDelta;
+    in >> sequence >> isDelta;
+    delta = isDelta != 0;
+    base = 0;
+    if (delta)
+        in >> base;
+
+    // each attribute has at least a key, a type, and a value
+    in >> size;
+    if (in.status() != QDataStream::Ok || size < 0 || !hasValues(in, size, 3 * sizeof(qint32)))
+        return false;
+
+    keys.clear();
+    types.clear();
+    values.clear();
+    for (int i = 0; i < size; i++)
+    {
+        QString key, text;
+        in >> key >> value >> text;
+        addAttribute(key, (TypesOfData) value, text);
+    }
+
+    in >> size >> value;
+    if (in.status() != QDataStream::Ok || size < 0 || !hasValues(in, size, sizeof(qint32)))
+        return false;
+
+    elementType = (TypesOfSubjects) value;
+    elementIds.clear();
+    rows.clear();
+
+    QVector<int> &elements = delta ? rows : elementIds;
+    elements.resize(size);
+    for (int i = 0; i < size; i++)
+    {
+        in >> value;
+        elements[i] = value;
+    }
+
+    qint32 numColumns;
+    in >> numColumns;
+    if (in.status() != QDataStream::Ok || numColumns < 0 || !hasValues(in, numColumns, 2 * sizeof(qint32)))
+        return false;
+
+    columns.clear();
+    for (int i = 0; i < numColumns; i++)
+    {
+        QString key;
+        in >> key >> value;
+
+        Column &column = addColumn(key, (TypesOfData) value);
+
+        if (column.type == TObsText)
+        {
+            // an empty string still has its size
+            if (!hasValues(in, size, sizeof(quint32)))
+                return false;
+
+            column.texts.resize(size);
+            for (int j = 0; j < size; j++)
+                in >> column.texts[j];
+        }
+        else
+        {
+            if (!hasValues(in, size, sizeof(double)))
+                return false;
+
+            int bytes = size * (int) sizeof(double);
+            column.numbers.resize(size);
+            if (in.readRawData((char *) column.numbers.data(), bytes) != bytes)
+                return false;
+        }
+    }
+
+    return in.status() == QDataStream::Ok;
+}
+
+QString StateFrame::toText() const
+{
+    QString msg, text;
+
+    if (delta)
+        return msg;
+
+    msg.append(QString::number(id));
+    msg.append(PROTOCOL_SEPARATOR);
+    msg.append(QString::number(subjectType));
+    msg.append(PROTOCOL_SEPARATOR);
+    msg.append(QString::number(keys.size()));
+    msg.append(PROTOCOL_SEPARATOR);
+    msg.append(QString::number(elementIds.size()));
+    msg.append(PROTOCOL_SEPARATOR);
+
+    for (int i = 0; i < keys.size(); i++)
+    {
+        msg.append(keys.at(i));
+        msg.append(PROTOCOL_SEPARATOR);
+        msg.append(QString::number(types.at(i)));
+        msg.append(PROTOCOL_SEPARATOR);
+        msg.append(values.at(i));
+        msg.append(PROTOCOL_SEPARATOR);
+    }
+    msg.append(PROTOCOL_SEPARATOR);
+
+    for (int i = 0; i < elementIds.size(); i++)
+    {
+        msg.append(QString::number(elementIds.at(i)));
+        msg.append(PROTOCOL_SEPARATOR);
+        msg.append(QString::number(elementType));
+        msg.append(PROTOCOL_SEPARATOR);
+        msg.append(QString::number(columns.size()));
+        msg.append(PROTOCOL_SEPARATOR);
+        msg.append(QString::number(0));
+        msg.append(PROTOCOL_SEPARATOR);
+
+        for (int j = 0; j < columns.size(); j++)
+        {
+            const Column &column = columns.at(j);
+
+            msg.append(column.key);
+            msg.append(PROTOCOL_SEPARATOR);
+            msg.append(QString::number(column.type));
+            msg.append(PROTOCOL_SEPARATOR);
+
+            if (column.type == TObsText)
+            {
+                msg.append(column.texts.at(i));
+            }
+            else if (column.type == TObsBool)
+            {
+                msg.append(QString::number((int) column.numbers.at(i)));
+            }
+            else
+            {
+                doubleToQString(column.numbers.at(i), text, 20);
+                msg.append(text);
+            }
+            msg.append(PROTOCOL_SEPARATOR);
+        }
+        msg.append(PROTOCOL_SEPARATOR);
+    }
+    msg.append(PROTOCOL_SEPARATOR);
+
+    return msg;
+}
+
+bool StateFrame::isFrame(QDataStream &in)
+{
+    if (!in.device())
+        return false;
+
+    QByteArray head = in.device()->peek(sizeof(quint32));
+    if (head.size() < (int) sizeof(quint32))
+        return false;
+
+    const uchar *data = (const uchar *) head.constData();
+    quint32 magic = (in.byteOrder() == QDataStream::BigEndian)
+        ? qFromBigEndian<quint32>(data) : qFromLittleEndian<quint32>(data);
+
+    return magic == MAGIC;
+}
+
+QString StateFrame::readText(QDataStream &in)
+{
+    QString msg;
+
+    if (isFrame(in))
+    {
+        StateFrame frame;
+        if (frame.read(in))
+            msg = frame.toText();
+    }
+    else
+    {
+        in >> msg;
+    }
+    return msg;
+}
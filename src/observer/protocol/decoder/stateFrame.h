@@ -0,0 +1,150 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+#ifndef STATE_FRAME_H
+#define STATE_FRAME_H
+
+#include <QVector>
+#include <QString>
+#include <QStringList>
+#include <QDataStream>
+
+#include "../../observerGlobals.h"
+
+namespace TerraMEObserver {
+
+/**
+ * \brief Typed binary encoding of the state of a Subject whose elements share
+ * the same attributes, such as a CellularSpace and its cells.
+ *
+ * The attributes of the elements are stored as columns. Numeric columns are
+ * written as raw arrays of doubles, in the byte order of the machine, so that
+ * the Decoder copies them at once into the Attributes of an observer instead of
+ * parsing one token per value. A frame is written with QDataStream as:
+ * the magic number; the id and the type of the subject; the number of attributes
+ * of the subject, each one as key, type, and value (as text); the number and the
+ * type of the elements, followed by their ids; and the number of columns, each one
+ * as key and type followed by its values.
+ *
+ * A frame is either a keyframe, with the values of all the elements, or a delta,
+ * with only the values of the elements that changed since the frame identified by
+ * base. A delta replaces the ids of the elements by their positions (rows) in the
+ * keyframe, and its columns have one value per row. Observers apply a delta in place
+ * only if it follows the last frame they received, waiting for the next keyframe
+ * otherwise.
+ * \see Decoder
+ * \file stateFrame.h
+ */
+class StateFrame
+{
+public:
+    /// Identifies a StateFrame within a QDataStream.
+    static const quint32 MAGIC = 0x544D4542;
+
+    /// Values of one attribute for all the elements
+    struct Column
+    {
+        QString key;
+        TypesOfData type;
+        QVector<double> numbers; ///< values of TObsNumber and TObsBool columns
+        QVector<QString> texts;  ///< values of TObsText columns
+    };
+
+    /**
+     * Constructor
+     */
+    StateFrame();
+
+    /**
+     * Adds an attribute of the subject
+     * \param key the name of the attribute
+     * \param type the type of the attribute
+     * \param value the value of the attribute as text
+     */
+    void addAttribute(const QString &key, TypesOfData type, const QString &value);
+
+    /**
+     * Adds an empty column with the values of an attribute of the elements
+     * \return a reference to the new column
+     */
+    Column & addColumn(const QString &key, TypesOfData type);
+
+    /**
+     * Builds a delta with the values of this keyframe that differ from the
+     * previous keyframe of the same subject. It fails if the frames do not have the same
+     * elements and columns, or if more than maxRows elements changed, in which
+     * case the keyframe must be sent instead.
+     * \param previous the whole state of the last frame sent to the observers
+     * \param result the delta
+     * \param maxRows the maximum number of changed elements
+     * \return whether the delta was built
+     */
+    bool diff(const StateFrame &previous, StateFrame &result, int maxRows) const;
+
+    /**
+     * Writes the frame
+     */
+    void write(QDataStream &out) const;
+
+    /**
+     * Reads a frame, returning whether it was possible to read it
+     */
+    bool read(QDataStream &in);
+
+    /**
+     * Converts the frame to the text protocol separated by PROTOCOL_SEPARATOR.
+     * A delta cannot be converted, returning an empty string.
+     */
+    QString toText() const;
+
+    /**
+     * Returns whether the next data of the stream is a StateFrame, without reading it
+     */
+    static bool isFrame(QDataStream &in);
+
+    /**
+     * Reads the state of a subject in the text protocol, converting it if
+     * it was written as a StateFrame
+     */
+    static QString readText(QDataStream &in);
+
+    int id;
+    TypesOfSubjects subjectType;
+
+    quint32 sequence;           ///< number of the frame within its subject
+    bool delta;                 ///< whether the frame is a delta
+    quint32 base;               ///< sequence of the frame that a delta updates
+
+    QStringList keys;           ///< names of the attributes of the subject
+    QVector<TypesOfData> types; ///< types of the attributes of the subject
+    QStringList values;         ///< values of the attributes of the subject
+
+    TypesOfSubjects elementType;
+    QVector<int> elementIds;    ///< ids of the elements, which define their number
+    QVector<int> rows;          ///< positions of the changed elements of a delta
+    QVector<Column> columns;
+};
+
+} // namespace TerraMEObserver
+
+#endif // STATE_FRAME_H
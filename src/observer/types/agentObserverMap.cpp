@@ -287,7 +287,7 @@ bool AgentObserverMap::decode(QDataStream &in, TypesOfSubjects subject)
 {
     bool ret = false;
     QString msg;
-    in >> msg;
+    msg = StateFrame::readText(in);
 
     // qDebug() << msg.split(PROTOCOL_SEPARATOR, QString::SkipEmptyParts);
 
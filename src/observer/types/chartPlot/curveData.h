@@ -0,0 +1,165 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+#ifndef CURVE_DATA_H
+#define CURVE_DATA_H
+
+#include <QVector>
+#include <QPolygonF>
+#include <QtMath>
+
+#include <qwt_series_data.h>
+#include <qwt_scale_map.h>
+
+namespace TerraMEObserver {
+
+/**
+ * \brief Samples of a curve that reference the values stored by the chart
+ * instead of copying them, so that appending a value does not copy the series.
+ * The bounding rectangle is updated incrementally when new values arrive.
+ * \see QwtSeriesData
+ * \file curveData.h
+ */
+class CurveData : public QwtSeriesData<QPointF>
+{
+public:
+    CurveData(const QVector<double> *xs, const QVector<double> *ys)
+        : xs(xs), ys(ys), scanned(0), sorted(true)
+    {
+    }
+
+    virtual size_t size() const
+    {
+        return qMin(xs->size(), ys->size());
+    }
+
+    virtual QPointF sample(size_t i) const
+    {
+        return QPointF(xs->at(i), ys->at(i));
+    }
+
+    virtual QRectF boundingRect() const
+    {
+        update();
+
+        if (scanned == 0)
+            return QRectF(1.0, 1.0, -2.0, -2.0);
+
+        return QRectF(minX, minY, maxX - minX, maxY - minY);
+    }
+
+    /**
+     * Returns true if the values of the x axis never decrease
+     */
+    bool isSorted() const
+    {
+        update();
+        return sorted;
+    }
+
+    /**
+     * Reduces the samples between from and to to at most four points for each
+     * pixel column: the first, the minimum, the maximum, and the last one. The
+     * returned points are already mapped to the canvas. It requires sorted samples.
+     * \param xMap the map of the x axis
+     * \param yMap the map of the y axis
+     * \param from the first sample
+     * \param to the last sample
+     */
+    QPolygonF decimate(const QwtScaleMap &xMap, const QwtScaleMap &yMap, int from, int to) const
+    {
+        QPolygonF points;
+        int i = from;
+
+        while (i <= to)
+        {
+            int column = qFloor(xMap.transform(xs->at(i)));
+            int first = i, min = i, max = i;
+
+            for (i++; (i <= to) && (qFloor(xMap.transform(xs->at(i))) == column); i++)
+            {
+                if (ys->at(i) < ys->at(min))
+                    min = i;
+                else if (ys->at(i) > ys->at(max))
+                    max = i;
+            }
+
+            int extremes[4] = {first, qMin(min, max), qMax(min, max), i - 1};
+
+            for (int j = 0; j < 4; j++)
+            {
+                if ((j == 0) || (extremes[j] != extremes[j - 1]))
+                {
+                    points += QPointF(xMap.transform(xs->at(extremes[j])),
+                                      yMap.transform(ys->at(extremes[j])));
+                }
+            }
+        }
+
+        return points;
+    }
+
+private:
+    /**
+     * Scans the values added since the last call. If the series was
+     * cleared, it starts again from the beginning
+     */
+    void update() const
+    {
+        int count = (int) size();
+
+        if (count < scanned)
+        {
+            scanned = 0;
+            sorted = true;
+        }
+
+        for (; scanned < count; scanned++)
+        {
+            double x = xs->at(scanned), y = ys->at(scanned);
+
+            if (scanned == 0)
+            {
+                minX = maxX = x;
+                minY = maxY = y;
+                continue;
+            }
+
+            if (x < maxX)
+                sorted = false;
+
+            minX = qMin(minX, x); maxX = qMax(maxX, x);
+            minY = qMin(minY, y); maxY = qMax(maxY, y);
+        }
+    }
+
+    const QVector<double> *xs, *ys;
+
+    mutable int scanned;
+    mutable bool sorted;
+    mutable double minX, maxX, minY, maxY;
+};
+
+} // namespace TerraMEObserver
+
+#endif // CURVE_DATA_H
@@ -29,6 +29,9 @@ of this software and its documentation.
 #include <qwt_plot.h>
 #include <qwt_plot_curve.h>
 #include <qwt_symbol.h>
+#include <qwt_painter.h>
+
+#include "curveData.h"
 
 
 namespace TerraMEObserver {
@@ -62,6 +65,16 @@ public:
 		gaps.clear();
 	}
 
+	/**
+	 * Uses the values of the x axis shared by all the curves of the chart.
+	 * The samples are not copied, therefore it is only necessary to replot
+	 * the chart after adding new values
+	 */
+	void setAbscissa(const QVector<double> *xs)
+	{
+		setData(new CurveData(xs, values));
+	}
+
 	void insertGap()
 	{
 		int from, to;
@@ -90,7 +103,7 @@ protected:
 	{
 		if (gaps.isEmpty())
 		{
-			QwtPlotCurve::drawCurve(p, style, xMap, yMap, canvasRect, from, to);
+			drawSegment(p, style, xMap, yMap, canvasRect, from, to);
 		}
 		else
 		{
@@ -100,16 +113,35 @@ protected:
 			{
 				f = gaps.at(i).first;
 				t = gaps.at(i).second;
-				QwtPlotCurve::drawCurve(p, style, xMap, yMap, canvasRect, f, t);
+				drawSegment(p, style, xMap, yMap, canvasRect, f, t);
 			}
 
 			if (to > t)
 			{
 				t++;
-				QwtPlotCurve::drawCurve(p, style, xMap, yMap, canvasRect, t, to);
+				drawSegment(p, style, xMap, yMap, canvasRect, t, to);
 			}
 		}
 	}
+
+private:
+	// Draws lines with many more samples than pixels using only the minimum
+	// and maximum values of each pixel column
+	void drawSegment(QPainter *p, int style,
+		const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+		const QRectF &canvasRect, int from, int to) const
+	{
+		const CurveData *samples = dynamic_cast<const CurveData *>(data());
+
+		if ((style != QwtPlotCurve::Lines) || (brush().style() != Qt::NoBrush)
+			|| !samples || (to - from < 4 * canvasRect.width()) || !samples->isSorted())
+		{
+			QwtPlotCurve::drawCurve(p, style, xMap, yMap, canvasRect, from, to);
+			return;
+		}
+
+		QwtPainter::drawPolyline(p, samples->decimate(xMap, yMap, from, to));
+	}
 };
 } // namespace TerraMEObserver
 
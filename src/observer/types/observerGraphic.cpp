@@ -40,6 +40,7 @@ using namespace std;
 #include "terrameGlobals.h"
 
 #include "visualArrangement.h"
+#include "../protocol/decoder/stateFrame.h"
 
 extern ExecutionModes execModes;
 
@@ -53,6 +54,9 @@ static const float hueValues[] = {
 };
 const int HUE_COUNT = 12;
 
+// Minimum time between two replots of the chart (25 frames per second)
+static const int REPLOT_INTERVAL = 40;
+
 ObserverGraphic::ObserverGraphic(Subject *sub, QWidget *parent)
     : ObserverInterf(sub), QThread()
 {
@@ -84,12 +88,17 @@ ObserverGraphic::ObserverGraphic(Subject *sub, QWidget *parent)
 
     VisualArrangement::getInstance()->starts(plotter->getId(), plotter);
 
+    replotTimer = new QTimer(this);
+    replotTimer->setSingleShot(true);
+    connect(replotTimer, SIGNAL(timeout()), SLOT(replot()));
+
     start(QThread::IdlePriority);
 }
 
 ObserverGraphic::~ObserverGraphic()
 {
     wait();
+    replotTimer->stop();
 
     foreach(InternalCurve *curve, internalCurves->values())
         delete curve;
@@ -116,15 +125,15 @@ const TypesOfObservers ObserverGraphic::getType()
 
 void ObserverGraphic::save(std::string file, std::string extension)
 {
+	replot();
 	plotter->exportChart(file, extension);
 }
 
 bool ObserverGraphic::draw(QDataStream &state)
 {
     QString msg, key;
-    state >> msg;
+    msg = StateFrame::readText(state);
     QStringList tokens = msg.split(PROTOCOL_SEPARATOR);
-    QVector<double> *ord = 0, *abs = xAxisValues;
     // double num = 0, x = 0, y = 0;
 
     //QString subjectId = tokens.at(0);
@@ -164,19 +173,6 @@ bool ObserverGraphic::draw(QDataStream &state)
                         internalCurves->value(key)->values->append(tokens.at(j).toDouble());
                     else
                         xAxisValues->append(tokens.at(j).toDouble());
-
-                    // Gr?fico Din?mico: Tempo vs Y
-                    if (observerType == TObsDynamicGraphic)
-                    {
-                        ord = internalCurves->value(key)->values;
-                        internalCurves->value(key)->setSamples(*abs, *ord);
-                    }
-                    else
-                    {
-                        // Gr?fico: X vs Y
-                        if (idx != attribList.size() - 1)
-                            ord = internalCurves->value(key)->values; // y axis
-                    }
                 }
                 break;
 
@@ -194,22 +190,6 @@ bool ObserverGraphic::draw(QDataStream &state)
                         internalCurves->value(key)->values->append(states.indexOf(tokens.at(j)));
                     else
                         xAxisValues->append(tokens.at(j).toDouble());
-
-                    // Gr?fico Din?mico: Tempo vs Y
-                    if (observerType == TObsDynamicGraphic)
-                    {
-                        ord = internalCurves->value(key)->values;
-                        abs = xAxisValues;
-                        internalCurves->value(key)->setSamples(*abs, *ord);
-                    }
-                    else
-                    {
-                        // Gr?fico: X vs Y
-                        if (idx != attribList.size() - 1)
-                            ord = internalCurves->value(key)->values;
-                        // else
-                        //     abs = xAxisValues; // internalCurves->value(key)->values;
-                    }
                 }
                 else
                 {
@@ -222,22 +202,29 @@ bool ObserverGraphic::draw(QDataStream &state)
         j++;
     }
 
-    if (observerType == TObsGraphic)
-    {
-        InternalCurve *curve = 0;
-
-        for (int i = 0; i < internalCurves->keys().size(); i++)
-        {
-            curve = internalCurves->value(internalCurves->keys().at(i));
-            curve->setSamples(*abs, *internalCurves->value(internalCurves->keys().at(i))->values);
-        }
-    }
-    plotter->repaint();
+    // The curves reference xAxisValues and their values, therefore it
+    // is only necessary to replot them
+    scheduleReplot();
 
     qApp->processEvents();
     return true;
 }
 
+void ObserverGraphic::scheduleReplot()
+{
+    if (!lastReplot.isValid() || lastReplot.elapsed() >= REPLOT_INTERVAL)
+        replot();
+    else if (!replotTimer->isActive())
+        replotTimer->start(REPLOT_INTERVAL - lastReplot.elapsed());
+}
+
+void ObserverGraphic::replot()
+{
+    replotTimer->stop();
+    plotter->replot();
+    lastReplot.start();
+}
+
 void ObserverGraphic::setTitles(const QString &title, const QString &xTitle, const QString &yTitle)
 {
 	QFontDatabase qfd;
@@ -297,6 +284,8 @@ void ObserverGraphic::setAttributes(const QStringList &attribs, const QStringLis
 
         if (interCurve)
         {
+            interCurve->setAbscissa(xAxisValues);
+
             if (i < curveTitles.size())
                 interCurve->setTitle(curveTitles.at(i));
             else
@@ -457,8 +446,9 @@ void ObserverGraphic::clear()
 	{
 		QString k(internalCurves->keys().at(i));
 		internalCurves->value(k)->clear();
-		internalCurves->value(k)->setSamples(*xAxisValues, *internalCurves->value(k)->values);
 	}
+
+	replot();
 }
 
 void ObserverGraphic::restart()
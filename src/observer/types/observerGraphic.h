@@ -28,6 +28,8 @@ of this software and its documentation.
 
 #include <QDialog>
 #include <QThread>
+#include <QTimer>
+#include <QElapsedTimer>
 
 #include <qwt_plot.h>
 #include <qwt_plot_curve.h>
@@ -155,6 +157,11 @@ private slots:
      */
     void colorChanged(QwtPlotItem* item);
 
+    /**
+     * Replots the chart with all the values received so far
+     */
+    void replot();
+
 protected:
     /**
      * Runs the thread
@@ -176,6 +183,15 @@ private:
 
     QVector<double> *xAxisValues;
 
+    /**
+     * Replots the chart at most once every REPLOT_INTERVAL milliseconds.
+     * Values received in between are plotted by a single delayed replot
+     */
+    void scheduleReplot();
+
+    QTimer *replotTimer;
+    QElapsedTimer lastReplot;
+
     bool paused;
 };
 
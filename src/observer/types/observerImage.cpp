@@ -0,0 +1,518 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+#include "observerImage.h"
+
+#include <QFileInfo>
+#include <QRunnable>
+#include <QThread>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#include "terrameGlobals.h"
+#include "observerMap.h"
+#include "../protocol/decoder/decoder.h"
+#include "../protocol/decoder/stateFrame.h"
+#include "../components/legend/legendAttributes.h"
+#include "../components/legend/legendColorUtils.h"
+#include "../components/painter/colorTable.h"
+
+extern ExecutionModes execModes;
+
+using namespace TerraMEObserver;
+
+const char *ObserverImage::STANDARD_OUTPUT = "-";
+
+/// Renders and writes a frame in the pool of threads of the observer
+class ObserverImage::FrameTask : public QRunnable
+{
+public:
+    FrameTask(ObserverImage *obs, const Frame &frame)
+        : observer(obs), frame(frame)
+    {
+    }
+
+    void run()
+    {
+        observer->write(frame.number, ObserverImage::render(frame));
+        observer->pending.release();
+    }
+
+private:
+    ObserverImage *observer;
+    Frame frame;
+};
+
+ObserverImage::ObserverImage(Subject *subj)
+    : ObserverInterf(subj), synchronized(false), lastSequence(0),
+    width(0), height(0), cellSize(1), grid(false), closed(false),
+    fileName(DEFAULT_NAME + ".png"), frames(0),
+    pending(qMax(2, 2 * QThread::idealThreadCount())), nextFrame(1)
+{
+    observerType = TObsImage;
+    subjectType = TObsUnknown;
+
+    mapAttributes = new QHash<QString, Attributes *>();
+    protocolDecoder = new Decoder(mapAttributes);
+}
+
+ObserverImage::~ObserverImage()
+{
+    close();
+
+    qDeleteAll(mapAttributes->values());
+    delete mapAttributes;
+    delete protocolDecoder;
+}
+
+const TypesOfObservers ObserverImage::getType()
+{
+    return observerType;
+}
+
+QStringList ObserverImage::getAttributes()
+{
+    return obsAttrib;
+}
+
+void ObserverImage::setCellSpaceSize(int w, int h)
+{
+    width = w;
+    height = h;
+    cellSize = qMax(1, IMAGE_SIZE.width() / qMax(1, qMax(w, h)));
+}
+
+void ObserverImage::setFileName(const QString &name)
+{
+    fileName = name;
+}
+
+void ObserverImage::setGridVisible(bool visible)
+{
+    grid = visible;
+}
+
+void ObserverImage::setAttributes(QStringList &attribs, QStringList legKeys,
+                                  QStringList legAttribs)
+{
+    for (int j = 0; (legKeys.size() > 0 && j < LEGEND_KEYS.size()); j++)
+    {
+        if (legKeys.indexOf(LEGEND_KEYS.at(j)) < 0)
+        {
+            qFatal("Error: Parameter legend \"%s\" not found. Please check it in the model.",
+                qPrintable(LEGEND_KEYS.at(j)));
+        }
+    }
+
+    for (int i = 0; i < attribs.size(); i++)
+    {
+        const QString &name = attribs.at(i);
+
+        if (mapAttributes->contains(name) || (name == "x") || (name == "y"))
+            continue;
+
+        obsAttrib.append(name);
+        Attributes *attrib = new Attributes(name, width * height, 0, 0);
+        attrib->setVisible(true);
+
+        if (!legKeys.isEmpty())
+        {
+            attrib->setDataType((TypesOfData) legAttribs.at(legKeys.indexOf(TYPE)).toInt());
+            attrib->setGroupMode((GroupingMode) legAttribs.at(legKeys.indexOf(GROUP_MODE)).toInt());
+            attrib->setSlices(legAttribs.at(legKeys.indexOf(SLICES)).toInt() - 1);
+            attrib->setPrecisionNumber(legAttribs.at(legKeys.indexOf(PRECISION)).toInt() - 1);
+            attrib->setStdDeviation((StdDev) legAttribs.at(legKeys.indexOf(STD_DEV)).toInt());
+            attrib->setMaxValue(legAttribs.at(legKeys.indexOf(MAX)).toDouble());
+            attrib->setMinValue(legAttribs.at(legKeys.indexOf(MIN)).toDouble());
+
+            std::vector<ColorBar> colorBarVec;
+            std::vector<ColorBar> stdColorBarVec;
+            QStringList labelList, valueList;
+
+            ObserverMap::createColorsBar(legAttribs.at(legKeys.indexOf(COLOR_BAR)),
+                colorBarVec, stdColorBarVec, valueList, labelList);
+
+            attrib->setColorBar(colorBarVec);
+            attrib->setStdColorBar(stdColorBarVec);
+            attrib->setValueList(valueList);
+            attrib->setLabelList(labelList);
+
+            for (int j = 0; j < LEGEND_ITENS; j++)
+            {
+                legKeys.removeFirst();
+                legAttribs.removeFirst();
+            }
+        }
+        mapAttributes->insert(name, attrib);
+    }
+}
+
+bool ObserverImage::draw(QDataStream &state)
+{
+    if (closed)
+        return false;
+
+    bool decoded = false;
+    QString msg;
+    StateFrame frame;
+    bool binary = StateFrame::isFrame(state);
+
+    if (binary)
+    {
+        if (!frame.read(state))
+            return true;
+
+        // a delta only updates the values of the previous frame
+        if (frame.delta && (!synchronized || (frame.base != lastSequence)))
+            return true;
+
+        synchronized = true;
+        lastSequence = frame.sequence;
+    }
+    else
+    {
+        state >> msg;
+    }
+
+    bool applyDelta = binary && frame.delta;
+    QList<Attributes *> cellAttribs;
+
+    foreach(Attributes *attrib, mapAttributes->values())
+    {
+        if (!applyDelta)
+            attrib->clear();
+        cellAttribs.append(attrib);
+    }
+
+    if (cellAttribs.isEmpty())
+        return false;
+
+    // the message is decoded once, filling the values of all the layers
+    Attributes *first = cellAttribs.first();
+
+    if (binary)
+        decoded = protocolDecoder->decode(frame, *first->getXsValue(), *first->getYsValue());
+    else
+        decoded = protocolDecoder->decode(msg, *first->getXsValue(), *first->getYsValue());
+
+    if (!decoded)
+    {
+        // the values do not match the delta anymore
+        if (applyDelta)
+            synchronized = false;
+        return false;
+    }
+
+    for (int i = 1; i < cellAttribs.size(); i++)
+    {
+        *cellAttribs.at(i)->getXsValue() = *first->getXsValue();
+        *cellAttribs.at(i)->getYsValue() = *first->getYsValue();
+    }
+
+    // the legends are computed from the first state, as in the ObserverMap
+    if (tables.isEmpty())
+    {
+        foreach(Attributes *attrib, cellAttribs)
+        {
+            makeLegend(attrib);
+            tables.insert(attrib->getName(),
+                QSharedPointer<ColorTable>(new ColorTable(attrib)));
+        }
+    }
+
+    frames++;
+
+    // blocks the simulation when the encoders fall behind
+    pending.acquire();
+    pool.start(new FrameTask(this, makeFrame(frames)));
+
+    return true;
+}
+
+ObserverImage::Frame ObserverImage::makeFrame(int number)
+{
+    Frame frame;
+    frame.number = number;
+    frame.size = QSize(width * cellSize, height * cellSize);
+    frame.cellSize = cellSize;
+    frame.grid = grid;
+
+    for (int i = 0; i < obsAttrib.size(); i++)
+    {
+        Attributes *attrib = mapAttributes->value(obsAttrib.at(i));
+        QSharedPointer<ColorTable> table = tables.value(obsAttrib.at(i));
+
+        if (!attrib || !table || !attrib->getVisible())
+            continue;
+
+        if ((attrib->getDataType() != TObsNumber) && (attrib->getDataType() != TObsText))
+            continue;
+
+        // the vectors are implicitly shared, so the copies are only made
+        // when the simulation changes the values of the Attributes
+        Layer layer;
+        layer.table = table;
+        layer.numeric = attrib->getDataType() == TObsNumber;
+        layer.numbers = *attrib->getNumericValues();
+        layer.texts = *attrib->getTextValues();
+        layer.xs = *attrib->getXsValue();
+        layer.ys = *attrib->getYsValue();
+        frame.layers.append(layer);
+    }
+    return frame;
+}
+
+QImage ObserverImage::render(const Frame &frame)
+{
+    QImage image(frame.size, QImage::Format_RGB32);
+    image.fill(Qt::white);
+
+    if (image.isNull())
+        return image;
+
+    const int cell = frame.cellSize;
+    const int imageWidth = image.width();
+    const int imageHeight = image.height();
+
+    for (int l = 0; l < frame.layers.size(); l++)
+    {
+        const Layer &layer = frame.layers.at(l);
+        int size = qMin(layer.xs.size(), layer.ys.size());
+        size = qMin(size, layer.numeric ? layer.numbers.size() : layer.texts.size());
+
+        for (int i = 0; i < size; i++)
+        {
+            int left = qRound(layer.xs.at(i)) * cell;
+            int top = qRound(layer.ys.at(i)) * cell;
+
+            if ((left < 0) || (top < 0) || (left >= imageWidth) || (top >= imageHeight))
+                continue;
+
+            QRgb color = qRgb(255, 255, 255);
+
+            if (layer.numeric)
+                layer.table->find(layer.numbers.at(i), color);
+            else
+                layer.table->find(layer.texts.at(i), color);
+
+            int right = qMin(left + cell, imageWidth);
+            int bottom = qMin(top + cell, imageHeight);
+
+            for (int y = top; y < bottom; y++)
+            {
+                QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+
+                if (l == 0)
+                {
+                    std::fill(line + left, line + right, color);
+                    continue;
+                }
+
+                // the upper layers are multiplied, as the ObserverMap composes them
+                for (int x = left; x < right; x++)
+                {
+                    QRgb pixel = line[x];
+                    line[x] = qRgb(qRed(pixel) * qRed(color) / 255,
+                                   qGreen(pixel) * qGreen(color) / 255,
+                                   qBlue(pixel) * qBlue(color) / 255);
+                }
+            }
+        }
+    }
+
+    if (frame.grid && (cell >= 3))
+    {
+        const QRgb gridColor = qRgb(128, 128, 128);
+
+        for (int y = 0; y < imageHeight; y++)
+        {
+            QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+
+            if (y % cell == 0)
+            {
+                std::fill(line, line + imageWidth, gridColor);
+                continue;
+            }
+
+            for (int x = 0; x < imageWidth; x += cell)
+                line[x] = gridColor;
+        }
+    }
+    return image;
+}
+
+void ObserverImage::makeLegend(Attributes *attrib)
+{
+    QVector<ObsLegend> *legend = attrib->getLegend();
+    legend->clear();
+
+    std::vector<ColorBar> colorBar = attrib->getColorBar();
+
+    // without colors, the values are painted with a gray ramp
+    if (colorBar.empty())
+        return;
+
+    int precision = attrib->getPrecisionNumber() + 1;
+    double fix = 1 / pow(10.0, precision);
+
+    if ((attrib->getGroupMode() == TObsUniqueValue) || (attrib->getDataType() == TObsText))
+    {
+        QStringList &valueList = attrib->getValueList();
+
+        if (valueList.isEmpty())
+        {
+            // the legend does not list the values, so they come from the first state
+            if (attrib->getDataType() == TObsNumber)
+            {
+                foreach(double value, *attrib->getNumericValues())
+                    attrib->addValueListItem(QString::number(value));
+            }
+            else
+            {
+                foreach(const QString &value, *attrib->getTextValues())
+                    attrib->addValueListItem(value);
+            }
+        }
+
+        std::vector<TeColor> colors = getColors(colorBar, qMax(2, valueList.size()));
+
+        for (int i = 0; i < valueList.size(); i++)
+        {
+            ObsLegend leg;
+            leg.setIdxColor((unsigned int) i);
+            leg.setFrom(valueList.at(i));
+            leg.setTo(valueList.at(i));
+            leg.setLabel(valueList.at(i));
+            leg.setColor(colors.at(i).red_, colors.at(i).green_, colors.at(i).blue_);
+            legend->append(leg);
+        }
+        return;
+    }
+
+    int rows = attrib->getSlices() + 1;
+    if (attrib->getSlices() == 0)
+        rows = 5;
+
+    std::vector<TeColor> colors = getColors(colorBar, qMax(2, rows));
+    QList<double> bounds;
+
+    if (attrib->getGroupMode() == TObsQuantil)
+    {
+        std::vector<double> values = attrib->getNumericValues()->toStdVector();
+
+        if (values.empty())
+            return;
+
+        std::sort(values.begin(), values.end());
+        double step = values.size() / (rows * 1.0);
+
+        bounds.append(values.front() - fix);
+        for (int n = 1; n < rows; n++)
+            bounds.append(values.at(qMin((int)(step * n + 0.5), (int) values.size() - 1)));
+        bounds.append(values.back() + fix);
+    }
+    else
+    {
+        // the standard deviation is not computed without the LegendWindow,
+        // so it is grouped by equal steps
+        double minValue = attrib->getMinValue();
+        double slice = (attrib->getMaxValue() - minValue) / (rows * 1.0);
+
+        for (int row = 0; row <= rows; row++)
+            bounds.append(minValue + row * slice);
+
+        bounds.first() -= fix;
+        bounds.last() += fix;
+    }
+
+    for (int row = 0; row < rows; row++)
+    {
+        QString from = QString("%1").arg(bounds.at(row), 0, 'f', precision);
+        QString to = QString("%1").arg(bounds.at(row + 1), 0, 'f', precision);
+
+        ObsLegend leg;
+        leg.setFrom(from);
+        leg.setTo(to);
+        leg.setLabel(QString("%1 ~ %2").arg(from).arg(to));
+        leg.setColor(colors.at(row).red_, colors.at(row).green_, colors.at(row).blue_);
+        legend->append(leg);
+    }
+}
+
+void ObserverImage::write(int number, const QImage &image)
+{
+    if (fileName != STANDARD_OUTPUT)
+    {
+        QFileInfo info(fileName);
+        QString suffix = info.suffix().isEmpty() ? QString("png") : info.suffix();
+        QString name = QString("%1/%2-%3.%4").arg(info.path())
+            .arg(info.completeBaseName()).arg(number).arg(suffix);
+
+        if (!image.save(name) && (execModes != Quiet))
+            qWarning("Warning: Failed to save the image file '%s'.", qPrintable(name));
+        return;
+    }
+
+    QImage rgb = image.convertToFormat(QImage::Format_RGB888);
+    int lineSize = rgb.width() * 3;
+    QByteArray data;
+    data.reserve(lineSize * rgb.height());
+
+    for (int y = 0; y < rgb.height(); y++)
+        data.append(reinterpret_cast<const char *>(rgb.constScanLine(y)), lineSize);
+
+    // the frames can be finished out of order by the threads
+    QMutexLocker locker(&writeMutex);
+    unwritten.insert(number, data);
+
+    while (unwritten.contains(nextFrame))
+    {
+        QByteArray next = unwritten.take(nextFrame);
+        fwrite(next.constData(), 1, next.size(), stdout);
+        nextFrame++;
+    }
+    fflush(stdout);
+}
+
+void ObserverImage::save(std::string file, std::string extension)
+{
+    pool.waitForDone();
+
+    QImage image = render(makeFrame(frames));
+    QString name = QString::fromLocal8Bit(file.c_str());
+
+    if (!image.save(name, extension.c_str()) && (execModes != Quiet))
+        qWarning("Warning: Failed to save the image file '%s'.", qPrintable(name));
+}
+
+int ObserverImage::close()
+{
+    if (closed)
+        return 0;
+
+    closed = true;
+    pool.waitForDone();
+    return 0;
+}
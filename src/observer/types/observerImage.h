@@ -0,0 +1,197 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+#ifndef OBSERVER_IMAGE_H
+#define OBSERVER_IMAGE_H
+
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QSemaphore>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QThreadPool>
+#include <QVector>
+
+#include "../observerInterf.h"
+
+namespace TerraMEObserver {
+
+class Attributes;
+class ColorTable;
+class Decoder;
+
+/**
+ * \brief Renders the attributes of a CellularSpace into images without any
+ * window, for simulations that run without a display.
+ *
+ * Each state received is saved as a numbered image, named after the file name
+ * followed by the number of the frame (map.png is saved as map-1.png, map-2.png,
+ * and so on), or written as a raw RGB24 frame to the standard output when the file
+ * name is "-", which can be piped to a video encoder such as ffmpeg. The values
+ * are decoded in the thread of the simulation, while the frames are rendered and
+ * encoded by a pool of threads. The legend is computed from the first state,
+ * as the LegendWindow of the ObserverMap does.
+ * \see ObserverInterf, \see ObserverMap
+ * \file observerImage.h
+ */
+class ObserverImage : public ObserverInterf
+{
+public:
+    /// File name that writes the frames to the standard output
+    static const char *STANDARD_OUTPUT;
+
+    /// Values of a layer of a frame, which are shared with the Attributes until they change
+    struct Layer
+    {
+        QSharedPointer<ColorTable> table;
+        QVector<double> numbers;
+        QVector<QString> texts;
+        QVector<double> xs, ys;
+        bool numeric;
+    };
+
+    /// Values needed to render a frame
+    struct Frame
+    {
+        int number;
+        QSize size;
+        int cellSize;
+        bool grid;
+        QList<Layer> layers;
+    };
+
+    /**
+     * Constructor
+     * \param subj a pointer to a Subject
+     * \see Subject
+     */
+    ObserverImage(Subject *subj);
+
+    /**
+     * Destructor
+     */
+    virtual ~ObserverImage();
+
+    /**
+     * \copydoc Observer::draw
+     */
+    bool draw(QDataStream &state);
+
+    /**
+     * Sets the attributes for observation and their legends
+     * \param attribs the list of attributes under observation
+     * \param legKeys the keys of the legends
+     * \param legAttribs the values of the legends
+     */
+    void setAttributes(QStringList &attribs, QStringList legKeys, QStringList legAttribs);
+
+    /**
+     * \copydoc Observer::getAttributes
+     */
+    QStringList getAttributes();
+
+    /**
+     * \copydoc Observer::getType
+     */
+    const TypesOfObservers getType();
+
+    /**
+     * Sets the dimension of the cellular space. The images have about
+     * IMAGE_SIZE pixels on their largest side, with square cells.
+     * \param width the number of columns
+     * \param height the number of lines
+     */
+    void setCellSpaceSize(int width, int height);
+
+    /**
+     * Sets the name of the files, or STANDARD_OUTPUT
+     */
+    void setFileName(const QString &name);
+
+    /**
+     * Draws the limits of the cells
+     */
+    void setGridVisible(bool visible);
+
+    /**
+     * Saves the last state in a file
+     * \param file the name of the file
+     * \param extension the format of the image
+     */
+    void save(std::string file, std::string extension);
+
+    /**
+     * Waits for all the frames to be written
+     */
+    int close();
+
+    /**
+     * Renders a frame
+     */
+    static QImage render(const Frame &frame);
+
+private:
+    class FrameTask;
+
+    /**
+     * Builds the legend of an attribute from its values, colors, and grouping mode
+     */
+    static void makeLegend(Attributes *attrib);
+
+    /**
+     * Copies the current values of the visible attributes
+     */
+    Frame makeFrame(int number);
+
+    /**
+     * Writes a rendered frame, keeping the order of the frames in the standard output
+     */
+    void write(int number, const QImage &image);
+
+    TypesOfObservers observerType;
+    TypesOfSubjects subjectType;
+
+    QStringList obsAttrib;
+    QHash<QString, Attributes *> *mapAttributes;
+    QHash<QString, QSharedPointer<ColorTable> > tables;
+    Decoder *protocolDecoder;
+
+    bool synchronized;      ///< whether the values are up to date with a keyframe
+    quint32 lastSequence;   ///< sequence of the last frame decoded
+
+    int width, height, cellSize;
+    bool grid, closed;
+    QString fileName;
+    int frames;             ///< number of frames received
+
+    QThreadPool pool;
+    QSemaphore pending;     ///< limits the frames waiting to be encoded
+    QMutex writeMutex;
+    QHash<int, QByteArray> unwritten; ///< frames of the standard output waiting for the previous ones
+    int nextFrame;          ///< next frame to be written in the standard output
+};
+
+} // namespace TerraMEObserver
+
+#endif // OBSERVER_IMAGE_H
@@ -24,9 +24,52 @@ of this software and its documentation.
 #include "observerLogFile.h"
 
 #include <QApplication>
+#include <QDataStream>
 #include <QMessageBox>
+#include <QRunnable>
 #include <QTextStream>
 
+#include <cstdlib>
+#include <limits>
+
+#include "../protocol/decoder/stateFrame.h"
+
+/// Size of the binary buffers written by the flusher thread
+static const int BUFFER_SIZE = 4 * 1024 * 1024;
+
+/// Number of notifications stored in each block of a columnar file
+static const int BLOCK_ROWS = 4096;
+
+/// Identifies the binary files
+static const char BINARY_MAGIC[] = "TMELOG";
+static const quint8 BINARY_VERSION = 1;
+
+/// Log files with binary buffers that still need to be written
+static QList<ObserverLogFile *> openLogFiles;
+
+/// Writes a buffer of a log file in the flusher thread
+class FlushTask : public QRunnable
+{
+public:
+    FlushTask(QFile *file, const QByteArray &data) : file(file), data(data) {}
+
+    void run()
+    {
+        file->write(data);
+    }
+
+private:
+    QFile *file;
+    QByteArray data;
+};
+
+/// Prepares a stream to write little-endian doubles at the end of a buffer
+static void setupStream(QDataStream &out)
+{
+    out.setByteOrder(QDataStream::LittleEndian);
+    out.setFloatingPointPrecision(QDataStream::DoublePrecision);
+}
+
 ObserverLogFile::ObserverLogFile() : QObject()
 {
     init();
@@ -41,6 +84,7 @@ ObserverLogFile::ObserverLogFile(Subject *subj)
 ObserverLogFile::~ObserverLogFile()
 {
     // wait();
+    close();
 }
 
 void ObserverLogFile::init()
@@ -54,6 +98,10 @@ void ObserverLogFile::init()
     fileName = DEFAULT_NAME + ".csv";
     separator = ";";
 
+    format = Text;
+    blockRows = 0;
+    flusher.setMaxThreadCount(1);
+
     // // prioridade da thread
     // //setPriority(QThread::IdlePriority); //  HighPriority    LowestPriority
     //start(QThread::IdlePriority);
@@ -66,57 +114,57 @@ const TypesOfObservers ObserverLogFile::getType()
 
 bool ObserverLogFile::draw(QDataStream &state)
 {
-    QString msg;
-    state >> msg;
-    QStringList tokens = msg.split(PROTOCOL_SEPARATOR);
-
-    //double num;
-    //QString text;
-    //bool b;
+    if (StateFrame::isFrame(state))
+    {
+        // only the attributes of the subject are logged, so the values of
+        // the elements are never converted to text
+        StateFrame frame;
+        if (!frame.read(state))
+            return false;
 
-    //QString subjectId = tokens.at(0);
-    subjectType =(TypesOfSubjects) tokens.at(1).toInt();
-    int qtdParametros = tokens.at(2).toInt();
-    //int nroElems = tokens.at(3).toInt();
-    int j = 4;
+        subjectType = frame.subjectType;
 
-    for (int i = 0; i < qtdParametros; i++)
+        for (int i = 0; i < frame.keys.size(); i++)
+            setValue(frame.keys.at(i), frame.types.at(i), frame.values.at(i));
+    }
+    else
     {
-        QString key = tokens.at(j);
-        j++;
-        int typeOfData = tokens.at(j).toInt();
-        j++;
+        QString msg;
+        state >> msg;
+        QStringList tokens = msg.split(PROTOCOL_SEPARATOR);
 
-        bool contains = attribList.contains(key);
+        //QString subjectId = tokens.at(0);
+        subjectType =(TypesOfSubjects) tokens.at(1).toInt();
+        int qtdParametros = tokens.at(2).toInt();
+        //int nroElems = tokens.at(3).toInt();
+        int j = 4;
 
-        switch (typeOfData)
+        for (int i = 0; i < qtdParametros; i++)
         {
-            case(TObsBool):
-                if (contains)
-                    valuesList.replace(attribList.indexOf(key),
-                                      (tokens.at(j).toInt() ? "true" : "false"));
-                break;
-
-            case(TObsDateTime):
-                //break;
-
-            case(TObsNumber):
-                if (contains)
-                    valuesList.replace(attribList.indexOf(key), tokens.at(j));
-                break;
-
-            default:
-                if (contains)
-                    valuesList.replace(attribList.indexOf(key), tokens.at(j));
-                break;
+            setValue(tokens.at(j), tokens.at(j + 1).toInt(), tokens.at(j + 2));
+            j += 3;
         }
-        j++;
     }
 
     qApp->processEvents();
     return write();
 }
 
+void ObserverLogFile::setValue(const QString &key, int type, const QString &value)
+{
+    int idx = attribList.indexOf(key);
+
+    if (idx < 0)
+        return;
+
+    typesList[idx] = type;
+
+    if (type == TObsBool)
+        valuesList.replace(idx, value.toInt() ? "true" : "false");
+    else
+        valuesList.replace(idx, value);
+}
+
 void ObserverLogFile::setFileName(QString name)
 {
     fileName = name;
@@ -132,6 +180,7 @@ void ObserverLogFile::setAttributes(QStringList &attribs)
     attribList = attribs;
     for (int i = 0; i < attribList.size(); i++)
         valuesList.insert(i, QString("")); // lista dos itens na ordem em que aparecem
+    typesList.fill(TObsUnknownData, attribList.size());
     header = true;
 }
 
@@ -140,57 +189,208 @@ bool ObserverLogFile::headerDefined()
     return header;
 }
 
-bool ObserverLogFile::write()
+bool ObserverLogFile::open()
 {
-    QFile file(fileName);
+    file.setFileName(fileName);
+
+    QIODevice::OpenMode openMode = (mode == QString("w")) ? QIODevice::WriteOnly : QIODevice::Append;
+    if (format == Text)
+        openMode |= QIODevice::Text;
+
+    if (!file.open(openMode))
+    {
+        QMessageBox::information(0, QObject::tr("Erro ao abrir arquivo"),
+                                 QObject::tr("N?o foi poss?vel abrir o arquivo de log \"%1\".\n%2")
+                                 .arg(this->fileName).arg(file.errorString()	));
+        return false;
+    }
+
+    if (format != Text)
+    {
+        // the last buffer is written when the observer is closed, either by
+        // clean() or by closeAll() at the end of the simulation
+        openLogFiles.append(this);
+        buffer.reserve(BUFFER_SIZE);
+
+        // the type of each column is taken from the first notification and
+        // kept while the file is open, as the header describes all the rows
+        columnTypes.resize(attribList.size());
+        for (int i = 0; i < attribList.size(); i++)
+            columnTypes[i] = (format == Raw || isNumeric(i)) ? TObsNumber : TObsText;
+    }
 
     if (mode == QString("w"))
     {
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+        if (format == Text)
         {
-            QMessageBox::information(0, QObject::tr("Erro ao abrir arquivo"),
-                                     QObject::tr("N?o foi poss?vel abrir o arquivo de log \"%1\".\n%2")
-                                     .arg(this->fileName).arg(file.errorString()	));
-            return false;
+            buffer += attribList.join(separator).toLatin1();
+            buffer += '\n';
         }
-
-        QString headers;
-        for (int i = 0; i < attribList.size(); ++i)
+        else
         {
-            headers += attribList.at(i);
+            QDataStream out(&buffer, QIODevice::WriteOnly | QIODevice::Append);
+            setupStream(out);
 
-            if (i < attribList.size() - 1)
-                headers += separator;
-        }
-        header = false;
-        headers += "\n";
-        file.write(headers.toLatin1().data(),  qstrlen(headers.toLatin1().data()));
+            out.writeRawData(BINARY_MAGIC, sizeof(BINARY_MAGIC) - 1);
+            out << BINARY_VERSION << (quint8) format << (quint32) attribList.size();
 
+            for (int i = 0; i < attribList.size(); i++)
+                out << attribList.at(i).toUtf8() << (quint8) columnTypes.at(i);
+        }
         mode = "w+";
     }
-    else
+    header = false;
+    return true;
+}
+
+bool ObserverLogFile::write()
+{
+    if (!file.isOpen() && !open())
+        return false;
+
+    switch (format)
     {
-        if (!file.open(QIODevice::Append | QIODevice::Text))
+        case Raw:
+            appendRaw();
+            break;
+
+        case Columnar:
+            appendColumnar();
+            break;
+
+        default:
+            appendText();
+
+            // the text files are complete after each notification
+            flush(false);
+            return true;
+    }
+
+    if (buffer.size() >= BUFFER_SIZE)
+        flush(true);
+
+    return true;
+}
+
+void ObserverLogFile::appendText()
+{
+    for (int i = 0; i < valuesList.size(); ++i)
+    {
+        buffer += valuesList.at(i).toLatin1();
+
+        if (i < attribList.size() - 1)
+            buffer += separator.toLatin1();
+    }
+    buffer += '\n';
+}
+
+void ObserverLogFile::appendRaw()
+{
+    QDataStream out(&buffer, QIODevice::WriteOnly | QIODevice::Append);
+    setupStream(out);
+
+    for (int i = 0; i < valuesList.size(); ++i)
+        out << number(i);
+}
+
+void ObserverLogFile::appendColumnar()
+{
+    if (blockRows == 0)
+    {
+        blockNumbers.fill(QVector<double>(), attribList.size());
+        blockTexts.fill(QList<QByteArray>(), attribList.size());
+    }
+
+    // values that do not match the type of their column are converted to it
+    for (int i = 0; i < valuesList.size(); ++i)
+    {
+        if (columnTypes.at(i) == TObsNumber)
+            blockNumbers[i].append(number(i));
+        else
+            blockTexts[i].append(valuesList.at(i).toUtf8());
+    }
+
+    blockRows++;
+
+    if (blockRows == BLOCK_ROWS)
+        appendBlock();
+}
+
+void ObserverLogFile::appendBlock()
+{
+    if (blockRows == 0)
+        return;
+
+    QDataStream out(&buffer, QIODevice::WriteOnly | QIODevice::Append);
+    setupStream(out);
+
+    // each block has the number of rows followed by the values of each attribute
+    out << (quint32) blockRows;
+
+    for (int i = 0; i < attribList.size(); i++)
+    {
+        if (columnTypes.at(i) == TObsNumber)
         {
-            QMessageBox::information(0, QObject::tr("Erro ao abrir arquivo"),
-                                     QObject::tr("N?o foi poss?vel abrir o arquivo de log \"%1\".\n%2")
-                                     .arg(this->fileName).arg(file.errorString()	));
-            return false;
+            const QVector<double> &numbers = blockNumbers.at(i);
+            for (int j = 0; j < numbers.size(); j++)
+                out << numbers.at(j);
+        }
+        else
+        {
+            const QList<QByteArray> &texts = blockTexts.at(i);
+            for (int j = 0; j < texts.size(); j++)
+                out << texts.at(j);
         }
     }
+    blockRows = 0;
+}
 
-    QString text;
-    for (int i = 0; i < valuesList.size(); ++i)
+bool ObserverLogFile::isNumeric(int attribute)
+{
+    int type = typesList.at(attribute);
+    return (type == TObsNumber) || (type == TObsBool);
+}
+
+double ObserverLogFile::number(int attribute)
+{
+    const QString &value = valuesList.at(attribute);
+
+    if (typesList.at(attribute) == TObsBool)
+        return value == "true" ? 1 : 0;
+
+    bool ok = false;
+    double result = value.toDouble(&ok);
+    return ok ? result : std::numeric_limits<double>::quiet_NaN();
+}
+
+void ObserverLogFile::flush(bool background)
+{
+    if (buffer.isEmpty())
+        return;
+
+    if (background)
     {
-        text += valuesList.at(i);
+        flusher.start(new FlushTask(&file, buffer));
 
-        if (i < attribList.size() - 1) text += separator;
+        buffer = QByteArray();
+        buffer.reserve(BUFFER_SIZE);
+        return;
     }
 
-    text.append("\n");
-    file.write(text.toLatin1().data(), qstrlen(text.toLatin1().data()));
-    file.close();
-    return true;
+    flusher.waitForDone();
+    file.write(buffer);
+    file.flush();
+    buffer.clear();
+}
+
+void ObserverLogFile::setFormat(Format format)
+{
+    this->format = format;
+}
+
+ObserverLogFile::Format ObserverLogFile::getFormat()
+{
+    return format;
 }
 
 void ObserverLogFile::setWriteMode(QString mode)
@@ -225,6 +425,19 @@ QStringList ObserverLogFile::getAttributes()
 int ObserverLogFile::close()
 {
     // QThread::exit(0);
+    if (file.isOpen())
+    {
+        appendBlock();
+        flush(false);
+        file.close();
+    }
+    openLogFiles.removeAll(this);
     return 0;
 }
 
+void ObserverLogFile::closeAll()
+{
+    while (!openLogFiles.isEmpty())
+        openLogFiles.first()->close();
+}
+
@@ -31,6 +31,8 @@ of this software and its documentation.
 #include <QStringList>
 #include <QFile>
 #include <QThread>
+#include <QThreadPool>
+#include <QVector>
 #include <QCloseEvent>
 
 #include <iostream>
@@ -39,6 +41,11 @@ namespace TerraMEObserver {
 
 /**
  * \brief Saves the observed attributes in a log file
+ *
+ * The file is kept open while the observer exists. Text files are written
+ * at each notification, so they can be read during the simulation. Binary
+ * files are buffered and written by a background thread, being complete
+ * only after the observer is closed.
  * \see QObject
  * \see ObserverInterf
  * \author Antonio Jos? da Cunha Rodrigues
@@ -47,6 +54,13 @@ namespace TerraMEObserver {
 class ObserverLogFile : public QObject, public ObserverInterf
 {
 public:
+    /// Formats of the file
+    enum Format {
+        Text = 0,       ///< one line of text per notification, with the values split by the separator
+        Raw = 1,        ///< a header with the attributes followed by one little-endian double per value
+        Columnar = 2    ///< a header with the attributes followed by blocks of values stored by attribute
+    };
+
     // TODO(Antonio)
     //enum WriteMode {
     //    WriteOnly = 0,
@@ -127,6 +141,17 @@ public:
      */
     QString getWriteMode();
 
+    /**
+     * Sets the format of the file
+     * \param format the format
+     */
+    void setFormat(Format format);
+
+    /**
+     * Gets the format of the file
+     */
+    Format getFormat();
+
     /**
      * Gets the type of observer
      * \see TypesOfObservers
@@ -143,6 +168,12 @@ public:
      */
     int close();
 
+    /**
+     * Closes all the binary log files still open, writing their buffers.
+     * It must be called while the application still exists.
+     */
+    static void closeAll();
+
 protected:
     /**
      * Runs the thread
@@ -166,6 +197,47 @@ private:
      */
     bool write();
 
+    /**
+     * Opens the file and writes its header
+     */
+    bool open();
+
+    /**
+     * Appends the values in the buffer, according to the format
+     */
+    void appendText();
+    void appendRaw();
+    void appendColumnar();
+
+    /**
+     * Appends the values accumulated by appendColumnar to the buffer
+     */
+    void appendBlock();
+
+    /**
+     * Writes the buffer into the file
+     * \param background whether the buffer is written by the flusher thread
+     */
+    void flush(bool background);
+
+    /**
+     * Updates the value of an observed attribute
+     * \param key the name of the attribute
+     * \param type the type of the value, as TypesOfData
+     * \param value the value as text
+     */
+    void setValue(const QString &key, int type, const QString &value);
+
+    /**
+     * Returns whether the current value of an attribute is a number or a boolean
+     */
+    bool isNumeric(int attribute);
+
+    /**
+     * Returns the value of an attribute as a number, or NaN
+     */
+    double number(int attribute);
+
 
     TypesOfObservers observerType;
     TypesOfSubjects subjectType;
@@ -178,6 +250,17 @@ private:
     QString mode;
 
     bool paused;
+
+    Format format;
+    QVector<int> typesList; ///< types of the values, as TypesOfData
+    QVector<int> columnTypes; ///< types of the columns of the binary formats, written in the header
+    QFile file;
+    QByteArray buffer;
+    QThreadPool flusher;    ///< a single thread that writes the binary buffers in order
+
+    int blockRows;          ///< rows accumulated by appendColumnar
+    QVector<QVector<double> > blockNumbers;
+    QVector<QList<QByteArray> > blockTexts;
 };
 
 } // namespace TerraMEObserver
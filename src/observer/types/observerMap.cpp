@@ -100,6 +100,9 @@ void ObserverMap::init()
 
     cleanValues = false;
 
+    synchronized = false;
+    lastSequence = 0;
+
     width = 0;
     height = 0;
     newWidthCellSpace = 0.;
@@ -125,25 +128,59 @@ bool ObserverMap::draw(QDataStream &state)
 {
     bool decoded = false;
     QString msg;
-    state >> msg;
+    StateFrame frame;
+    bool binary = StateFrame::isFrame(state);
+
+    if (binary)
+    {
+        if (!frame.read(state))
+            return true;
+
+        // a delta only updates the values of the previous frame
+        if (frame.delta && (!synchronized || (frame.base != lastSequence)))
+            return true;
+
+        synchronized = true;
+        lastSequence = frame.sequence;
+    }
+    else
+    {
+        state >> msg;
+    }
 
+    bool applyDelta = binary && frame.delta;
     QList<Attributes *> listAttribs = mapAttributes->values();
-    Attributes * attrib = 0;
+    QList<Attributes *> cellAttribs;
 
-    connectTreeLayerSlot(false);
     for (int i = 0; i < listAttribs.size(); i++)
     {
-        attrib = listAttribs.at(i);
-        if (attrib->getType() == TObsCell)
+        if (listAttribs.at(i)->getType() == TObsCell)
         {
-            attrib->clear();
+            if (!applyDelta)
+                listAttribs.at(i)->clear();
+            cellAttribs.append(listAttribs.at(i));
+        }
+    }
 
-            decoded = protocolDecoder->decode(msg, *attrib->getXsValue(), *attrib->getYsValue());
-            if (decoded)
-                painterWidget->plotMap(attrib);
+    connectTreeLayerSlot(false);
+    if (!cellAttribs.isEmpty())
+    {
+        if (binary)
+            decoded = decodeLayers(*protocolDecoder, frame, cellAttribs);
+        else
+            decoded = decodeLayers(*protocolDecoder, msg, cellAttribs);
+
+        if (applyDelta && !decoded)
+        {
+            // the values do not match the delta anymore
+            synchronized = false;
+        }
+        else if (decoded)
+        {
+            painterWidget->plotMap(cellAttribs);
         }
-        qApp->processEvents();
     }
+    qApp->processEvents();
 
     connectTreeLayerSlot(true);
 
@@ -706,6 +743,42 @@ void ObserverMap::createColorsBar(QString colors, std::vector<ColorBar> &colorBa
     }
 }
 
+/// Copies the coordinates of the cells decoded in the first layer to the other ones
+static void shareCoordinates(const QList<Attributes *> &layers)
+{
+    Attributes *first = layers.first();
+
+    for (int i = 1; i < layers.size(); i++)
+    {
+        *layers.at(i)->getXsValue() = *first->getXsValue();
+        *layers.at(i)->getYsValue() = *first->getYsValue();
+    }
+}
+
+bool ObserverMap::decodeLayers(Decoder &decoder, const StateFrame &frame,
+    const QList<Attributes *> &layers)
+{
+    Attributes *first = layers.first();
+
+    if (!decoder.decode(frame, *first->getXsValue(), *first->getYsValue()))
+        return false;
+
+    shareCoordinates(layers);
+    return true;
+}
+
+bool ObserverMap::decodeLayers(Decoder &decoder, const QString &msg,
+    const QList<Attributes *> &layers)
+{
+    Attributes *first = layers.first();
+
+    if (!decoder.decode(msg, *first->getXsValue(), *first->getYsValue()))
+        return false;
+
+    shareCoordinates(layers);
+    return true;
+}
+
 bool ObserverMap::constainsItem(const QVector<QPair<Subject *, QString> > &linkedSubjects,
         const Subject *subj)
 {
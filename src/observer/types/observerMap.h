@@ -53,6 +53,7 @@ class QVBoxLayout;
 namespace TerraMEObserver {
 
 class Decoder;
+class StateFrame;
 
 /**
  * \brief Spatial visualization for cells and saved in the user interface
@@ -148,6 +149,28 @@ public:
     static bool constainsItem(const QVector<QPair<Subject *, QString> > &linkedSubjects,
         const Subject *subj);
 
+    /**
+     * Decodes a state once, filling the values of all the cell layers, which
+     * share the coordinates of the cells decoded in the first layer
+     * \param decoder the Decoder of the attributes of the layers
+     * \param frame the state encoded as a StateFrame
+     * \param layers a non-empty list of cell layers
+     * \return whether the state was decoded
+     * \see Decoder, \see StateFrame
+     */
+    static bool decodeLayers(Decoder &decoder, const StateFrame &frame,
+        const QList<Attributes *> &layers);
+
+    /**
+     * Decodes a state in the text protocol once for all the cell layers
+     * \param decoder the Decoder of the attributes of the layers
+     * \param msg the state in QString format
+     * \param layers a non-empty list of cell layers
+     * \return whether the state was decoded
+     */
+    static bool decodeLayers(Decoder &decoder, const QString &msg,
+        const QList<Attributes *> &layers);
+
     /**
      * Closes the observer window
      */
@@ -331,6 +354,9 @@ private:
     Decoder *protocolDecoder;
     int builtLegend;
 
+    bool synchronized;      /// whether the values are up to date with a keyframe
+    quint32 lastSequence;   /// sequence of the last frame decoded
+
     bool needResizeImage;
     double 	newWidthCellSpace, newHeightCellSpace;
     int width, height;
@@ -23,154 +23,74 @@ of this software and its documentation.
 
 #include "observerTCPSender.h"
 
-#include <QtNetwork>
+#include <QApplication>
+#include <QByteArray>
+#include <QDataStream>
 
-//#include "senderGUI.h"
-//#include "tcpSocketTask.h"
+#include "tcpSocketTask.h"
+#include "udpSender/udpSenderGUI.h"
+#include "terrameGlobals.h"
 
-//#include "taskManager.h"
-//#include "worker.h"
-
-#ifdef TME_BLACK_BOARD
-	#include "blackBoard.h"
-//	#include "subjectAttributes.h"
-#endif
+extern ExecutionModes execModes;
 
 using namespace TerraMEObserver;
 
-//ObserverTCPSender::ObserverTCPSender(Subject *subj, QObject *parent)
-//    : QObject(parent), ObserverInterf(subj)
-//{
-//	int i = 1;
-/*
+ObserverTCPSender::ObserverTCPSender(Subject *subj, QObject *parent)
+    : QObject(parent), ObserverInterf(subj)
+{
     observerType = TObsTCPSender;
-    subjectType = subj->getType(); // TO_DO: Changes it to Observer pattern
-    tcpSocketTask = 0;
+    subjectType = TObsUnknown;
+
+    port = DEFAULT_PORT;
+    compressed = true;
+    closed = false;
 
-    //tcpSocketTask = new TcpSocketTask();
-    //tcpSocketTask->setCompress(false);
+    tcpSocketTask = new TcpSocketTask();
+    tcpSocketTask->moveToThread(&thread);
 
-    //connect(tcpSocketTask, SIGNAL(messageSent(const QString &)), this, SLOT(messageSent(const QString &)));
-    //connect(tcpSocketTask, SIGNAL(messageFailed(const QString &)), this, SLOT(messageFailed(const QString &)));
-    //connect(tcpSocketTask, SIGNAL(statusMessage(int, int)), this, SLOT(statusMessage(int, int)));
-    //// connect(tcpSocketTask, SIGNAL(connected()), this, SLOT(connected()));
+    connect(tcpSocketTask, SIGNAL(connected()), this, SLOT(connected()));
+    connect(tcpSocketTask, SIGNAL(messageFailed(const QString &)),
+            this, SLOT(messageFailed(const QString &)));
 
-    senderGUI = new SenderGUI();
+    senderGUI = new UdpSenderGUI();
     senderGUI->setWindowTitle("TCP Sender");
+    senderGUI->setCompressDatagram(compressed);
 
-    addresses = new QList<QHostAddress>();
-*/
-//}
+    thread.start(QThread::IdlePriority);
+}
 
-//ObserverTCPSender::~ObserverTCPSender()
-//{
-//	int i = 1;
-/*
-    // tcpSocketTask->disconnectFromHost();
-    // tcpSocketTask->waitForDisconnected(2000);
+ObserverTCPSender::~ObserverTCPSender()
+{
+    close();
 
-    // delete tcpSocketTask; tcpSocketTask = 0;
+    delete tcpSocketTask; tcpSocketTask = 0;
     delete senderGUI; senderGUI = 0;
-    delete addresses; addresses = 0;
-*/
-//}
+}
 
 bool ObserverTCPSender::draw(QDataStream& state)
 {
-/*
-    bool drew = false;
+    // The state is only copied here. It is converted, compressed and
+    // written by tcpSocketTask in its own thread
+    QByteArray stateAux = state.device()->readAll();
 
-    QByteArray stateAux;
-    state >> stateAux;
-
-    // qDebug() << "stateAux.size(): " << stateAux.size();
-
-    if (!stateAux.isEmpty())
-    {
-        static bool socket = false;
-        if (!socket)
-        {
-            tcpSocketTask = new TcpSocketTask();
-
-            connect(tcpSocketTask, SIGNAL(messageSent(const QString &)),
-            		senderGUI, SLOT(appendMessage(const QString &)));
-                // , Qt::DirectConnection);
-            connect(tcpSocketTask, SIGNAL(messageFailed(const QString &)),
-            		senderGUI, SLOT(messageFailed(const QString &)));
-            connect(tcpSocketTask, SIGNAL(statusMessages(int)),
-            		senderGUI, SLOT(statusMessages(int)) //, Qt::DirectConnection);
-            connect(tcpSocketTask, SIGNAL(statusStates(int)),
-            		senderGUI, SLOT(statusStates(int)) //, Qt::DirectConnection);
-            // connect(tcpSocketTask, SIGNAL(disconnected()), this, SLOT(deleteLater()));
-            connect(tcpSocketTask, SIGNAL(connected()), this, SLOT(connected()));
-            connect(tcpSocketTask, SIGNAL(speed(const QString &)),
-            		senderGUI, SLOT(setSpeed(const QString &)) //, Qt::DirectConnection);
-
-            connect(this, SIGNAL(addState(const QByteArray &)),
-            		tcpSocketTask, SLOT(addState(const QByteArray &)),
-                Qt::DirectConnection);
-                // Qt::QueuedConnection);
-            connect(this, SIGNAL(setModelTimeSignal(double)),
-            		tcpSocketTask, SLOT(setModelTime(double)),
-                Qt::DirectConnection);
-            connect(this, SIGNAL(abort()), tcpSocketTask, SLOT(abort()),
-                Qt::DirectConnection);
-
-            tcpSocketTask->setCompress(compressed);
-            tcpSocketTask->connectToHost(addresses->first(), port);
-
-            // const BagOfTasks::Worker *w = tcpSocketTask->runExclusively();
-            // tcpSocketTask->moveToThread((QThread *) w);
-            tcpSocketTask->moveToThread((QThread *) tcpSocketTask->runExclusively());
-
-            socket = true;
-        }
-
-        BagOfTasks::TaskManager::getInstance().add(tcpSocketTask);
-        emit addState(stateAux);
-        qApp->processEvents();
-
-        drew = true;
-    }
-    else
+    if (stateAux.isEmpty())
     {
-        senderGUI->appendMessage(
-        		tr("The retrieved state is empty. There is nothing to do."));
+        senderGUI->appendMessage(tr("The retrieved state is empty. There is nothing to do."));
+        return false;
     }
 
+    tcpSocketTask->addState(stateAux);
+
+    senderGUI->setStateSent(tcpSocketTask->getStatesSent());
+    senderGUI->setSpeed(tr("States discarded: %1").arg(tcpSocketTask->getStatesDropped()));
+
     qApp->processEvents();
-    return drew;
-*/
-	return true;
+    return true;
 }
 
 void ObserverTCPSender::setAttributes(QStringList &attribs)
 {
-/*
     attribList = attribs;
-
-#ifdef TME_BLACK_BOARD
-    SubjectAttributes *subjAttr = BlackBoard::getInstance().insertSubject(getSubjectId());
-    if (subjAttr)
-        subjAttr->setSubjectType(getSubjectType());
-#endif
-
-//#ifdef TME_BLACK_BOARD_
-//    Attributes *attrib = 0;
-//
-//    for (int i = 0; i < attribList.size(); i++)
-//    {
-//        if ((attribList.at(i) != "x") && (attribList.at(i) != "y"))
-//        {
-//            attrib =(Attributes *) &BlackBoard::getInstance()
-//                .addAttribute(getSubjectId(), attribList.at(i));
-//
-//            attrib->setVisible(true);
-//            attrib->setObservedBy(observerType);
-//        }
-//    }
-//#endif
-*/
 }
 
 QStringList ObserverTCPSender::getAttributes()
@@ -178,63 +98,80 @@ QStringList ObserverTCPSender::getAttributes()
     return attribList;
 }
 
-const TypesOfObservers ObserverTCPSender::getType() const
+const TypesOfObservers ObserverTCPSender::getType()
 {
     return observerType;
 }
 
 void ObserverTCPSender::addHost(const QString & host)
 {
-    addresses->append(QHostAddress(host));
+    hosts.append(host);
 }
 
 int ObserverTCPSender::close()
 {
-/*
-    emit abort();
+    if (closed)
+        return 0;
+
+    closed = true;
+    disconnectFromHost();
+    thread.quit();
+    thread.wait();
     senderGUI->close();
-*/
     return 0;
 }
 
 void ObserverTCPSender::show()
 {
- //   senderGUI->showNormal();
+    senderGUI->showNormal();
 }
 
 void ObserverTCPSender::setCompress(bool compress)
 {
-//    compressed = compress;
-//    senderGUI->setCompress(compress);
+    compressed = compress;
+    tcpSocketTask->setCompress(compress);
+    senderGUI->setCompressDatagram(compress);
 }
 
 void ObserverTCPSender::setModelTime(double time)
 {
-//    if (time == -1)
-//        emit setModelTimeSignal(time);
+    if (time == -1)
+    {
+        QByteArray flag;
+        QDataStream out(&flag, QIODevice::WriteOnly);
+        out << COMPLETE_SIMULATION;
+        tcpSocketTask->addState(flag);
+    }
 }
 
 bool ObserverTCPSender::connectTo(quint16 prt)
 {
     port = prt;
+    senderGUI->setPort(port);
+
+    if (hosts.size() > 1)
+        senderGUI->appendMessage(tr("Sending only to the first host, '%1'.").arg(hosts.first()));
 
-    //if (addresses->size() > 1)
-    //    qDebug() << "ObserverTCPSender - Sends for more than one client simultaneously did not implement yet";
-
-    //if (tcpSocketTask->connectToHost(addresses->first(), port))
-    //{
-    //    senderGUI->appendMessage(SenderGUI::tr("Connected on %1:%2 ")
-    //        .arg(addresses->first().toString())
-    //        .arg(port));
-    //    return true;
-    //}
-    //senderGUI->appendMessage(SenderGUI::tr("Conection fail: '%1'").arg(tcpSocketTask->errorString()));
-    return false;
+    tcpSocketTask->setHost(hosts.isEmpty() ? QString("localhost") : hosts.first(), port);
+    return QMetaObject::invokeMethod(tcpSocketTask, "connectToHost", Qt::QueuedConnection);
+}
+
+void ObserverTCPSender::disconnectFromHost()
+{
+    if (thread.isRunning())
+        QMetaObject::invokeMethod(tcpSocketTask, "abort", Qt::BlockingQueuedConnection);
 }
 
 void ObserverTCPSender::connected()
 {
-    // Used only for debugging
-//    senderGUI->appendMessage("conectou!!");
+    QString host = hosts.isEmpty() ? QString("localhost") : hosts.first();
+    senderGUI->appendMessage(tr("Connected on %1:%2").arg(host).arg(port));
 }
 
+void ObserverTCPSender::messageFailed(const QString &message)
+{
+    senderGUI->appendMessage(message);
+
+    if (execModes != Quiet)
+        qWarning("%s", qPrintable(message));
+}
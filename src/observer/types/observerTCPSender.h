@@ -24,21 +24,23 @@ of this software and its documentation.
 #ifndef OBSERVER_TCPSENDER_H
 #define OBSERVER_TCPSENDER_H
 
-#include <QHostAddress>
-#include <QList>
+#include <QThread>
 #include <QStringList>
 
 #include "observerInterf.h"
 
-class SenderGUI;
+class UdpSenderGUI;
 
 namespace TerraMEObserver {
 
 class TcpSocketTask;
 
 /**
- * \brief Sends the attributes observed via TCP Protocol
+ * \brief Sends the attributes observed via TCP Protocol. The states are
+ * queued and sent by a TcpSocketTask in another thread, therefore the
+ * simulation never waits for the receiver.
  * \see ObserverInterf
+ * \see TcpSocketTask
  * \author Antonio Jose da Cunha Rodrigues
  * \file observerTCPSender.h
  */
@@ -46,11 +48,20 @@ class ObserverTCPSender : public QObject, public ObserverInterf
 {
     Q_OBJECT
 public:
-    ObserverTCPSender(Subject *subj, QObject *parent = 0) {}
-    virtual ~ObserverTCPSender() {}
+    ObserverTCPSender(Subject *subj, QObject *parent = 0);
+    virtual ~ObserverTCPSender();
 
+    /**
+     * Connects to the first host added
+     * \param port the port of the receiver
+     */
     bool connectTo(quint16 port);
     void disconnectFromHost();
+
+    /**
+     * Adds a receiver. Only the first one is used
+     * \param host the name or the address of the receiver
+     */
     void addHost(const QString & host);
 
     /**
@@ -71,12 +82,12 @@ public:
     QStringList getAttributes();
 
     /**
-     * \copydoc Observer::getAttributes
+     * \copydoc Observer::getType
      */
-    const TypesOfObservers getType() const;
+    const TypesOfObservers getType();
 
     /**
-     * \copydoc SenderTask::setCompress
+     * \copydoc TcpSocketTask::setCompress
      */
     void setCompress(bool on);
 
@@ -90,13 +101,9 @@ public:
      */
     void show();
 
-signals:
-    void addState(const QByteArray &);
-    void setModelTimeSignal(double t1);
-    void abort();
-
 public slots:
     void connected();
+    void messageFailed(const QString &message);
 
 protected:
     /**
@@ -106,20 +113,18 @@ protected:
 
 private:
     quint16 port;
-    int stateCount, msgCount;
-    int datagramSize;
-    double datagramRatio;
-    bool compressed;
+    bool compressed, closed;
 
     TypesOfObservers observerType;
     TypesOfSubjects subjectType;
 
+    QThread thread;
     TcpSocketTask *tcpSocketTask;
 
     QStringList attribList;
-    QList<QHostAddress> *addresses;
+    QStringList hosts;
 
-    SenderGUI *senderGUI;
+    UdpSenderGUI *senderGUI;
 };
 
 } // namespace TerraMEObserver
@@ -32,6 +32,7 @@ of this software and its documentation.
 #include <math.h>
 
 #include "visualArrangement.h"
+#include "../protocol/decoder/stateFrame.h"
 
 ObserverTable::ObserverTable(Subject *subj, QWidget *parent)
     : QDialog(parent), ObserverInterf(subj), QThread()
@@ -107,7 +108,7 @@ void ObserverTable::setAttributes(QStringList &attribs)
 bool ObserverTable::draw(QDataStream &state)
 {
     QString msg;
-    state >> msg;
+    msg = StateFrame::readText(state);
 
     QStringList tokens = msg.split(PROTOCOL_SEPARATOR); //, QString::SkipEmptyParts);
     QTreeWidgetItem *item = 0;
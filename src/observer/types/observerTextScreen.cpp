@@ -27,6 +27,7 @@ of this software and its documentation.
 #include <QByteArray>
 
 #include "visualArrangement.h"
+#include "../protocol/decoder/stateFrame.h"
 
 ObserverTextScreen::ObserverTextScreen(Subject *subj, QWidget *parent)
     : QDialog(parent), ObserverInterf(subj), QThread()
@@ -62,7 +63,7 @@ const TypesOfObservers ObserverTextScreen::getType()
 bool ObserverTextScreen::draw(QDataStream &state)
 {
     QString msg;
-    state >> msg;
+    msg = StateFrame::readText(state);
     QStringList tokens = msg.split(PROTOCOL_SEPARATOR);
 
     //double num;
@@ -28,7 +28,11 @@ of this software and its documentation.
 #include <QApplication>
 #include <QLabel>
 #include <QList>
+#include <QDateTime>
+#include <QMutexLocker>
 #include "terrameGlobals.h"
+#include "../protocol/decoder/stateFrame.h"
+#include "../protocol/decoder/datagramFrame.h"
 
 ///< Gobal variabel: Lua stack used for comunication with C++ modules.
 extern lua_State * L;
@@ -40,7 +44,12 @@ void saveInFile(QString & msg);
 
 // Datagram default size
 static const int MINIMUM_DATAGRAM_SIZE = 1024;
+static const float DATAGRAM_RATIO = 8.0;
 static const int COMPRESS_RATIO = 6;
+// Maximum time that the bandwidth not used while idle can be used later (ms)
+static const int MAXIMUM_BURST = 1000;
+// Maximum number of states waiting to be sent at the bandwidth
+static const int MAXIMUM_PENDING_STATES = 4;
 
 ObserverUDPSender::ObserverUDPSender()
     : QThread()
@@ -56,6 +65,12 @@ ObserverUDPSender::ObserverUDPSender(Subject *subj)
 
 ObserverUDPSender::~ObserverUDPSender()
 {
+    {
+        QMutexLocker locker(&queueMutex);
+        stopping = true;
+        queued.wakeAll();
+    }
+
     //if (QThread::isRunning())
     wait();
 
@@ -78,15 +93,20 @@ void ObserverUDPSender::init()
     // default port
     port = DEFAULT_PORT;
 
-    if (compressDatagram)
-        datagramRatio = 50.0;
-    else
-        datagramRatio = 6.0;
-
+    datagramRatio = DATAGRAM_RATIO;
     datagramSize = MINIMUM_DATAGRAM_SIZE * datagramRatio;
     stateCount = 0;
     msgCount = 0;
 
+    // a receiver still assembling the states of a previous simulation
+    // will not confuse them with the new ones
+    frameId = (quint32) QDateTime::currentMSecsSinceEpoch();
+
+    bandwidth = 0;
+    pacedBandwidth = 0;
+    pacedBytes = 0;
+    stopping = false;
+
     udpSocket = new QUdpSocket();
     hosts = new QList<QHostAddress>();
 
@@ -108,15 +128,15 @@ bool ObserverUDPSender::draw(QDataStream &state)
         return false;
 
     QString msg;
-    state >> msg;
+    msg = StateFrame::readText(state);
 
-    if (!sendDatagram(msg))
+    if (!sendDatagram(msg.toLatin1()))
     {
         datagramRatio *= 0.5;
         datagramSize = MINIMUM_DATAGRAM_SIZE * datagramRatio;
         QString str;
 
-        if (datagramSize < 32)
+        if (datagramSize < DatagramFrame::MINIMUM_CHUNK_SIZE)
         {
             str = "Warning: The datagram's size is low that 32 bytes. "
                 "The Udp Sender will stop to send datagrams.";
@@ -138,11 +158,36 @@ bool ObserverUDPSender::draw(QDataStream &state)
 
 void ObserverUDPSender::run()
 {
-    //while (!paused)
-    //{
-    //    QThread::exec();
-    //}
-    QThread::exec();
+    // the socket used to send the paced states belongs to this thread
+    QUdpSocket socket;
+
+    forever
+    {
+        PacedState state;
+        {
+            QMutexLocker locker(&queueMutex);
+
+            while (pending.isEmpty() && !stopping)
+                queued.wait(&queueMutex);
+
+            // the states already queued are sent before the thread stops
+            if (pending.isEmpty())
+                return;
+
+            state = pending.dequeue();
+        }
+
+        for (int j = 0; j < state.datagrams.size(); j++)
+        {
+            pace(state.datagrams.at(j).size() * state.hosts.size(), state.bandwidth);
+
+            for (int i = 0; i < state.hosts.size(); i++)
+            {
+                if (socket.writeDatagram(state.datagrams.at(j), state.hosts.at(i), state.port) == -1)
+                    failures.ref();
+            }
+        }
+    }
 }
 
 void ObserverUDPSender::pause()
@@ -164,41 +209,46 @@ void ObserverUDPSender::setAttributes(QStringList& attribs)
     //sendDatagram(msg);
 }
 
-bool ObserverUDPSender::sendDatagram(QString& msg)
+bool ObserverUDPSender::sendDatagram(const QByteArray &data, quint8 flags)
 {
-    QByteArray data(msg.toLatin1().constData(), msg.size());
+    QByteArray message = data;
+
+    // the whole state is compressed before being split, therefore
+    // every datagram but the last one has exactly datagramSize bytes
+    if (compressDatagram)
+    {
+        message = qCompress(data, COMPRESS_RATIO);
+        flags |= DatagramFrame::Compressed;
+    }
 
-    qint64 bytesWritten = 0, bytesRead = data.size();
-    int pos = 0;
+    QList<QByteArray> datagrams = DatagramFrame::split(frameId++, message, datagramSize, flags);
+    qint64 bytesWritten = 0;
 
-    while (bytesRead > 0)
+    if (bandwidth > 0)
     {
-        QByteArray datagram;
+        enqueue(datagrams);
+        msgCount += datagrams.size();
+        stateCount++;
 
-        QDataStream out(&datagram, QIODevice::WriteOnly);
-        out.setVersion(QDataStream::Qt_4_6);
+        udpGUI->setMessagesSent(msgCount);
+        udpGUI->setStateSent(stateCount);
 
-        out <<(qint64) data.size();
-        out <<(qint64) datagramSize;
-        out <<(qint64) pos;
-        out << compressDatagram; // flag formato do datagrama transmitido
+        int failed = failures.fetchAndStoreOrdered(0);
+        if (failed > 0)
+            udpGUI->appendMessage(tr("Warning: %1 datagrams could not be sent.\n").arg(failed));
 
-        if (compressDatagram)
-        {
-            out << qCompress(data.mid(pos, datagramSize), COMPRESS_RATIO);
-        }
-        else
-        {
-            out << data.mid(pos, datagramSize);
-        }
+        int discarded = dropped.fetchAndStoreOrdered(0);
+        if (discarded > 0)
+            udpGUI->appendMessage(tr("Warning: %1 states were discarded, as the bandwidth is too low.\n").arg(discarded));
 
+        return true;
+    }
+
+    for (int j = 0; j < datagrams.size(); j++)
+    {
         for (int i = 0; i < hosts->size(); i++)
         {
-            bytesWritten = udpSocket->writeDatagram(datagram, hosts->at(i), port);
-
-            udpSocket->flush();
-
-            udpGUI->appendMessage(QLabel::tr("Datagram sent for %1").arg(hosts->at(i).toString()));
+            bytesWritten = udpSocket->writeDatagram(datagrams.at(j), hosts->at(i), port);
 
             if (bytesWritten == -1)
             {
@@ -222,43 +272,69 @@ bool ObserverUDPSender::sendDatagram(QString& msg)
                 return false;
             }
         }
-
-        if (compressDatagram)
-        {
-            bytesRead -= datagramSize;
-            pos += datagramSize;
-        }
-        else
-        {
-            bytesRead -= bytesWritten;
-            pos += bytesWritten;
-        }
         msgCount++;
-
-        // faz um pausa antes de continuar a enviar
-        // delay((float) 0.01); // 0.0125);
-        // delay((float) 0.0125);
-        qApp->processEvents();
     }
 
-    completeState(COMPLETE_STATE.toLatin1());
-
-    msgCount++;
     stateCount++;
 
     udpGUI->setMessagesSent(msgCount);
     udpGUI->setStateSent(stateCount);
 
-    //udpGUI->appendMessage(tr("compressionSum: %1 / %2 = %3")
-    //    .arg(compressionSum).arg(compressionCount).arg(compressionSum / compressionCount));
-    //udpGUI->appendMessage(tr("renderingSum: %1 / %2 = %3")
-    //    .arg(renderingSum).arg(renderingCount).arg(renderingSum / renderingCount));
-
-    udpGUI->appendMessage(tr("States sent: %1.\n").arg(stateCount));
+    udpGUI->appendMessage(tr("States sent: %1 (%2 datagrams).\n")
+        .arg(stateCount).arg(datagrams.size()));
 
     return true;
 }
 
+void ObserverUDPSender::enqueue(const QList<QByteArray> &datagrams)
+{
+    PacedState state;
+    state.datagrams = datagrams;
+    state.hosts = *hosts;
+    state.port = port;
+    state.bandwidth = bandwidth;
+
+    QMutexLocker locker(&queueMutex);
+    pending.enqueue(state);
+
+    while (pending.size() > MAXIMUM_PENDING_STATES)
+    {
+        pending.dequeue();
+        dropped.ref();
+    }
+
+    queued.wakeOne();
+}
+
+void ObserverUDPSender::pace(int bytes, int bytesPerSecond)
+{
+    if (bytesPerSecond <= 0)
+        return;
+
+    // a new bandwidth starts a new count
+    if (!pacing.isValid() || (bytesPerSecond != pacedBandwidth))
+    {
+        pacing.start();
+        pacedBytes = 0;
+        pacedBandwidth = bytesPerSecond;
+    }
+
+    // the time at which the bytes already sent would be sent at the bandwidth
+    qint64 due = pacedBytes * 1000 / bytesPerSecond;
+
+    if (pacing.elapsed() - due > MAXIMUM_BURST)
+    {
+        pacing.restart();
+        pacedBytes = 0;
+        due = 0;
+    }
+
+    if (due > pacing.elapsed())
+        msleep(due - pacing.elapsed());
+
+    pacedBytes += bytes;
+}
+
 void ObserverUDPSender::setPort(int prt)
 {
     port = prt;
@@ -279,13 +355,6 @@ void ObserverUDPSender::addHost(const QString & host)
 void ObserverUDPSender::setCompressDatagram(bool on)
 {
     compressDatagram = on;
-
-    if (compressDatagram)
-        datagramRatio = 50.0;
-    else
-        datagramRatio = 6.0;
-
-    datagramSize = MINIMUM_DATAGRAM_SIZE * datagramRatio;
     udpGUI->setCompressDatagram(compressDatagram);
 }
 
@@ -294,46 +363,24 @@ bool ObserverUDPSender::getCompressDatagram()
     return compressDatagram;
 }
 
-bool ObserverUDPSender::completeState(const QByteArray & flag)
+void ObserverUDPSender::setBandwidth(int bytesPerSecond)
 {
-    qint64 bytesWritten = 0;
-    QByteArray datagram, data;
-    data = QByteArray(flag);
-
-    QDataStream out(&datagram, QIODevice::WriteOnly);
-    // out.setVersion(QDataStream::Qt_4_6);
-
-    out <<(qint64) data.size();
-    out <<(qint64) datagramSize;
-    out <<(qint64) -1;
-    out << compressDatagram;
-
-    if (compressDatagram)
-       out << qCompress(data, 1);
-    else
-        out << data;
-
-    for (int i = 0; i < hosts->size(); i++)
-    {
-        bytesWritten = udpSocket->writeDatagram(datagram, hosts->at(i), port);
-        udpSocket->flush();
-
-        if (bytesWritten == -1)
-            return false;
-    }
-    return true;
+    bandwidth = bytesPerSecond;
 }
 
 void ObserverUDPSender::setModelTime(double time)
 {
     if (time == -1)
-        completeState(COMPLETE_SIMULATION.toLatin1());
+        sendDatagram(COMPLETE_SIMULATION.toLatin1(), DatagramFrame::EndOfSimulation);
 }
 
 int ObserverUDPSender::close()
 {
     udpSocket->abort();
-    QThread::exit(0);
+
+    QMutexLocker locker(&queueMutex);
+    stopping = true;
+    queued.wakeAll();
     return 0;
 }
 
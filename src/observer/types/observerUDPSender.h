@@ -36,6 +36,11 @@ extern "C"
 #include <QDialog>
 #include <QThread>
 #include <QHostAddress>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QQueue>
+#include <QAtomicInt>
 
 class QUdpSocket;
 
@@ -137,9 +142,17 @@ public:
      */
     void addHost(const QString & host);
 
+    /**
+     * Limits the number of bytes sent per second. The datagrams of large
+     * states are spread over time by the thread of the observer instead of
+     * being sent at once, so that the simulation does not wait for them
+     * \param bytesPerSecond the bandwidth, or 0 to send without limits
+     */
+    void setBandwidth(int bytesPerSecond);
+
 protected:
     /**
-     * Runs the thread
+     * Runs the thread, which sends the states queued when there is a bandwidth
      * \see QThread
      */
     void run();
@@ -156,21 +169,37 @@ private:
     void init();
 
     /**
-     * Sends the datagram
-     * \param msg a reference to the datagram composes of the subject internal state
-     * \return boolean, \a true if the datagram could be sent.
+     * Sends a message split into datagrams with DatagramFrame
+     * \param data the message, usually the subject internal state
+     * \param flags the DatagramFrame::Flags of the message
+     * \return boolean, \a true if the datagrams could be sent.
      * Otherwise, returns \a false.
+     * \see DatagramFrame
+     */
+    bool sendDatagram(const QByteArray &data, quint8 flags = 0);
+
+    /// The datagrams of a state waiting to be sent by the thread of the observer
+    struct PacedState
+    {
+        QList<QByteArray> datagrams;
+        QList<QHostAddress> hosts;
+        int port;
+        int bandwidth;
+    };
+
+    /**
+     * Queues the datagrams of a state to be sent at the bandwidth. The oldest
+     * state is discarded when the queue is full
      */
-    bool sendDatagram(QString & msg);
+    void enqueue(const QList<QByteArray> &datagrams);
 
     /**
-     *  Sends the informations that indicates that complete state was sent
-     * \param flag a reference to the QByteArray \a flag
-     * \return boolean, \a true if the complete state could be sent.
-     * Otherwise, returns \a false.
-     * \see QByteArray
+     * Waits until the bandwidth allows sending more bytes. It is called
+     * only by the thread of the observer
+     * \param bytes the size of the next datagram
+     * \param bytesPerSecond the bandwidth
      */
-    bool completeState(const QByteArray &flag);
+    void pace(int bytes, int bytesPerSecond);
 
     TypesOfObservers observerType;
     TypesOfSubjects subjectType;
@@ -179,6 +208,18 @@ private:
     int port, stateCount, msgCount;
     int datagramSize;
     float datagramRatio;
+    quint32 frameId;
+
+    int bandwidth;
+    int pacedBandwidth;
+    qint64 pacedBytes;
+    QElapsedTimer pacing;
+
+    QMutex queueMutex; ///< protects pending and stopping
+    QWaitCondition queued;
+    QQueue<PacedState> pending;
+    bool stopping;
+    QAtomicInt failures, dropped;
 
     QUdpSocket *udpSocket;
 
@@ -0,0 +1,191 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+#include "tcpSocketTask.h"
+
+#include <QtNetwork/QTcpSocket>
+#include <QDataStream>
+#include <QMutexLocker>
+
+#include "../protocol/decoder/stateFrame.h"
+
+using namespace TerraMEObserver;
+
+// Bytes waiting in the socket buffer before the queue stops being flushed
+static const qint64 MAXIMUM_PENDING_BYTES = 1 << 20;
+// Minimum time between two attempts to connect to the receiver (ms)
+static const int RECONNECT_INTERVAL = 1000;
+static const int COMPRESS_RATIO = 6;
+
+TcpSocketTask::TcpSocketTask(int capacity)
+    : QObject(), socket(0), port(0), compress(true), capacity(capacity),
+      scheduled(0), sent(0), dropped(0)
+{
+}
+
+TcpSocketTask::~TcpSocketTask()
+{
+}
+
+void TcpSocketTask::setHost(const QString &host, quint16 port)
+{
+    this->host = host;
+    this->port = port;
+}
+
+void TcpSocketTask::setCompress(bool on)
+{
+    QMutexLocker locker(&mutex);
+    compress = on;
+}
+
+bool TcpSocketTask::addState(const QByteArray &state)
+{
+    bool full = false;
+    {
+        QMutexLocker locker(&mutex);
+
+        QueuedState queued;
+        queued.data = state;
+        queued.compress = compress;
+        states.enqueue(queued);
+
+        while (states.size() > capacity)
+        {
+            states.dequeue();
+            dropped.ref();
+            full = true;
+        }
+    }
+
+    if (scheduled.testAndSetOrdered(0, 1))
+        QMetaObject::invokeMethod(this, "flush", Qt::QueuedConnection);
+
+    return !full;
+}
+
+int TcpSocketTask::getStatesSent() const
+{
+    return sent.load();
+}
+
+int TcpSocketTask::getStatesDropped() const
+{
+    return dropped.load();
+}
+
+void TcpSocketTask::connectToHost()
+{
+    // the socket is created here to belong to the thread of the task
+    if (!socket)
+    {
+        socket = new QTcpSocket(this);
+        connect(socket, SIGNAL(connected()), this, SIGNAL(connected()));
+        connect(socket, SIGNAL(connected()), this, SLOT(flush()));
+        connect(socket, SIGNAL(bytesWritten(qint64)), this, SLOT(flush()));
+        connect(socket, SIGNAL(error(QAbstractSocket::SocketError)), this, SLOT(socketError()));
+    }
+
+    lastAttempt.start();
+    socket->connectToHost(host, port);
+}
+
+void TcpSocketTask::flush()
+{
+    scheduled.store(0);
+
+    if (!socket)
+        return;
+
+    if (socket->state() == QAbstractSocket::UnconnectedState)
+    {
+        if (lastAttempt.elapsed() >= RECONNECT_INTERVAL)
+            connectToHost();
+        return;
+    }
+
+    if (socket->state() != QAbstractSocket::ConnectedState)
+        return;
+
+    QueuedState state;
+
+    while ((socket->bytesToWrite() < MAXIMUM_PENDING_BYTES) && takeState(state))
+        write(state);
+}
+
+void TcpSocketTask::abort()
+{
+    if (!socket)
+        return;
+
+    // waits a little for the states already written
+    if (socket->state() == QAbstractSocket::ConnectedState)
+    {
+        flush();
+        socket->disconnectFromHost();
+
+        if (socket->state() != QAbstractSocket::UnconnectedState)
+            socket->waitForDisconnected(1000);
+    }
+    socket->abort();
+}
+
+void TcpSocketTask::socketError()
+{
+    emit messageFailed(tr("Warning: Failed on send message. Socket Error: %1")
+        .arg(socket->errorString()));
+}
+
+bool TcpSocketTask::takeState(QueuedState &state)
+{
+    QMutexLocker locker(&mutex);
+
+    if (states.isEmpty())
+        return false;
+
+    state = states.dequeue();
+    return true;
+}
+
+void TcpSocketTask::write(const QueuedState &state)
+{
+    QDataStream in(state.data);
+    QByteArray data = StateFrame::readText(in).toLatin1();
+
+    if (state.compress)
+        data = qCompress(data, COMPRESS_RATIO);
+
+    QByteArray frame;
+    QDataStream out(&frame, QIODevice::WriteOnly);
+    out << (quint32) data.size();
+    out << (quint8) state.compress;
+    frame.append(data);
+
+    sent.ref();
+
+    if (socket->write(frame) == -1)
+    {
+        sent.deref();
+        socketError();
+    }
+}
@@ -0,0 +1,142 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2017 INPE and TerraLAB/UFOP -- www.terrame.org
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this software and its documentation.
+*************************************************************************************/
+
+#ifndef TCP_SOCKET_TASK_H
+#define TCP_SOCKET_TASK_H
+
+#include <QObject>
+#include <QQueue>
+#include <QMutex>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QByteArray>
+#include <QString>
+
+class QTcpSocket;
+
+namespace TerraMEObserver {
+
+/**
+ * \brief Sends the states of a subject through a TCP connection. It must be moved
+ * to its own thread, where the states are converted, compressed and written.
+ *
+ * The states wait in a bounded queue. When the receiver is slower than the
+ * simulation, the oldest states are discarded, as each state replaces the
+ * previous ones. Each state is written as a frame with its size (quint32),
+ * a flag (quint8) indicating whether it is compressed, and the data.
+ * \see ObserverTCPSender
+ * \file tcpSocketTask.h
+ */
+class TcpSocketTask : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * Constructor
+     * \param capacity the maximum number of states waiting to be sent
+     */
+    TcpSocketTask(int capacity = 4);
+
+    /**
+     * Destructor
+     */
+    virtual ~TcpSocketTask();
+
+    /**
+     * Sets the host and the port of the receiver
+     */
+    void setHost(const QString &host, quint16 port);
+
+    /**
+     * Compresses the data of the states added from now on before sending them
+     */
+    void setCompress(bool on);
+
+    /**
+     * Adds a serialized state to the queue. It can be called from any thread
+     * and never waits for the socket.
+     * \return boolean, \a false if an older state had to be discarded
+     */
+    bool addState(const QByteArray &state);
+
+    /**
+     * Gets the number of states written to the socket
+     */
+    int getStatesSent() const;
+
+    /**
+     * Gets the number of states discarded because the receiver was too slow
+     */
+    int getStatesDropped() const;
+
+public slots:
+    /**
+     * Connects to the receiver
+     */
+    void connectToHost();
+
+    /**
+     * Writes the queued states while the socket buffer is not full
+     */
+    void flush();
+
+    /**
+     * Closes the connection
+     */
+    void abort();
+
+signals:
+    void connected();
+    void messageFailed(const QString &message);
+
+private slots:
+    void socketError();
+
+private:
+    /// A serialized state waiting to be sent
+    struct QueuedState
+    {
+        QByteArray data;
+        bool compress; ///< the option of the sender when the state was added
+    };
+
+    bool takeState(QueuedState &state);
+    void write(const QueuedState &state);
+
+    QTcpSocket *socket;
+    QString host;
+    quint16 port;
+
+    QMutex mutex; ///< protects compress and states
+    bool compress;
+    QQueue<QueuedState> states;
+    int capacity;
+
+    QAtomicInt scheduled, sent, dropped;
+    QElapsedTimer lastAttempt;
+};
+
+} // namespace TerraMEObserver
+
+#endif // TCP_SOCKET_TASK_H
@@ -0,0 +1,96 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2008 INPE and TerraLAB/UFOP.
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this library and its documentation.
+*************************************************************************************/
+
+#include "CSRNeighborhoodTest.h"
+
+#include "core/csrNeighborhood.h"
+
+void CSRNeighborhoodTest::SetUp() {}
+
+void CSRNeighborhoodTest::TearDown() {}
+
+TEST_F(CSRNeighborhoodTest, SortedRows)
+{
+	CSRNeighborhood graph;
+
+	graph.add(0, 1, 0.5);
+	graph.add(0, 2, 0.25);
+	graph.add(2, 0, 1);
+	graph.build(4);
+
+	ASSERT_EQ(graph.cells(), 4);
+	ASSERT_EQ(graph.size(), 3);
+	ASSERT_EQ(graph.degree(0), 2);
+	ASSERT_EQ(graph.degree(1), 0);
+	ASSERT_EQ(graph.degree(2), 1);
+	ASSERT_EQ(graph.degree(3), 0);
+
+	ASSERT_EQ(graph.getNeighbor(graph.begin(0)), 1);
+	ASSERT_DOUBLE_EQ(graph.getWeight(graph.begin(0)), 0.5);
+	ASSERT_EQ(graph.getNeighbor(graph.begin(0) + 1), 2);
+	ASSERT_DOUBLE_EQ(graph.getWeight(graph.begin(0) + 1), 0.25);
+	ASSERT_EQ(graph.getNeighbor(graph.begin(2)), 0);
+	ASSERT_EQ(graph.end(2), graph.begin(3));
+	ASSERT_EQ(graph.findRepeated(), -1);
+}
+
+TEST_F(CSRNeighborhoodTest, UnsortedRows)
+{
+	CSRNeighborhood graph;
+
+	graph.add(2, 1, 3);
+	graph.add(0, 2, 1);
+	graph.add(2, 0, 4);
+	graph.add(1, 2, 2);
+	graph.add(0, 1, 5);
+	graph.build(3);
+
+	ASSERT_EQ(graph.degree(0), 2);
+	ASSERT_EQ(graph.degree(1), 1);
+	ASSERT_EQ(graph.degree(2), 2);
+
+	// connections from the same origin keep the order they were added
+	ASSERT_EQ(graph.getNeighbor(graph.begin(0)), 2);
+	ASSERT_EQ(graph.getNeighbor(graph.begin(0) + 1), 1);
+	ASSERT_DOUBLE_EQ(graph.getWeight(graph.begin(0) + 1), 5);
+	ASSERT_EQ(graph.getNeighbor(graph.begin(2)), 1);
+	ASSERT_EQ(graph.getNeighbor(graph.begin(2) + 1), 0);
+	ASSERT_DOUBLE_EQ(graph.getWeight(graph.begin(2) + 1), 4);
+}
+
+TEST_F(CSRNeighborhoodTest, Repeated)
+{
+	CSRNeighborhood graph;
+
+	graph.add(0, 1, 1);
+	graph.add(1, 0, 1);
+	graph.add(1, 2, 1);
+	graph.add(1, 0, 1);
+	graph.build(3);
+
+	int repeated = graph.findRepeated();
+	ASSERT_EQ(repeated, 3);
+	ASSERT_EQ(graph.getOrigin(repeated), 1);
+	ASSERT_EQ(graph.getNeighbor(repeated), 0);
+	ASSERT_EQ(graph.getOrigin(0), 0);
+}
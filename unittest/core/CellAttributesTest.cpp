@@ -0,0 +1,212 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2008 INPE and TerraLAB/UFOP.
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this library and its documentation.
+*************************************************************************************/
+
+#include "CellAttributesTest.h"
+
+#include "core/cellAttributes.h"
+
+void CellAttributesTest::SetUp() {}
+
+void CellAttributesTest::TearDown() {}
+
+TEST_F(CellAttributesTest, AddAttribute)
+{
+	CellAttributes attrs;
+	attrs.resize(10);
+
+	ASSERT_EQ(attrs.addAttribute("height", CellAttributes::TNumber), 0);
+	ASSERT_EQ(attrs.addAttribute("forest", CellAttributes::TBoolean), 1);
+	ASSERT_EQ(attrs.addAttribute("height", CellAttributes::TInteger), 0);
+	ASSERT_EQ(attrs.count(), 2);
+	ASSERT_EQ(attrs.size(), 10);
+	ASSERT_EQ(attrs.find("forest"), 1);
+	ASSERT_EQ(attrs.find("cover"), -1);
+	ASSERT_EQ(attrs.getName(0), "height");
+	ASSERT_EQ(attrs.getType(0), CellAttributes::TNumber);
+}
+
+TEST_F(CellAttributesTest, SetAndGet)
+{
+	CellAttributes attrs;
+	attrs.resize(5);
+
+	int height = attrs.addAttribute("height", CellAttributes::TNumber);
+	int forest = attrs.addAttribute("forest", CellAttributes::TBoolean);
+
+	ASSERT_TRUE(attrs.setNumber(height, 3, 2.5));
+	ASSERT_TRUE(attrs.setBoolean(forest, 4, true));
+	ASSERT_FALSE(attrs.setNumber(forest, 4, 1));
+	ASSERT_FALSE(attrs.setBoolean(height, 4, true));
+
+	ASSERT_DOUBLE_EQ(attrs.getNumber(height, 3), 2.5);
+	ASSERT_DOUBLE_EQ(attrs.getNumber(height, 0), 0);
+	ASSERT_TRUE(attrs.getBoolean(forest, 4));
+	ASSERT_FALSE(attrs.getBoolean(forest, 0));
+	ASSERT_DOUBLE_EQ(attrs.numbers(height)[3], 2.5);
+}
+
+TEST_F(CellAttributesTest, IntegerPromotion)
+{
+	CellAttributes attrs;
+	attrs.resize(3);
+
+	int value = attrs.addAttribute("value", CellAttributes::TInteger);
+
+	attrs.setNumber(value, 0, 4);
+	ASSERT_EQ(attrs.getType(value), CellAttributes::TInteger);
+	ASSERT_EQ(attrs.getInteger(value, 0), 4);
+
+	attrs.setNumber(value, 1, 0.5);
+	ASSERT_EQ(attrs.getType(value), CellAttributes::TNumber);
+	ASSERT_DOUBLE_EQ(attrs.getNumber(value, 0), 4);
+	ASSERT_DOUBLE_EQ(attrs.getNumber(value, 1), 0.5);
+}
+
+TEST_F(CellAttributesTest, Resize)
+{
+	CellAttributes attrs;
+	int value = attrs.addAttribute("value", CellAttributes::TNumber);
+
+	attrs.resize(2);
+	attrs.setNumber(value, 1, 3);
+	attrs.resize(4);
+
+	ASSERT_EQ(attrs.size(), 4);
+	ASSERT_DOUBLE_EQ(attrs.getNumber(value, 1), 3);
+	ASSERT_DOUBLE_EQ(attrs.getNumber(value, 3), 0);
+
+	attrs.clear();
+	ASSERT_EQ(attrs.count(), 0);
+	ASSERT_EQ(attrs.size(), 0);
+}
+
+TEST_F(CellAttributesTest, Synchronize)
+{
+	CellAttributes attrs;
+	attrs.resize(3);
+
+	int value = attrs.addAttribute("value", CellAttributes::TInteger);
+	int forest = attrs.addAttribute("forest", CellAttributes::TBoolean);
+
+	attrs.setNumber(value, 0, 5);
+	attrs.setBoolean(forest, 0, true);
+	ASSERT_FALSE(attrs.isSynchronized(value));
+
+	attrs.synchronize(value);
+	attrs.synchronize(forest);
+	attrs.setNumber(value, 0, 6);
+	attrs.setBoolean(forest, 0, false);
+
+	ASSERT_TRUE(attrs.isSynchronized(value));
+	ASSERT_EQ(attrs.getPastInteger(value, 0), 5);
+	ASSERT_TRUE(attrs.getPastBoolean(forest, 0));
+	ASSERT_EQ(attrs.getInteger(value, 0), 6);
+
+	attrs.setNumber(value, 1, 1.5);
+	ASSERT_DOUBLE_EQ(attrs.getPastNumber(value, 0), 5);
+	ASSERT_DOUBLE_EQ(attrs.getPastNumber(value, 1), 0);
+
+	attrs.resetPast();
+	attrs.synchronize(value);
+	ASSERT_TRUE(attrs.isSynchronized(value));
+	ASSERT_FALSE(attrs.isSynchronized(forest));
+	ASSERT_DOUBLE_EQ(attrs.getPastNumber(value, 1), 1.5);
+}
+
+TEST_F(CellAttributesTest, Restore)
+{
+	CellAttributes attrs;
+	attrs.resize(3);
+
+	int value = attrs.addAttribute("value", CellAttributes::TInteger);
+	int forest = attrs.addAttribute("forest", CellAttributes::TBoolean);
+
+	attrs.setNumber(value, 0, 2);
+	attrs.setBoolean(forest, 1, true);
+	attrs.synchronize(value);
+
+	CellAttributes snapshot = attrs;
+
+	attrs.setNumber(value, 0, 0.5);
+	attrs.setBoolean(forest, 1, false);
+	attrs.resetPast();
+	int height = attrs.addAttribute("height", CellAttributes::TNumber);
+	attrs.setNumber(height, 2, 7);
+
+	ASSERT_TRUE(attrs.restore(snapshot));
+	ASSERT_EQ(attrs.getType(value), CellAttributes::TInteger);
+	ASSERT_EQ(attrs.getInteger(value, 0), 2);
+	ASSERT_TRUE(attrs.getBoolean(forest, 1));
+	ASSERT_TRUE(attrs.isSynchronized(value));
+	ASSERT_EQ(attrs.getPastInteger(value, 0), 2);
+	ASSERT_DOUBLE_EQ(attrs.getNumber(height, 2), 7);
+
+	CellAttributes other;
+	other.resize(4);
+	other.addAttribute("value", CellAttributes::TInteger);
+	ASSERT_FALSE(other.restore(snapshot));
+
+	other.resize(3);
+	ASSERT_FALSE(other.restore(snapshot));
+}
+
+TEST_F(CellAttributesTest, Data)
+{
+	CellAttributes attrs;
+	attrs.resize(3);
+
+	int value = attrs.addAttribute("value", CellAttributes::TNumber);
+	int count = attrs.addAttribute("count", CellAttributes::TInteger);
+
+	attrs.setNumber(value, 1, 2.5);
+	attrs.setNumber(count, 2, 7);
+	attrs.synchronize(value);
+	attrs.setNumber(value, 1, 4);
+
+	size_t bytes, pastBytes;
+	const char* data = attrs.getData(value, false, bytes);
+	const char* past = attrs.getData(value, true, pastBytes);
+	ASSERT_EQ(bytes, 3 * sizeof(double));
+	ASSERT_EQ(pastBytes, 3 * sizeof(double));
+
+	std::string values(data, bytes);
+	std::string pastValues(past, pastBytes);
+
+	CellAttributes other;
+	other.resize(3);
+	int otherValue = other.addAttribute("value", CellAttributes::TInteger);
+	int otherCount = other.addAttribute("count", CellAttributes::TInteger);
+
+	ASSERT_TRUE(other.setData(otherValue, CellAttributes::TNumber, values.data(), values.size(), pastValues.data(), pastValues.size()));
+	ASSERT_EQ(other.getType(otherValue), CellAttributes::TNumber);
+	ASSERT_DOUBLE_EQ(other.getNumber(otherValue, 1), 4);
+	ASSERT_TRUE(other.isSynchronized(otherValue));
+	ASSERT_DOUBLE_EQ(other.getPastNumber(otherValue, 1), 2.5);
+
+	data = attrs.getData(count, false, bytes);
+	ASSERT_TRUE(other.setData(otherCount, CellAttributes::TInteger, data, bytes, 0, 0));
+	ASSERT_EQ(other.getInteger(otherCount, 2), 7);
+	ASSERT_FALSE(other.isSynchronized(otherCount));
+
+	ASSERT_FALSE(other.setData(otherCount, CellAttributes::TNumber, data, bytes, 0, 0));
+}
@@ -0,0 +1,105 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2008 INPE and TerraLAB/UFOP.
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this library and its documentation.
+*************************************************************************************/
+
+#include "CellGridTest.h"
+
+#include "core/cellGrid.h"
+
+void CellGridTest::SetUp() {}
+
+void CellGridTest::TearDown() {}
+
+TEST_F(CellGridTest, Dense)
+{
+	CellGrid grid;
+
+	for(int x = 0; x < 10; x++)
+		for(int y = 0; y < 5; y++)
+			grid.add(x, y);
+
+	grid.update();
+
+	ASSERT_EQ(grid.getXDim(), 10);
+	ASSERT_EQ(grid.getYDim(), 5);
+	ASSERT_EQ(grid.find(0, 0), 0);
+	ASSERT_EQ(grid.find(0, 4), 4);
+	ASSERT_EQ(grid.find(9, 4), 49);
+	ASSERT_EQ(grid.find(10, 0), -1);
+	ASSERT_EQ(grid.find(-1, 0), -1);
+	ASSERT_EQ(grid.find(0, 5), -1);
+}
+
+TEST_F(CellGridTest, Sparse)
+{
+	CellGrid grid;
+
+	grid.add(0, 0);
+	grid.add(1000, 1000);
+	grid.add(-500, 20);
+	grid.update();
+
+	ASSERT_EQ(grid.find(0, 0), 0);
+	ASSERT_EQ(grid.find(1000, 1000), 1);
+	ASSERT_EQ(grid.find(-500, 20), 2);
+	ASSERT_EQ(grid.find(20, -500), -1);
+	ASSERT_EQ(grid.find(1, 1), -1);
+	ASSERT_EQ(grid.getXMin(), -500);
+	ASSERT_EQ(grid.getYMax(), 1000);
+}
+
+TEST_F(CellGridTest, AddAfterUpdate)
+{
+	CellGrid grid;
+
+	grid.add(0, 0);
+	grid.add(1, 0);
+	grid.update();
+
+	grid.add(0, 1);
+	grid.add(1, 1);
+	grid.add(1, 1);
+
+	ASSERT_EQ(grid.find(0, 0), 0);
+	ASSERT_EQ(grid.find(1, 0), 1);
+	ASSERT_EQ(grid.find(0, 1), 2);
+	ASSERT_EQ(grid.find(1, 1), 3);
+	ASSERT_EQ(grid.getYDim(), 2);
+
+	for(int y = 2; y < 20; y++)
+	{
+		grid.add(0, y);
+		grid.add(1, y);
+		grid.update();
+
+		// the duplicated cell (1, 1) takes ordinal 4
+		ASSERT_EQ(grid.find(0, y), 2 * y + 1);
+		ASSERT_EQ(grid.find(1, y), 2 * y + 2);
+	}
+
+	ASSERT_EQ(grid.find(1, 1), 3);
+
+	grid.clear();
+	ASSERT_TRUE(grid.empty());
+	grid.update();
+	ASSERT_EQ(grid.find(0, 0), -1);
+}
@@ -0,0 +1,146 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2008 INPE and TerraLAB/UFOP.
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this library and its documentation.
+*************************************************************************************/
+
+#include "CellTraversalTest.h"
+
+#include "core/cellTraversal.h"
+
+void CellTraversalTest::SetUp() {}
+
+void CellTraversalTest::TearDown() {}
+
+TEST_F(CellTraversalTest, PartitionLines)
+{
+	CellAttributes attributes;
+	CellGrid grid;
+
+	for(int x = 0; x < 10; x++)
+		for(int y = 0; y < 7; y++)
+			grid.add(x, y);
+
+	attributes.resize(70);
+
+	CellTraversal traversal(attributes, grid);
+	traversal.partition(4);
+
+	ASSERT_EQ(traversal.getPartitions(), 4);
+	ASSERT_EQ(traversal.begin(0), 0);
+	ASSERT_EQ(traversal.end(0), 21);
+	ASSERT_EQ(traversal.begin(1), 21);
+	ASSERT_EQ(traversal.end(1), 35);
+	ASSERT_EQ(traversal.end(2), 56);
+	ASSERT_EQ(traversal.end(3), 70);
+}
+
+TEST_F(CellTraversalTest, PartitionSingleLine)
+{
+	CellAttributes attributes;
+	CellGrid grid;
+
+	for(int y = 0; y < 10; y++)
+		grid.add(0, y);
+
+	attributes.resize(10);
+
+	CellTraversal traversal(attributes, grid);
+	traversal.partition(3);
+
+	ASSERT_EQ(traversal.getPartitions(), 3);
+	ASSERT_EQ(traversal.end(0), 3);
+	ASSERT_EQ(traversal.end(1), 6);
+	ASSERT_EQ(traversal.end(2), 10);
+
+	traversal.partition(20);
+
+	ASSERT_EQ(traversal.getPartitions(), 10);
+
+	for(int i = 0; i < 10; i++)
+		ASSERT_EQ(traversal.end(i) - traversal.begin(i), 1);
+}
+
+TEST_F(CellTraversalTest, Outputs)
+{
+	CellAttributes attributes;
+	CellGrid grid;
+
+	int count = attributes.addAttribute("count", CellAttributes::TInteger);
+	int alive = attributes.addAttribute("alive", CellAttributes::TBoolean);
+	int other = attributes.addAttribute("other", CellAttributes::TNumber);
+	attributes.resize(4);
+	attributes.setNumber(count, 3, 7);
+
+	CellTraversal traversal(attributes, grid);
+
+	int o1 = traversal.addOutput(count);
+	int o2 = traversal.addOutput(alive);
+
+	ASSERT_EQ(traversal.addOutput(count), o1);
+	ASSERT_EQ(traversal.getOutputs(), 2);
+	ASSERT_EQ(traversal.getOutput(other), -1);
+
+	ASSERT_TRUE(traversal.setNumber(o1, 0, 2));
+	ASSERT_FALSE(traversal.setNumber(o2, 0, 2));
+	ASSERT_TRUE(traversal.setBoolean(o2, 1, true));
+	ASSERT_FALSE(traversal.setBoolean(o1, 1, true));
+
+	ASSERT_TRUE(traversal.isWritten(o1, 0));
+	ASSERT_FALSE(traversal.isWritten(o1, 1));
+	ASSERT_EQ(traversal.getValue(o1, 0), 2);
+	ASSERT_EQ(attributes.getInteger(count, 0), 0);
+
+	traversal.setNumber(o1, 1, 0.5);
+	traversal.commit();
+
+	ASSERT_EQ(attributes.getType(count), CellAttributes::TNumber);
+	ASSERT_EQ(attributes.getNumber(count, 0), 2);
+	ASSERT_EQ(attributes.getNumber(count, 1), 0.5);
+	ASSERT_EQ(attributes.getNumber(count, 3), 7);
+	ASSERT_TRUE(attributes.getBoolean(alive, 1));
+	ASSERT_FALSE(attributes.getBoolean(alive, 0));
+}
+
+TEST_F(CellTraversalTest, RandomStreams)
+{
+	CellRandom r1(10, 0);
+	CellRandom r2(10, 0);
+	CellRandom r3(10, 1);
+
+	bool different = false;
+
+	for(int i = 0; i < 100; i++)
+	{
+		double v1 = r1.number();
+		ASSERT_EQ(v1, r2.number());
+		ASSERT_GE(v1, 0);
+		ASSERT_LT(v1, 1);
+
+		if(v1 != r3.number()) different = true;
+
+		long long v = r1.integer(-2, 2);
+		r2.integer(-2, 2);
+		ASSERT_GE(v, -2);
+		ASSERT_LE(v, 2);
+	}
+
+	ASSERT_TRUE(different);
+}
@@ -0,0 +1,171 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2008 INPE and TerraLAB/UFOP.
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this library and its documentation.
+*************************************************************************************/
+
+#include "CheckpointFileTest.h"
+
+#include <cstdio>
+#include <limits>
+
+#include "core/checkpointFile.cpp"
+
+void CheckpointFileTest::SetUp()
+{
+	fileName = "checkpointfiletest.tmc";
+}
+
+void CheckpointFileTest::TearDown()
+{
+	remove(fileName.c_str());
+}
+
+TEST_F(CheckpointFileTest, WriteAndRead)
+{
+	CheckpointWriter writer;
+	ASSERT_EQ(writer.open(fileName), "");
+
+	std::string binary("a\0b", 3);
+
+	ASSERT_EQ(writer.beginTable(), 0u);
+	writer.writeString("value", 5);
+	writer.writeNumber(-std::numeric_limits<double>::infinity());
+	writer.writeInteger(1);
+	writer.writeInteger(-5000000000LL);
+	writer.writeInteger(2);
+	writer.writeString(binary.data(), binary.size());
+	writer.writeBoolean(true);
+	ASSERT_EQ(writer.beginTable(), 1u);
+	writer.writeBoolean(false);
+	writer.writeNil();
+	writer.endTable();
+	writer.writeInteger(3);
+	writer.writeReference(1);
+	writer.endTable();
+	ASSERT_EQ(writer.close(), "");
+
+	FILE* tmp = fopen((fileName + ".tmp").c_str(), "rb");
+	ASSERT_TRUE(tmp == 0);
+
+	CheckpointReader reader;
+	CheckpointValue value;
+	ASSERT_EQ(reader.open(fileName), "");
+
+	ASSERT_TRUE(reader.read(value));
+	ASSERT_EQ(value.type, CheckpointValue::TTable);
+	ASSERT_EQ(value.table, 0u);
+
+	ASSERT_TRUE(reader.read(value));
+	ASSERT_EQ(value.type, CheckpointValue::TString);
+	ASSERT_EQ(std::string(value.text, value.size), "value");
+
+	ASSERT_TRUE(reader.read(value));
+	ASSERT_EQ(value.type, CheckpointValue::TNumber);
+	ASSERT_EQ(value.number, -std::numeric_limits<double>::infinity());
+
+	ASSERT_TRUE(reader.read(value));
+	ASSERT_TRUE(reader.read(value));
+	ASSERT_EQ(value.type, CheckpointValue::TInteger);
+	ASSERT_EQ(value.integer, -5000000000LL);
+
+	ASSERT_TRUE(reader.read(value));
+	ASSERT_TRUE(reader.read(value));
+	ASSERT_EQ(std::string(value.text, value.size), binary);
+
+	ASSERT_TRUE(reader.read(value));
+	ASSERT_EQ(value.type, CheckpointValue::TTrue);
+
+	ASSERT_TRUE(reader.read(value));
+	ASSERT_EQ(value.type, CheckpointValue::TTable);
+	ASSERT_EQ(value.table, 1u);
+
+	ASSERT_TRUE(reader.read(value));
+	ASSERT_EQ(value.type, CheckpointValue::TFalse);
+	ASSERT_TRUE(reader.read(value));
+	ASSERT_EQ(value.type, CheckpointValue::TNil);
+	ASSERT_TRUE(reader.read(value));
+	ASSERT_EQ(value.type, CheckpointValue::TEnd);
+
+	ASSERT_TRUE(reader.read(value));
+	ASSERT_TRUE(reader.read(value));
+	ASSERT_EQ(value.type, CheckpointValue::TReference);
+	ASSERT_EQ(value.table, 1u);
+
+	ASSERT_TRUE(reader.read(value));
+	ASSERT_EQ(value.type, CheckpointValue::TEnd);
+	ASSERT_TRUE(reader.atEnd());
+	ASSERT_FALSE(reader.read(value));
+}
+
+TEST_F(CheckpointFileTest, InvalidFiles)
+{
+	CheckpointReader reader;
+	ASSERT_EQ(reader.open(fileName), "Could not open file '" + fileName + "'.");
+
+	FILE* file = fopen(fileName.c_str(), "wb");
+	fputs("GPMB", file);
+	fclose(file);
+	ASSERT_EQ(reader.open(fileName), "File '" + fileName + "' is not a checkpoint file.");
+
+	unsigned int version = 2;
+	file = fopen(fileName.c_str(), "wb");
+	fputs("TMCP", file);
+	fwrite(&version, sizeof(version), 1, file);
+	fclose(file);
+	ASSERT_EQ(reader.open(fileName), "File '" + fileName + "' was created by an incompatible version of TerraME.");
+
+	unsigned long long size = 10;
+	version = 1;
+	file = fopen(fileName.c_str(), "wb");
+	fputs("TMCP", file);
+	fwrite(&version, sizeof(version), 1, file);
+	fputc(CheckpointValue::TString, file);
+	fwrite(&size, sizeof(size), 1, file);
+	fputs("abc", file);
+	fputc(CheckpointValue::TReference, file);
+	fclose(file);
+
+	CheckpointValue value;
+	ASSERT_EQ(reader.open(fileName), "");
+	ASSERT_FALSE(reader.read(value));
+}
+
+TEST_F(CheckpointFileTest, InterruptedWriting)
+{
+	{
+		CheckpointWriter writer;
+		ASSERT_EQ(writer.open(fileName), "");
+		writer.writeInteger(1);
+		ASSERT_EQ(writer.close(), "");
+	}
+
+	{
+		CheckpointWriter writer;
+		ASSERT_EQ(writer.open(fileName), "");
+		writer.writeInteger(2);
+	}
+
+	CheckpointReader reader;
+	CheckpointValue value;
+	ASSERT_EQ(reader.open(fileName), "");
+	ASSERT_TRUE(reader.read(value));
+	ASSERT_EQ(value.integer, 1);
+}
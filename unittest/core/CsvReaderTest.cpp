@@ -0,0 +1,199 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2008 INPE and TerraLAB/UFOP.
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this library and its documentation.
+*************************************************************************************/
+
+#include "CsvReaderTest.h"
+
+#include <climits>
+#include <clocale>
+#include <cstdio>
+
+#include "core/csvReader.cpp"
+
+void CsvReaderTest::SetUp()
+{
+	fileName = "csvreadertest.csv";
+}
+
+void CsvReaderTest::TearDown()
+{
+	remove(fileName.c_str());
+}
+
+void CsvReaderTest::write(const std::string& content)
+{
+	FILE* file = fopen(fileName.c_str(), "wb");
+	fwrite(content.data(), 1, content.size(), file);
+	fclose(file);
+}
+
+TEST_F(CsvReaderTest, ParseLine)
+{
+	std::vector<std::string> values;
+	std::string line = " a ,,\"b, c\",\"d\"\"e\"\"f\"";
+
+	ASSERT_TRUE(CsvReader::parseLine(line.data(), line.data() + line.size(), ",", values));
+	ASSERT_EQ(values.size(), 4);
+	ASSERT_EQ(values[0], "a");
+	ASSERT_EQ(values[1], "");
+	ASSERT_EQ(values[2], "b, c");
+	ASSERT_EQ(values[3], "d\"e\"f");
+
+	// as in the former Lua parser, a separator at the end does not create a value
+	line = "a;b;";
+	ASSERT_TRUE(CsvReader::parseLine(line.data(), line.data() + line.size(), ";", values));
+	ASSERT_EQ(values.size(), 2);
+
+	line = "\"a\"b,c";
+	ASSERT_FALSE(CsvReader::parseLine(line.data(), line.data() + line.size(), ",", values));
+
+	line = "\"a,c";
+	ASSERT_FALSE(CsvReader::parseLine(line.data(), line.data() + line.size(), ",", values));
+}
+
+TEST_F(CsvReaderTest, ToNumber)
+{
+	double value;
+
+	ASSERT_EQ(CsvReader::toNumber("20", value), CsvColumn::Integer);
+	ASSERT_DOUBLE_EQ(value, 20);
+	ASSERT_EQ(CsvReader::toNumber("-2.5", value), CsvColumn::Float);
+	ASSERT_DOUBLE_EQ(value, -2.5);
+	ASSERT_EQ(CsvReader::toNumber("1e3", value), CsvColumn::Float);
+	ASSERT_DOUBLE_EQ(value, 1000);
+	ASSERT_EQ(CsvReader::toNumber("0x10", value), CsvColumn::Integer);
+	ASSERT_DOUBLE_EQ(value, 16);
+	ASSERT_EQ(CsvReader::toNumber("john", value), CsvColumn::Text);
+	ASSERT_EQ(CsvReader::toNumber("inf", value), CsvColumn::Text);
+	ASSERT_EQ(CsvReader::toNumber("nan", value), CsvColumn::Text);
+	ASSERT_EQ(CsvReader::toNumber("12a", value), CsvColumn::Text);
+	ASSERT_EQ(CsvReader::toNumber("", value), CsvColumn::Text);
+}
+
+TEST_F(CsvReaderTest, ToNumberInteger)
+{
+	double value;
+	long long integer;
+
+	ASSERT_EQ(CsvReader::toNumber("9007199254740993", value, integer), CsvColumn::Integer);
+	ASSERT_EQ(integer, 9007199254740993LL);
+	ASSERT_EQ(CsvReader::toNumber(" 20 ", value, integer), CsvColumn::Integer);
+	ASSERT_EQ(integer, 20);
+	ASSERT_EQ(CsvReader::toNumber("-9223372036854775808", value, integer), CsvColumn::Integer);
+	ASSERT_EQ(integer, LLONG_MIN);
+	ASSERT_EQ(CsvReader::toNumber("0xffffffffffffffff", value, integer), CsvColumn::Integer);
+	ASSERT_EQ(integer, -1);
+
+	// decimal integers that do not fit in 64 bits are floats
+	ASSERT_EQ(CsvReader::toNumber("9223372036854775808", value, integer), CsvColumn::Float);
+	ASSERT_DOUBLE_EQ(value, 9223372036854775808.0);
+}
+
+TEST_F(CsvReaderTest, ToNumberLocale)
+{
+	std::string previous = setlocale(LC_NUMERIC, 0);
+	double value;
+
+	// the conversion must not depend on the locale, when one with comma is available
+	if(setlocale(LC_NUMERIC, "pt_BR.UTF-8") || setlocale(LC_NUMERIC, "de_DE.UTF-8"))
+	{
+		ASSERT_EQ(CsvReader::toNumber("1.5", value), CsvColumn::Float);
+		ASSERT_DOUBLE_EQ(value, 1.5);
+		ASSERT_EQ(CsvReader::toNumber("1,5", value), CsvColumn::Text);
+	}
+
+	setlocale(LC_NUMERIC, previous.c_str());
+
+	ASSERT_EQ(CsvReader::toNumber("1.5", value), CsvColumn::Float);
+	ASSERT_DOUBLE_EQ(value, 1.5);
+}
+
+TEST_F(CsvReaderTest, Read)
+{
+	write("name,age,wealth\r\njohn,20,200.5\r\n\"mary, jr\",18,none\r\nbob,30\r\npeter,40,3\r\n");
+
+	CsvReader reader(",");
+	ASSERT_EQ(reader.open(fileName), "");
+	ASSERT_EQ(reader.getHeader().size(), 3);
+	ASSERT_EQ(reader.getHeader()[2], "wealth");
+
+	ASSERT_EQ(reader.read(), "");
+	ASSERT_TRUE(reader.atEnd());
+	ASSERT_EQ(reader.getRows(), 3);
+	ASSERT_EQ(reader.getLine(), 5);
+
+	const CsvColumn& name = reader.getColumns()[0];
+	ASSERT_FALSE(name.isNumeric());
+	ASSERT_EQ(name.texts[1], "mary, jr");
+	ASSERT_EQ(name.texts[2], "peter");
+
+	const CsvColumn& age = reader.getColumns()[1];
+	ASSERT_TRUE(age.isNumeric());
+	ASSERT_DOUBLE_EQ(age.numbers[2], 40);
+
+	const CsvColumn& wealth = reader.getColumns()[2];
+	ASSERT_FALSE(wealth.isNumeric());
+	ASSERT_EQ(wealth.kinds[0], CsvColumn::Float);
+	ASSERT_EQ(wealth.kinds[1], CsvColumn::Text);
+	ASSERT_EQ(wealth.texts.size(), 1);
+
+	ASSERT_EQ(reader.getWarnings().size(), 1);
+	ASSERT_EQ(reader.getWarnings()[0].line, 4);
+	ASSERT_EQ(reader.getWarnings()[0].text, "bob,30");
+	ASSERT_EQ(reader.getWarnings()[0].values, 2);
+}
+
+TEST_F(CsvReaderTest, ReadChunks)
+{
+	write("x;y\n1;2\n3;4\n5;6");
+
+	CsvReader reader(";");
+	ASSERT_EQ(reader.open(fileName), "");
+	ASSERT_EQ(reader.read(2), "");
+	ASSERT_EQ(reader.getRows(), 2);
+	ASSERT_FALSE(reader.atEnd());
+
+	size_t offset = reader.getOffset();
+	int line = reader.getLine();
+
+	CsvReader next(";");
+	ASSERT_EQ(next.open(fileName), "");
+	next.seek(offset, line);
+	ASSERT_EQ(next.read(2), "");
+	ASSERT_EQ(next.getRows(), 1);
+	ASSERT_TRUE(next.atEnd());
+	ASSERT_EQ(next.getLine(), 4);
+	ASSERT_DOUBLE_EQ(next.getColumns()[1].numbers[0], 6);
+}
+
+TEST_F(CsvReaderTest, InvalidLine)
+{
+	write("x,y\n\"1\"2,3\n");
+
+	CsvReader reader(",");
+	ASSERT_EQ(reader.open(fileName), "");
+	ASSERT_EQ(reader.read(), "Line 2 ('\"1\"2,3') is invalid.");
+
+	write("");
+	ASSERT_EQ(reader.open(fileName), "File 'csvreadertest.csv' is empty.");
+	ASSERT_EQ(reader.open("csvreadertest-missing.csv"), "Could not open file 'csvreadertest-missing.csv'.");
+}
@@ -0,0 +1,106 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2008 INPE and TerraLAB/UFOP.
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this library and its documentation.
+*************************************************************************************/
+
+#include "EventQueueTest.h"
+
+#include "core/eventQueue.h"
+
+void EventQueueTest::SetUp() {}
+
+void EventQueueTest::TearDown() {}
+
+TEST_F(EventQueueTest, Order)
+{
+	EventQueue queue;
+
+	int a = queue.push(2, 0);
+	int b = queue.push(1, 0);
+	int c = queue.push(2, -1);
+	int d = queue.push(2, 0);
+
+	ASSERT_EQ(queue.size(), 4);
+	ASSERT_EQ(queue.top(), b);
+	ASSERT_DOUBLE_EQ(queue.topTime(), 1);
+	queue.pop();
+	ASSERT_EQ(queue.top(), c);
+	queue.pop();
+	ASSERT_EQ(queue.top(), a);
+	queue.pop();
+	ASSERT_EQ(queue.top(), d);
+	queue.pop();
+	ASSERT_TRUE(queue.empty());
+}
+
+TEST_F(EventQueueTest, StableOrderForManyEvents)
+{
+	EventQueue queue;
+	std::vector<int> handles;
+
+	for(int i = 0; i < 10000; i++)
+		handles.push_back(queue.push(i % 10, 0));
+
+	for(int time = 0; time < 10; time++)
+	{
+		for(int i = time; i < 10000; i += 10)
+		{
+			ASSERT_EQ(queue.top(), handles[i]);
+			queue.pop();
+		}
+	}
+
+	ASSERT_TRUE(queue.empty());
+}
+
+TEST_F(EventQueueTest, ReuseHandles)
+{
+	EventQueue queue;
+
+	int a = queue.push(1, 0);
+	queue.push(2, 0);
+	queue.pop();
+
+	ASSERT_EQ(queue.push(3, 0), a);
+	ASSERT_EQ(queue.size(), 2);
+
+	queue.clear();
+	ASSERT_TRUE(queue.empty());
+	ASSERT_EQ(queue.push(1, 0), 0);
+}
+
+TEST_F(EventQueueTest, Sorted)
+{
+	EventQueue queue;
+
+	int a = queue.push(3, 0);
+	int b = queue.push(1, 1);
+	int c = queue.push(1, 0);
+
+	std::vector<int> handles;
+	queue.sorted(handles);
+
+	ASSERT_EQ(handles.size(), 3u);
+	ASSERT_EQ(handles[0], c);
+	ASSERT_EQ(handles[1], b);
+	ASSERT_EQ(handles[2], a);
+	ASSERT_EQ(queue.top(), c);
+}
@@ -0,0 +1,238 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2008 INPE and TerraLAB/UFOP.
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this library and its documentation.
+*************************************************************************************/
+
+#include "NeighborhoodFileTest.h"
+
+#include <cstdio>
+
+#include "core/neighborhoodFile.cpp"
+
+void NeighborhoodFileTest::SetUp()
+{
+	fileName = "neighborhoodfiletest.txt";
+}
+
+void NeighborhoodFileTest::TearDown()
+{
+	remove(fileName.c_str());
+}
+
+void NeighborhoodFileTest::write(const std::string& content)
+{
+	FILE* file = fopen(fileName.c_str(), "wb");
+	fwrite(content.data(), 1, content.size(), file);
+	fclose(file);
+}
+
+static NeighborhoodFile::IdIndex createIds()
+{
+	NeighborhoodFile::IdIndex ids;
+	ids["a"] = 0;
+	ids["b"] = 1;
+	ids["c"] = 2;
+	return ids;
+}
+
+TEST_F(NeighborhoodFileTest, LoadGAL)
+{
+	CSRNeighborhood graph;
+
+	write("0 3 layer id\na 2\nb c\nc 1\na\n");
+	ASSERT_EQ(NeighborhoodFile::loadText(fileName, "gal", false, createIds(), graph), "");
+	graph.build(3);
+
+	ASSERT_EQ(graph.size(), 3);
+	ASSERT_EQ(graph.degree(0), 2);
+	ASSERT_EQ(graph.degree(1), 0);
+	ASSERT_EQ(graph.degree(2), 1);
+	ASSERT_EQ(graph.getNeighbor(graph.begin(0)), 1);
+	ASSERT_EQ(graph.getNeighbor(graph.begin(0) + 1), 2);
+	ASSERT_DOUBLE_EQ(graph.getWeight(graph.begin(0)), 1);
+	ASSERT_EQ(graph.getNeighbor(graph.begin(2)), 0);
+}
+
+TEST_F(NeighborhoodFileTest, LoadGPM)
+{
+	CSRNeighborhood graph;
+
+	write("0 layer layer id weight\r\na 2\r\nb 0.5 c 0.25\r\nb 1\r\na 2\r\n");
+	ASSERT_EQ(NeighborhoodFile::loadText(fileName, "gpm", true, createIds(), graph), "");
+	graph.build(3);
+
+	ASSERT_EQ(graph.size(), 3);
+	ASSERT_EQ(graph.degree(0), 2);
+	ASSERT_EQ(graph.degree(1), 1);
+	ASSERT_DOUBLE_EQ(graph.getWeight(graph.begin(0)), 0.5);
+	ASSERT_DOUBLE_EQ(graph.getWeight(graph.begin(0) + 1), 0.25);
+	ASSERT_EQ(graph.getNeighbor(graph.begin(1)), 0);
+	ASSERT_DOUBLE_EQ(graph.getWeight(graph.begin(1)), 2);
+}
+
+TEST_F(NeighborhoodFileTest, LoadGWT)
+{
+	CSRNeighborhood graph;
+
+	write("0 3 layer id\na b 0.5\na c 0.5\nc a 1\n");
+	ASSERT_EQ(NeighborhoodFile::loadText(fileName, "gwt", false, createIds(), graph), "");
+	graph.build(3);
+
+	ASSERT_EQ(graph.size(), 3);
+	ASSERT_EQ(graph.degree(0), 2);
+	ASSERT_EQ(graph.degree(2), 1);
+	ASSERT_DOUBLE_EQ(graph.getWeight(graph.begin(2)), 1);
+}
+
+TEST_F(NeighborhoodFileTest, Errors)
+{
+	CSRNeighborhood graph;
+
+	write("0 3 layer id\na 2\nb d\n");
+	ASSERT_EQ(NeighborhoodFile::loadText(fileName, "gal", false, createIds(), graph),
+		"Could not find id 'd' in line 3. It seems that it is corrupted.");
+
+	write("0 3 layer id\na 2\nb\n");
+	ASSERT_EQ(NeighborhoodFile::loadText(fileName, "gal", false, createIds(), graph),
+		"Could not find id 'nil' in line 3. It seems that it is corrupted.");
+
+	write("0 3 layer id\nd 1\na\n");
+	ASSERT_EQ(NeighborhoodFile::loadText(fileName, "gal", false, createIds(), graph),
+		"Could not find id 'd' in line 2. It seems that it is corrupted.");
+
+	write("0 3 layer id\na x\nb\n");
+	ASSERT_EQ(NeighborhoodFile::loadText(fileName, "gal", false, createIds(), graph),
+		"Could not read the number of neighbors in line 2. It seems that it is corrupted.");
+
+	write("0 3 layer id\na b\n");
+	ASSERT_EQ(NeighborhoodFile::loadText(fileName, "gwt", false, createIds(), graph),
+		"Could not find id 'nil' in line 2. It seems that it is corrupted.");
+
+	ASSERT_EQ(NeighborhoodFile::loadText(fileName, "txt", false, createIds(), graph),
+		"Invalid neighborhood format 'txt'.");
+
+	ASSERT_EQ(NeighborhoodFile::loadText("missing.gal", "gal", false, createIds(), graph),
+		"Could not open file 'missing.gal'.");
+
+	std::string layer;
+	ASSERT_EQ(NeighborhoodFile::loadBinary(fileName, createIds(), graph, layer),
+		"File '" + fileName + "' is not a GPMB file.");
+}
+
+TEST_F(NeighborhoodFileTest, Binary)
+{
+	CSRNeighborhood graph;
+	graph.add(0, 1, 0.5);
+	graph.add(0, 2, 0.25);
+	graph.add(2, 0, 1);
+	graph.build(3);
+
+	std::vector<std::string> names;
+	names.push_back("a");
+	names.push_back("b");
+	names.push_back("c");
+
+	ASSERT_EQ(NeighborhoodFile::saveBinary(fileName, "cells", names, graph), "");
+
+	// the ids of the CellularSpace can be in a different order
+	NeighborhoodFile::IdIndex ids;
+	ids["a"] = 2;
+	ids["b"] = 0;
+	ids["c"] = 1;
+
+	CSRNeighborhood loaded;
+	std::string layer;
+	ASSERT_EQ(NeighborhoodFile::loadBinary(fileName, ids, loaded, layer), "");
+	loaded.build(3);
+
+	ASSERT_EQ(layer, "cells");
+	ASSERT_EQ(loaded.size(), 3);
+	ASSERT_EQ(loaded.degree(0), 0);
+	ASSERT_EQ(loaded.degree(1), 1);
+	ASSERT_EQ(loaded.degree(2), 2);
+	ASSERT_EQ(loaded.getNeighbor(loaded.begin(1)), 2);
+	ASSERT_EQ(loaded.getNeighbor(loaded.begin(2)), 0);
+	ASSERT_DOUBLE_EQ(loaded.getWeight(loaded.begin(2)), 0.5);
+	ASSERT_EQ(loaded.getNeighbor(loaded.begin(2) + 1), 1);
+	ASSERT_DOUBLE_EQ(loaded.getWeight(loaded.begin(2) + 1), 0.25);
+
+	ids.erase("c");
+	CSRNeighborhood missing;
+	ASSERT_EQ(NeighborhoodFile::loadBinary(fileName, ids, missing, layer),
+		"Could not find id 'c' from file '" + fileName + "' in the CellularSpace.");
+
+	FILE* file = fopen(fileName.c_str(), "rb");
+	std::string content(1024, '\0');
+	content.resize(fread(&content[0], 1, content.size(), file));
+	fclose(file);
+	write(content.substr(0, content.size() - 4));
+
+	ids["c"] = 1;
+	ASSERT_EQ(NeighborhoodFile::loadBinary(fileName, ids, missing, layer),
+		"Could not read file '" + fileName + "'. It seems that it is corrupted.");
+}
+
+TEST_F(NeighborhoodFileTest, BinaryLayout)
+{
+	CSRNeighborhood graph;
+	graph.add(0, 1, 0.5);
+	graph.add(0, 2, 0.25);
+	graph.add(2, 0, 1);
+	graph.build(3);
+
+	std::vector<std::string> names;
+	names.push_back("a");
+	names.push_back("b");
+	names.push_back("c");
+
+	ASSERT_EQ(NeighborhoodFile::saveBinary(fileName, "cells", names, graph), "");
+
+	FILE* file = fopen(fileName.c_str(), "rb");
+	std::string content(1024, '\0');
+	content.resize(fread(&content[0], 1, content.size(), file));
+	fclose(file);
+
+	// magic, version, layer, cells, connections, ids, degrees, neighbors, and weights
+	const size_t degrees = 4 + 4 + (4 + 5) + 4 + 4 + 3 * (4 + 1);
+	ASSERT_EQ(content.size(), degrees + 3 * 4 + 3 * 4 + 3 * 8);
+
+	// the integers and doubles are stored in little-endian byte order
+	ASSERT_EQ(content.substr(4, 4), std::string("\x01\0\0\0", 4));
+	ASSERT_EQ(content.substr(degrees, 4), std::string("\x02\0\0\0", 4));
+	ASSERT_EQ(content.substr(degrees + 24, 8), std::string("\0\0\0\0\0\0\xe0\x3f", 8));
+
+	std::string layer;
+	CSRNeighborhood loaded;
+
+	write(content + '\0');
+	ASSERT_EQ(NeighborhoodFile::loadBinary(fileName, createIds(), loaded, layer),
+		"Could not read file '" + fileName + "'. It seems that it is corrupted.");
+
+	std::string mismatch = content;
+	mismatch[degrees] = 1;
+	write(mismatch);
+	ASSERT_EQ(NeighborhoodFile::loadBinary(fileName, createIds(), loaded, layer),
+		"Could not read file '" + fileName + "'. It seems that it is corrupted.");
+	ASSERT_EQ(loaded.size(), 0);
+
+	write(content);
+	ASSERT_EQ(NeighborhoodFile::loadBinary(fileName, createIds(), loaded, layer), "");
+}
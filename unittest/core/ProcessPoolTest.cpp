@@ -0,0 +1,98 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2008 INPE and TerraLAB/UFOP.
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this library and its documentation.
+*************************************************************************************/
+
+#include "ProcessPoolTest.h"
+
+#include <cstdlib>
+#include <map>
+#include <sstream>
+
+#include "core/processPool.cpp"
+
+void ProcessPoolTest::SetUp() {}
+
+void ProcessPoolTest::TearDown() {}
+
+static bool square(int run, std::string& result, void* data)
+{
+	int offset = *(int*)data;
+	std::ostringstream stream;
+	stream << run * run + offset;
+	result = stream.str();
+	return run != 3;
+}
+
+static bool crash(int run, std::string&, void*)
+{
+	exit(run);
+}
+
+TEST_F(ProcessPoolTest, Runs)
+{
+	ProcessPool pool;
+	int offset = 10;
+
+	for(int i = 1; i <= 4; i++)
+		ASSERT_TRUE(pool.start(i, square, &offset));
+
+	ASSERT_EQ(pool.running(), 4);
+
+	std::map<int, std::string> results;
+	std::map<int, bool> oks;
+	int run;
+	bool ok;
+	std::string text;
+
+	while(pool.wait(run, ok, text))
+	{
+		results[run] = text;
+		oks[run] = ok;
+	}
+
+	ASSERT_EQ(pool.running(), 0);
+	ASSERT_EQ(results.size(), 4);
+	ASSERT_EQ(results[1], "11");
+	ASSERT_EQ(results[2], "14");
+	ASSERT_EQ(results[4], "26");
+	ASSERT_TRUE(oks[1]);
+	ASSERT_FALSE(oks[3]);
+	ASSERT_EQ(results[3], "19");
+}
+
+TEST_F(ProcessPoolTest, Crash)
+{
+	if(!ProcessPool::isSupported()) return;
+
+	ProcessPool pool;
+	ASSERT_TRUE(pool.start(5, crash, 0));
+
+	int run;
+	bool ok;
+	std::string text;
+
+	ASSERT_TRUE(pool.wait(run, ok, text));
+	ASSERT_EQ(run, 5);
+	ASSERT_FALSE(ok);
+	ASSERT_EQ(text, "Run 5 finished unexpectedly (exit code 5).");
+	ASSERT_FALSE(pool.wait(run, ok, text));
+}
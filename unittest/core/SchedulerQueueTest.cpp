@@ -0,0 +1,161 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2008 INPE and TerraLAB/UFOP.
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this library and its documentation.
+*************************************************************************************/
+
+#include "SchedulerQueueTest.h"
+
+#include "core/event.cpp"
+#include "core/schedulerQueue.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+void SchedulerQueueTest::SetUp() {}
+
+void SchedulerQueueTest::TearDown() {}
+
+/// Executes the Events of a queue until a final time, rescheduling each one
+/// according to its period, and returns the number of Messages executed.
+static int run(SchedulerQueue& queue, double finalTime, std::vector<Message*>* order = 0)
+{
+	int executed = 0;
+
+	while(!queue.empty() && queue.getEvent().getTime() <= finalTime)
+	{
+		Event event = queue.getEvent();
+		Message* message = queue.getMessage();
+		queue.pop();
+
+		if(order) order->push_back(message);
+		executed++;
+
+		event.setTime(event.getTime() + event.getPeriod());
+		queue.add(event, message);
+	}
+
+	return executed;
+}
+
+static void fill(SchedulerQueue& queue, std::vector<Message>& messages)
+{
+	srand(1234);
+	for(unsigned int i = 0; i < messages.size(); i++)
+	{
+		double period = 1 + rand() % 4;
+		double priority = rand() % 3;
+		Event event(rand() % 10, period, priority);
+		queue.add(event, &messages[i]);
+	}
+}
+
+TEST_F(SchedulerQueueTest, SameOrderAsMultimap)
+{
+	std::vector<Message> messages(500);
+	MultimapSchedulerQueue multimap;
+	CalendarSchedulerQueue calendar;
+
+	fill(multimap, messages);
+	fill(calendar, messages);
+
+	std::vector<Message*> multimapOrder, calendarOrder;
+	run(multimap, 200, &multimapOrder);
+	run(calendar, 200, &calendarOrder);
+
+	ASSERT_EQ(multimapOrder.size(), calendarOrder.size());
+	for(unsigned int i = 0; i < multimapOrder.size(); i++)
+		ASSERT_EQ(multimapOrder[i], calendarOrder[i]);
+
+	ASSERT_EQ(calendar.size(), 500);
+	ASSERT_GT(calendar.getBuckets(), 16);
+}
+
+TEST_F(SchedulerQueueTest, StableOrder)
+{
+	Message a, b, c;
+	CalendarSchedulerQueue queue;
+
+	Event e1(1, 1, 0), e2(1, 1, 0), e3(1, 1, -1), e4(0.5, 1, 0);
+	queue.add(e1, &a);
+	queue.add(e2, &b);
+	queue.add(e3, &c);
+	queue.add(e4, &a);
+
+	ASSERT_DOUBLE_EQ(queue.getEvent().getTime(), 0.5);
+	queue.pop();
+	ASSERT_EQ(queue.getMessage(), &c);
+	queue.pop();
+	ASSERT_EQ(queue.getMessage(), &a);
+	queue.pop();
+	ASSERT_EQ(queue.getMessage(), &b);
+	queue.pop();
+	ASSERT_TRUE(queue.empty());
+}
+
+TEST_F(SchedulerQueueTest, EventBeforeLastRemoved)
+{
+	Message a, b;
+	CalendarSchedulerQueue queue;
+
+	Event e1(100, 1, 0);
+	queue.add(e1, &a);
+	queue.pop();
+
+	Event e2(150, 1, 0), e3(3, 1, 0);
+	queue.add(e2, &a);
+	queue.add(e3, &b);
+
+	ASSERT_EQ(queue.getMessage(), &b);
+}
+
+static double benchmark(SchedulerQueue& queue, int events)
+{
+	std::vector<Message> messages(events);
+	for(int i = 0; i < events; i++)
+	{
+		Event event(i % 10, 1, 0);
+		queue.add(event, &messages[i]);
+	}
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	run(queue, 20);
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+	return std::chrono::duration<double>(end - start).count();
+}
+
+// Microbenchmark comparing the Event-Message queues. Run it with
+// unittest --gtest_also_run_disabled_tests --gtest_filter=*Benchmark*
+TEST_F(SchedulerQueueTest, DISABLED_Benchmark)
+{
+	for(int events = 1000; events <= 1000000; events *= 10)
+	{
+		MultimapSchedulerQueue multimap;
+		CalendarSchedulerQueue calendar;
+
+		double multimapTime = benchmark(multimap, events);
+		double calendarTime = benchmark(calendar, events);
+
+		printf("%8d events: multimap %.3fs, calendar %.3fs\n", events, multimapTime, calendarTime);
+		fflush(stdout);
+	}
+}
@@ -0,0 +1,199 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2008 INPE and TerraLAB/UFOP.
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this library and its documentation.
+*************************************************************************************/
+
+#include "SocialNetworkGeneratorTest.h"
+
+#include "core/socialNetworkGenerator.h"
+
+void SocialNetworkGeneratorTest::SetUp() {}
+
+void SocialNetworkGeneratorTest::TearDown() {}
+
+static bool isConnection(const CSRNeighborhood& graph, int origin, int neighbor)
+{
+	for(int p = graph.begin(origin); p < graph.end(origin); p++)
+	{
+		if(graph.getNeighbor(p) == neighbor) return true;
+	}
+
+	return false;
+}
+
+static void assertSymmetric(const CSRNeighborhood& graph)
+{
+	for(int origin = 0; origin < graph.cells(); origin++)
+	{
+		for(int p = graph.begin(origin); p < graph.end(origin); p++)
+			ASSERT_TRUE(isConnection(graph, graph.getNeighbor(p), origin));
+	}
+}
+
+TEST_F(SocialNetworkGeneratorTest, Probability)
+{
+	CSRNeighborhood graph;
+	SocialNetworkGenerator generator(1000, 123);
+
+	generator.probability(0.01);
+	generator.build(graph, false);
+
+	ASSERT_EQ(graph.cells(), 1000);
+	ASSERT_GT(graph.size(), 8991);
+	ASSERT_LT(graph.size(), 10991);
+	ASSERT_EQ(graph.findRepeated(), -1);
+
+	for(int origin = 0; origin < 1000; origin++)
+		ASSERT_FALSE(isConnection(graph, origin, origin));
+
+	CSRNeighborhood complete;
+	SocialNetworkGenerator all(10, 123);
+
+	all.probability(1);
+	all.build(complete, false);
+
+	ASSERT_EQ(complete.size(), 90);
+	ASSERT_EQ(complete.findRepeated(), -1);
+
+	CSRNeighborhood same;
+	SocialNetworkGenerator again(1000, 123);
+
+	again.probability(0.01);
+	again.build(same, false);
+
+	ASSERT_EQ(same.size(), graph.size());
+	ASSERT_EQ(same.getNeighbor(same.size() - 1), graph.getNeighbor(graph.size() - 1));
+}
+
+TEST_F(SocialNetworkGeneratorTest, Quantity)
+{
+	CSRNeighborhood graph;
+	SocialNetworkGenerator generator(20, 5);
+
+	generator.quantity(19);
+	generator.build(graph, false);
+
+	ASSERT_EQ(graph.size(), 380);
+	ASSERT_EQ(graph.findRepeated(), -1);
+
+	CSRNeighborhood symmetric;
+	SocialNetworkGenerator other(100, 5);
+
+	other.quantity(3);
+	ASSERT_EQ(other.size(), 300u);
+
+	other.build(symmetric, true);
+
+	ASSERT_GE(symmetric.size(), 300);
+	ASSERT_LE(symmetric.size(), 600);
+	ASSERT_EQ(symmetric.findRepeated(), -1);
+
+	for(int origin = 0; origin < 100; origin++)
+	{
+		ASSERT_GE(symmetric.degree(origin), 3);
+		ASSERT_FALSE(isConnection(symmetric, origin, origin));
+	}
+
+	assertSymmetric(symmetric);
+}
+
+TEST_F(SocialNetworkGeneratorTest, Erdos)
+{
+	CSRNeighborhood graph;
+	SocialNetworkGenerator generator(50, 7);
+
+	generator.erdos(200);
+	generator.build(graph, false);
+
+	ASSERT_EQ(graph.size(), 400);
+	ASSERT_EQ(graph.findRepeated(), -1);
+	assertSymmetric(graph);
+
+	CSRNeighborhood complete;
+	SocialNetworkGenerator all(30, 7);
+
+	all.erdos(435);
+	all.build(complete, false);
+
+	ASSERT_EQ(complete.size(), 870);
+	ASSERT_EQ(complete.findRepeated(), -1);
+
+	for(int origin = 0; origin < 30; origin++)
+		ASSERT_EQ(complete.degree(origin), 29);
+}
+
+TEST_F(SocialNetworkGeneratorTest, Barabasi)
+{
+	CSRNeighborhood graph;
+	SocialNetworkGenerator generator(1000, 11);
+
+	generator.barabasi(10, 3);
+	generator.build(graph, false);
+
+	ASSERT_EQ(graph.size(), 990 * 3 * 2);
+	ASSERT_EQ(graph.findRepeated(), -1);
+	assertSymmetric(graph);
+
+	int maximum = 0;
+
+	for(int origin = 10; origin < 1000; origin++)
+	{
+		ASSERT_GE(graph.degree(origin), 3);
+		maximum = std::max(maximum, graph.degree(origin));
+	}
+
+	ASSERT_GT(maximum, 30);
+}
+
+TEST_F(SocialNetworkGeneratorTest, Watts)
+{
+	CSRNeighborhood ring;
+	SocialNetworkGenerator generator(20, 3);
+
+	generator.watts(2, 0);
+	generator.build(ring, false);
+
+	ASSERT_EQ(ring.size(), 80);
+	ASSERT_EQ(ring.findRepeated(), -1);
+	assertSymmetric(ring);
+
+	for(int origin = 0; origin < 20; origin++)
+	{
+		ASSERT_EQ(ring.degree(origin), 4);
+		ASSERT_TRUE(isConnection(ring, origin, (origin + 1) % 20));
+		ASSERT_TRUE(isConnection(ring, origin, (origin + 2) % 20));
+	}
+
+	CSRNeighborhood graph;
+	SocialNetworkGenerator rewired(200, 3);
+
+	rewired.watts(4, 0.2);
+	rewired.build(graph, false);
+
+	ASSERT_EQ(graph.findRepeated(), -1);
+	assertSymmetric(graph);
+
+	for(int origin = 0; origin < 200; origin++)
+	{
+		ASSERT_GE(graph.degree(origin), 4);
+		ASSERT_FALSE(isConnection(graph, origin, origin));
+	}
+}
@@ -0,0 +1,140 @@
+/************************************************************************************
+TerraME - a software platform for multiple scale spatially-explicit dynamic modeling.
+Copyright (C) 2001-2008 INPE and TerraLAB/UFOP.
+
+This code is part of the TerraME framework.
+This framework is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library.
+
+The authors reassure the license terms regarding the warranties.
+They specifically disclaim any warranties, including, but not limited to,
+the implied warranties of merchantability and fitness for a particular purpose.
+The framework provided hereunder is on an "as is" basis, and the authors have no
+obligation to provide maintenance, support, updates, enhancements, or modifications.
+In no event shall INPE and TerraLAB / UFOP be held liable to any party for direct,
+indirect, special, incidental, or consequential damages arising out of the use
+of this library and its documentation.
+*************************************************************************************/
+
+#include "StencilNeighborhoodTest.h"
+
+#include "core/stencilNeighborhood.h"
+
+void StencilNeighborhoodTest::SetUp() {}
+
+void StencilNeighborhoodTest::TearDown() {}
+
+static CellGrid createGrid(int xdim, int ydim)
+{
+	std::vector<std::pair<int, int> > coords;
+	for(int x = 0; x < xdim; x++)
+		for(int y = 0; y < ydim; y++)
+			coords.push_back(std::make_pair(x, y));
+
+	CellGrid grid;
+	grid.build(coords);
+	return grid;
+}
+
+static StencilNeighborhood createMoore(bool wrap)
+{
+	std::vector<int> dx, dy;
+	for(int lin = -1; lin <= 1; lin++)
+	{
+		for(int col = -1; col <= 1; col++)
+		{
+			if(lin == 0 && col == 0) continue;
+			dx.push_back(col);
+			dy.push_back(lin);
+		}
+	}
+
+	return StencilNeighborhood(dx, dy, true, wrap);
+}
+
+TEST_F(StencilNeighborhoodTest, Grid)
+{
+	CellGrid grid = createGrid(3, 2);
+
+	ASSERT_EQ(grid.getXDim(), 3);
+	ASSERT_EQ(grid.getYDim(), 2);
+	ASSERT_EQ(grid.find(0, 0), 0);
+	ASSERT_EQ(grid.find(0, 1), 1);
+	ASSERT_EQ(grid.find(2, 1), 5);
+	ASSERT_EQ(grid.find(3, 1), -1);
+	ASSERT_EQ(grid.find(-1, 0), -1);
+
+	std::vector<std::pair<int, int> > coords;
+	coords.push_back(std::make_pair(5, 5));
+	coords.push_back(std::make_pair(7, 5));
+	grid.build(coords);
+
+	ASSERT_EQ(grid.find(5, 5), 0);
+	ASSERT_EQ(grid.find(6, 5), -1);
+	ASSERT_EQ(grid.find(7, 5), 1);
+
+	grid.clear();
+	ASSERT_TRUE(grid.empty());
+}
+
+TEST_F(StencilNeighborhoodTest, Moore)
+{
+	CellGrid grid = createGrid(5, 5);
+	StencilNeighborhood moore = createMoore(false);
+	std::vector<int> neighbors;
+	int sizes[9] = {0};
+
+	for(int x = 0; x < 5; x++)
+	{
+		for(int y = 0; y < 5; y++)
+		{
+			double weight = moore.neighbors(grid, x, y, neighbors);
+			ASSERT_DOUBLE_EQ(weight * neighbors.size(), 1);
+			sizes[neighbors.size()]++;
+		}
+	}
+
+	ASSERT_EQ(sizes[3], 4);
+	ASSERT_EQ(sizes[5], 12);
+	ASSERT_EQ(sizes[8], 9);
+
+	moore.neighbors(grid, 0, 0, neighbors);
+	ASSERT_EQ(neighbors[0], grid.find(1, 0));
+	ASSERT_EQ(neighbors[1], grid.find(0, 1));
+	ASSERT_EQ(neighbors[2], grid.find(1, 1));
+}
+
+TEST_F(StencilNeighborhoodTest, Wrap)
+{
+	CellGrid grid = createGrid(5, 5);
+	StencilNeighborhood moore = createMoore(true);
+	std::vector<int> neighbors;
+
+	double weight = moore.neighbors(grid, 0, 0, neighbors);
+	ASSERT_EQ(neighbors.size(), 8);
+	ASSERT_DOUBLE_EQ(weight, 1.0 / 8);
+	ASSERT_EQ(neighbors[0], grid.find(4, 4));
+
+	grid = createGrid(2, 2);
+	weight = moore.neighbors(grid, 0, 0, neighbors);
+	ASSERT_EQ(neighbors.size(), 3);
+	ASSERT_DOUBLE_EQ(weight, 1.0 / 8);
+}
+
+TEST_F(StencilNeighborhoodTest, ConstantWeight)
+{
+	CellGrid grid = createGrid(5, 5);
+	std::vector<int> dx(1, 0), dy(1, 0);
+	StencilNeighborhood self(dx, dy, false, false);
+	std::vector<int> neighbors;
+
+	ASSERT_DOUBLE_EQ(self.neighbors(grid, 2, 3, neighbors), 1);
+	ASSERT_EQ(neighbors.size(), 1);
+	ASSERT_EQ(neighbors[0], grid.find(2, 3));
+	ASSERT_EQ(self.size(), 1);
+}